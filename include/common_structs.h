@@ -199,9 +199,9 @@ typedef struct {
     /* 0x00 */ u16 unk30;
     /* 0x02 */ u16 unk32;
     /* 0x04 */ u16 unk34;
-    /* 0x06 */ u16 meshIndexYX;         ///< Index of the collision mesh in the YX plane.
-    /* 0x08 */ u16 meshIndexZY;         ///< Index of the collision mesh in the ZY plane.
-    /* 0x0A */ u16 meshIndexZX;         ///< Index of the collision mesh in the ZX plane.
+    /* 0x06 */ u32 meshIndexYX;         ///< Index of the collision mesh in the YX plane.
+    /* 0x08 */ u32 meshIndexZY;         ///< Index of the collision mesh in the ZY plane.
+    /* 0x0A */ u32 meshIndexZX;         ///< Index of the collision mesh in the ZX plane.
     /* 0x0C */ Vec3f surfaceDistance;   ///< Distance from the object to the surface in each plane.
     /* 0x18 */ Vec3f unk48;
     /* 0x24 */ Vec3f unk54;
@@ -286,7 +286,7 @@ typedef struct {
     /* 0x00 */ Vec3f pos;                 ///< The position of the tyre in 3D space.
     /* 0x0C */ u8 surfaceType;            ///< The type of surface the tyre is currently on.
     /* 0x0D */ u8 surfaceFlags;           ///< Flags related to the surface.
-    /* 0x0E */ u16 collisionMeshIndex;    ///< The index of the collision mesh the tyre is interacting with.
+    /* 0x0E */ u32 collisionMeshIndex;    ///< The index of the collision mesh the tyre is interacting with.
     /* 0x10 */ f32 baseHeight;            ///< The height of the tyre relative to the ground.
     /* 0x14 */ s32 unk_14;                ///< Lighting-related properties.
 } KartTyre; // size = 0x18
@@ -465,6 +465,10 @@ enum PLACE { FIRST_PLACE, SECOND_PLACE, THIRD_PLACE, FOURTH_PLACE };
  */
 
 #define GRID_SIZE 32
+// Large custom tracks use a finer grid so each cell keeps roughly this many triangles
+#define GRID_SIZE_MAX 256
+#define GRID_TRIANGLES_PER_CELL 64
+#define GRID_MIN_CELL_LENGTH 64
 
 #define FACING_Y_AXIS 0x4000
 #define FACING_X_AXIS 0x8000
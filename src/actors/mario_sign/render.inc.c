@@ -20,19 +20,15 @@ void render_actor_mario_sign(Camera* arg0, UNUSED Mat4 arg1, struct Actor* arg2)
     }
 
     unk = is_within_render_distance(arg0->pos, arg2->pos, arg0->rot[1], 0, gCameraZoom[arg0 - camera1], 16000000.0f);
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         unk = MAX(unk, 0.0f);
     }
     if (!(unk < 0.0f)) {
 
         FrameInterpolation_RecordOpenChild("mario_sign", TAG_OBJECT(arg2));
 
-        gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
-        gSPClearGeometryMode(gDisplayListHead++, G_LIGHTING);
         mtxf_pos_rotation_xyz(mtx, arg2->pos, arg2->rot);
-        if (render_set_position(mtx, 0) != 0) {
-            gSPDisplayList(gDisplayListHead++, d_course_mario_raceway_dl_sign);
-        }
+        DrawBatch_Add((Gfx*) d_course_mario_raceway_dl_sign, NULL, G_SHADING_SMOOTH, G_LIGHTING, mtx);
         FrameInterpolation_RecordCloseChild();
     }
 }
@@ -27,7 +27,7 @@ void render_actor_piranha_plant(Camera* arg0, Mat4 arg1, struct PiranhaPlant* ar
 
     temp_f0 = is_within_render_distance(arg0->pos, arg2->pos, arg0->rot[1], 0, gCameraZoom[arg0 - camera1], 1000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -57,7 +57,7 @@ void render_actor_piranha_plant(Camera* arg0, Mat4 arg1, struct PiranhaPlant* ar
         return;
     }
 
-    if (CVarGetInteger("gDisableLod", 1) == 1) {
+    if (gFrameSettings.DisableLod == 1) {
         temp_f0 = 0.0f;
     }
 
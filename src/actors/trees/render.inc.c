@@ -24,7 +24,7 @@ void render_actor_tree_mario_raceway(Camera* camera, Mat4 arg1, struct Actor* ar
     temp_f0 = is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1],
                                         16000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -39,10 +39,7 @@ void render_actor_tree_mario_raceway(Camera* camera, Mat4 arg1, struct Actor* ar
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_mario_raceway_dl_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_mario_raceway_dl_tree, common_tlut_trees_import, 0, 0, arg1);
 }
 
 /**
@@ -63,7 +60,7 @@ void render_actor_tree_yoshi_valley(Camera* camera, Mat4 arg1, struct Actor* arg
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -78,10 +75,7 @@ void render_actor_tree_yoshi_valley(Camera* camera, Mat4 arg1, struct Actor* arg
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_yoshi_valley_dl_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_yoshi_valley_dl_tree, common_tlut_trees_import, 0, 0, arg1);
 }
 
 /**
@@ -102,7 +96,7 @@ void render_actor_tree_royal_raceway(Camera* camera, Mat4 arg1, struct Actor* ar
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -117,10 +111,7 @@ void render_actor_tree_royal_raceway(Camera* camera, Mat4 arg1, struct Actor* ar
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_royal_raceway_dl_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_royal_raceway_dl_tree, common_tlut_trees_import, 0, 0, arg1);
 }
 
 /**
@@ -141,7 +132,7 @@ void render_actor_tree_moo_moo_farm(Camera* camera, Mat4 arg1, struct Actor* arg
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 6250000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -156,10 +147,7 @@ void render_actor_tree_moo_moo_farm(Camera* camera, Mat4 arg1, struct Actor* arg
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_moo_moo_farm_dl_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_moo_moo_farm_dl_tree, common_tlut_trees_import, 0, 0, arg1);
 }
 
 // have all the properties of the tree
@@ -174,7 +162,7 @@ void func_80299864(Camera* camera, Mat4 arg1, struct Actor* arg2) {
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -226,7 +214,7 @@ void render_actor_tree_bowser_castle(Camera* camera, Mat4 arg1, struct Actor* ar
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -241,10 +229,7 @@ void render_actor_tree_bowser_castle(Camera* camera, Mat4 arg1, struct Actor* ar
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_royal_raceway_dl_castle_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_royal_raceway_dl_castle_tree, common_tlut_trees_import, 0, 0, arg1);
 }
 
 /**
@@ -265,7 +250,7 @@ void render_actor_bush_bowser_castle(Camera* camera, Mat4 arg1, struct Actor* ar
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 640000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -280,10 +265,7 @@ void render_actor_bush_bowser_castle(Camera* camera, Mat4 arg1, struct Actor* ar
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gDPLoadTLUT_pal256(gDisplayListHead++, common_tlut_trees_import);
-        gSPDisplayList(gDisplayListHead++, d_course_bowsers_castle_dl_bush);
-    }
+    DrawBatch_Add((Gfx*) d_course_bowsers_castle_dl_bush, common_tlut_trees_import, 0, 0, arg1);
 }
 
 /**
@@ -304,7 +286,7 @@ void render_actor_tree_frappe_snowland(Camera* camera, Mat4 arg1, struct Actor*
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -319,9 +301,7 @@ void render_actor_tree_frappe_snowland(Camera* camera, Mat4 arg1, struct Actor*
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gSPDisplayList(gDisplayListHead++, d_course_frappe_snowland_dl_tree);
-    }
+    DrawBatch_Add((Gfx*) d_course_frappe_snowland_dl_tree, NULL, 0, 0, arg1);
 }
 
 /**
@@ -342,7 +322,7 @@ void render_actor_tree_cactus1_kalimari_desert(Camera* camera, Mat4 arg1, struct
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -357,9 +337,7 @@ void render_actor_tree_cactus1_kalimari_desert(Camera* camera, Mat4 arg1, struct
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gSPDisplayList(gDisplayListHead++, d_course_kalimari_desert_dl_cactus1);
-    }
+    DrawBatch_Add((Gfx*) d_course_kalimari_desert_dl_cactus1, NULL, 0, 0, arg1);
 }
 
 /**
@@ -380,7 +358,7 @@ void render_actor_tree_cactus2_kalimari_desert(Camera* camera, Mat4 arg1, struct
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -395,9 +373,7 @@ void render_actor_tree_cactus2_kalimari_desert(Camera* camera, Mat4 arg1, struct
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gSPDisplayList(gDisplayListHead++, d_course_kalimari_desert_dl_cactus2);
-    }
+    DrawBatch_Add((Gfx*) d_course_kalimari_desert_dl_cactus2, NULL, 0, 0, arg1);
 }
 
 /**
@@ -418,7 +394,7 @@ void render_actor_tree_cactus3_kalimari_desert(Camera* camera, Mat4 arg1, struct
     temp_f0 =
         is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -433,7 +409,5 @@ void render_actor_tree_cactus3_kalimari_desert(Camera* camera, Mat4 arg1, struct
     arg1[3][1] = arg2->pos[1];
     arg1[3][2] = arg2->pos[2];
 
-    if (render_set_position(arg1, 0) != 0) {
-        gSPDisplayList(gDisplayListHead++, d_course_kalimari_desert_dl_cactus3);
-    }
+    DrawBatch_Add((Gfx*) d_course_kalimari_desert_dl_cactus3, NULL, 0, 0, arg1);
 }
@@ -77,9 +77,9 @@ s16 gPlaceItemBoxes = 1;
 
 // Technically a pointer to an array, but declaring it so creates regalloc issues.
 CollisionTriangle* gCollisionMesh;
-u16* gCollisionIndices;
-u16 gCollisionMeshCount; // Number of entries in gCollisionMesh
-u16 gNumCollisionTriangles;
+u32* gCollisionIndices;
+u32 gCollisionMeshCount; // Number of entries in gCollisionMesh
+u32 gNumCollisionTriangles;
 u32 D_8015F58C;
 
 Vec3f D_8015F590;
@@ -209,12 +209,12 @@ void setup_race(void) {
     if (gCurrentCourseId != gCurrentlyLoadedCourseId) {
         D_80150120 = 0;
         gCurrentlyLoadedCourseId = gCurrentCourseId;
-        gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
+        memory_pool_begin_course();
         load_course(gCurrentCourseId);
         course_init();
-        gFreeMemoryCourseAnchor = gNextFreeMemoryAddress;
+        memory_pool_end_course();
     } else {
-        gNextFreeMemoryAddress = gFreeMemoryCourseAnchor;
+        memory_pool_begin_race();
     }
 
     // Cow related
@@ -69,9 +69,9 @@ extern s16 gPlaceItemBoxes;
 extern Vec3f gVtxStretch;
 
 extern CollisionTriangle* gCollisionMesh;
-extern u16* gCollisionIndices;
-extern u16 gCollisionMeshCount;
-extern u16 gNumCollisionTriangles;
+extern u32* gCollisionIndices;
+extern u32 gCollisionMeshCount;
+extern u32 gNumCollisionTriangles;
 extern u32 D_8015F58C;
 
 extern Vec3f D_8015F590;
@@ -107,9 +107,8 @@ extern uintptr_t gHeapEndPtr;
 /**
  * This repoints gNextFreeMemoryAddress to the point in the memory pool just after a course was loaded.
  * This allows players to retry or reset a course without reloading the whole course.
- * Memory allocated after course load is not zeroed or reset. But should get overwritten by future allocations.
- *
- * This is a relatively unsafe way to architect a memory pool as old memory could accidentally be used if future allocations do not zero or fully overwrite their free memory.
+ * Use memory_pool_begin_race and memory_pool_begin_course to go back to an anchor. They give the memory
+ * allocated after it back to the OS, so it reads back as zero instead of holding stale data.
  */
 extern uintptr_t gFreeMemoryCourseAnchor;
 extern uintptr_t gFreeMemoryResetAnchor;
@@ -9,7 +9,9 @@
 #include "math_util.h"
 #include "code_800029B0.h"
 #include "racing/memory.h"
+#include "racing/rankings.h"
 #include "waypoints.h"
+#include "path_spatial_index.h"
 #include "camera.h"
 #include "actors.h"
 #include "actors_extended.h"
@@ -39,6 +41,7 @@
 #include <stdio.h>
 
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include "engine/courses/Course.h"
 
 s32 unk_code_80005FD0_pad[24];
@@ -674,7 +677,7 @@ s32 set_vehicle_render_distance_flags(Vec3f vehiclePos, f32 renderDistance, s32
             }
         }
     }
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         flag |= (RENDER_VEHICLE << PLAYER_ONE) | (RENDER_VEHICLE << PLAYER_TWO) | (RENDER_VEHICLE << PLAYER_THREE) |
                 (RENDER_VEHICLE << PLAYER_FOUR);
     }
@@ -718,15 +721,11 @@ void detect_wrong_player_direction(s32 playerId, Player* player) {
 }
 
 void set_places(void) {
-    s32 temp_s2;
-    f32 temp_f0;
-    s32 sp80[8];
-    s32 a_really_cool_variable_name;
-    UNUSED s32 pad;
+    s32 sp80[NUM_PLAYERS];
+    bool finished[NUM_PLAYERS];
     s32 var_t4;
     s32 playerId;
     s32 temp_a0;
-    s32 var_t1_3;
 
     switch (gModeSelection) {
         case BATTLE:
@@ -755,24 +754,11 @@ void set_places(void) {
         }
     }
 
-    for (playerId = 0; playerId < var_t4 - 1; playerId++) {
-        if ((gPlayers[gGPCurrentRacePlayerIdByRank[playerId]].type & 0x800)) {
-            continue;
-        }
-
-        for (var_t1_3 = playerId + 1; var_t1_3 < var_t4; var_t1_3++) {
-            if (gCourseCompletionPercentByRank[playerId] < gCourseCompletionPercentByRank[var_t1_3]) {
-                if (!(gPlayers[gGPCurrentRacePlayerIdByRank[var_t1_3]].type & 0x800)) {
-                    temp_s2 = sp80[playerId];
-                    sp80[playerId] = sp80[var_t1_3];
-                    sp80[var_t1_3] = temp_s2;
-                    temp_f0 = gCourseCompletionPercentByRank[playerId];
-                    gCourseCompletionPercentByRank[playerId] = gCourseCompletionPercentByRank[var_t1_3];
-                    gCourseCompletionPercentByRank[var_t1_3] = temp_f0;
-                }
-            }
-        }
+    // Racers who finished keep their place
+    for (playerId = 0; playerId < var_t4; playerId++) {
+        finished[playerId] = (gPlayers[gGPCurrentRacePlayerIdByRank[playerId]].type & 0x800) != 0;
     }
+    rank_racers_around_fixed(sp80, gCourseCompletionPercentByRank, finished, var_t4);
 
     for (playerId = 0; playerId < NUM_PLAYERS; playerId++) {
         gPreviousGPCurrentRaceRankByPlayerId[playerId] = gGPCurrentRaceRankByPlayerId[playerId];
@@ -784,23 +770,11 @@ void set_places(void) {
     }
 
     for (playerId = 0; playerId < var_t4; playerId++) {
-        a_really_cool_variable_name = D_80164378[playerId];
-        sp80[playerId] = a_really_cool_variable_name;
-        gCourseCompletionPercentByRank[playerId] = gCourseCompletionPercentByPlayerId[a_really_cool_variable_name];
-    }
-
-    for (playerId = 0; playerId < var_t4 - 1; playerId++) {
-        for (var_t1_3 = playerId + 1; var_t1_3 < var_t4; var_t1_3++) {
-            if (gCourseCompletionPercentByRank[playerId] < gCourseCompletionPercentByRank[var_t1_3]) {
-                temp_s2 = sp80[playerId];
-                sp80[playerId] = sp80[var_t1_3];
-                sp80[var_t1_3] = temp_s2;
-                temp_f0 = gCourseCompletionPercentByRank[playerId];
-                gCourseCompletionPercentByRank[playerId] = gCourseCompletionPercentByRank[var_t1_3];
-                gCourseCompletionPercentByRank[var_t1_3] = temp_f0;
-            }
-        }
+        temp_a0 = D_80164378[playerId];
+        sp80[playerId] = temp_a0;
+        gCourseCompletionPercentByRank[playerId] = gCourseCompletionPercentByPlayerId[temp_a0];
     }
+    rank_racers(sp80, gCourseCompletionPercentByRank, var_t4);
 
     for (playerId = 0; playerId < var_t4; playerId++) {
         gGPCurrentRaceRankByPlayerIdDup[sp80[playerId]] = playerId;
@@ -809,12 +783,8 @@ void set_places(void) {
 }
 
 void update_player_rankings(void) {
-    f32 temp_f0;
-    UNUSED s32 pad;
-    s32 sp50[8];
+    s32 sp50[NUM_PLAYERS];
     s32 temp_a0;
-    s32 temp_t2_2;
-    s32 var_a1_2;
     s32 var_a3;
     s32 var_a2;
 
@@ -824,7 +794,7 @@ void update_player_rankings(void) {
             return; // HEY! returns, not breaks
         case GRAND_PRIX:
         case TIME_TRIALS:
-            var_a2 = 8;
+            var_a2 = NUM_PLAYERS;
             break;
         case VERSUS:
             var_a2 = gPlayerCount;
@@ -836,19 +806,7 @@ void update_player_rankings(void) {
         sp50[var_a3] = temp_a0;
         gCourseCompletionPercentByRank[var_a3] = -gTimePlayerLastTouchedFinishLine[temp_a0];
     }
-
-    for (var_a3 = 0; var_a3 < (var_a2 - 1); var_a3++) {
-        for (var_a1_2 = var_a3 + 1; var_a1_2 < var_a2; var_a1_2++) {
-            if (gCourseCompletionPercentByRank[var_a3] < gCourseCompletionPercentByRank[var_a1_2]) {
-                temp_t2_2 = sp50[var_a3];
-                sp50[var_a3] = sp50[var_a1_2];
-                sp50[var_a1_2] = temp_t2_2;
-                temp_f0 = gCourseCompletionPercentByRank[var_a3];
-                gCourseCompletionPercentByRank[var_a3] = gCourseCompletionPercentByRank[var_a1_2];
-                gCourseCompletionPercentByRank[var_a1_2] = temp_f0;
-            }
-        }
-    }
+    rank_racers(sp50, gCourseCompletionPercentByRank, var_a2);
 
     for (var_a3 = 0; var_a3 < NUM_PLAYERS; var_a3++) {
         gPreviousGPCurrentRaceRankByPlayerId[var_a3] = gGPCurrentRaceRankByPlayerId[var_a3];
@@ -861,20 +819,16 @@ void update_player_rankings(void) {
 }
 
 void set_places_end_course_with_time(void) {
-    f32 temp_a0;
-    s32 temp;
-    s32 sp68[8];
-    UNUSED s32 pad;
+    s32 sp68[NUM_PLAYERS];
     s32 temp_t1;
     s32 i;
     s32 j;
-    s32 this_loops_upper_bound_is_brough_to_you_by_the_number = 8;
 
-    for (i = 0; i < this_loops_upper_bound_is_brough_to_you_by_the_number;) {
+    for (i = 0; i < NUM_PLAYERS;) {
         gCourseCompletionPercentByRank[i++] = 0.0f;
     }
 
-    for (j = 0, i = 0; i < this_loops_upper_bound_is_brough_to_you_by_the_number; i++) {
+    for (j = 0, i = 0; i < NUM_PLAYERS; i++) {
         if (gPlayers[i].type & 0x800) {
             sp68[j] = i;
             gCourseCompletionPercentByRank[j] = -gTimePlayerLastTouchedFinishLine[i];
@@ -883,7 +837,7 @@ void set_places_end_course_with_time(void) {
     }
 
     temp_t1 = j;
-    for (i = 0; i < this_loops_upper_bound_is_brough_to_you_by_the_number; i++) {
+    for (i = 0; i < NUM_PLAYERS; i++) {
         if (!(gPlayers[i].type & 0x800)) {
             sp68[j] = i;
             gCourseCompletionPercentByRank[j] = gCourseCompletionPercentByPlayerId[i];
@@ -891,37 +845,15 @@ void set_places_end_course_with_time(void) {
         }
     }
 
-    for (i = 0; i < (temp_t1 - 1); i++) {
-        for (j = i + 1; j < temp_t1; j++) {
-            if (gCourseCompletionPercentByRank[i] < gCourseCompletionPercentByRank[j]) {
-                temp = sp68[i];
-                sp68[i] = sp68[j];
-                sp68[j] = temp;
-                temp_a0 = gCourseCompletionPercentByRank[i];
-                gCourseCompletionPercentByRank[i] = gCourseCompletionPercentByRank[j];
-                gCourseCompletionPercentByRank[j] = temp_a0;
-            }
-        }
-    }
-
-    for (i = temp_t1; i < (this_loops_upper_bound_is_brough_to_you_by_the_number - 1); i++) {
-        for (j = i + 1; j < this_loops_upper_bound_is_brough_to_you_by_the_number; j++) {
-            if (gCourseCompletionPercentByRank[i] < gCourseCompletionPercentByRank[j]) {
-                temp = sp68[i];
-                sp68[i] = sp68[j];
-                sp68[j] = temp;
-                temp_a0 = gCourseCompletionPercentByRank[i];
-                gCourseCompletionPercentByRank[i] = gCourseCompletionPercentByRank[j];
-                gCourseCompletionPercentByRank[j] = temp_a0;
-            }
-        }
-    }
+    // Finishers by time, then everyone else by how far they got
+    rank_racers(sp68, gCourseCompletionPercentByRank, temp_t1);
+    rank_racers(&sp68[temp_t1], &gCourseCompletionPercentByRank[temp_t1], NUM_PLAYERS - temp_t1);
 
-    for (i = 0; i < 8; i++) {
+    for (i = 0; i < NUM_PLAYERS; i++) {
         gPreviousGPCurrentRaceRankByPlayerId[i] = gGPCurrentRaceRankByPlayerId[i];
     }
 
-    for (i = 0; i < this_loops_upper_bound_is_brough_to_you_by_the_number; i++) {
+    for (i = 0; i < NUM_PLAYERS; i++) {
         gGPCurrentRaceRankByPlayerId[sp68[i]] = i;
         gGPCurrentRacePlayerIdByRank[i] = sp68[i];
     }
@@ -1958,7 +1890,7 @@ void update_player(s32 playerId) {
                     cpu_TargetSpeed[playerId] = CM_GetProps()->D_0D0096B8[gCCSelection];
                 }
 
-                if (CVarGetInteger("gEnableCustomCC", 0) == 1) {
+                if (gFrameSettings.EnableCustomCC == 1) {
 #define calc_a(x, y, x2, y2) (y2 - y) / (x2 - x)
 #define calc_b(x, y, b) y - (b * x)
                     f32 a;
@@ -1967,7 +1899,7 @@ void update_player(s32 playerId) {
 #define calc(table)                                   \
     a = calc_a(50, table[CC_50], 150, table[CC_150]); \
     b = calc_b(50, table[CC_50], a);                  \
-    cpu_TargetSpeed[playerId] = a * CVarGetFloat("gCustomCC", 150.0f) + b;
+    cpu_TargetSpeed[playerId] = a * gFrameSettings.CustomCC + b;
                     // end of define
                     if ((gIsPlayerInCurve[playerId] == true) || (D_801630E8[playerId] == 1) ||
                         (D_801630E8[playerId] == -1) ||
@@ -1991,7 +1923,7 @@ void update_player(s32 playerId) {
                     cpu_TargetSpeed[playerId] = 3.3333333f;
                 }
                 // Override cpu speed for harder cpu enhancment
-                if (CVarGetInteger("gHarderCPU", 0) == 1) {
+                if (gFrameSettings.HarderCPU == 1) {
                     cpu_TargetSpeed[playerId] = player->topSpeed * 1.5f;
                 }
 
@@ -2259,6 +2191,15 @@ void calculate_track_offset_position(u16 waypointIndex, f32 arg1, f32 arg2, s16
 }
 
 void set_track_offset_position(u16 waypointIndex, f32 arg1, s16 pathIndex) {
+    get_track_offset_position(waypointIndex, arg1, pathIndex, gOffsetPosition);
+}
+
+/**
+ * Same as set_track_offset_position but writes to offset instead of gOffsetPosition,
+ * so vehicles can follow their path from worker threads.
+ * Only offset[0] and offset[2] are written.
+ */
+void get_track_offset_position(u16 waypointIndex, f32 arg1, s16 pathIndex, Vec3f offset) {
     TrackPathPoint* path1;
     TrackPathPoint* path2;
     f32 x1;
@@ -2295,8 +2236,8 @@ void set_track_offset_position(u16 waypointIndex, f32 arg1, s16 pathIndex) {
 
     temp_f0 = 0.5f - (arg1 / 2.0f);
     temp_f12 = 1.0f - temp_f0;
-    gOffsetPosition[0] = ((temp_f0 * (x1 + x3)) / 2.0f) + ((temp_f12 * (x2 + x4)) / 2.0f);
-    gOffsetPosition[2] = ((temp_f0 * (z1 + z3)) / 2.0f) + ((temp_f12 * (z2 + z4)) / 2.0f);
+    offset[0] = ((temp_f0 * (x1 + x3)) / 2.0f) + ((temp_f12 * (x2 + x4)) / 2.0f);
+    offset[2] = ((temp_f0 * (z1 + z3)) / 2.0f) + ((temp_f12 * (z2 + z4)) / 2.0f);
 }
 
 s16 func_8000BD94(f32 posX, f32 posY, f32 posZ, s32 pathIndex) {
@@ -2333,95 +2274,15 @@ s16 func_8000BD94(f32 posX, f32 posY, f32 posZ, s32 pathIndex) {
     return nearestWaypointIndex;
 }
 
+/**
+ * Finds the path point closest to (posX, posY, posZ) in section trackSectionId.
+ * Uses the path spatial index when the paths have one, which gives the same result as the linear search.
+ **/
 s16 find_closest_path_point_track_section(f32 posX, f32 posY, f32 posZ, u16 trackSectionId, s32* pathIndex) {
-    TrackPathPoint* pathWaypoints;
-    TrackPathPoint* considerWaypoint;
-    f32 x_dist;
-    f32 y_dist;
-    f32 z_dist;
-    f32 considerSquaredDistance;
-    f32 minimumSquaredDistance;
-    s32 considerWaypointIndex;
-    s32 pathWaypointCount;
-    s32 temp_t0;
-    s32 var_a1;
-    s32 var_t1;
-    s32 considerPathIndex;
-    s32 var_t4;
-    s16 nearestWaypointIndex;
+    s16 nearestWaypointIndex = find_closest_path_point_track_section_indexed(posX, posY, posZ, trackSectionId, pathIndex);
 
-    minimumSquaredDistance = 1000000.0f;
-    temp_t0 = *pathIndex;
-    nearestWaypointIndex = 0;
-    var_t1 = 0;
-    var_a1 = 0;
-    pathWaypoints = gTrackPaths[temp_t0];
-    pathWaypointCount = gPathCountByPathIndex[temp_t0];
-    considerWaypoint = &pathWaypoints[0];
-    for (considerWaypointIndex = 0; considerWaypointIndex < pathWaypointCount;
-         considerWaypointIndex++, considerWaypoint++) {
-        if ((considerWaypoint->trackSectionId == trackSectionId) || (IsPodiumCeremony())) {
-            var_t1 = 1;
-            x_dist = (f32) considerWaypoint->posX - posX;
-            y_dist = (f32) considerWaypoint->posY - posY;
-            z_dist = (f32) considerWaypoint->posZ - posZ;
-            considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
-            if (considerSquaredDistance < minimumSquaredDistance) {
-                nearestWaypointIndex = considerWaypointIndex;
-                var_a1 = 1;
-                minimumSquaredDistance = considerSquaredDistance;
-            }
-        }
-    }
-    if (var_t1 == 0) {
-        for (considerPathIndex = 0; considerPathIndex < 4; considerPathIndex++) {
-            if ((considerPathIndex != temp_t0) && (D_80163368[considerPathIndex] >= 2)) {
-                pathWaypoints = gTrackPaths[considerPathIndex];
-                considerWaypoint = &pathWaypoints[0];
-                pathWaypointCount = gPathCountByPathIndex[considerPathIndex];
-                for (considerWaypointIndex = 0; considerWaypointIndex < pathWaypointCount;
-                     considerWaypointIndex++, considerWaypoint++) {
-                    if (considerWaypoint->trackSectionId == trackSectionId) {
-                        x_dist = (f32) considerWaypoint->posX - posX;
-                        y_dist = (f32) considerWaypoint->posY - posY;
-                        z_dist = (f32) considerWaypoint->posZ - posZ;
-                        considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
-                        if (considerSquaredDistance < minimumSquaredDistance) {
-                            nearestWaypointIndex = considerWaypointIndex;
-                            var_t4 = considerPathIndex;
-                            var_a1 = 2;
-                            minimumSquaredDistance = considerSquaredDistance;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    if (var_a1 == 0) {
-        pathWaypoints = gTrackPaths[0];
-        pathWaypointCount = gPathCountByPathIndex[0];
-        considerWaypoint = &pathWaypoints[0];
-        x_dist = (f32) considerWaypoint->posX - posX;
-        y_dist = (f32) considerWaypoint->posY - posY;
-        z_dist = (f32) considerWaypoint->posZ - posZ;
-        minimumSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
-        nearestWaypointIndex = 0;
-        for (considerWaypointIndex = 1; considerWaypointIndex < pathWaypointCount;
-             considerWaypoint++, considerWaypointIndex++) {
-            x_dist = (f32) considerWaypoint->posX - posX;
-            y_dist = (f32) considerWaypoint->posY - posY;
-            z_dist = (f32) considerWaypoint->posZ - posZ;
-            considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
-            if (considerSquaredDistance < minimumSquaredDistance) {
-                nearestWaypointIndex = considerWaypointIndex;
-                var_t4 = 0;
-                var_a1 = 2;
-                minimumSquaredDistance = considerSquaredDistance;
-            }
-        }
-    }
-    if (var_a1 == 2) {
-        *pathIndex = var_t4;
+    if (nearestWaypointIndex < 0) {
+        nearestWaypointIndex = find_closest_path_point_track_section_linear(posX, posY, posZ, trackSectionId, pathIndex);
     }
     return nearestWaypointIndex;
 }
@@ -2795,6 +2656,7 @@ s16 func_8000D6D0(Vec3f position, s16* waypointIndex, f32 speed, f32 arg3, s16 p
     f32 ydiff;
     f32 zdiff;
     Vec3f oldPos;
+    Vec3f offset;
     TrackPathPoint* path;
 
     path = gTrackPaths[pathIndex];
@@ -2809,12 +2671,12 @@ s16 func_8000D6D0(Vec3f position, s16* waypointIndex, f32 speed, f32 arg3, s16 p
     temp_v1 = temp_v0 + arg5;
     waypoint1 = temp_v1 % gPathCountByPathIndex[pathIndex];
     waypoint2 = (temp_v1 + 1) % gPathCountByPathIndex[pathIndex];
-    set_track_offset_position(waypoint1, arg3, pathIndex);
-    pad3 = gOffsetPosition[0];
-    pad4 = gOffsetPosition[2];
-    set_track_offset_position(waypoint2, arg3, pathIndex);
-    temp1 = gOffsetPosition[0];
-    temp2 = gOffsetPosition[2];
+    get_track_offset_position(waypoint1, arg3, pathIndex, offset);
+    pad3 = offset[0];
+    pad4 = offset[2];
+    get_track_offset_position(waypoint2, arg3, pathIndex, offset);
+    temp1 = offset[0];
+    temp2 = offset[2];
     midY = (path[waypoint1].posY + path[waypoint2].posY) * 0.5f;
     midX = (pad3 + temp1) * 0.5f;
     midZ = (pad4 + temp2) * 0.5f;
@@ -2863,6 +2725,7 @@ s16 func_8000D940(Vec3f pos, s16* waypointIndex, f32 speed, f32 arg3, s16 pathIn
     f32 zdiff;
     s32 waypointCount;
     Vec3f sp54;
+    Vec3f offset;
 
     sp54[0] = pos[0];
     sp54[1] = pos[1];
@@ -2875,12 +2738,12 @@ s16 func_8000D940(Vec3f pos, s16* waypointIndex, f32 speed, f32 arg3, s16 pathIn
     *waypointIndex = temp_v0;
     waypoint1 = ((temp_v0 + waypointCount) - 3) % waypointCount;
     waypoint2 = ((temp_v0 + waypointCount) - 4) % waypointCount;
-    set_track_offset_position(waypoint1, arg3, pathIndex);
-    pad2 = gOffsetPosition[0];
-    pad3 = gOffsetPosition[2];
-    set_track_offset_position(waypoint2, arg3, pathIndex);
-    thing1 = gOffsetPosition[0];
-    thing2 = gOffsetPosition[2];
+    get_track_offset_position(waypoint1, arg3, pathIndex, offset);
+    pad2 = offset[0];
+    pad3 = offset[2];
+    get_track_offset_position(waypoint2, arg3, pathIndex, offset);
+    thing1 = offset[0];
+    thing2 = offset[2];
     midY = (gTrackPaths[pathIndex][waypoint1].posY + gTrackPaths[pathIndex][waypoint2].posY) * 0.5f;
     midX = (pad2 + thing1) * 0.5f;
     midZ = (pad3 + thing2) * 0.5f;
@@ -3467,16 +3330,16 @@ void init_course_path_point(void) {
     D_80163368[3] = (s32) ptr->unk6;
 
     temp = ptr->unk8;
-    gVehicle2DPathPoint = get_next_available_memory_addr(temp * 4);
+    gVehicle2DPathPoint = get_next_available_memory_addr(temp * 4, MEMORY_TAG_PATHS);
 
     // Podium ceremony appears to allocate 1 * 8 bytes of data. Which would be aligned to 0x10.
     for (i = 0; i < 4; i++) {
-        gTrackPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8);
-        gTrackLeftPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8);
-        gTrackRightPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8);
-        gTrackSectionTypes[i] = get_next_available_memory_addr(D_80163368[i] * 2);
-        gPathExpectedRotation[i] = get_next_available_memory_addr(D_80163368[i] * 2);
-        gTrackConsecutiveCurveCounts[i] = get_next_available_memory_addr(D_80163368[i] * 2);
+        gTrackPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8, MEMORY_TAG_PATHS);
+        gTrackLeftPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8, MEMORY_TAG_PATHS);
+        gTrackRightPaths[i] = get_next_available_memory_addr(D_80163368[i] * 8, MEMORY_TAG_PATHS);
+        gTrackSectionTypes[i] = get_next_available_memory_addr(D_80163368[i] * 2, MEMORY_TAG_PATHS);
+        gPathExpectedRotation[i] = get_next_available_memory_addr(D_80163368[i] * 2, MEMORY_TAG_PATHS);
+        gTrackConsecutiveCurveCounts[i] = get_next_available_memory_addr(D_80163368[i] * 2, MEMORY_TAG_PATHS);
     }
 
     gCurrentTrackPath = gTrackPaths[0];
@@ -3506,6 +3369,7 @@ void init_course_path_point(void) {
             analyze_curved_path(i);
         }
     }
+    generate_path_spatial_index();
 
     gSelectedPathCount = *gPathCountByPathIndex;
 
@@ -7025,7 +6889,7 @@ void cpu_decisions_branch_item(UNUSED s32 playerId, s16* branch, s32 itemId) {
             break;
     }
 
-    if (CVarGetInteger("gHarderCPU", 0) == 1) {
+    if (gFrameSettings.HarderCPU == 1) {
         switch (itemId) {
             case ITEM_NONE:
                 value = -1;
@@ -7107,7 +6971,7 @@ void cpu_use_item_strategy(s32 playerId) {
 
             // Harder CPU Items
             if (((gNumPathPointsTraversed[playerId] + (playerId * 20) + 100) % 8 == 0) && (cpuStrategy->timer >= 512) &&
-                (CVarGetInteger("gHarderCPU", 0) == true)) {
+                (gFrameSettings.HarderCPU == true)) {
 
                 cpu_decisions_branch_item(playerId, &cpuStrategy->branch,
                                           hard_cpu_gen_random_item((s16) gLapCountByPlayerId[playerId],
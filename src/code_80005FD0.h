@@ -133,6 +133,7 @@ f32 calculate_track_position_factor(f32, f32, u16, s32);
 void update_player_position_factor(s32, u16, s32);
 void calculate_track_offset_position(u16, f32, f32, s16);
 void set_track_offset_position(u16, f32, s16);
+void get_track_offset_position(u16, f32, s16, Vec3f);
 s16 func_8000BD94(f32, f32, f32, s32);
 
 s16 find_closest_path_point_track_section(f32, f32, f32, u16, s32*);
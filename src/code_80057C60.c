@@ -38,6 +38,7 @@
 #include "data/some_data.h"
 #include <assets/some_data.h>
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include "engine/Matrix.h"
 #include "port/interpolation/FrameInterpolation.h"
 
@@ -952,7 +953,7 @@ void func_80058F78(void) {
                 draw_simplified_lap_count(PLAYER_ONE);
                 func_8004EB38(0);
                 if (D_801657E6 != false) {
-                    if (CVarGetInteger("gEnableDigitalSpeedometer", false) == true) {
+                    if (gFrameSettings.EnableDigitalSpeedometer == true) {
                         render_digital_speedometer(PLAYER_ONE);
                     }
                     render_speedometer(PLAYER_ONE);
@@ -1663,7 +1664,7 @@ void func_8005A99C(void) {
             if (gPlayerCountSelection1 == 3) {
                 D_801657E8 = true;
             }
-            if (CVarGetInteger("gEditorEnabled", 0) == false) {
+            if (gFrameSettings.EditorEnabled == false) {
                 gIsHUDVisible = (s32) 1;
             }
             D_8018D170 = (s32) 1;
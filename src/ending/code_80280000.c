@@ -28,6 +28,7 @@
 #include "engine/courses/Course.h"
 #include "engine/Matrix.h"
 #include "port/Game.h"
+#include "port/Frustum.h"
 
 s32 D_802874A0;
 // s32 D_802874A4[5];
@@ -65,6 +66,8 @@ void func_80280038(void) {
              camera->lookAt[1], camera->lookAt[2], camera->up[0], camera->up[1], camera->up[2]);
     gSPMatrix(gDisplayListHead++, GetLookAtMatrix(0),
               G_MTX_NOPUSH | G_MTX_MUL | G_MTX_PROJECTION);
+    Frustum_SetCamera(0, camera->pos, camera->lookAt, camera->up, gCameraZoom[0], gScreenAspect,
+                      CM_GetProps()->NearPersp, CM_GetProps()->FarPersp);
     gCurrentCourseId = gCreditsCourseId;
     SetCourseById(gCreditsCourseId);
     mtxf_identity(matrix);
@@ -147,9 +150,9 @@ void load_credits(void) {
     D_800DC5EC->screenStartY = 120;
     gScreenModeSelection = SCREEN_MODE_1P;
     gActiveScreenMode = SCREEN_MODE_1P;
-    gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
+    memory_pool_begin_course();
     load_course(gCurrentCourseId);
-    gFreeMemoryCourseAnchor = gNextFreeMemoryAddress;
+    memory_pool_end_course();
 #ifdef TARGET_N64
     set_segment_base_addr(0xB, (void*) decompress_segments((u8*) CEREMONY_DATA_ROM_START, (u8*) CEREMONY_DATA_ROM_END));
 #endif
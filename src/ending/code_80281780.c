@@ -112,11 +112,11 @@ void setup_podium_ceremony(void) {
     D_800DC5EC->screenStartX = 160;
     D_800DC5EC->screenStartY = 120;
     gScreenModeSelection = SCREEN_MODE_1P;
-    gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
+    memory_pool_begin_course();
     gActiveScreenMode = SCREEN_MODE_1P;
     gModeSelection = GRAND_PRIX;
     load_course(gCurrentCourseId);
-    gFreeMemoryCourseAnchor = (s32) gNextFreeMemoryAddress;
+    memory_pool_end_course();
 #ifdef TARGET_N64
     set_segment_base_addr(0xB, (void*) decompress_segments((u8*) CEREMONY_DATA_ROM_START, (u8*) CEREMONY_DATA_ROM_END));
     set_segment_base_addr(6, (void*) decompress_segments((u8*) &_course_banshee_boardwalk_dl_mio0SegmentRomStart,
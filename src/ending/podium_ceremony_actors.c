@@ -310,7 +310,7 @@ void unused_80280FA8(UNUSED CeremonyActor* actor) {
 
 void balloons_and_fireworks_init(void) {
     D_802874D8.actorTimer = 0;
-    sPodiumActorList = (CeremonyActor*) get_next_available_memory_addr(sizeof(CeremonyActor) * 200);
+    sPodiumActorList = (CeremonyActor*) get_next_available_memory_addr(sizeof(CeremonyActor) * 200, MEMORY_TAG_ACTORS);
     bzero(sPodiumActorList, (sizeof(CeremonyActor) * 200));
     new_actor(&initDummy);
 }
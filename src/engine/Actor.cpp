@@ -2,6 +2,7 @@
 #include "Matrix.h"
 
 #include "Actor.h"
+#include "World.h"
 
 extern "C" {
 #include "math_util.h"
@@ -26,11 +27,17 @@ void AActor::Draw(Camera *camera) {
 }
 void AActor::Collision(Player* player, AActor* actor) {}
 void AActor::VehicleCollision(s32 playerId, Player* player){}
+bool AActor::GetVehicleCollisionArea(f32 area[4]) { return false; }
+bool AActor::HasVehicleCollisionState() { return false; }
+bool AActor::GetDrawBounds(FVector& center, f32& radius) { return false; }
 void AActor::Destroy() {
     // Set uuid to zero.
     memset(uuid, 0, sizeof(uuid));
+    gWorldInstance.DestroyActor(this);
 }
 bool AActor::IsMod() { return false; }
+bool AActor::IsParallelTickSafe() { return false; }
+void AActor::TickCommit() {}
 void AActor::SetLocation(FVector pos) {
     Pos[0] = pos.x;
     Pos[1] = pos.y;
@@ -2,6 +2,7 @@
 
 #include <libultraship.h>
 #include "CoreMath.h"
+#include "EntityHandle.h"
 
 extern "C" {
 #include "macros.h"
@@ -10,6 +11,16 @@ extern "C" {
 #include "common_structs.h"
 
 
+// Actor classes that engine code looks up by type. World keeps a list for each of
+// them so those lookups don't have to dynamic_cast every actor.
+enum class ActorClass : uint8_t {
+    Other,
+    Train,
+    Boat,
+    Finishline,
+    Count,
+};
+
 class AActor {
 public:
 
@@ -29,6 +40,9 @@ public:
     FVector Scale = {1, 1, 1};
 
     Gfx* Model = NULL;
+    EntityHandle Handle; // Assigned by World when the actor is added
+    bool bPendingDestroy = false;
+    ActorClass Class = ActorClass::Other; // Set by the constructors of the classes in ActorClass
 
     virtual ~AActor() = default;  // Virtual destructor for proper cleanup in derived classes
 
@@ -38,11 +52,24 @@ public:
     virtual void Draw(Camera*);
     virtual void Collision(Player* player, AActor* actor);
     virtual void VehicleCollision(s32 playerId, Player* player);
+    // Vehicles return true and the XZ box (min x, min z, max x, max z) outside of which VehicleCollision
+    // does nothing to a player. Only actors that return true get VehicleCollision calls.
+    virtual bool GetVehicleCollisionArea(f32 area[4]);
+    // True while VehicleCollision has something to undo for a player that left the area, like a sound
+    virtual bool HasVehicleCollisionState();
+    // Actors that return true and a sphere holding everything Draw() renders are frustum culled before drawing
+    virtual bool GetDrawBounds(FVector& center, f32& radius);
     void SetLocation(FVector pos);
     FVector GetLocation() const;
 
     virtual void Destroy();
     virtual bool IsMod();
+    // True if Tick() only writes this actor and its C actor slot, and only reads state that no other actor's
+    // tick or commit writes. Such actors may be ticked on worker threads.
+    virtual bool IsParallelTickSafe();
+    // Runs on the game thread after Tick(), in actor list order. Sounds, spawns, random numbers and other side
+    // effects go here.
+    virtual void TickCommit();
 };
 
 }
\ No newline at end of file
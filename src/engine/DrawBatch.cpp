@@ -0,0 +1,274 @@
+#include "DrawBatch.h"
+#include <libultraship.h>
+#include <libultra/gbi.h>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Matrix.h"
+#include "World.h"
+#include "StaticMeshActor.h"
+#include "port/FrameSettings.h"
+#include "port/GfxPool.h"
+
+extern "C" {
+#include <align_asset_macro.h>
+#include <assets/common_data.h>
+#include <assets/mario_raceway_data.h>
+#include <assets/kalimari_desert_data.h>
+#include "macros.h"
+#include "main.h"
+}
+
+namespace {
+
+struct BatchKey {
+    Gfx* Model;
+    const char* Tlut;
+    u32 SetGeometry;
+    u32 ClearGeometry;
+
+    bool operator==(const BatchKey& other) const {
+        return (Model == other.Model) && (Tlut == other.Tlut) && (SetGeometry == other.SetGeometry) &&
+               (ClearGeometry == other.ClearGeometry);
+    }
+};
+
+struct Batch {
+    BatchKey Key;
+    bool bSharesSetup;
+    std::vector<Mtx*> Transforms;
+};
+
+std::vector<Batch> sBatches;
+size_t sBatchCount = 0; // Batches in use. The rest keep their vectors for the next frame.
+bool sOpen = false;
+
+// Whether each model leaves the geometry mode and TLUT as it found them
+std::unordered_map<Gfx*, bool> sSharesSetup;
+// One copy of each static mesh name, so every actor using a model passes the same pointer
+std::unordered_set<std::string> sModelNames;
+
+// Looks for commands that would undo the setup shared by a batch
+bool ChangesSetup(const Gfx* gfx, s32 depth) {
+    if ((gfx == nullptr) || (depth > 16)) {
+        return false;
+    }
+
+    for (s32 i = 0; i < 0x1FFF; i++, gfx++) {
+        uintptr_t lo = gfx->words.w0;
+        uintptr_t hi = gfx->words.w1;
+        // Signed to match the immediate opcodes, as in Course.cpp's ScanSection
+        int8_t opcode = GFX_GET_OPCODE(lo) >> 24;
+
+        switch (opcode) {
+            case G_DL:
+                if (ChangesSetup((const Gfx*) hi, depth + 1)) {
+                    return true;
+                }
+                break;
+            case G_DL_OTR_FILEPATH:
+                if (ChangesSetup((const Gfx*) ResourceGetDataByName((const char*) hi), depth + 1)) {
+                    return true;
+                }
+                break;
+            case G_DL_OTR_HASH:
+                gfx++;
+                if (ChangesSetup((const Gfx*) ResourceGetDataByCrc(((uint64_t) gfx->words.w0 << 32) + gfx->words.w1),
+                                 depth + 1)) {
+                    return true;
+                }
+                break;
+            case G_VTX_OTR_FILEPATH:
+            case G_VTX_OTR_HASH:
+            case G_MTX_OTR:
+                gfx++;
+                break;
+            case G_SETGEOMETRYMODE:
+            case G_CLEARGEOMETRYMODE:
+            case (int8_t) G_LOADTLUT:
+                return true;
+            case G_ENDDL:
+                return false;
+        }
+        // A branch never comes back
+        if (((opcode == G_DL) || (opcode == G_DL_OTR_FILEPATH) || (opcode == G_DL_OTR_HASH)) &&
+            (((lo >> 16) & 1) == G_DL_NOPUSH)) {
+            return false;
+        }
+    }
+    // Too long to be sure of
+    return true;
+}
+
+bool SharesSetup(Gfx* model) {
+    auto it = sSharesSetup.find(model);
+    if (it == sSharesSetup.end()) {
+        const char* name = (const char*) model;
+        const Gfx* gfx = GameEngine_OTRSigCheck(name) ? (const Gfx*) ResourceGetDataByName(name) : model;
+        // A model that can't be loaded gets its setup every time
+        it = sSharesSetup.emplace(model, (gfx != nullptr) && !ChangesSetup(gfx, 0)).first;
+    }
+    return it->second;
+}
+
+Gfx* InternModel(const std::string& model) {
+    const std::string& name = *sModelNames.insert(model).first;
+    Gfx* gfx = (Gfx*) name.c_str();
+    if (sSharesSetup.find(gfx) == sSharesSetup.end()) {
+        // Static mesh names may lack the OTR signature SharesSetup looks for
+        const Gfx* data = (const Gfx*) ResourceGetDataByName(name.c_str());
+        sSharesSetup.emplace(gfx, (data != nullptr) && !ChangesSetup(data, 0));
+    }
+    return gfx;
+}
+
+void EmitSetup(const BatchKey& key) {
+    if (key.SetGeometry != 0) {
+        gSPSetGeometryMode(gDisplayListHead++, key.SetGeometry);
+    }
+    if (key.ClearGeometry != 0) {
+        gSPClearGeometryMode(gDisplayListHead++, key.ClearGeometry);
+    }
+    if (key.Tlut != nullptr) {
+        gDPLoadTLUT_pal256(gDisplayListHead++, key.Tlut);
+    }
+}
+
+void EmitInstance(Gfx* model, Mtx* mtx) {
+    gSPMatrix(gDisplayListHead++, mtx, G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
+    gSPDisplayList(gDisplayListHead++, model);
+}
+
+void Queue(const BatchKey& key, Mat4 mtx) {
+    // Tracks use a handful of prop models, so a linear search beats hashing
+    Batch* batch = nullptr;
+    for (size_t i = 0; i < sBatchCount; i++) {
+        if (sBatches[i].Key == key) {
+            batch = &sBatches[i];
+            break;
+        }
+    }
+    if (batch == nullptr) {
+        if (sBatchCount == sBatches.size()) {
+            sBatches.emplace_back();
+        }
+        batch = &sBatches[sBatchCount++];
+        batch->Key = key;
+        batch->bSharesSetup = SharesSetup(key.Model);
+        batch->Transforms.clear();
+    }
+    batch->Transforms.push_back(ConvertObjectMatrix(mtx));
+}
+
+} // namespace
+
+extern "C" void DrawBatch_Begin(void) {
+    sBatchCount = 0;
+    sOpen = gFrameSettings.BatchDraws;
+}
+
+extern "C" void DrawBatch_Add(Gfx* model, const char* tlut, u32 setGeometry, u32 clearGeometry, Mat4 mtx) {
+    BatchKey key = { model, tlut, setGeometry, clearGeometry };
+
+    if (!sOpen) {
+        EmitSetup(key);
+        AddObjectMatrix(mtx, G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
+        gSPDisplayList(gDisplayListHead++, model);
+        return;
+    }
+    Queue(key, mtx);
+}
+
+extern "C" void DrawBatch_Flush(void) {
+    for (size_t i = 0; i < sBatchCount; i++) {
+        Batch& batch = sBatches[i];
+
+        for (size_t j = 0; j < batch.Transforms.size(); j++) {
+            GfxPool_Ensure();
+            if ((j == 0) || !batch.bSharesSetup) {
+                EmitSetup(batch.Key);
+            }
+            EmitInstance(batch.Key.Model, batch.Transforms[j]);
+        }
+    }
+    sBatchCount = 0;
+    sOpen = false;
+}
+
+namespace DrawBatch {
+
+void Add(const std::string& model, u32 setGeometry, u32 clearGeometry, Mat4 mtx) {
+    DrawBatch_Add(InternModel(model), nullptr, setGeometry, clearGeometry, mtx);
+}
+
+} // namespace DrawBatch
+
+extern "C" void DrawBatch_RunBenchmark(void) {
+    using Clock = std::chrono::steady_clock;
+    struct Prop {
+        Gfx* Model;
+        const char* Tlut;
+        u32 SetGeometry;
+        u32 ClearGeometry;
+    };
+    const Prop kStockProps[] = {
+        { (Gfx*) d_course_mario_raceway_dl_tree, common_tlut_trees_import, 0, 0 },
+        { (Gfx*) d_course_kalimari_desert_dl_cactus1, nullptr, 0, 0 },
+        { (Gfx*) d_course_kalimari_desert_dl_cactus2, nullptr, 0, 0 },
+        { (Gfx*) d_course_mario_raceway_dl_sign, nullptr, G_SHADING_SMOOTH, G_LIGHTING },
+    };
+    const size_t kInstances = 512;
+
+    // The loaded track's static meshes, then stock props laid out on a grid up to the instance count
+    std::vector<Prop> props;
+    std::vector<FVector> positions;
+    for (StaticMeshActor* actor : gWorldInstance.StaticMeshActors) {
+        if (!actor->Model.empty()) {
+            props.push_back({ InternModel(actor->Model), nullptr, G_SHADING_SMOOTH, G_LIGHTING });
+            positions.push_back(actor->Pos);
+        }
+    }
+    size_t staticMeshes = props.size();
+    for (size_t i = 0; props.size() < kInstances; i++) {
+        props.push_back(kStockProps[i % ARRAY_COUNT(kStockProps)]);
+        positions.push_back(FVector((f32) (i % 32) * 100.0f, 0.0f, (f32) (i / 32) * 100.0f));
+    }
+
+    Gfx* savedHead = gDisplayListHead;
+    Gfx* savedEnd = gGfxPoolBlockEnd;
+    // Room for four viewports drawn one by one, so GfxPool_Ensure never chains to a real block
+    std::vector<Gfx> scratch((props.size() * 16 * 4) + (GFX_POOL_RESERVE * 2));
+    auto savedBatchDraws = gFrameSettings.BatchDraws;
+
+    printf("[DrawBatch] %zu props, %zu of them the track's static meshes\n", props.size(), staticMeshes);
+    for (s32 batched = 0; batched < 2; batched++) {
+        // Four viewports draw every prop once each
+        gFrameSettings.BatchDraws = batched;
+        gDisplayListHead = scratch.data();
+        gGfxPoolBlockEnd = scratch.data() + scratch.size() - 1;
+
+        auto start = Clock::now();
+        for (s32 viewport = 0; viewport < 4; viewport++) {
+            DrawBatch_Begin();
+            for (size_t i = 0; i < props.size(); i++) {
+                Mat4 mtx;
+                ApplyMatrixTransformations(mtx, positions[i], IRotator(0, 0, 0), FVector(1, 1, 1));
+                DrawBatch_Add(props[i].Model, props[i].Tlut, props[i].SetGeometry, props[i].ClearGeometry, mtx);
+                GfxPool_Ensure();
+            }
+            DrawBatch_Flush();
+        }
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+        size_t commands = gDisplayListHead - scratch.data();
+        printf("[DrawBatch] %s: %zu commands per viewport, %.1f per prop, built in %lld us for 4 viewports\n",
+               batched ? "Batched" : "One by one", commands / 4, (f32) commands / (f32) (props.size() * 4), us);
+    }
+
+    gFrameSettings.BatchDraws = savedBatchDraws;
+    gDisplayListHead = savedHead;
+    gGfxPoolBlockEnd = savedEnd;
+}
@@ -0,0 +1,47 @@
+#ifndef _DRAW_BATCH_HEADER_
+#define _DRAW_BATCH_HEADER_
+
+#include <libultraship.h>
+#include "common_structs.h"
+
+/**
+ * Groups draws of the same model.
+ *
+ * Props such as trees, cacti, signs and static meshes each used to load their matrix and then emit the same
+ * state setup and display list call as every other copy of the model. Between DrawBatch_Begin and
+ * DrawBatch_Flush, DrawBatch_Add converts the instance's matrix right away, which keeps frame interpolation
+ * working, but only queues the draw. The flush emits each model's setup once, followed by a matrix load and a
+ * display list call per instance.
+ *
+ * A model whose display list changes the geometry mode or loads a TLUT would undo the shared setup for the
+ * instances after it, so its setup is still emitted for every instance. Outside a batch, or with gBatchDraws
+ * off, DrawBatch_Add draws at once the same way the props used to.
+ */
+
+#ifdef __cplusplus
+#include <string>
+
+namespace DrawBatch {
+// Draws a model by resource name. Static meshes with the same model are batched together.
+void Add(const std::string& model, u32 setGeometry, u32 clearGeometry, Mat4 mtx);
+} // namespace DrawBatch
+
+extern "C" {
+#endif
+
+void DrawBatch_Begin(void);
+// Draws model with mtx as its modelview matrix. The tlut is loaded before it unless NULL, and the geometry
+// mode bits are set and cleared.
+void DrawBatch_Add(Gfx* model, const char* tlut, u32 setGeometry, u32 clearGeometry, Mat4 mtx);
+// Emits the queued draws, grouped by model in the order each model was first added
+void DrawBatch_Flush(void);
+
+// Builds the display list for a few hundred props with and without batching and prints the commands and
+// time each took
+void DrawBatch_RunBenchmark(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRAW_BATCH_HEADER_
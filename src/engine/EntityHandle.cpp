@@ -0,0 +1,55 @@
+#include "EntityHandle.h"
+
+#include <algorithm>
+
+EntityHandle EntityHandleAllocator::Allocate() {
+    if (_freeSlots.empty()) {
+        return AllocateAppend();
+    }
+
+    uint32_t index = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    Slot& slot = _slots[index];
+    slot.bLive = true;
+    return { index, slot.Generation };
+}
+
+EntityHandle EntityHandleAllocator::AllocateAppend() {
+    uint32_t index = (uint32_t) _slots.size();
+    _slots.push_back({ _baseGeneration, true });
+    return { index, _baseGeneration };
+}
+
+void EntityHandleAllocator::Release(EntityHandle handle) {
+    if (!IsValid(handle)) {
+        return;
+    }
+
+    Slot& slot = _slots[handle.Index];
+    slot.bLive = false;
+    slot.Generation++;
+    _freeSlots.push_back(handle.Index);
+}
+
+bool EntityHandleAllocator::IsValid(EntityHandle handle) const {
+    if (handle.Index >= _slots.size()) {
+        return false;
+    }
+    const Slot& slot = _slots[handle.Index];
+    return slot.bLive && (slot.Generation == handle.Generation);
+}
+
+bool EntityHandleAllocator::HasFreeSlot() const {
+    return !_freeSlots.empty();
+}
+
+void EntityHandleAllocator::Clear() {
+    uint32_t highest = _baseGeneration;
+    for (const Slot& slot : _slots) {
+        highest = std::max(highest, slot.Generation);
+    }
+    _baseGeneration = highest + 1;
+    _slots.clear();
+    _freeSlots.clear();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Generational reference to an actor or object slot in the World.
+ * The slot index may be recycled once its entity is destroyed, but the generation
+ * is bumped every time, so a handle held past destruction no longer resolves.
+ */
+struct EntityHandle {
+    uint32_t Index = UINT32_MAX;
+    uint32_t Generation = 0;
+
+    bool IsNull() const {
+        return Index == UINT32_MAX;
+    }
+
+    bool operator==(const EntityHandle& other) const {
+        return (Index == other.Index) && (Generation == other.Generation);
+    }
+
+    bool operator!=(const EntityHandle& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * Hands out slot indices and tracks the generation of each slot.
+ * The owner keeps its own index-addressed storage; this only decides which
+ * index to use and whether a handle is still current.
+ */
+class EntityHandleAllocator {
+public:
+    EntityHandle Allocate();       // Reuses a released slot if one is available
+    EntityHandle AllocateAppend(); // Always uses a new slot at the end
+    void Release(EntityHandle handle);
+    bool IsValid(EntityHandle handle) const;
+    bool HasFreeSlot() const;
+    void Clear();
+
+    size_t GetSlotCount() const {
+        return _slots.size();
+    }
+
+    size_t GetLiveCount() const {
+        return _slots.size() - _freeSlots.size();
+    }
+
+private:
+    struct Slot {
+        uint32_t Generation;
+        bool bLive;
+    };
+
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    // Generation given to new slots. Raised on Clear() so handles from before the clear stay stale.
+    uint32_t _baseGeneration = 1;
+};
@@ -1,45 +1,132 @@
 #include "GarbageCollector.h"
 #include "World.h"
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
 void RunGarbageCollector() {
-    //CleanActors();
+    CleanActors();
     CleanObjects();
     CleanStaticMeshActors();
 }
 
 void CleanActors() {
-    // for (auto actor = gWorldInstance.Actors.begin(); actor != gWorldInstance.Actors.end();) {
-    //     OObject* act = *actor; // Get a mutable copy
-    //     if (act->PendingDestroy) {
-    //         delete act;
-    //         actor = gWorldInstance.Objects.erase(actor); // Remove from container
-    //         continue;
-    //     }
-    //     actor++;
-    // }
+    gWorldInstance.FlushDestroyedActors();
 }
 
 void CleanStaticMeshActors() {
-    for (auto actor = gWorldInstance.StaticMeshActors.begin(); actor != gWorldInstance.StaticMeshActors.end();) {
-        StaticMeshActor* act = *actor; // Get a mutable copy
-        if (act->bPendingDestroy) {
-            delete act;
-            actor = gWorldInstance.StaticMeshActors.erase(actor); // Remove from container
-            continue;
-        } else {
-            actor++;
+    // The editor despawns static meshes by writing bPendingDestroy directly, so these are found by scanning
+    auto& actors = gWorldInstance.StaticMeshActors;
+    auto end = std::remove_if(actors.begin(), actors.end(), [](StaticMeshActor* actor) {
+        if (actor->bPendingDestroy) {
+            delete actor;
+            return true;
         }
-    }
+        return false;
+    });
+    actors.erase(end, actors.end());
 }
 
 void CleanObjects() {
-    for (auto object = gWorldInstance.Objects.begin(); object != gWorldInstance.Objects.end();) {
-        OObject* obj = *object; // Get a mutable copy
-        if (obj->bPendingDestroy) {
-            delete obj;
-            object = gWorldInstance.Objects.erase(object); // Remove from container
-            continue;
-        }
-        object++;
+    gWorldInstance.FlushDestroyedObjects();
+}
+
+/**
+ * Spawns and destroys actors and objects in a scratch World over several frames.
+ * Checks that every destroyed handle goes stale, that survivors still resolve,
+ * and that released actor slots are recycled instead of growing the list.
+ *
+ * @return Number of errors found
+ */
+size_t RunEntityStressTest(size_t count) {
+    const size_t frames = 16;
+    const size_t spawnsPerFrame = std::max<size_t>(count / frames, 1);
+    auto world = std::make_unique<World>();
+    std::vector<EntityHandle> liveActors, liveObjects, deadActors, deadObjects;
+    size_t peakActors = 0;
+    size_t errors = 0;
+    uint32_t seed = 0x2545F491;
+
+    auto nextRandom = [&seed]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+
+    // Destroys roughly half of the live handles
+    auto destroySome = [&](std::vector<EntityHandle>& live, std::vector<EntityHandle>& dead, bool actors, bool all) {
+        for (size_t i = 0; i < live.size();) {
+            if (!all && (nextRandom() & 1)) {
+                i++;
+                continue;
+            }
+            if (actors) {
+                AActor* actor = world->GetActorByHandle(live[i]);
+                actor->Flags = 0; // Same as destroy_actor()
+                world->DestroyActor(actor);
+            } else {
+                world->DestroyObject(world->GetObjectByHandle(live[i]));
+            }
+            dead.push_back(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t frame = 0; frame <= frames; frame++) {
+        bool last = (frame == frames);
+
+        if (!last) {
+            for (size_t i = 0; i < spawnsPerFrame; i++) {
+                Actor* actor = world->AddBaseActor();
+                actor->flags = 1;
+                liveActors.push_back(world->ConvertActorToAActor(actor)->Handle);
+                liveObjects.push_back(world->AddObject(new OObject())->Handle);
+            }
+        }
+        peakActors = std::max(peakActors, liveActors.size());
+
+        destroySome(liveActors, deadActors, true, last);
+        destroySome(liveObjects, deadObjects, false, last);
+
+        // Destroyed entities must stay resolvable until the end of the frame
+        for (EntityHandle handle : deadActors) {
+            if (world->ActorHandles.IsValid(handle) && !world->Actors[handle.Index]->bPendingDestroy) {
+                errors++;
+            }
+        }
+
+        world->FlushDestroyedActors();
+        world->FlushDestroyedObjects();
+
+        for (EntityHandle handle : deadActors) {
+            errors += world->ActorHandles.IsValid(handle);
+        }
+        for (EntityHandle handle : deadObjects) {
+            errors += world->ObjectHandles.IsValid(handle);
+        }
+        for (EntityHandle handle : liveActors) {
+            AActor* actor = world->ActorHandles.IsValid(handle) ? world->Actors[handle.Index] : nullptr;
+            errors += (actor == nullptr) || (actor->Handle != handle);
+        }
+        for (EntityHandle handle : liveObjects) {
+            OObject* object = world->ObjectHandles.IsValid(handle) ? world->GetObjectByHandle(handle) : nullptr;
+            errors += (object == nullptr) || (object->Handle != handle);
+        }
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Everything was destroyed on the last frame
+    errors += world->ActorHandles.GetLiveCount() + world->ObjectHandles.GetLiveCount() + world->Objects.size();
+    // Actor slots should have been recycled, so the list only grows to about the peak live count
+    if (world->Actors.size() > peakActors + spawnsPerFrame) {
+        errors++;
     }
+
+    printf("RunEntityStressTest() %zu actors and %zu objects, %zu actor slots, %zu errors, %lld us\n",
+           deadActors.size(), deadObjects.size(), world->Actors.size(), errors, (long long) elapsed.count());
+    return errors;
 }
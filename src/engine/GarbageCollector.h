@@ -10,3 +10,4 @@ void RunGarbageCollector();
 void CleanActors();
 void CleanStaticMeshActors();
 void CleanObjects();
+size_t RunEntityStressTest(size_t count);
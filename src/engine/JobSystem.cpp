@@ -0,0 +1,119 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+JobSystem::JobSystem(size_t workerCount) {
+    for (size_t i = 0; i <= workerCount; i++) {
+        _queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        _threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _bQuit = true;
+    }
+    _wake.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+bool JobSystem::PopJob(size_t queueIndex, Job& job) {
+    WorkQueue& queue = *_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+
+    if (queue.Jobs.empty()) {
+        return false;
+    }
+    job = std::move(queue.Jobs.back());
+    queue.Jobs.pop_back();
+    _queuedJobs--;
+    return true;
+}
+
+bool JobSystem::StealJob(size_t thiefIndex, Job& job) {
+    for (size_t i = 1; i < _queues.size(); i++) {
+        WorkQueue& queue = *_queues[(thiefIndex + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+
+        if (!queue.Jobs.empty()) {
+            job = std::move(queue.Jobs.front());
+            queue.Jobs.pop_front();
+            _queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex) {
+    Job job;
+
+    while (true) {
+        if (PopJob(queueIndex, job) || StealJob(queueIndex, job)) {
+            job();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wake.wait(lock, [this] { return _bQuit || (_queuedJobs.load() > 0); });
+        if (_bQuit) {
+            return;
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+
+    batchSize = std::max<size_t>(batchSize, 1);
+    size_t numBatches = (count + batchSize - 1) / batchSize;
+
+    if (_threads.empty() || (numBatches == 1)) {
+        func(0, count);
+        return;
+    }
+
+    std::atomic<size_t> remaining = numBatches;
+
+    // Deal the batches out round robin so every worker starts with local work
+    for (size_t batch = 0; batch < numBatches; batch++) {
+        size_t begin = batch * batchSize;
+        size_t end = std::min(begin + batchSize, count);
+        WorkQueue& queue = *_queues[batch % _queues.size()];
+
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Jobs.push_back([&func, &remaining, begin, end]() {
+            func(begin, end);
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+        _queuedJobs++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+    }
+    _wake.notify_all();
+
+    Job job;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (PopJob(0, job) || StealJob(0, job)) {
+            job();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystem& GetJobSystem() {
+    // The game thread takes part in every ParallelFor, so leave one core for it
+    static JobSystem sJobSystem(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return sJobSystem;
+}
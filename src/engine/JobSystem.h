@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small work-stealing thread pool used to tick parallel-safe actors and objects.
+ * Each worker owns a deque. It takes jobs from the back of its own deque and steals
+ * from the front of the others once it runs dry. The thread calling ParallelFor
+ * helps out until every batch it queued has finished.
+ *
+ * ParallelFor is meant to be called from the game thread only, and does not nest.
+ */
+class JobSystem {
+public:
+    explicit JobSystem(size_t workerCount);
+    ~JobSystem();
+
+    // Calls func(begin, end) over [0, count) in batches of batchSize and waits for all of them
+    void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& func);
+
+    size_t GetWorkerCount() const {
+        return _threads.size();
+    }
+
+private:
+    using Job = std::function<void()>;
+
+    struct WorkQueue {
+        std::mutex Mutex;
+        std::deque<Job> Jobs;
+    };
+
+    bool PopJob(size_t queueIndex, Job& job);
+    bool StealJob(size_t thiefIndex, Job& job);
+    void WorkerLoop(size_t queueIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues; // Queue 0 belongs to the calling thread
+    std::vector<std::thread> _threads;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::atomic<size_t> _queuedJobs = 0;
+    bool _bQuit = false;
+};
+
+// Shared pool sized to the machine, created on first use
+JobSystem& GetJobSystem();
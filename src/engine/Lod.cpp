@@ -0,0 +1,148 @@
+#include "Lod.h"
+#include <libultraship.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+
+#include "editor/Collision.h"
+#include "port/FrameSettings.h"
+
+namespace {
+
+std::unordered_map<std::string, std::vector<LodLevel>> sModelLods;
+std::unordered_map<Gfx*, u32> sTriangleCounts;
+std::unordered_map<std::string, u32> sModelTriangleCounts;
+u32 sTriangles[FRUSTUM_MAX_VIEWPORTS];
+u32 sLastTriangles[FRUSTUM_MAX_VIEWPORTS];
+uint32_t sFramesSinceReport = 0;
+
+f32 DistanceToPoint(const FVector& point, const Vec3f pos) {
+    f32 dx = point.x - pos[0];
+    f32 dy = point.y - pos[1];
+    f32 dz = point.z - pos[2];
+    return sqrtf((dx * dx) + (dy * dy) + (dz * dz));
+}
+
+} // namespace
+
+namespace Lod {
+
+void Declare(const std::string& model, std::vector<LodLevel> levels) {
+    std::sort(levels.begin(), levels.end(),
+              [](const LodLevel& a, const LodLevel& b) { return a.Distance < b.Distance; });
+    // u8 levels in LodState
+    if (levels.size() > 255) {
+        levels.resize(255);
+    }
+    if (levels.empty()) {
+        sModelLods.erase(model);
+    } else {
+        sModelLods[model] = std::move(levels);
+    }
+}
+
+const std::vector<LodLevel>* GetLevels(const std::string& model) {
+    auto it = sModelLods.find(model);
+    return (it != sModelLods.end()) ? &it->second : nullptr;
+}
+
+size_t SelectLevel(const std::vector<LodLevel>& levels, u8& current, f32 distance) {
+    size_t level = std::min<size_t>(current, levels.size());
+
+    while ((level < levels.size()) && (distance > levels[level].Distance * (1.0f + LOD_HYSTERESIS))) {
+        level++;
+    }
+    while ((level > 0) && (distance < levels[level - 1].Distance * (1.0f - LOD_HYSTERESIS))) {
+        level--;
+    }
+    current = (u8) level;
+    return level;
+}
+
+const std::string& Select(const std::string& model, LodState& state, FVector pos) {
+    Vec3f cameraPos;
+    s32 viewport;
+
+    if (gFrameSettings.DisableLod || !Frustum_GetCamera(cameraPos, &viewport)) {
+        return model;
+    }
+    const std::vector<LodLevel>* levels = GetLevels(model);
+    if (levels == nullptr) {
+        return model;
+    }
+    size_t level = SelectLevel(*levels, state.Level[viewport], DistanceToPoint(pos, cameraPos));
+    return (level == 0) ? model : (*levels)[level - 1].Model;
+}
+
+u32 GetTriangleCount(Gfx* gfx) {
+    if (gfx == nullptr) {
+        return 0;
+    }
+    auto it = sTriangleCounts.find(gfx);
+    if (it == sTriangleCounts.end()) {
+        u32 count = 0;
+        Editor::ForEachModelTriangle(gfx, [&count](const Triangle&) { count++; });
+        it = sTriangleCounts.emplace(gfx, count).first;
+    }
+    return it->second;
+}
+
+u32 GetTriangleCount(const std::string& model) {
+    auto it = sModelTriangleCounts.find(model);
+    if (it == sModelTriangleCounts.end()) {
+        Gfx* gfx = (Gfx*) ResourceGetDataByName(model.c_str());
+        it = sModelTriangleCounts.emplace(model, GetTriangleCount(gfx)).first;
+    }
+    return it->second;
+}
+
+void CountTriangles(u32 triangles) {
+    Vec3f cameraPos;
+    s32 viewport;
+
+    if (Frustum_GetCamera(cameraPos, &viewport)) {
+        sTriangles[viewport] += triangles;
+    }
+}
+
+void from_json(const nlohmann::json& j) {
+    for (const auto& [model, levelsJson] : j.items()) {
+        std::vector<LodLevel> levels;
+        for (const auto& levelJson : levelsJson) {
+            levels.push_back({ levelJson.at("Model").get<std::string>(), levelJson.at("Distance").get<f32>() });
+        }
+        Declare(model, std::move(levels));
+    }
+}
+
+nlohmann::json to_json(const std::string& prefix) {
+    nlohmann::json j = nlohmann::json::object();
+
+    for (const auto& [model, levels] : sModelLods) {
+        if (model.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        nlohmann::json levelsJson = nlohmann::json::array();
+        for (const LodLevel& level : levels) {
+            levelsJson.push_back({ { "Model", level.Model }, { "Distance", level.Distance } });
+        }
+        j[model] = levelsJson;
+    }
+    return j;
+}
+
+} // namespace Lod
+
+extern "C" void Lod_EndFrame(void) {
+    for (s32 i = 0; i < FRUSTUM_MAX_VIEWPORTS; i++) {
+        sLastTriangles[i] = sTriangles[i];
+        sTriangles[i] = 0;
+    }
+
+    if (gFrameSettings.ReportLod && ++sFramesSinceReport >= 60) {
+        sFramesSinceReport = 0;
+        printf("[Lod] Triangles submitted per viewport: %u, %u, %u, %u\n", sLastTriangles[0], sLastTriangles[1],
+               sLastTriangles[2], sLastTriangles[3]);
+    }
+}
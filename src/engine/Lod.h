@@ -0,0 +1,69 @@
+#ifndef _LOD_HEADER_
+#define _LOD_HEADER_
+
+#include <libultraship.h>
+#include "port/Frustum.h"
+
+/**
+ * Detail levels for models drawn by resource name.
+ *
+ * A model declares lower detail versions of itself, each drawn from a switch distance on. Custom tracks list
+ * them under "ModelLods" in their scene file, which covers the track's static mesh actors and its track
+ * sections. Draw code asks for the level to draw from the current viewport's camera. A level only changes
+ * once the camera is LOD_HYSTERESIS past its switch distance, so a model sitting at the distance does not
+ * flicker between two levels. gDisableLod, which also turns off the stock courses' detail levels, keeps
+ * every model at full detail.
+ */
+
+// Fraction of a switch distance the camera must go past before the level changes
+#define LOD_HYSTERESIS 0.1f
+
+#ifdef __cplusplus
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "CoreMath.h"
+
+struct LodLevel {
+    std::string Model;
+    f32 Distance; // Drawn from this distance on
+};
+
+// The level an instance drew last in each viewport
+struct LodState {
+    u8 Level[FRUSTUM_MAX_VIEWPORTS] = {};
+};
+
+namespace Lod {
+// Replaces the levels of a model. They are sorted by distance.
+void Declare(const std::string& model, std::vector<LodLevel> levels);
+// Levels below full detail, nullptr if the model has none
+const std::vector<LodLevel>* GetLevels(const std::string& model);
+
+// Moves current to the level for this distance, with hysteresis. Level 0 is full detail.
+size_t SelectLevel(const std::vector<LodLevel>& levels, u8& current, f32 distance);
+// The model to draw at pos from the current viewport's camera
+const std::string& Select(const std::string& model, LodState& state, FVector pos);
+
+// Triangles in a display list and the lists it calls, counted once per list
+u32 GetTriangleCount(Gfx* gfx);
+u32 GetTriangleCount(const std::string& model);
+// Adds to the triangles submitted in the current viewport this frame
+void CountTriangles(u32 triangles);
+
+// "ModelLods" of a scene file. Saving only writes the models under prefix, the track's own directory.
+void from_json(const nlohmann::json& j);
+nlohmann::json to_json(const std::string& prefix);
+} // namespace Lod
+
+extern "C" {
+#endif
+
+// Resets the per viewport triangle counts, printing them first if gReportLod is set
+void Lod_EndFrame(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LOD_HEADER_
@@ -21,6 +21,24 @@ void AddMatrix(std::deque<Mtx>& stack, Mat4 mtx, s32 flags) {
     gSPMatrix(gDisplayListHead++, &stack.back(), flags);
 }
 
+/**
+ * Bounds checks the fixed size matrix arrays. An index past the end gets a scratch matrix, so the
+ * draw looks wrong instead of overwriting the matrices that follow.
+ */
+template <size_t N> static Mtx* GetFixedMatrix(std::array<Mtx, N>& pool, size_t index, const char* name) {
+    static Mtx sScratch;
+    static bool sWarned = false;
+
+    if (index < N) {
+        return &pool[index];
+    }
+    if (!sWarned) {
+        sWarned = true;
+        printf("[Matrix] %s matrix %zu is out of range, the pool only has %zu\n", name, index, N);
+    }
+    return &sScratch;
+}
+
 Mtx* GetMatrix(std::deque<Mtx>& stack) {
     stack.emplace_back();
     return &stack.back();
@@ -59,14 +77,14 @@ void SetTextMatrix(Mat4 mf, f32 x, f32 y, f32 arg3, f32 arg4) {
 // AddMatrix but with custom gfx ptr arg and flags are predefined
 Gfx* AddTextMatrix(Gfx* displayListHead, Mat4 mtx) {
     // Push a new matrix to the stack
-    gWorldInstance.Mtx.Objects.emplace_back();
+    gWorldInstance.Mtx->Objects.emplace_back();
 
     // Convert to a fixed-point matrix
-    FrameInterpolation_RecordMatrixMtxFToMtx((MtxF*)mtx, &gWorldInstance.Mtx.Objects.back());
-    guMtxF2L(mtx, &gWorldInstance.Mtx.Objects.back());
+    FrameInterpolation_RecordMatrixMtxFToMtx((MtxF*)mtx, &gWorldInstance.Mtx->Objects.back());
+    guMtxF2L(mtx, &gWorldInstance.Mtx->Objects.back());
 
     // Load the matrix
-    gSPMatrix(displayListHead++, &gWorldInstance.Mtx.Objects.back(), G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
+    gSPMatrix(displayListHead++, &gWorldInstance.Mtx->Objects.back(), G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
 
     return displayListHead;
 }
@@ -146,43 +164,52 @@ void AddLocalRotation(Mat4 mat, IRotator rot) {
 extern "C" {
 
     void AddHudMatrix(Mat4 mtx, s32 flags) {
-        AddMatrix(gWorldInstance.Mtx.Objects, mtx, flags);
+        AddMatrix(gWorldInstance.Mtx->Objects, mtx, flags);
     }
 
     Mtx* GetScreenMatrix(void) {
-        return &gWorldInstance.Mtx.Screen2D;
+        return &gWorldInstance.Mtx->Screen2D;
     }
 
     Mtx* GetOrthoMatrix(void) {
-        return &gWorldInstance.Mtx.Ortho;
+        return &gWorldInstance.Mtx->Ortho;
     }
 
     Mtx* GetPerspMatrix(size_t cameraId) {
-        return &gWorldInstance.Mtx.Persp[cameraId];
+        return GetFixedMatrix(gWorldInstance.Mtx->Persp, cameraId, "Persp");
     }
 
     Mtx* GetLookAtMatrix(size_t cameraId) {
-        return &gWorldInstance.Mtx.LookAt[cameraId];
+        return GetFixedMatrix(gWorldInstance.Mtx->LookAt, cameraId, "LookAt");
     }
 
     void AddObjectMatrix(Mat4 mtx, s32 flags) {
-        AddMatrix(gWorldInstance.Mtx.Objects, mtx, flags);
+        AddMatrix(gWorldInstance.Mtx->Objects, mtx, flags);
+    }
+
+    Mtx* ConvertObjectMatrix(Mat4 mtx) {
+        auto& stack = gWorldInstance.Mtx->Objects;
+        stack.emplace_back();
+
+        FrameInterpolation_RecordMatrixMtxFToMtx((MtxF*)mtx, &stack.back());
+        guMtxF2L(mtx, &stack.back());
+        return &stack.back();
     }
 
     Mtx* GetShadowMatrix(size_t playerId) {
-        return &gWorldInstance.Mtx.Shadows[playerId];
+        return GetFixedMatrix(gWorldInstance.Mtx->Shadows, playerId, "Shadow");
     }
 
     Mtx* GetKartMatrix(size_t playerId) {
-        return &gWorldInstance.Mtx.Karts[playerId];
+        return GetFixedMatrix(gWorldInstance.Mtx->Karts, playerId, "Kart");
     }
 
     void AddEffectMatrix(Mat4 mtx, s32 flags) {
-        AddMatrix(gWorldInstance.Mtx.Objects, mtx, flags);
+        AddMatrix(gWorldInstance.Mtx->Objects, mtx, flags);
     }
 
     void AddEffectMatrixOrtho(void) {
-        auto& stack = gWorldInstance.Mtx.Objects;
+        auto& stack = gWorldInstance.Mtx->Objects;
         stack.emplace_back();
 
         guOrtho(&stack.back(), 0.0f, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, 0.0f, -100.0f, 100.0f, 1.0f);
@@ -191,7 +218,7 @@ extern "C" {
     }
 
     Mtx* GetEffectMatrix(void) {
-        return GetMatrix(gWorldInstance.Mtx.Objects);
+        return GetMatrix(gWorldInstance.Mtx->Objects);
     }
 
 
@@ -200,14 +227,14 @@ extern "C" {
      * We might need to adjust which ones we clear.
      */
     void ClearMatrixPools(void) {
-        gWorldInstance.Mtx.Objects.clear();
-       // gWorldInstance.Mtx.Shadows.clear();
-        //gWorldInstance.Mtx.Karts.clear();
-       // gWorldInstance.Mtx.Effects.clear();
+        gWorldInstance.Mtx->Objects.clear();
+       // gWorldInstance.Mtx->Shadows.clear();
+        //gWorldInstance.Mtx->Karts.clear();
+       // gWorldInstance.Mtx->Effects.clear();
     }
 
     void ClearObjectsMatrixPool(void) {
-        gWorldInstance.Mtx.Objects.clear();
+        gWorldInstance.Mtx->Objects.clear();
     }
 }
 
@@ -14,6 +14,8 @@ void AddLocalRotation(Mat4 mat, IRotator rot);
 void ClearMatrixPools(void);
 void AddHudMatrix(Mat4 mtx, s32 flags);
 void AddObjectMatrix(Mat4 mtx, s32 flags);
+// Converts mtx into the object pool without loading it, for a draw that loads it later
+Mtx* ConvertObjectMatrix(Mat4 mtx);
 void AddEffectMatrix(Mat4 mtx, s32 flags);
 void AddEffectMatrixOrtho(void);
 
@@ -26,19 +26,16 @@ void Rulesets::PreInit() {
 // Only runs a single time at the beginning of a track.
 void Rulesets::PostInit() {
     if (CVarGetInteger("gAllThwompsAreMarty", false) == true) {
-        for (auto object : gWorldInstance.Objects) {
-            if (OThwomp* thwomp = dynamic_cast<OThwomp*>(object)) {
-                gObjectList[thwomp->_objectIndex].unk_0D5 = OThwomp::States::JAILED; // Sets all the thwomp behaviour flags to marty
-                thwomp->State =  OThwomp::States::JAILED;
-            }
+        for (OObject* object : gWorldInstance.GetObjectsOfClass(ObjectClass::Thwomp)) {
+            OThwomp* thwomp = static_cast<OThwomp*>(object);
+            gObjectList[thwomp->_objectIndex].unk_0D5 = OThwomp::States::JAILED; // Sets all the thwomp behaviour flags to marty
+            thwomp->State =  OThwomp::States::JAILED;
         }
     }
 
     if (CVarGetInteger("gAllBombKartsChase", false) == true) {
-        for (auto object : gWorldInstance.Objects) {
-            if (OBombKart* kart = dynamic_cast<OBombKart*>(object)) {
-                kart->State = OBombKart::States::CHASE;
-            }
+        for (OObject* object : gWorldInstance.GetObjectsOfClass(ObjectClass::BombKart)) {
+            static_cast<OBombKart*>(object)->State = OBombKart::States::CHASE;
         }
     }
 
@@ -0,0 +1,119 @@
+#include "SectionPlan.h"
+#include <libultraship.h>
+#include <libultra/gbi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "engine/JobSystem.h"
+#include "port/FrameSettings.h"
+
+namespace SectionPlanner {
+
+f32 DistanceToSection(const TrackSection& section, const Vec3f pos) {
+    f32 dx = std::max({ section.Min.x - pos[0], 0.0f, pos[0] - section.Max.x });
+    f32 dy = std::max({ section.Min.y - pos[1], 0.0f, pos[1] - section.Max.y });
+    f32 dz = std::max({ section.Min.z - pos[2], 0.0f, pos[2] - section.Max.z });
+    return (dx * dx) + (dy * dy) + (dz * dz);
+}
+
+void Plan(const std::vector<TrackSection>& sections, const FrustumView* view, const Vec3f sortPos,
+          SectionPlan& plan) {
+    plan.bHasView = (view != nullptr);
+    if (plan.bHasView) {
+        plan.View = *view;
+    }
+    plan.SortPos[0] = sortPos[0];
+    plan.SortPos[1] = sortPos[1];
+    plan.SortPos[2] = sortPos[2];
+    plan.Order.clear();
+    plan.Models.clear();
+    plan.Levels.clear();
+    plan.Drawn = 0;
+    plan.Culled = 0;
+
+    // Cull sections out of the camera's view, then draw each run of opaque sections front to back so
+    // the Fast3D interpreter can reject hidden pixels by depth. Everything else keeps its place.
+    for (size_t i = 0; i < sections.size(); i++) {
+        const TrackSection& section = sections[i];
+        if (section.bCullable && section.bHasBounds) {
+            Vec3f min = { section.Min.x, section.Min.y, section.Min.z };
+            Vec3f max = { section.Max.x, section.Max.y, section.Max.z };
+            if ((view != nullptr) && !Frustum_TestBoxInView(view, min, max)) {
+                plan.Culled++;
+                continue;
+            }
+            plan.Drawn++;
+        }
+        plan.Order.push_back(i);
+    }
+
+    const f32* pos = plan.SortPos;
+    auto closer = [&sections, pos](size_t a, size_t b) {
+        return DistanceToSection(sections[a], pos) < DistanceToSection(sections[b], pos);
+    };
+    for (auto run = plan.Order.begin(); run != plan.Order.end();) {
+        auto end = std::find_if(run, plan.Order.end(), [&sections](size_t i) { return !sections[i].bSortable; });
+        std::stable_sort(run, end, closer);
+        run = (end == plan.Order.end()) ? end : end + 1;
+    }
+
+    bool useLod = !gFrameSettings.DisableLod && (view != nullptr);
+    for (size_t i : plan.Order) {
+        const TrackSection& section = sections[i];
+        Gfx* model = section.Model;
+        u8 level = (view != nullptr) ? section.Lod.Level[view->Viewport] : 0;
+        const std::vector<LodLevel>* levels = useLod ? Lod::GetLevels(section.Path) : nullptr;
+        if ((levels != nullptr) && (levels->size() == section.LodModels.size())) {
+            size_t selected = Lod::SelectLevel(*levels, level, sqrtf(DistanceToSection(section, view->CameraPos)));
+            if (selected > 0) {
+                model = section.LodModels[selected - 1];
+            }
+        }
+        plan.Models.push_back(model);
+        plan.Levels.push_back(level);
+    }
+
+    plan.Commands.resize(plan.Models.size());
+    for (size_t i = 0; i < plan.Models.size(); i++) {
+        gSPDisplayList(&plan.Commands[i], plan.Models[i]);
+    }
+}
+
+void PlanViewports(const std::vector<TrackSection>& sections, const FrustumView* views, size_t count,
+                   SectionPlan* plans, JobSystem* jobs) {
+    auto plan = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Plan(sections, &views[i], views[i].CameraPos, plans[i]);
+            plans[i].bReady = true;
+        }
+    };
+
+    if ((jobs == nullptr) || (count < 2)) {
+        plan(0, count);
+        return;
+    }
+    jobs->ParallelFor(count, 1, plan);
+}
+
+bool Matches(const SectionPlan& plan, const FrustumView* view, const Vec3f sortPos) {
+    if (plan.bHasView != (view != nullptr)) {
+        return false;
+    }
+    if ((view != nullptr) && (memcmp(&plan.View, view, sizeof(FrustumView)) != 0)) {
+        return false;
+    }
+    return (plan.SortPos[0] == sortPos[0]) && (plan.SortPos[1] == sortPos[1]) && (plan.SortPos[2] == sortPos[2]);
+}
+
+void Apply(std::vector<TrackSection>& sections, const SectionPlan& plan) {
+    if (!plan.bHasView) {
+        return;
+    }
+    for (size_t i = 0; i < plan.Order.size(); i++) {
+        sections[plan.Order[i]].Lod.Level[plan.View.Viewport] = plan.Levels[i];
+    }
+}
+
+} // namespace SectionPlanner
@@ -0,0 +1,66 @@
+#ifndef _SECTION_PLAN_HEADER_
+#define _SECTION_PLAN_HEADER_
+
+#include <libultraship.h>
+#include <string>
+#include <vector>
+#include "CoreMath.h"
+#include "engine/Lod.h"
+#include "port/Frustum.h"
+
+/**
+ * What each viewport draws of an O2R track's sections.
+ *
+ * Course::Render used to cull, sort and pick detail levels for the sections one viewport at a time, while
+ * drawing them. A plan does the same work for a single viewport from its own FrustumView, reading the
+ * sections without changing them, and writes the display list calls into a buffer of its own. Splitscreen
+ * frames plan every viewport at once on the job system before drawing any of them. Each viewport then
+ * applies its plan, which moves the sections to the detail levels it picked, and copies its calls into the
+ * frame's display list.
+ */
+
+class JobSystem;
+
+// A section of an O2R track, measured by Course::ParseCourseSections
+struct TrackSection {
+    Gfx* Model;
+    FVector Min;
+    FVector Max;
+    bool bHasBounds;
+    bool bCullable; // The next section doesn't rely on state this one sets
+    bool bSortable; // Opaque, and draws the same wherever it is in the order
+    std::string Path;
+    std::vector<Gfx*> LodModels; // One per level declared for Path
+    LodState Lod;
+};
+
+struct SectionPlan {
+    FrustumView View;
+    bool bHasView = false; // Culled and detail levels picked against View
+    Vec3f SortPos = {};    // Where runs of sortable sections were sorted from
+    bool bReady = false;   // Planned ahead for this frame and not drawn yet
+    std::vector<size_t> Order; // Sections drawn, in draw order
+    std::vector<Gfx*> Models;  // The model drawn for each section of Order
+    std::vector<u8> Levels;    // The detail level each section of Order moves to
+    std::vector<Gfx> Commands; // A display list call for each model
+    u32 Drawn = 0;
+    u32 Culled = 0;
+};
+
+namespace SectionPlanner {
+// Squared distance from pos to the closest point of a section's box
+f32 DistanceToSection(const TrackSection& section, const Vec3f pos);
+
+// Plans a viewport. Without a view nothing is culled and every section is drawn at full detail.
+void Plan(const std::vector<TrackSection>& sections, const FrustumView* view, const Vec3f sortPos,
+          SectionPlan& plan);
+// Plans views[i] into plans[i] from each view's camera, across the job system's threads unless jobs is nullptr
+void PlanViewports(const std::vector<TrackSection>& sections, const FrustumView* views, size_t count,
+                   SectionPlan* plans, JobSystem* jobs);
+// Whether plan was made from this view and sort position
+bool Matches(const SectionPlan& plan, const FrustumView* view, const Vec3f sortPos);
+// Moves the sections of plan's viewport to the detail levels it picked
+void Apply(std::vector<TrackSection>& sections, const SectionPlan& plan);
+} // namespace SectionPlanner
+
+#endif // _SECTION_PLAN_HEADER_
@@ -1,6 +1,11 @@
 #include "StaticMeshActor.h"
 #include <libultra/gbi.h>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #include "Matrix.h"
+#include "DrawBatch.h"
+#include "editor/Collision.h"
 
 extern "C" {
 #include "main.h"
@@ -14,14 +19,42 @@ StaticMeshActor::StaticMeshActor(std::string name, FVector pos, IRotator rot, FV
 
 void StaticMeshActor::Draw() {
     Mat4 mtx;
-    gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
-    gSPClearGeometryMode(gDisplayListHead++, G_LIGHTING);
     if (!Model.empty()) {
         ApplyMatrixTransformations(mtx, Pos, Rot, Scale);
-        if (render_set_position(mtx, 0) != 0) {
-            gSPDisplayList(gDisplayListHead++, (Gfx*)Model.c_str());
+        const std::string& model = Lod::Select(Model, LodLevels, Pos);
+        DrawBatch::Add(model, G_SHADING_SMOOTH, G_LIGHTING, mtx);
+        Lod::CountTriangles(Lod::GetTriangleCount(model));
+    }
+}
+
+// Distance from the origin to the furthest vertex of each model, measured once and shared by every actor using it
+static std::unordered_map<std::string, f32> sModelRadii;
+
+bool StaticMeshActor::GetDrawBounds(FVector& center, f32& radius) {
+    if (Model.empty()) {
+        return false;
+    }
+
+    auto it = sModelRadii.find(Model);
+    if (it == sModelRadii.end()) {
+        f32 furthest = 0.0f;
+        Gfx* gfx = (Gfx*) ResourceGetDataByName(Model.c_str());
+        if (gfx != nullptr) {
+            Editor::ForEachModelTriangle(gfx, [&furthest](const Triangle& tri) {
+                for (const FVector& v : { tri.v0, tri.v1, tri.v2 }) {
+                    furthest = std::max(furthest, (v.x * v.x) + (v.y * v.y) + (v.z * v.z));
+                }
+            });
         }
+        it = sModelRadii.emplace(Model, sqrtf(furthest)).first;
     }
+    if (it->second <= 0.0f) {
+        return false;
+    }
+
+    center = Pos;
+    radius = it->second * std::max({ fabsf(Scale.x), fabsf(Scale.y), fabsf(Scale.z) });
+    return true;
 }
 
 void StaticMeshActor::Destroy() {
@@ -3,6 +3,7 @@
 #include <libultraship.h>
 #include <libultra/gbi.h>
 #include "CoreMath.h"
+#include "Lod.h"
 #include <nlohmann/json.hpp>
 
 // todo: Make this class AStaticMeshActor : public AActor
@@ -15,6 +16,7 @@ public:
     std::string Model;
     int32_t* Collision;
     bool bPendingDestroy = false;
+    LodState LodLevels; // Detail level drawn last in each viewport
     StaticMeshActor(std::string name, FVector pos, IRotator rot, FVector scale, std::string model, int32_t* collision);
 
     nlohmann::json to_json() const {
@@ -58,4 +60,6 @@ public:
 
     virtual void Draw();
     virtual void Destroy();
+    // Sphere around Pos that holds the scaled model, false if the model can't be measured
+    bool GetDrawBounds(FVector& center, f32& radius);
 };
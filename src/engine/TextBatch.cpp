@@ -0,0 +1,64 @@
+#include "TextBatch.h"
+#include <libultraship.h>
+#include <libultra/gbi.h>
+
+#include "port/FrameSettings.h"
+
+namespace {
+
+struct {
+    bool bOpen = false;
+    const Gfx* Mode = nullptr;
+    const u8* Texture = nullptr;
+    u32 Width = 0;
+    u32 Height = 0;
+} sLine;
+
+} // namespace
+
+extern "C" void TextBatch_Begin(void) {
+    sLine.bOpen = gFrameSettings.BatchText;
+    sLine.Mode = nullptr;
+    sLine.Texture = nullptr;
+}
+
+extern "C" Gfx* TextBatch_SetMode(Gfx* gfx, const Gfx* mode) {
+    if (sLine.bOpen && (mode == sLine.Mode)) {
+        return gfx;
+    }
+    gSPDisplayList(gfx++, (Gfx*) mode);
+    if (sLine.bOpen) {
+        // The first glyph used to clear it right after the mode, before drawing
+        gSPClearGeometryMode(gfx++, G_ZBUFFER);
+        sLine.Mode = mode;
+        sLine.Texture = nullptr;
+    }
+    return gfx;
+}
+
+extern "C" bool TextBatch_LoadsTexture(const u8* texture, u32 width, u32 height) {
+    if (!sLine.bOpen) {
+        return true;
+    }
+    if ((texture == sLine.Texture) && (width == sLine.Width) && (height == sLine.Height)) {
+        return false;
+    }
+    sLine.Texture = texture;
+    sLine.Width = width;
+    sLine.Height = height;
+    return true;
+}
+
+extern "C" bool TextBatch_IsOpen(void) {
+    return sLine.bOpen;
+}
+
+extern "C" Gfx* TextBatch_End(Gfx* gfx) {
+    if (sLine.bOpen && (sLine.Mode != nullptr)) {
+        gSPSetGeometryMode(gfx++, G_ZBUFFER);
+    }
+    sLine.bOpen = false;
+    sLine.Mode = nullptr;
+    sLine.Texture = nullptr;
+    return gfx;
+}
@@ -0,0 +1,36 @@
+#ifndef _TEXT_BATCH_HEADER_
+#define _TEXT_BATCH_HEADER_
+
+#include <libultraship.h>
+
+/**
+ * Shares state between the glyphs of a line of text.
+ *
+ * The print_text functions used to draw each glyph on its own. Every glyph called the letter mode's display
+ * list, cleared and set G_ZBUFFER around its rectangle, and loaded its texture, even when the glyph before it
+ * left all of that in place. Between TextBatch_Begin and TextBatch_End, the mode and the depth test are set
+ * once per line. A texture is only loaded if the previous glyph used a different one. Each glyph still gets its
+ * own matrix and rectangle, so the layout is the same to the pixel. With gBatchText off, every glyph is drawn
+ * the old way.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Starts a line of text
+void TextBatch_Begin(void);
+// Emits the letter mode's display list, unless the line already uses it
+Gfx* TextBatch_SetMode(Gfx* gfx, const Gfx* mode);
+// Whether a glyph has to load its texture, false if the previous glyph of the line loaded the same one
+bool TextBatch_LoadsTexture(const u8* texture, u32 width, u32 height);
+// Whether a line is being drawn, in which case a glyph leaves G_ZBUFFER alone
+bool TextBatch_IsOpen(void);
+// Ends the line, setting G_ZBUFFER again if the line cleared it
+Gfx* TextBatch_End(Gfx* gfx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _TEXT_BATCH_HEADER_
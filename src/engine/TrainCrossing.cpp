@@ -29,14 +29,12 @@ void TrainCrossing::CrossingTrigger() {
     s32 i;
     OnTriggered = 0;
 
-    for (const auto& actor : gWorldInstance.Actors) {
-        if (auto train = dynamic_cast<ATrain*>(actor)) {
-            ;
-            f32 radius = DynamicRadius(train->Locomotive.position, train->Locomotive.velocity, Position);
+    for (AActor* actor : gWorldInstance.GetActorsOfClass(ActorClass::Train)) {
+        ATrain* train = static_cast<ATrain*>(actor);
+        f32 radius = DynamicRadius(train->Locomotive.position, train->Locomotive.velocity, Position);
 
-            if (Distance(train->Locomotive.position, Position) < radius) {
-                OnTriggered = true; // Trigger within range
-            }
+        if (Distance(train->Locomotive.position, Position) < radius) {
+            OnTriggered = true; // Trigger within range
         }
     }
 
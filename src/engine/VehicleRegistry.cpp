@@ -0,0 +1,112 @@
+#include "VehicleRegistry.h"
+#include "Actor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define VEHICLE_GRID_CELL_SIZE 512.0f
+// Vehicles covering more cells than this are visited by every player instead
+#define VEHICLE_GRID_MAX_CELLS 64
+
+static int32_t GetVehicleGridCell(f32 value) {
+    return (int32_t) std::floor(value / VEHICLE_GRID_CELL_SIZE);
+}
+
+static uint64_t GetVehicleGridKey(int32_t x, int32_t z) {
+    return ((uint64_t) (uint32_t) x << 32) | (uint32_t) z;
+}
+
+void VehicleRegistry::Add(AActor* actor) {
+    f32 area[4];
+
+    if (actor->GetVehicleCollisionArea(area)) {
+        _vehicles.push_back(actor);
+        _bDirty = true;
+    }
+}
+
+void VehicleRegistry::Remove(AActor* actor) {
+    auto it = std::find(_vehicles.begin(), _vehicles.end(), actor);
+
+    if (it != _vehicles.end()) {
+        _vehicles.erase(it);
+        _bDirty = true;
+    }
+}
+
+void VehicleRegistry::Clear() {
+    _vehicles.clear();
+    _cells.clear();
+    _always.clear();
+    _bDirty = true;
+}
+
+void VehicleRegistry::Rebuild() {
+    _cells.clear();
+    _always.clear();
+
+    for (uint32_t i = 0; i < _vehicles.size(); i++) {
+        AActor* vehicle = _vehicles[i];
+        f32 area[4];
+
+        // Pad the area so that float rounding in the vehicle's own checks can never place a player outside of it
+        if (!vehicle->GetVehicleCollisionArea(area) || vehicle->HasVehicleCollisionState() ||
+            !std::isfinite(area[0] + area[1] + area[2] + area[3])) {
+            _always.push_back(i);
+            continue;
+        }
+        int32_t minX = GetVehicleGridCell(area[0] - 1.0f);
+        int32_t minZ = GetVehicleGridCell(area[1] - 1.0f);
+        int32_t maxX = GetVehicleGridCell(area[2] + 1.0f);
+        int32_t maxZ = GetVehicleGridCell(area[3] + 1.0f);
+
+        if (((int64_t) (maxX - minX + 1) * (maxZ - minZ + 1)) > VEHICLE_GRID_MAX_CELLS) {
+            _always.push_back(i);
+            continue;
+        }
+        for (int32_t x = minX; x <= maxX; x++) {
+            for (int32_t z = minZ; z <= maxZ; z++) {
+                _cells.push_back({ GetVehicleGridKey(x, z), i });
+            }
+        }
+    }
+
+    std::sort(_cells.begin(), _cells.end());
+    _bDirty = false;
+}
+
+void VehicleRegistry::Collide(s32 playerId, Player* player) {
+    f32 x = player->pos[0];
+    f32 z = player->pos[2];
+
+    // Positions the grid can't place are checked against every vehicle
+    if (!std::isfinite(x) || !std::isfinite(z) || (std::fabs(x) > 1.0e9f) || (std::fabs(z) > 1.0e9f)) {
+        for (AActor* vehicle : _vehicles) {
+            vehicle->VehicleCollision(playerId, player);
+        }
+        return;
+    }
+
+    if (_bDirty) {
+        Rebuild();
+    }
+
+    uint64_t key = GetVehicleGridKey(GetVehicleGridCell(x), GetVehicleGridCell(z));
+    auto first = std::lower_bound(_cells.begin(), _cells.end(), CellEntry{ key, 0 });
+
+    // Merge the cell with the vehicles every player visits, keeping actor list order
+    _visit.clear();
+    size_t always = 0;
+    for (auto it = first; (it != _cells.end()) && (it->Cell == key); it++) {
+        while ((always < _always.size()) && (_always[always] < it->Vehicle)) {
+            _visit.push_back(_always[always++]);
+        }
+        _visit.push_back(it->Vehicle);
+    }
+    _visit.insert(_visit.end(), _always.begin() + always, _always.end());
+
+    // VehicleCollision only touches the vehicle and the player, so the list can't change during the loop
+    for (uint32_t i : _visit) {
+        _vehicles[i]->VehicleCollision(playerId, player);
+    }
+}
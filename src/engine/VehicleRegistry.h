@@ -0,0 +1,56 @@
+#pragma once
+
+#include <libultraship.h>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "common_structs.h"
+}
+
+class AActor;
+
+/**
+ * Keeps track of the actors that react to players through VehicleCollision, and buckets them
+ * into a coarse XZ grid so that a player only visits the vehicles around it.
+ *
+ * Vehicles are kept in actor list order and are always called in that order, so gameplay is the
+ * same as calling VehicleCollision on every actor. A vehicle is skipped only if the player is
+ * outside of its collision area and it has no state to clear for that player.
+ *
+ * The grid is rebuilt lazily after vehicles were added, removed or ticked.
+ */
+class VehicleRegistry {
+public:
+    void Add(AActor* actor);
+    void Remove(AActor* actor);
+    void Clear();
+    void MarkDirty() {
+        _bDirty = true;
+    }
+
+    // Calls VehicleCollision on every vehicle that can affect this player
+    void Collide(s32 playerId, Player* player);
+
+    size_t GetCount() const {
+        return _vehicles.size();
+    }
+
+private:
+    struct CellEntry {
+        uint64_t Cell;
+        uint32_t Vehicle; // Index into _vehicles
+
+        bool operator<(const CellEntry& other) const {
+            return (Cell != other.Cell) ? (Cell < other.Cell) : (Vehicle < other.Vehicle);
+        }
+    };
+
+    void Rebuild();
+
+    std::vector<AActor*> _vehicles; // In actor list order
+    std::vector<CellEntry> _cells;  // Sorted by cell, then vehicle
+    std::vector<uint32_t> _always;  // Vehicles visited by every player, sorted
+    std::vector<uint32_t> _visit;
+    bool _bDirty = true;
+};
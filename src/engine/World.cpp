@@ -5,10 +5,20 @@
 #include "objects/BombKart.h"
 #include "TrainCrossing.h"
 #include <memory>
+#include <algorithm>
+#include <typeinfo>
+#include <chrono>
+#include <cstring>
 #include "objects/Object.h"
 #include "port/Game.h"
+#include "JobSystem.h"
+#include "port/GfxPool.h"
+#include "port/Frustum.h"
+#include "port/FrameSettings.h"
+#include "DrawBatch.h"
 
 #include "editor/GameObject.h"
+#include "vehicles/Utils.h"
 
 extern "C" {
 #include "camera.h"
@@ -19,11 +29,73 @@ extern "C" {
 #include "menus.h"
 #include "common_data.h"
 #include "mario_raceway_data.h"
+#include "math_util.h"
+#include "actor_types.h"
+#include "code_80005FD0.h"
 }
 
 World::World() {}
 World::~World() {
-    CM_CleanWorld();
+    if (this == &gWorldInstance) {
+        CM_CleanWorld();
+    } else {
+        ClearEntities();
+    }
+}
+
+static bool ValidateEntityHandles() {
+    return gFrameSettings.ValidateEntityHandles != 0;
+}
+
+// Runs of fewer parallel-safe entities than this are not worth handing to worker threads
+#define PARALLEL_TICK_MIN_ENTITIES 64
+#define PARALLEL_TICK_BATCH_SIZE 32
+
+static JobSystem* GetTickJobSystem() {
+    return gFrameSettings.ParallelTick ? &GetJobSystem() : nullptr;
+}
+
+/**
+ * Ticks entities in list order. A run of consecutive entities reporting IsParallelTickSafe() is ticked in
+ * batches across the job system, and then their TickCommit() calls run in list order before the entity that
+ * ends the run is ticked. A parallel-safe Tick() reads nothing another entity's tick writes, so every entity
+ * sees the same state it would if they were ticked one at a time, and side effects happen in the same order.
+ * Entities added during the tick are not ticked until the next one.
+ */
+template <typename T, typename TickFunc, typename CommitFunc>
+static void TickEntities(const std::vector<T*>& entities, JobSystem* jobs, TickFunc tick, CommitFunc commit) {
+    size_t count = entities.size();
+    size_t i = 0;
+
+    while (i < count) {
+        size_t runEnd = i;
+        while ((runEnd < count) && entities[runEnd]->IsParallelTickSafe()) {
+            runEnd++;
+        }
+
+        if ((jobs != nullptr) && ((runEnd - i) >= PARALLEL_TICK_MIN_ENTITIES)) {
+            T* const* run = &entities[i];
+            jobs->ParallelFor(runEnd - i, PARALLEL_TICK_BATCH_SIZE, [run, &tick](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; j++) {
+                    tick(run[j]);
+                }
+            });
+            for (; i < runEnd; i++) {
+                commit(entities[i]);
+            }
+        } else {
+            for (; i < runEnd; i++) {
+                tick(entities[i]);
+                commit(entities[i]);
+            }
+        }
+
+        // The entity that ended the run
+        if (i < count) {
+            tick(entities[i]);
+            i++;
+        }
+    }
 }
 
 std::shared_ptr<Course> CurrentCourse;
@@ -125,7 +197,14 @@ void World::PreviousCourse() {
 }
 
 AActor* World::AddActor(AActor* actor) {
+    // Released slots hold a base AActor that C code may still point at.
+    // Those are only recycled in place by AddBaseActor, so other actors always take a new slot.
+    actor->Handle = ActorHandles.AllocateAppend();
     Actors.push_back(actor);
+    Vehicles.Add(actor);
+    if (actor->Class != ActorClass::Other) {
+        _actorsByClass[(size_t) actor->Class].push_back(actor);
+    }
 
     if (actor->Model != NULL) {
         gEditor.AddObject(actor->Name, (FVector*) &actor->Pos, (IRotator*)&actor->Rot, &actor->Scale,
@@ -138,12 +217,23 @@ AActor* World::AddActor(AActor* actor) {
 }
 
 struct Actor* World::AddBaseActor() {
-    Actors.push_back(new AActor());
+    AActor* actor;
 
-    AActor* actor = Actors.back();
+    if (ActorHandles.HasFreeSlot()) {
+        EntityHandle handle = ActorHandles.Allocate();
+
+        // Reinitialize the released actor in place so that old C pointers to it never dangle
+        actor = Actors[handle.Index];
+        *actor = AActor();
+        actor->Handle = handle;
+    } else {
+        actor = new AActor();
+        actor->Handle = ActorHandles.AllocateAppend();
+        Actors.push_back(actor);
+    }
 
     // Skip C++ vtable to access variables in C
-    return reinterpret_cast<struct Actor*>(reinterpret_cast<char*>(Actors.back()) + sizeof(void*));
+    return reinterpret_cast<struct Actor*>(reinterpret_cast<char*>(actor) + sizeof(void*));
 }
 
 void World::AddEditorObject(Actor* actor, const char* name) {
@@ -177,13 +267,107 @@ AActor* World::GetActor(size_t index) {
     return Actors[index];
 }
 
+/**
+ * Returns the actor the handle was issued for, or nullptr if that actor has been destroyed.
+ */
+AActor* World::GetActorByHandle(EntityHandle handle) {
+    if (!ActorHandles.IsValid(handle)) {
+        if (ValidateEntityHandles() && !handle.IsNull()) {
+            printf("World::GetActorByHandle() use after destroy. slot %u generation %u\n", handle.Index,
+                   handle.Generation);
+        }
+        return nullptr;
+    }
+    return Actors[handle.Index];
+}
+
+/**
+ * Queues the actor for destruction. It stays in its slot until FlushDestroyedActors
+ * runs at the end of the frame, so indices held by C code remain usable until then.
+ */
+void World::DestroyActor(AActor* actor) {
+    if ((actor == nullptr) || !ActorHandles.IsValid(actor->Handle)) {
+        if (ValidateEntityHandles()) {
+            printf("World::DestroyActor() actor is not alive in this world\n");
+        }
+        return;
+    }
+    if (actor->bPendingDestroy) {
+        return;
+    }
+    actor->bPendingDestroy = true;
+    _pendingActorDestroy.push_back(actor->Handle);
+}
+
+void World::FlushDestroyedActors() {
+    for (EntityHandle handle : _pendingActorDestroy) {
+        if (!ActorHandles.IsValid(handle)) {
+            continue;
+        }
+
+        AActor* actor = Actors[handle.Index];
+        bool isBaseActor = typeid(*actor) == typeid(AActor);
+
+        // destroy_actor() clears the flags. If they are set again the slot was reused before the flush.
+        if (isBaseActor && (actor->Flags != 0)) {
+            actor->bPendingDestroy = false;
+            continue;
+        }
+
+        gEditor.RemoveObject(actor, sizeof(AActor));
+        Vehicles.Remove(actor);
+        if (actor->Class != ActorClass::Other) {
+            auto& list = _actorsByClass[(size_t) actor->Class];
+            auto it = std::find(list.begin(), list.end(), actor);
+            if (it != list.end()) {
+                list.erase(it);
+            }
+        }
+        if (!isBaseActor) {
+            // Leave a base actor in the slot so C loops over the actor list see an unused entry
+            delete actor;
+            actor = new AActor();
+            Actors[handle.Index] = actor;
+        }
+
+        ActorHandles.Release(handle);
+        actor->Handle = EntityHandle();
+        actor->bPendingDestroy = false;
+    }
+    _pendingActorDestroy.clear();
+
+    if (ValidateEntityHandles() && (ActorHandles.GetSlotCount() != Actors.size())) {
+        printf("World::FlushDestroyedActors() %zu actors but %zu handle slots\n", Actors.size(),
+               ActorHandles.GetSlotCount());
+    }
+}
+
 void World::TickActors() {
-    // This only ticks modded actors
-    for (AActor* actor : Actors) {
-        if (actor->IsMod()) {
-            actor->Tick();
+    if (ValidateEntityHandles()) {
+        for (AActor* actor : Actors) {
+            if (actor->IsMod() && !ActorHandles.IsValid(actor->Handle)) {
+                printf("World::TickActors() ticking destroyed actor %s\n", actor->Name);
+            }
         }
     }
+
+    // This only ticks modded actors
+    TickEntities(
+        Actors, GetTickJobSystem(),
+        [](AActor* actor) {
+            if (actor->IsMod()) {
+                actor->Tick();
+            }
+        },
+        [](AActor* actor) {
+            if (actor->IsMod()) {
+                actor->TickCommit();
+            }
+        });
+
+    // Vehicles moved
+    Vehicles.MarkDirty();
+    Traffic.Tick(GetTickJobSystem());
 }
 
 StaticMeshActor* World::AddStaticMeshActor(std::string name, FVector pos, IRotator rot, FVector scale, std::string model, int32_t* collision) {
@@ -194,10 +378,28 @@ StaticMeshActor* World::AddStaticMeshActor(std::string name, FVector pos, IRotat
     return actor;
 }
 
+// Tests an entity's draw bounds against the current camera. Entities without bounds are always drawn.
+static bool IsInView(bool hasBounds, const FVector& center, f32 radius) {
+    if (!hasBounds) {
+        return true;
+    }
+    Vec3f pos = { center.x, center.y, center.z };
+    return Frustum_IsSphereVisible(pos, radius);
+}
+
 void World::DrawStaticMeshActors() {
+    FVector center;
+    f32 radius;
+
+    DrawBatch_Begin();
     for (const auto& actor: StaticMeshActors) {
+        if (!IsInView(actor->GetDrawBounds(center, radius), center, radius)) {
+            continue;
+        }
+        GfxPool_Ensure();
         actor->Draw();
     }
+    DrawBatch_Flush();
 }
 
 void World::DeleteStaticMeshActors() {
@@ -212,7 +414,16 @@ void World::DeleteStaticMeshActors() {
 }
 
 OObject* World::AddObject(OObject* object) {
+    object->Handle = ObjectHandles.Allocate();
+    if (object->Handle.Index == _objectSlots.size()) {
+        _objectSlots.push_back(object);
+    } else {
+        _objectSlots[object->Handle.Index] = object;
+    }
     Objects.push_back(object);
+    if (object->Class != ObjectClass::Other) {
+        _objectsByClass[(size_t) object->Class].push_back(object);
+    }
 
     if (object->_objectIndex != -1) {
         Object* cObj = &gObjectList[object->_objectIndex];
@@ -227,18 +438,85 @@ OObject* World::AddObject(OObject* object) {
     return Objects.back();
 }
 
+/**
+ * Returns the object the handle was issued for, or nullptr if that object has been destroyed.
+ */
+OObject* World::GetObjectByHandle(EntityHandle handle) {
+    if (!ObjectHandles.IsValid(handle)) {
+        if (ValidateEntityHandles() && !handle.IsNull()) {
+            printf("World::GetObjectByHandle() use after destroy. slot %u generation %u\n", handle.Index,
+                   handle.Generation);
+        }
+        return nullptr;
+    }
+    return _objectSlots[handle.Index];
+}
+
+/**
+ * Queues the object for destruction at the end of the frame.
+ */
+void World::DestroyObject(OObject* object) {
+    if (object == nullptr || object->bPendingDestroy) {
+        return;
+    }
+    if (ValidateEntityHandles() && !ObjectHandles.IsValid(object->Handle)) {
+        printf("World::DestroyObject() object %s is not alive in this world\n", object->Name);
+    }
+    object->bPendingDestroy = true;
+    _pendingObjectDestroy.push_back(object->Handle);
+}
+
+void World::FlushDestroyedObjects() {
+    if (_pendingObjectDestroy.empty()) {
+        return;
+    }
+
+    for (EntityHandle handle : _pendingObjectDestroy) {
+        if (ObjectHandles.IsValid(handle)) {
+            ObjectHandles.Release(handle);
+            _objectSlots[handle.Index] = nullptr;
+        }
+    }
+    _pendingObjectDestroy.clear();
+
+    for (auto& list : _objectsByClass) {
+        list.erase(std::remove_if(list.begin(), list.end(), [](OObject* object) { return object->bPendingDestroy; }),
+                   list.end());
+    }
+
+    // Compact in a single pass instead of erasing one element at a time
+    auto end = std::remove_if(Objects.begin(), Objects.end(), [this](OObject* object) {
+        if (!object->bPendingDestroy) {
+            return false;
+        }
+        for (auto it = Lakitus.begin(); it != Lakitus.end();) {
+            it = ((OObject*) it->second == object) ? Lakitus.erase(it) : std::next(it);
+        }
+        gEditor.RemoveObject(object, sizeof(OObject));
+        delete object;
+        return true;
+    });
+    Objects.erase(end, Objects.end());
+}
+
 void World::TickObjects() {
-    for (const auto& object : Objects) {
-        object->Tick();
+    if (ValidateEntityHandles()) {
+        for (const auto& object : Objects) {
+            if (!ObjectHandles.IsValid(object->Handle)) {
+                printf("World::TickObjects() ticking destroyed object %s\n", object->Name);
+            }
+        }
     }
+
+    TickEntities(
+        Objects, GetTickJobSystem(), [](OObject* object) { object->Tick(); },
+        [](OObject* object) { object->TickCommit(); });
 }
 
 // Some objects such as lakitu are ticked in process_game_tick.
 // This is a fallback to support those objects. Probably don't use this.
 void World::TickObjects60fps() {
-    for (const auto& object : Objects) {
-        object->Tick60fps();
-    }
+    TickEntities(Objects, GetTickJobSystem(), [](OObject* object) { object->Tick60fps(); }, [](OObject* object) {});
 }
 
 ParticleEmitter* World::AddEmitter(ParticleEmitter* emitter) {
@@ -247,19 +525,27 @@ ParticleEmitter* World::AddEmitter(ParticleEmitter* emitter) {
 }
 
 void World::DrawObjects(s32 cameraId) {
+    FVector center;
+    f32 radius;
+
     for (const auto& object : Objects) {
+        if (!IsInView(object->GetDrawBounds(center, radius), center, radius)) {
+            continue;
+        }
+        GfxPool_Ensure();
         object->Draw(cameraId);
     }
 }
 
 void World::TickParticles() {
-    for (const auto& emitter : Emitters) {
-        emitter->Tick();
-    }
+    TickEntities(
+        Emitters, GetTickJobSystem(), [](ParticleEmitter* emitter) { emitter->Tick(); },
+        [](ParticleEmitter* emitter) { emitter->TickCommit(); });
 }
 
 void World::DrawParticles(s32 cameraId) {
     for (const auto& emitter : Emitters) {
+        GfxPool_Ensure();
         emitter->Draw(cameraId);
     }
 }
@@ -279,6 +565,32 @@ Object* World::GetObjectByIndex(size_t index) {
     return nullptr; // Or handle the error as needed
 }
 
+void World::ClearEntities(void) {
+    for (AActor* actor : Actors) {
+        delete actor;
+    }
+    for (OObject* object : Objects) {
+        delete object;
+    }
+
+    Actors.clear();
+    Objects.clear();
+    Vehicles.Clear();
+    Traffic.Clear();
+    for (auto& list : _actorsByClass) {
+        list.clear();
+    }
+    for (auto& list : _objectsByClass) {
+        list.clear();
+    }
+    _objectSlots.clear();
+    _pendingActorDestroy.clear();
+    _pendingObjectDestroy.clear();
+    // Handles issued before this point will never resolve again
+    ActorHandles.Clear();
+    ObjectHandles.Clear();
+}
+
 void World::ClearWorld(void) {
     World::DeleteStaticMeshActors();
     CM_CleanWorld();
@@ -290,3 +602,133 @@ void World::ClearWorld(void) {
     // gCollisionMesh
     // Paths
 }
+
+namespace {
+
+// Follows the track path like a road vehicle, into a C actor of its own, so that the benchmark leaves the race's
+// actors alone. Commits, and serial ticks, append the car to Order, which shows the order side effects ran in.
+class BenchmarkCar : public AActor {
+  public:
+    Vec3f CarPosition;
+    Vec3f CarVelocity;
+    Vec3s CarRotation;
+    f32 CarSpeed;
+    f32 Multiplier;
+    u16 WaypointIndex;
+    s16 SomeType;
+    bool bParallelTickSafe = true;
+    size_t Id = 0;
+    std::vector<size_t>* Order = nullptr;
+    struct Actor Slot = {};
+
+    bool IsParallelTickSafe() override {
+        return bParallelTickSafe;
+    }
+
+    void Tick() override {
+        RoadVehicleTick(CarPosition, CarVelocity, CarRotation, &WaypointIndex, &Multiplier, CarSpeed, SomeType);
+        vec3f_copy_return(Slot.pos, CarPosition);
+        vec3s_copy(Slot.rot, CarRotation);
+        vec3f_copy_return(Slot.velocity, CarVelocity);
+        if (!bParallelTickSafe) {
+            Order->push_back(Id);
+        }
+    }
+
+    void TickCommit() override {
+        Order->push_back(Id);
+    }
+};
+
+} // namespace
+
+/**
+ * Builds count cars on the current course and times ticking them serially and with increasing worker counts.
+ * Every 100th car is serial, so the parallel-safe ones come in runs like in a real actor list. Every parallel
+ * run starts from the same state as the serial run and is compared against it, both the cars and the order
+ * their side effects ran in, so any divergence is reported as a mismatch. The cars are never spawned, so the
+ * race's actor slots, random seed and vehicle counts stay as they were.
+ */
+void RunParallelTickBenchmark(size_t count) {
+    const size_t ticks = 60;
+
+    if ((gGamestate != RACING) || (gPathCountByPathIndex[0] == 0)) {
+        printf("RunParallelTickBenchmark() needs a race with a track path\n");
+        return;
+    }
+
+    std::vector<size_t> order;
+    std::vector<std::unique_ptr<BenchmarkCar>> initial;
+    for (size_t i = 0; i < count; i++) {
+        // The same start as a road vehicle at 100cc, with its type picked in turn instead of at random
+        BenchmarkCar* car = initial.emplace_back(std::make_unique<BenchmarkCar>()).get();
+        u16 waypoint = (i * 7) % gPathCountByPathIndex[0];
+        TrackPathPoint* point = &gTrackPaths[0][waypoint];
+
+        car->CarPosition[0] = point->posX;
+        car->CarPosition[1] = point->posY;
+        car->CarPosition[2] = point->posZ;
+        vec3f_set(car->CarVelocity, 0.0f, 0.0f, 0.0f);
+        car->WaypointIndex = waypoint;
+        car->SomeType = i % 3;
+        car->Multiplier = (f32) ((f64) (f32) (car->SomeType - 1) * 0.6);
+        car->CarSpeed = (car->SomeType == 2) ? 2.0f : 2.5f;
+        vec3s_set(car->CarRotation, 0, 0, 0);
+        if (gIsInExtra == 0) {
+            car->CarRotation[1] = func_8000D6D0(car->CarPosition, (s16*) &car->WaypointIndex, car->CarSpeed,
+                                                car->Multiplier, 0, 3);
+        } else {
+            car->CarRotation[1] =
+                func_8000D940(car->CarPosition, (s16*) &car->WaypointIndex, car->CarSpeed, car->Multiplier, 0);
+        }
+        spawn_vehicle_on_road(car->CarPosition, car->CarRotation, car->CarVelocity, car->WaypointIndex,
+                              car->Multiplier, car->CarSpeed);
+        car->bParallelTickSafe = (i % 100) != 99;
+        car->Id = i;
+        car->Order = &order;
+    }
+
+    auto run = [&](JobSystem* jobs, std::vector<BenchmarkCar>& cars) {
+        std::vector<BenchmarkCar*> list;
+        for (size_t i = 0; i < count; i++) {
+            cars.push_back(*initial[i]);
+            list.push_back(&cars.back());
+        }
+        order.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ticks; i++) {
+            TickEntities(list, jobs, [](BenchmarkCar* car) { car->Tick(); },
+                         [](BenchmarkCar* car) { car->TickCommit(); });
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::vector<BenchmarkCar> serial;
+    serial.reserve(count);
+    long long serialTime = run(nullptr, serial);
+    std::vector<size_t> serialOrder = order;
+    printf("RunParallelTickBenchmark() %zu cars, %zu ticks. Serial: %lld us\n", count, ticks, serialTime);
+
+    size_t maxWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+        JobSystem jobs(workers);
+        std::vector<BenchmarkCar> parallel;
+        parallel.reserve(count);
+        long long time = run(&jobs, parallel);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; i++) {
+            const BenchmarkCar& a = serial[i];
+            const BenchmarkCar& b = parallel[i];
+            mismatches += (memcmp(a.CarPosition, b.CarPosition, sizeof(Vec3f)) != 0) ||
+                          (memcmp(a.CarVelocity, b.CarVelocity, sizeof(Vec3f)) != 0) ||
+                          (memcmp(a.CarRotation, b.CarRotation, sizeof(Vec3s)) != 0) ||
+                          (memcmp(a.Slot.pos, b.Slot.pos, sizeof(Vec3f)) != 0) || (a.Multiplier != b.Multiplier) ||
+                          (a.WaypointIndex != b.WaypointIndex);
+        }
+        printf("RunParallelTickBenchmark() 1 + %zu threads: %lld us (%.2fx), %zu mismatches, side effects %s\n",
+               workers, time, (double) serialTime / (double) std::max(time, 1LL), mismatches,
+               (order == serialOrder) ? "in order" : "out of order");
+    }
+}
@@ -7,6 +7,7 @@
 #include "Cup.h"
 #include "vehicles/Train.h"
 #include "vehicles/Car.h"
+#include "vehicles/Traffic.h"
 #include "objects/BombKart.h"
 #include "PlayerBombKart.h"
 #include "vehicles/Train.h"
@@ -18,6 +19,8 @@
 #include <memory>
 #include <unordered_map>
 #include "Actor.h"
+#include "EntityHandle.h"
+#include "VehicleRegistry.h"
 #include "StaticMeshActor.h"
 #include "particles/ParticleEmitter.h"
 
@@ -65,6 +68,13 @@ public:
     struct Actor* AddBaseActor();
     void AddEditorObject(Actor* actor, const char* name);
     AActor* GetActor(size_t index);
+    AActor* GetActorByHandle(EntityHandle handle);
+    void DestroyActor(AActor* actor);
+    void FlushDestroyedActors();
+    // Actors of one class in actor list order. Replaces dynamic_cast over every actor.
+    const std::vector<AActor*>& GetActorsOfClass(ActorClass actorClass) const {
+        return _actorsByClass[(size_t) actorClass];
+    }
 
     void TickActors();
     AActor* ConvertActorToAActor(Actor* actor);
@@ -75,6 +85,12 @@ public:
     void DeleteStaticMeshActors();
 
     OObject* AddObject(OObject* object);
+    OObject* GetObjectByHandle(EntityHandle handle);
+    void DestroyObject(OObject* object);
+    void FlushDestroyedObjects();
+    const std::vector<OObject*>& GetObjectsOfClass(ObjectClass objectClass) const {
+        return _objectsByClass[(size_t) objectClass];
+    }
 
     void TickObjects();
     void TickObjects60fps();
@@ -97,6 +113,7 @@ public:
 
     World* GetWorld(void);
     void ClearWorld(void);
+    void ClearEntities(void); // Deletes every actor and object and invalidates their handles
 
 
     // These are only for browsing through the course list
@@ -114,7 +131,10 @@ public:
     void NextCourse(void);
     void PreviousCourse(void);
 
-    Matrix Mtx;
+    // One set per gfx pool, as the matrices were on the N64. While a display list is still being drawn, the
+    // next frame writes its matrices to the other set.
+    Matrix MtxPools[2];
+    Matrix* Mtx = &MtxPools[0];
 
 
     std::shared_ptr<Course> CurrentCourse;
@@ -124,8 +144,12 @@ public:
     size_t CupIndex = 1;
 
     std::vector<StaticMeshActor*> StaticMeshActors;
-    std::vector<AActor*> Actors;
+    std::vector<AActor*> Actors; // Indexed by actor handle. C code refers to actors by this position
     std::vector<OObject*> Objects;
+    EntityHandleAllocator ActorHandles;
+    EntityHandleAllocator ObjectHandles;
+    VehicleRegistry Vehicles; // Actors that get VehicleCollision calls
+    RoadTraffic Traffic; // Road vehicles without actors
     std::vector<ParticleEmitter*> Emitters;
 
     std::unordered_map<s32, OLakitu*> Lakitus;
@@ -140,7 +164,13 @@ public:
     std::vector<std::shared_ptr<Course>> Courses;
     size_t CourseIndex = 0; // For browsing courses.
 private:
-
+    std::vector<OObject*> _objectSlots; // Indexed by object handle
+    std::vector<EntityHandle> _pendingActorDestroy;
+    std::vector<EntityHandle> _pendingObjectDestroy;
+    std::vector<AActor*> _actorsByClass[(size_t) ActorClass::Count];
+    std::vector<OObject*> _objectsByClass[(size_t) ObjectClass::Count];
 };
 
 extern World gWorldInstance;
+
+void RunParallelTickBenchmark(size_t count);
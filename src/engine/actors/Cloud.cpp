@@ -3,6 +3,7 @@
 #include "Cloud.h"
 #include "engine/Actor.h"
 #include "World.h"
+#include "DrawBatch.h"
 
 extern "C" {
 #include "macros.h"
@@ -56,10 +57,7 @@ void ACloud::Draw(Camera* camera) {
     }
 
     mtxf_pos_rotation_xyz(mtx, Pos, Rot);
-    if (render_set_position(mtx, 0) != 0) {
-        gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
-        gSPDisplayList(gDisplayListHead++, (Gfx*) cloud_mesh);
-    }
+    DrawBatch_Add((Gfx*) cloud_mesh, nullptr, G_SHADING_SMOOTH, 0, mtx);
 }
 
 void ACloud::Collision(Player* player, AActor* actor) {
@@ -23,6 +23,7 @@ size_t AFinishline::_count = 0;
 
 AFinishline::AFinishline(std::optional<FVector> pos) {
     Name = "Finishline";
+    Class = ActorClass::Finishline;
 
     if (pos.has_value()) {
         // Set spawn point to the provided position
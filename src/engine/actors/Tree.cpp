@@ -1,6 +1,8 @@
 #include "Tree.h"
 
 #include <libultra/gbi.h>
+#include "port/FrameSettings.h"
+#include "engine/DrawBatch.h"
 
 extern "C" {
 #include "common_structs.h"
@@ -40,7 +42,7 @@ void ATree::Draw(Camera* camera) {
     dist = is_within_render_distance(camera->pos, Pos, camera->rot[1], 0, gCameraZoom[camera - camera1],
                                         DrawDistance);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         dist = MAX(dist, 0.0f);
     }
  
@@ -55,12 +57,13 @@ void ATree::Draw(Camera* camera) {
     sBillBoardMtx[3][1] = Pos[1];
     sBillBoardMtx[3][2] = Pos[2];
 
-    if (render_set_position(sBillBoardMtx, 0) != 0) {
-        if (Tlut) {
-            gDPLoadTLUT_pal256(gDisplayListHead++, Tlut);
-        }
-        gSPDisplayList(gDisplayListHead++, Displaylist);
-    }
+    DrawBatch_Add(Displaylist, Tlut, 0, 0, sBillBoardMtx);
+}
+
+bool ATree::GetDrawBounds(FVector& center, f32& radius) {
+    center = FVector(Pos[0], Pos[1], Pos[2]);
+    radius = 150.0f;
+    return true;
 }
 
 void ATree::Collision(Player* player, AActor*) { }
@@ -30,6 +30,7 @@ public:
 
     virtual void Tick() override;
     virtual void Draw(Camera* camera) override;
+    virtual bool GetDrawBounds(FVector& center, f32& radius) override;
     virtual void Collision(Player*, AActor*) override;
     virtual void Destroy() override;
 };
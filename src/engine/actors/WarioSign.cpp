@@ -2,6 +2,8 @@
 
 #include <libultra/gbi.h>
 #include <assets/wario_stadium_data.h>
+#include "port/FrameSettings.h"
+#include "engine/DrawBatch.h"
 
 extern "C" {
 #include "common_structs.h"
@@ -27,17 +29,17 @@ void AWarioSign::Draw(Camera *camera) {
     f32 unk =
         is_within_render_distance(camera->pos, Pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 16000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         unk = MAX(unk, 0.0f);
     }
     if (!(unk < 0.0f)) {
-        gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
-        gSPClearGeometryMode(gDisplayListHead++, G_LIGHTING);
-
         mtxf_pos_rotation_xyz(sp38, Pos, Rot);
-        if (render_set_position(sp38, 0) != 0) {
-
-            gSPDisplayList(gDisplayListHead++, (Gfx*)d_course_wario_stadium_dl_sign);
-        }
+        DrawBatch_Add((Gfx*)d_course_wario_stadium_dl_sign, nullptr, G_SHADING_SMOOTH, G_LIGHTING, sp38);
     }
 }
+
+bool AWarioSign::GetDrawBounds(FVector& center, f32& radius) {
+    center = FVector(Pos[0], Pos[1], Pos[2]);
+    radius = 250.0f;
+    return true;
+}
@@ -16,4 +16,5 @@ public:
 
     virtual void Tick() override;
     virtual void Draw(Camera*) override;
+    virtual bool GetDrawBounds(FVector& center, f32& radius) override;
 };
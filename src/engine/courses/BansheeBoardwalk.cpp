@@ -65,6 +65,7 @@ const course_texture banshee_boardwalk_textures[] = {
 };
 
 BansheeBoardwalk::BansheeBoardwalk() {
+    Type = CourseType::BansheeBoardwalk;
     this->vtx = d_course_banshee_boardwalk_vertex;
     this->gfx = d_course_banshee_boardwalk_packed_dls;
     this->gfxSize = 3689;
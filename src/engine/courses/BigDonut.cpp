@@ -39,6 +39,7 @@ const course_texture big_donut_textures[] = {
 };
 
 BigDonut::BigDonut() {
+    Type = CourseType::BigDonut;
     this->vtx = d_course_big_donut_vertex;
     this->gfx = d_course_big_donut_packed_dls;
     this->gfxSize = 528;
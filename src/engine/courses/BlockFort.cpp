@@ -41,6 +41,7 @@ const course_texture block_fort_textures[] = {
 };
 
 BlockFort::BlockFort() {
+    Type = CourseType::BlockFort;
     this->vtx = d_course_block_fort_vertex;
     this->gfx = d_course_block_fort_packed_dls;
     this->gfxSize = 699;
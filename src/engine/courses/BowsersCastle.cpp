@@ -68,6 +68,7 @@ const course_texture bowsers_castle_textures[] = {
 };
 
 BowsersCastle::BowsersCastle() {
+    Type = CourseType::BowsersCastle;
     this->vtx = d_course_bowsers_castle_vertex;
     this->gfx = d_course_bowsers_castle_packed_dls;
     this->gfxSize = 4900;
@@ -60,6 +60,7 @@ const course_texture choco_mountain_textures[] = {
 };
 
 ChocoMountain::ChocoMountain() {
+    Type = CourseType::ChocoMountain;
     this->vtx = d_course_choco_mountain_vertex;
     this->gfx = d_course_choco_mountain_packed_dls;
     this->gfxSize = 2910;
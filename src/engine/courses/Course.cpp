@@ -6,6 +6,13 @@
 #include "port/Game.h"
 #include "port/resource/type/TrackPathPointData.h"
 #include "port/resource/type/TrackSections.h"
+#include "port/Frustum.h"
+#include "port/GfxPool.h"
+#include "port/FrameSettings.h"
+#include "engine/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 extern "C" {
 #include "main.h"
@@ -177,7 +184,7 @@ void Course::Load() {
     size_t texSegSize;
 
     // Convert course vtx to vtx
-    Vtx* vtx = reinterpret_cast<Vtx*>(allocate_memory(vtxSize));
+    Vtx* vtx = reinterpret_cast<Vtx*>(allocate_memory(vtxSize, MEMORY_TAG_GEOMETRY));
     gSegmentTable[4] = reinterpret_cast<uintptr_t>(&vtx[0]);
     func_802A86A8(reinterpret_cast<CourseVtx*>(LOAD_ASSET_RAW(this->vtx)), vtx, vtxSize / sizeof(Vtx));
 
@@ -189,7 +196,7 @@ void Course::Load() {
     texSegSize = 0;
     while (asset->addr) {
         size = ResourceGetTexSizeByName(asset->addr);
-        freeMemory = (u8*) allocate_memory(size);
+        freeMemory = (u8*) allocate_memory(size, MEMORY_TAG_TEXTURES);
 
         texture = (u8*) (asset->addr);
         if (texture) {
@@ -206,7 +213,7 @@ void Course::Load() {
 
     // Extract packed DLs
     u8* packed = reinterpret_cast<u8*>(LOAD_ASSET_RAW(this->gfx));
-    Gfx* gfx = (Gfx*) allocate_memory(sizeof(Gfx) * this->gfxSize); // Size of unpacked DLs
+    Gfx* gfx = (Gfx*) allocate_memory(sizeof(Gfx) * this->gfxSize, MEMORY_TAG_GEOMETRY); // Size of unpacked DLs
     if (gfx == NULL) {
         printf("Failed to allocate course displaylist memory\n");
     }
@@ -217,8 +224,191 @@ void Course::Load() {
     Course::Init();
 }
 
+namespace {
+
+// RDP state set by a single command, beyond the geometry and other modes
+enum SectionState : u32 {
+    SECTION_COMBINE = 1 << 0,
+    SECTION_TEXTURE_IMAGE = 1 << 1,
+    SECTION_TEXTURE = 1 << 2,
+    SECTION_TILE = 1 << 3,
+    SECTION_TILE_SIZE = 1 << 4,
+    SECTION_PRIM_COLOR = 1 << 5,
+    SECTION_ENV_COLOR = 1 << 6,
+    SECTION_FOG_COLOR = 1 << 7,
+    SECTION_BLEND_COLOR = 1 << 8,
+};
+
+// Bits of one kind of state that a section changes
+struct SectionWrites {
+    u32 Anywhere = 0;
+    u32 BeforeDraw = 0; // Changed before the first triangle
+
+    // State that no section touches is whatever the course set up before them. Anything else must be set again
+    // before drawing for the section to look the same wherever it is drawn.
+    bool Covers(u32 courseWrites) const {
+        return (courseWrites & ~BeforeDraw) == 0;
+    }
+};
+
+// What a track section's display list does. Vertices are found the same way generate_collision_mesh finds them.
+struct SectionScan {
+    FVector Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+    FVector Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    bool bHasVertices = false;
+    bool bDrawn = false;
+    bool bTranslucent = false;
+    SectionWrites State;    // SectionState bits
+    SectionWrites Geometry; // Geometry mode bits
+    SectionWrites OtherModeL;
+    SectionWrites OtherModeH;
+
+    void Write(SectionWrites& writes, u32 bits) {
+        writes.Anywhere |= bits;
+        if (!bDrawn) {
+            writes.BeforeDraw |= bits;
+        }
+    }
+
+    // The same pass over the course sections decides this for every section, so they see the same state
+    void Merge(const SectionScan& other) {
+        State.Anywhere |= other.State.Anywhere;
+        Geometry.Anywhere |= other.Geometry.Anywhere;
+        OtherModeL.Anywhere |= other.OtherModeL.Anywhere;
+        OtherModeH.Anywhere |= other.OtherModeH.Anywhere;
+    }
+
+    bool IsSelfContained(const SectionScan& course) const {
+        return State.Covers(course.State.Anywhere) && Geometry.Covers(course.Geometry.Anywhere) &&
+               OtherModeL.Covers(course.OtherModeL.Anywhere) && OtherModeH.Covers(course.OtherModeH.Anywhere);
+    }
+};
+
+// Bits of the other mode word a G_SETOTHERMODE_L/H command replaces
+u32 OtherModeMask(uintptr_t lo) {
+    u32 shift = (lo >> 8) & 0xFF;
+    u32 length = lo & 0xFF;
+    if (length >= 32) {
+        return 0xFFFFFFFF;
+    }
+    return ((1u << length) - 1) << shift;
+}
+
+void ScanVertices(SectionScan& scan, const Vtx* vtx, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        FVector v = FVector(vtx[i].v.ob[0], vtx[i].v.ob[1], vtx[i].v.ob[2]);
+        scan.Min = FVector(std::min(scan.Min.x, v.x), std::min(scan.Min.y, v.y), std::min(scan.Min.z, v.z));
+        scan.Max = FVector(std::max(scan.Max.x, v.x), std::max(scan.Max.y, v.y), std::max(scan.Max.z, v.z));
+    }
+    scan.bHasVertices |= (count > 0);
+}
+
+void ScanSection(const Gfx* gfx, SectionScan& scan, s32 depth) {
+    if ((gfx == nullptr) || (depth > 16)) {
+        return;
+    }
+
+    for (s32 i = 0; i < 0x1FFF; i++, gfx++) {
+        uintptr_t lo = gfx->words.w0;
+        uintptr_t hi = gfx->words.w1;
+        // Signed, like the immediate opcodes. The RDP ones are defined unsigned and need a cast to match.
+        int8_t opcode = GFX_GET_OPCODE(lo) >> 24;
+
+        switch (opcode) {
+            case G_DL:
+                ScanSection((const Gfx*) hi, scan, depth + 1);
+                break;
+            case G_DL_OTR_FILEPATH:
+                ScanSection((const Gfx*) ResourceGetDataByName((const char*) hi), scan, depth + 1);
+                break;
+            case G_DL_OTR_HASH:
+                gfx++;
+                ScanSection((const Gfx*) ResourceGetDataByCrc(((uint64_t) gfx->words.w0 << 32) + gfx->words.w1), scan,
+                            depth + 1);
+                break;
+            case G_VTX:
+                ScanVertices(scan, (const Vtx*) hi, (lo >> 10) & 0x3F);
+                break;
+            case G_VTX_OTR_FILEPATH: {
+                const char* filePath = (const char*) hi;
+                gfx++;
+                const Vtx* vtx = (const Vtx*) ResourceGetDataByName(filePath);
+                if ((vtx != nullptr) && !is_cull_box(filePath)) {
+                    ScanVertices(scan, vtx + (gfx->words.w1 & 0xFFFF), gfx->words.w0);
+                }
+                break;
+            }
+            case G_TRI1:
+            case G_TRI1_OTR:
+            case G_TRI2:
+            case G_QUAD:
+                scan.bDrawn = true;
+                break;
+            case G_SETGEOMETRYMODE:
+            case G_CLEARGEOMETRYMODE:
+                scan.Write(scan.Geometry, hi);
+                break;
+            case G_SETOTHERMODE_H:
+                scan.Write(scan.OtherModeH, OtherModeMask(lo));
+                break;
+            case G_SETOTHERMODE_L:
+                scan.Write(scan.OtherModeL, OtherModeMask(lo));
+                // The alpha compare and depth source bits sit below the render mode
+                if ((OtherModeMask(lo) & ~7) != 0) {
+                    if (((hi & Z_UPD) == 0) || ((hi & ZMODE_DEC) >= ZMODE_XLU)) {
+                        scan.bTranslucent = true;
+                    }
+                }
+                break;
+            case (int8_t) G_RDPSETOTHERMODE:
+                scan.Write(scan.OtherModeH, 0x00FFFFFF);
+                scan.Write(scan.OtherModeL, 0xFFFFFFFF);
+                if (((hi & Z_UPD) == 0) || ((hi & ZMODE_DEC) >= ZMODE_XLU)) {
+                    scan.bTranslucent = true;
+                }
+                break;
+            case G_TEXTURE:
+                scan.Write(scan.State, SECTION_TEXTURE);
+                break;
+            case (int8_t) G_SETCOMBINE:
+                scan.Write(scan.State, SECTION_COMBINE);
+                break;
+            case (int8_t) G_SETTIMG:
+            case (int8_t) G_SETTIMG_OTR_FILEPATH:
+                scan.Write(scan.State, SECTION_TEXTURE_IMAGE);
+                break;
+            case (int8_t) G_SETTILE:
+                scan.Write(scan.State, SECTION_TILE);
+                break;
+            case (int8_t) G_SETTILESIZE:
+                scan.Write(scan.State, SECTION_TILE_SIZE);
+                break;
+            case (int8_t) G_SETPRIMCOLOR:
+                scan.Write(scan.State, SECTION_PRIM_COLOR);
+                break;
+            case (int8_t) G_SETENVCOLOR:
+                scan.Write(scan.State, SECTION_ENV_COLOR);
+                break;
+            case (int8_t) G_SETFOGCOLOR:
+                scan.Write(scan.State, SECTION_FOG_COLOR);
+                break;
+            case (int8_t) G_SETBLENDCOLOR:
+                scan.Write(scan.State, SECTION_BLEND_COLOR);
+                break;
+            case G_ENDDL:
+                return;
+        }
+    }
+}
+
+} // namespace
+
 // C++ version of parse_course_displaylists()
 void Course::ParseCourseSections(TrackSectionsO2R* sections, size_t size) {
+    std::vector<SectionScan> scans;
+    std::vector<std::vector<std::pair<Gfx*, SectionScan>>> lods;
+
+    TrackSections.clear();
     for (size_t i = 0; i < (size / sizeof(TrackSectionsO2R)); i++) {
         if (sections[i].flags & 0x8000) {
             D_8015F59C = 1; // single-sided wall
@@ -236,8 +426,60 @@ void Course::ParseCourseSections(TrackSectionsO2R* sections, size_t size) {
             D_8015F5A4 = 0;
         }
         printf("LOADING DL %s\n", sections[i].addr.c_str());
-        generate_collision_mesh((Gfx*) LOAD_ASSET_RAW(sections[i].addr.c_str()), sections[i].surfaceType,
-                                sections[i].sectionId);
+        Gfx* model = (Gfx*) LOAD_ASSET_RAW(sections[i].addr.c_str());
+        generate_collision_mesh(model, sections[i].surfaceType, sections[i].sectionId);
+
+        SectionScan& scan = scans.emplace_back();
+        ScanSection(model, scan, 0);
+        TrackSections.emplace_back(
+            TrackSection{ model, scan.Min, scan.Max, scan.bHasVertices, false, false, sections[i].addr });
+
+        // Collision always comes from the full detail model
+        std::vector<std::pair<Gfx*, SectionScan>>& sectionLods = lods.emplace_back();
+        if (const std::vector<LodLevel>* levels = Lod::GetLevels(sections[i].addr)) {
+            for (const LodLevel& level : *levels) {
+                Gfx* lodModel = (Gfx*) LOAD_ASSET_RAW(level.Model.c_str());
+                SectionScan& lodScan = sectionLods.emplace_back(lodModel, SectionScan()).second;
+                if (lodModel != nullptr) {
+                    ScanSection(lodModel, lodScan, 0);
+                }
+            }
+        }
+    }
+
+    // Whether a section sets up its own state depends on which state any of the others change
+    SectionScan course;
+    for (size_t i = 0; i < scans.size(); i++) {
+        course.Merge(scans[i]);
+        for (const auto& [lodModel, lodScan] : lods[i]) {
+            course.Merge(lodScan);
+        }
+    }
+
+    // A section that relies on state left by the one before it must stay right after it. So a section may
+    // only be culled if the next one sets up its own state, and only moved if it also sets up its own.
+    for (size_t i = 0; i < TrackSections.size(); i++) {
+        bool selfContained = scans[i].IsSelfContained(course);
+        bool nextSelfContained = (i + 1 == TrackSections.size()) || scans[i + 1].IsSelfContained(course);
+        TrackSections[i].bCullable = nextSelfContained;
+        TrackSections[i].bSortable =
+            nextSelfContained && selfContained && !scans[i].bTranslucent && scans[i].bHasVertices;
+    }
+
+    // Lower detail levels take the place of the section in the draw order, so they must need the same state.
+    // They may leave different state behind only if the next section sets up its own.
+    for (size_t i = 0; i < TrackSections.size(); i++) {
+        for (const auto& [lodModel, lodScan] : lods[i]) {
+            if ((lodModel == nullptr) || !TrackSections[i].bCullable ||
+                (lodScan.IsSelfContained(course) != scans[i].IsSelfContained(course)) ||
+                (lodScan.bTranslucent != scans[i].bTranslucent)) {
+                printf("[Course] A detail level of %s can't replace it, the section keeps full detail\n",
+                       TrackSections[i].Path.c_str());
+                TrackSections[i].LodModels.clear();
+                break;
+            }
+            TrackSections[i].LodModels.push_back(lodModel);
+        }
     }
 }
 
@@ -366,12 +608,41 @@ void Course::Render(struct UnkStruct_800DC5EC* arg0) {
             // d_course_big_donut_packed_dl_DE8
         }
 
-        TrackSectionsO2R* sections = (TrackSectionsO2R*) LOAD_ASSET_RAW(TrackSectionsPtr.c_str());
-        size_t size = ResourceGetSizeByName(TrackSectionsPtr.c_str());
-        for (size_t i = 0; i < (size / sizeof(TrackSectionsO2R)); i++) {
-            gSPDisplayList(gDisplayListHead++, (Gfx*) LOAD_ASSET_RAW(sections[i].addr.c_str()));
+        // Splitscreen viewports are usually planned by PrepareViewports already. A plan made from another
+        // camera is made again here.
+        FrustumView view;
+        bool hasView = Frustum_GetView(&view);
+        const f32* cameraPos = arg0->camera->pos;
+        SectionPlan& plan = _sectionPlans[hasView ? view.Viewport : 0];
+        if (!plan.bReady || !SectionPlanner::Matches(plan, hasView ? &view : nullptr, cameraPos)) {
+            SectionPlanner::Plan(TrackSections, hasView ? &view : nullptr, cameraPos, plan);
+        }
+        plan.bReady = false;
+        SectionPlanner::Apply(TrackSections, plan);
+        Frustum_AddCounts(plan.Drawn, plan.Culled);
+
+        for (Gfx* model : plan.Models) {
+            Lod::CountTriangles(Lod::GetTriangleCount(model));
         }
+        for (size_t i = 0; i < plan.Commands.size();) {
+            size_t count = std::min<size_t>(plan.Commands.size() - i, GFX_POOL_RESERVE);
+            GfxPool_Ensure();
+            memcpy(gDisplayListHead, &plan.Commands[i], count * sizeof(Gfx));
+            gDisplayListHead += count;
+            i += count;
+        }
+    }
+}
+
+void Course::PrepareViewports(const FrustumView* views, size_t count) {
+    for (SectionPlan& plan : _sectionPlans) {
+        plan.bReady = false;
+    }
+    if (TrackSectionsPtr.empty() || !gFrameSettings.ParallelViewports || (count < 2)) {
+        return;
     }
+    SectionPlanner::PlanViewports(TrackSections, views, std::min<size_t>(count, FRUSTUM_MAX_VIEWPORTS),
+                                  _sectionPlans, &GetJobSystem());
 }
 
 void Course::RenderCredits() {
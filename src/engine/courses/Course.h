@@ -7,6 +7,8 @@
 #ifdef __cplusplus
 #include "engine/objects/Lakitu.h"
 #include "port/resource/type/TrackSections.h"
+#include "engine/Lod.h"
+#include "engine/SectionPlan.h"
 extern "C" {
 #endif
 
@@ -288,10 +290,39 @@ typedef struct Properties {
 
 class World; // <-- Forward declare
 
+// Identifies the stock courses so that C code can check the current course with an integer compare
+enum class CourseType : uint8_t {
+    Custom,
+    MarioRaceway,
+    LuigiRaceway,
+    ChocoMountain,
+    BowsersCastle,
+    BansheeBoardwalk,
+    YoshiValley,
+    FrappeSnowland,
+    KoopaTroopaBeach,
+    RoyalRaceway,
+    MooMooFarm,
+    ToadsTurnpike,
+    KalimariDesert,
+    SherbetLand,
+    RainbowRoad,
+    WarioStadium,
+    BlockFort,
+    Skyscraper,
+    DoubleDeck,
+    DKJungle,
+    BigDonut,
+    PodiumCeremony,
+    Harbour,
+    TestCourse,
+};
+
 class Course {
 
 public:
     std::string Id;
+    CourseType Type = CourseType::Custom; // Set by the stock course constructors
     Properties Props;
 
     // This allows multiple water levels in a map.
@@ -307,6 +338,10 @@ public:
     std::string TrackSectionsPtr;
     bool bIsMod = false;
 
+    // A section of an O2R track, measured by ParseCourseSections
+    using TrackSection = ::TrackSection;
+    std::vector<TrackSection> TrackSections;
+
     virtual ~Course() = default;
 
     explicit Course();
@@ -335,6 +370,9 @@ public:
     virtual void WhatDoesThisDoAI(Player*, int8_t);
     virtual void SetStaffGhost();
     virtual void Render(struct UnkStruct_800DC5EC*);
+    // Plans the track sections of every splitscreen viewport at once, ahead of Render drawing each of them.
+    // views[i] is the view of viewport i.
+    void PrepareViewports(const FrustumView* views, size_t count);
     virtual void RenderCredits();
     virtual void Waypoints(Player* player, int8_t playerId);
     virtual f32 GetWaterLevel(FVector pos, Collision* collision);
@@ -346,6 +384,7 @@ public:
 
   private:
     void Init();
+    SectionPlan _sectionPlans[FRUSTUM_MAX_VIEWPORTS];
 };
 
 #endif
@@ -69,6 +69,7 @@ const course_texture dks_jungle_parkway_textures[] = {
 };
 
 DKJungle::DKJungle() {
+    Type = CourseType::DKJungle;
     this->vtx = d_course_dks_jungle_parkway_vertex;
     this->gfx = d_course_dks_jungle_parkway_packed_dls;
     this->gfxSize = 4997;
@@ -39,6 +39,7 @@ const course_texture double_deck_textures[] = {
 };
 
 DoubleDeck::DoubleDeck() {
+    Type = CourseType::DoubleDeck;
     this->vtx = d_course_double_deck_vertex;
     this->gfx = d_course_double_deck_packed_dls;
     this->gfxSize = 699;
@@ -48,6 +48,7 @@ const course_texture frappe_snowland_textures[] = {
 };
 
 FrappeSnowland::FrappeSnowland() {
+    Type = CourseType::FrappeSnowland;
     this->vtx = d_course_frappe_snowland_vertex;
     this->gfx = d_course_frappe_snowland_packed_dls;
     this->gfxSize = 4140;
@@ -517,6 +517,7 @@ TrackPathPoint harbour_path[] = {
 };
 
 Harbour::Harbour() {
+    Type = CourseType::Harbour;
     this->gfxSize = 100;
     this->textures = NULL;
     Props.Minimap.Texture = minimap_mario_raceway;
@@ -53,6 +53,7 @@ const course_texture kalimari_desert_textures[] = {
 };
 
 KalimariDesert::KalimariDesert() {
+    Type = CourseType::KalimariDesert;
     this->vtx = d_course_kalimari_desert_vertex;
     this->gfx = d_course_kalimari_desert_packed_dls;
     this->gfxSize = 5328;
@@ -58,6 +58,7 @@ const course_texture koopa_troopa_beach_textures[] = {
 };
 
 KoopaTroopaBeach::KoopaTroopaBeach() {
+    Type = CourseType::KoopaTroopaBeach;
     this->vtx = d_course_koopa_troopa_beach_vertex;
     this->gfx = d_course_koopa_troopa_beach_packed_dls;
     this->gfxSize = 5720;
@@ -85,6 +85,7 @@ const course_texture luigi_raceway_textures[] = {
 };
 
 LuigiRaceway::LuigiRaceway() {
+    Type = CourseType::LuigiRaceway;
     this->vtx = d_course_luigi_raceway_vertex;
     this->gfx = d_course_luigi_raceway_packed_dls;
     this->gfxSize = 6377;
@@ -5,6 +5,7 @@
 
 #include "MarioRaceway.h"
 #include "World.h"
+#include "port/FrameSettings.h"
 #include "engine/actors/Finishline.h"
 #include "engine/objects/Object.h"
 #include "engine/objects/BombKart.h"
@@ -71,6 +72,7 @@ const course_texture mario_raceway_textures[] = {
 };
 
 MarioRaceway::MarioRaceway() {
+    Type = CourseType::MarioRaceway;
     this->vtx = d_course_mario_raceway_vertex;
     this->gfx = d_course_mario_raceway_packed_dls;
     this->gfxSize = 3367;
@@ -162,7 +164,7 @@ void MarioRaceway::Load() {
         // d_course_mario_raceway_packed_dl_8E8
         generate_collision_mesh_with_defaults(segmented_gfx_to_virtual((void*)0x070008E8));
     } else {
-        if (CVarGetInteger("gDisableLod", 1) == true) {
+        if (gFrameSettings.DisableLod == true) {
             generate_collision_mesh_with_defaults(segmented_gfx_to_virtual((void*)0x070008E8));
         } else {
             // d_course_mario_raceway_packed_dl_2D68
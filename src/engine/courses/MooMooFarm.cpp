@@ -71,6 +71,7 @@ const course_texture moo_moo_farm_textures[] = {
 };
 
 MooMooFarm::MooMooFarm() {
+    Type = CourseType::MooMooFarm;
     this->vtx = d_course_moo_moo_farm_vertex;
     this->gfx = d_course_moo_moo_farm_packed_dls;
     this->gfxSize = 3304;
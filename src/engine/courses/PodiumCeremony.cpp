@@ -88,6 +88,7 @@ const course_texture podium_ceremony_textures[] = {
 };
 
 PodiumCeremony::PodiumCeremony() {
+    Type = CourseType::PodiumCeremony;
     this->vtx = d_course_royal_raceway_vertex;
     this->gfx = d_course_royal_raceway_packed_dls;
     this->gfxSize = 5670;
@@ -45,6 +45,7 @@ const course_texture rainbow_road_textures[] = {
 
 
 RainbowRoad::RainbowRoad() {
+    Type = CourseType::RainbowRoad;
     this->vtx = d_course_rainbow_road_vertex;
     this->gfx = d_course_rainbow_road_packed_dls;
     this->gfxSize = 5670;
@@ -83,6 +83,7 @@ const course_texture royal_raceway_textures[] = {
 };
 
 RoyalRaceway::RoyalRaceway() {
+    Type = CourseType::RoyalRaceway;
     this->vtx = d_course_royal_raceway_vertex;
     this->gfx = d_course_royal_raceway_packed_dls;
     this->gfxSize = 5670;
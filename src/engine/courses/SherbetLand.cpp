@@ -45,6 +45,7 @@ const course_texture sherbet_land_textures[] = {
 };
 
 SherbetLand::SherbetLand() {
+    Type = CourseType::SherbetLand;
     this->vtx = d_course_sherbet_land_vertex;
     this->gfx = d_course_sherbet_land_packed_dls;
     this->gfxSize = 1803;
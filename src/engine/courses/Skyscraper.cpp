@@ -60,6 +60,7 @@ const course_texture skyscraper_textures[] = {
 };
 
 Skyscraper::Skyscraper() {
+    Type = CourseType::Skyscraper;
     this->vtx = d_course_skyscraper_vertex;
     this->gfx = d_course_skyscraper_packed_dls;
     this->gfxSize = 548;
@@ -59,6 +59,7 @@ extern "C" {
 }
 
 TestCourse::TestCourse() {
+    Type = CourseType::TestCourse;
     this->gfxSize = 100;
     this->textures = NULL;
     Props.Minimap.Texture = minimap_mario_raceway;
@@ -8,10 +8,7 @@
 #include "engine/objects/BombKart.h"
 #include "assets/toads_turnpike_data.h"
 #include "engine/actors/Finishline.h"
-#include "engine/vehicles/Bus.h"
-#include "engine/vehicles/Car.h"
-#include "engine/vehicles/Truck.h"
-#include "engine/vehicles/TankerTruck.h"
+#include "engine/vehicles/Traffic.h"
 
 #include "engine/vehicles/Utils.h"
 
@@ -66,6 +63,7 @@ const course_texture toads_turnpike_textures[] = {
 };
 
 ToadsTurnpike::ToadsTurnpike() {
+    Type = CourseType::ToadsTurnpike;
     this->vtx = d_course_toads_turnpike_vertex;
     this->gfx = d_course_toads_turnpike_packed_dls;
     this->gfxSize = 3427;
@@ -191,22 +189,22 @@ void ToadsTurnpike::BeginPlay() {
 
         for (size_t i = 0; i < _numTrucks; i++) {
             waypoint = CalculateWaypointDistribution(i, _numTrucks, gPathCountByPathIndex[0], 0);
-            gWorldInstance.AddActor(new ATruck(a, b,  &gTrackPaths[0][0], waypoint));
+            gWorldInstance.Traffic.Add(TrafficKind::Truck, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numBuses; i++) {
             waypoint = CalculateWaypointDistribution(i, _numBuses, gPathCountByPathIndex[0], 75);
-            gWorldInstance.AddActor(new ABus(a, b, &gTrackPaths[0][0], waypoint));
+            gWorldInstance.Traffic.Add(TrafficKind::Bus, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numTankerTrucks; i++) {
             waypoint = CalculateWaypointDistribution(i, _numTankerTrucks, gPathCountByPathIndex[0], 50);
-            gWorldInstance.AddActor(new ATankerTruck(a, b, &gTrackPaths[0][0], waypoint));
+            gWorldInstance.Traffic.Add(TrafficKind::TankerTruck, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numCars; i++) {
             waypoint = CalculateWaypointDistribution(i, _numCars, gPathCountByPathIndex[0], 25);
-            gWorldInstance.AddActor(new ACar(a, b, &gTrackPaths[0][0], waypoint));
+            gWorldInstance.Traffic.Add(TrafficKind::Car, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         if (gModeSelection == VERSUS) {
@@ -62,6 +62,7 @@ const course_texture wario_stadium_textures[] = {
 };
 
 WarioStadium::WarioStadium() {
+    Type = CourseType::WarioStadium;
     this->vtx = d_course_wario_stadium_vertex;
     this->gfx = d_course_wario_stadium_packed_dls;
     this->gfxSize = 5272;
@@ -56,6 +56,7 @@ const course_texture yoshi_valley_textures[] = {
 };
 
 YoshiValley::YoshiValley() {
+    Type = CourseType::YoshiValley;
     this->vtx = d_course_yoshi_valley_vertex;
     this->gfx = d_course_yoshi_valley_packed_dls;
     this->gfxSize = 4140;
@@ -3,6 +3,10 @@
 #include <libultraship/libultraship.h>
 #include <libultra/gbi.h>
 #include "Matrix.h"
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include "port/Game.h"
 
 extern "C" {
 #include "main.h"
@@ -10,7 +14,101 @@ extern "C" {
 }
 
 namespace Editor {
+    // Meshes by the display list they were extracted from. Objects own them, so a mesh goes away with its last object.
+    std::unordered_map<const Gfx*, std::weak_ptr<const std::vector<Triangle>>> gCollisionMeshCache;
+
+    std::vector<Triangle> ExtractTriangles(Gfx* model) {
+        std::vector<Triangle> triangles;
+        ForEachModelTriangle(model, [&triangles](const Triangle& tri) { triangles.push_back(tri); });
+        triangles.shrink_to_fit();
+        return triangles;
+    }
+
+    std::shared_ptr<const std::vector<Triangle>> GetCollisionMesh(Gfx* model) {
+        if (model == nullptr) {
+            return nullptr;
+        }
+        auto& cached = gCollisionMeshCache[model];
+        auto mesh = cached.lock();
+        if (mesh == nullptr) {
+            mesh = std::make_shared<const std::vector<Triangle>>(ExtractTriangles(model));
+            cached = mesh;
+        }
+        return mesh;
+    }
+
+    void ClearCollisionMeshCache() {
+        gCollisionMeshCache.clear();
+    }
+
     void GenerateCollisionMesh(GameObject* object, Gfx* model, float scale) {
+        object->Triangles = GetCollisionMesh(model);
+    }
+
+    void RunCollisionMeshTest(size_t copies) {
+        using Clock = std::chrono::steady_clock;
+        std::unordered_set<Gfx*> models;
+        std::unordered_set<const std::vector<Triangle>*> meshes;
+        size_t sharedBytes = 0;
+        size_t copiedBytes = 0;
+
+        for (const auto* object : gEditor.eGameObjects) {
+            if (object->Model != nullptr) {
+                models.insert(object->Model);
+            }
+            if ((object->Triangles != nullptr) && meshes.insert(object->Triangles.get()).second) {
+                sharedBytes += object->Triangles->size() * sizeof(Triangle);
+            }
+            copiedBytes += object->GetTriangles().size() * sizeof(Triangle);
+        }
+        if (models.empty()) {
+            printf("[Collision] No editor objects with a model. Load a track with the editor enabled first.\n");
+            return;
+        }
+        printf("[Collision] %zu editor objects over %zu meshes: %zu KB shared, %zu KB as a copy per object\n",
+               gEditor.eGameObjects.size(), meshes.size(), sharedBytes / 1024, copiedBytes / 1024);
+
+        // Every model placed again and again, like a track full of the same tree
+        std::vector<std::vector<Triangle>> copied;
+        auto start = Clock::now();
+        for (Gfx* model : models) {
+            for (size_t i = 0; i < copies; i++) {
+                copied.push_back(ExtractTriangles(model));
+            }
+        }
+        auto copiedTime = Clock::now() - start;
+        copiedBytes = 0;
+        for (const auto& triangles : copied) {
+            copiedBytes += triangles.capacity() * sizeof(Triangle);
+        }
+
+        // Starts from an empty cache, so the first copy of each model is extracted too
+        auto cache = std::move(gCollisionMeshCache);
+        std::vector<std::shared_ptr<const std::vector<Triangle>>> shared;
+        gCollisionMeshCache.clear();
+        start = Clock::now();
+        for (Gfx* model : models) {
+            for (size_t i = 0; i < copies; i++) {
+                shared.push_back(GetCollisionMesh(model));
+            }
+        }
+        auto sharedTime = Clock::now() - start;
+        gCollisionMeshCache = std::move(cache);
+        meshes.clear();
+        sharedBytes = 0;
+        for (const auto& mesh : shared) {
+            if (meshes.insert(mesh.get()).second) {
+                sharedBytes += mesh->capacity() * sizeof(Triangle);
+            }
+        }
+
+        auto ms = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+        printf("[Collision] %zu copies of %zu models: extracting each copy took %.2f ms and %zu KB, sharing took "
+               "%.2f ms and %zu KB\n",
+               copies, models.size(), ms(copiedTime), copiedBytes / 1024, ms(sharedTime), sharedBytes / 1024);
+    }
+
+    void ForEachModelTriangle(Gfx* model, const std::function<void(const Triangle&)>& fn) {
         int8_t opcode;
         uintptr_t lo;
         uintptr_t hi;
@@ -27,15 +125,15 @@ namespace Editor {
             opcode = (EDITOR_GFX_GET_OPCODE(lo) >> 24);
             switch(opcode) {
                 case G_DL:
-                    GenerateCollisionMesh(object, (Gfx*)hi, scale);
+                    ForEachModelTriangle((Gfx*)hi, fn);
                     break;
                 case G_DL_OTR_HASH:
                     ptr++;
-                    GenerateCollisionMesh(object, (Gfx*)ResourceGetDataByCrc(((uint64_t)(ptr->words.w0 << 32)) + ptr->words.w1), scale);
+                    ForEachModelTriangle((Gfx*)ResourceGetDataByCrc(((uint64_t)(ptr->words.w0 << 32)) + ptr->words.w1), fn);
                     break;
                 case G_DL_OTR_FILEPATH:
                    // printf("otr filepath: %s\n", (const char*)hi);
-                    GenerateCollisionMesh(object, (Gfx*)ResourceGetDataByName((const char*)hi), scale);
+                    ForEachModelTriangle((Gfx*)ResourceGetDataByName((const char*)hi), fn);
                     break;
                 case G_VTX:
                     vtx = (Vtx*)ptr->words.w1;
@@ -65,7 +163,7 @@ namespace Editor {
                     FVector p2 = FVector(vtx[v2].v.ob[0], vtx[v2].v.ob[1], vtx[v2].v.ob[2]);
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
+                    fn({p1, p2, p3});
                     break;
                 }
                 case G_TRI1_OTR: {
@@ -83,7 +181,7 @@ namespace Editor {
                     FVector p2 = FVector(vtx[v2].v.ob[0], vtx[v2].v.ob[1], vtx[v2].v.ob[2]);
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
+                    fn({p1, p2, p3});
 
                     break;
                 }
@@ -109,8 +207,8 @@ namespace Editor {
                     FVector p5 = FVector(vtx[v5].v.ob[0], vtx[v5].v.ob[1], vtx[v5].v.ob[2]);
                     FVector p6 = FVector(vtx[v6].v.ob[0], vtx[v6].v.ob[1], vtx[v6].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
-                    object->Triangles.push_back({p4, p5, p6});
+                    fn({p1, p2, p3});
+                    fn({p4, p5, p6});
                     break;
                 }
                 case G_QUAD: {
@@ -128,8 +226,8 @@ namespace Editor {
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
                     FVector p4 = FVector(vtx[v4].v.ob[0], vtx[v4].v.ob[1], vtx[v4].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
-                    object->Triangles.push_back({p1, p3, p4});
+                    fn({p1, p2, p3});
+                    fn({p1, p3, p4});
                     break;
                 }
                 case G_ENDDL:
@@ -2,6 +2,8 @@
 
 #include <libultraship/libultraship.h>
 #include <libultra/gbi.h>
+#include <functional>
+#include <memory>
 #include "GameObject.h"
 
 #include "EditorMath.h"
@@ -13,11 +15,23 @@
  * Proper vtx intersection tests are necessary for object picking
  * 
  * Therefore, generate a full collision mesh for actors
+ *
+ * A model's triangles are extracted once and shared by every object that draws it. Objects only keep a reference,
+ * and their position is applied when picking. The cache only holds meshes some object still uses, and it is dropped
+ * when resources are reloaded.
  */
 
 #define EDITOR_GFX_GET_OPCODE(var) ((uint32_t) ((var) & 0xFF000000))
 
 namespace Editor {
     void GenerateCollisionMesh(GameObject* object, Gfx* model, float scale);
+    // The triangles of a model, extracted the first time any object asks for them
+    std::shared_ptr<const std::vector<Triangle>> GetCollisionMesh(Gfx* model);
+    // Forgets every extracted mesh, for when the resources behind the models are reloaded
+    void ClearCollisionMeshCache();
+    // Times extracting the editor objects' models once per copy against sharing them, and prints the memory both use
+    void RunCollisionMeshTest(size_t copies);
+    // Calls fn for every triangle a model draws, in model space
+    void ForEachModelTriangle(Gfx* model, const std::function<void(const Triangle&)>& fn);
     void DebugCollision(GameObject* obj, FVector pos, IRotator rot, FVector scale, const std::vector<Triangle>& triangles);
 }
\ No newline at end of file
@@ -2,11 +2,13 @@
 #include <libultra/gbi.h>
 #include "../CoreMath.h"
 #include <libultra/types.h>
+#include <algorithm>
 #include "../World.h"
 
 #include "Editor.h"
 #include "Collision.h"
 #include "Light.h"
+#include "SceneManager.h"
 
 #include "port/Engine.h"
 #include <controller/controldevice/controller/mapping/keyboard/KeyboardScancodes.h>
@@ -14,6 +16,7 @@
 
 #include "engine/actors/Ship.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 
 extern "C" {
 #include "common_structs.h"
@@ -47,13 +50,15 @@ namespace Editor {
 
     void Editor::Tick() {
 
-        if (CVarGetInteger("gEditorEnabled", 0) == true) {
+        if (gFrameSettings.EditorEnabled == true) {
             bEditorEnabled = true;
         } else {
             bEditorEnabled = false;
             return;
         }
 
+        TickAutosave();
+
         auto wnd = GameEngine::Instance->context->GetWindow();
 
         static bool wasMouseDown = false;
@@ -146,6 +151,31 @@ namespace Editor {
         eGameObjects.clear();
     }
 
+    /**
+     * Removes editor objects that point into memory owned by an actor or object that is about to be freed.
+     */
+    void Editor::RemoveObject(const void* owner, size_t ownerSize) {
+        const char* begin = static_cast<const char*>(owner);
+        const char* end = begin + ownerSize;
+        auto pointsInto = [begin, end](const void* ptr) {
+            const char* p = static_cast<const char*>(ptr);
+            return (p >= begin) && (p < end);
+        };
+
+        auto removed = std::remove_if(eGameObjects.begin(), eGameObjects.end(), [&](GameObject* obj) {
+            if (!pointsInto(obj->Pos) && !pointsInto(obj->DespawnFlag)) {
+                return false;
+            }
+            if (eObjectPicker._selected == obj) {
+                eObjectPicker._selected = nullptr;
+                eObjectPicker.eGizmo._selected = nullptr;
+            }
+            delete obj;
+            return true;
+        });
+        eGameObjects.erase(removed, eGameObjects.end());
+    }
+
     void Editor::DeleteObject() {
         Gizmo* gizmo = &eObjectPicker.eGizmo;
 
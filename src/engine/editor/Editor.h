@@ -25,7 +25,7 @@ public:
     GameObject* AddObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, float collScale, GameObject::CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue);
     void AddLight(const char* name, FVector* pos, s8* rot);
     void ClearObjects();
-    void RemoveObject();
+    void RemoveObject(const void* owner, size_t ownerSize);
     void SelectObjectFromSceneExplorer(GameObject* object);
     void SetLevelDimensions(s16 minX, s16 maxX, s16 minZ, s16 maxZ, s16 minY, s16 maxY);
     void ClearMatrixPool();
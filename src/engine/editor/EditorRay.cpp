@@ -0,0 +1,131 @@
+#include "EditorMath.h"
+
+#include <cfloat>
+#include <cmath>
+
+// The ray tests picking runs. They read no game state, so the headless checks build them without the engine.
+
+bool QueryCollisionRayActor(Vec3f rayOrigin, Vec3f rayDir, Vec3f actorMin, Vec3f actorMax, float* t) {
+    float tmin = -FLT_MAX, tmax = FLT_MAX;
+
+    for (size_t i = 0; i < 3; i++) {
+        if (fabs(rayDir[i]) > 1e-6f) { // Avoid division by zero
+            float t1 = (actorMin[i] - rayOrigin[i]) / rayDir[i];
+            float t2 = (actorMax[i] - rayOrigin[i]) / rayDir[i];
+
+            if (t1 > t2) { float temp = t1; t1 = t2; t2 = temp; }
+
+            tmin = fmax(tmin, t1);
+            tmax = fmin(tmax, t2);
+
+            if (tmax < tmin) return false; // No intersection
+        } else if (rayOrigin[i] < actorMin[i] || rayOrigin[i] > actorMax[i]) {
+            return false; // Ray is outside the slab
+        }
+    }
+
+    *t = tmin; // Distance to first intersection
+    return true;
+}
+
+bool IntersectRayTriangle(const Ray& ray, const Triangle& tri, float& t) {
+    constexpr float EPSILON = 1e-6f;
+
+    // Adjust the triangle vertices by the object's position
+    FVector v0 = tri.v0;
+    FVector v1 = tri.v1;
+    FVector v2 = tri.v2;
+
+    FVector edge1 = v1 - v0;
+    FVector edge2 = v2 - v0;
+    FVector h = ray.Direction.Cross(edge2);
+    float a = edge1.Dot(h);
+
+    if (std::abs(a) < EPSILON)
+        return false; // Ray is parallel to triangle
+
+    float f = 1.0f / a;
+    FVector s = ray.Origin - v0;
+    float u = f * s.Dot(h);
+
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    FVector q = s.Cross(edge1);
+    float v = f * ray.Direction.Dot(q);
+
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    t = f * edge2.Dot(q);
+    return t > EPSILON;
+}
+
+bool IntersectRayTriangleAndTransform(const Ray& ray, FVector pos, const Triangle& tri, float& t) {
+    constexpr float EPSILON = 1e-6f;
+
+    // Adjust the triangle vertices by the object's position
+    FVector v0 = tri.v0 + pos;
+    FVector v1 = tri.v1 + pos;
+    FVector v2 = tri.v2 + pos;
+
+    FVector edge1 = v1 - v0;
+    FVector edge2 = v2 - v0;
+    FVector h = ray.Direction.Cross(edge2);
+    float a = edge1.Dot(h);
+
+    if (std::abs(a) < EPSILON)
+        return false; // Ray is parallel to triangle
+
+    float f = 1.0f / a;
+    FVector s = ray.Origin - v0;
+    float u = f * s.Dot(h);
+
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    FVector q = s.Cross(edge1);
+    float v = f * ray.Direction.Dot(q);
+
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    t = f * edge2.Dot(q);
+    return t > EPSILON;
+}
+
+bool IntersectRaySphere(const Ray& ray, const FVector& sphereCenter, float radius, float& t) {
+    const float EPSILON = 1e-6f;
+
+    // Vector from ray origin to sphere center
+    FVector oc = ray.Origin - sphereCenter;
+
+    // Quadratic equation coefficients
+    float a = ray.Direction.Dot(ray.Direction);
+    float b = 2.0f * oc.Dot(ray.Direction);
+    float c = oc.Dot(oc) - (radius * radius);
+
+    // Compute discriminant
+    float discriminant = (b * b) - (4 * a * c);
+
+    // No intersection if discriminant is negative
+    if (discriminant < 0) {
+        return false;
+    }
+
+    // Compute nearest intersection point
+    float sqrtD = sqrtf(discriminant);
+    float t0 = (-b - sqrtD) / (2.0f * a);
+    float t1 = (-b + sqrtD) / (2.0f * a);
+
+    // Select the closest valid intersection
+    if (t0 > EPSILON) {
+        t = t0;
+        return true;
+    } else if (t1 > EPSILON) {
+        t = t1;
+        return true;
+    }
+
+    return false; // Sphere is behind the ray origin
+}
@@ -3,7 +3,7 @@
 
 namespace Editor {
 
-    GameObject::GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::vector<Triangle> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue) {
+    GameObject::GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::shared_ptr<const std::vector<Triangle>> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue) {
         Name = name;
         Pos = pos;
         Rot = rot;
@@ -23,6 +23,11 @@ namespace Editor {
 
     GameObject::GameObject() {};
 
+    const std::vector<Triangle>& GameObject::GetTriangles() const {
+        static const std::vector<Triangle> sNone;
+        return (Triangles != nullptr) ? *Triangles : sNone;
+    }
+
     void GameObject::Draw(){};
 
     void GameObject::Tick(){};
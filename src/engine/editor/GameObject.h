@@ -5,6 +5,7 @@
 #include <libultra/types.h>
 #include "../CoreMath.h"
 #include "EditorMath.h"
+#include <memory>
 #include <vector>
 
 extern "C" {
@@ -22,19 +23,22 @@ public:
             BOUNDING_SPHERE
         };
 
-        GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::vector<Triangle> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue);
+        GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::shared_ptr<const std::vector<Triangle>> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue);
         GameObject(FVector* pos, Vec3s* rot);
         GameObject();
         virtual void Tick();
         virtual void Draw();
         virtual void Load() {};
 
+        // The collision triangles in model space, or none
+        const std::vector<Triangle>& GetTriangles() const;
+
         const char* Name;
         FVector* Pos;
         IRotator* Rot;
         FVector* Scale;
         Gfx* Model;
-        std::vector<Triangle> Triangles;
+        std::shared_ptr<const std::vector<Triangle>> Triangles; // Shared with every object drawing the same model
         CollisionType Collision;
         float BoundingBoxSize;
         int32_t* DespawnFlag;
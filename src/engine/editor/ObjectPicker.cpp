@@ -11,6 +11,7 @@
 
 #include "engine/actors/Ship.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include "Gizmo.h"
 
 #include "EditorMath.h"
@@ -100,19 +101,19 @@ void ObjectPicker::DragHandle() {
 
     switch(static_cast<Gizmo::TranslationMode>(CVarGetInteger("eGizmoMode", 0))) {
         case Gizmo::TranslationMode::Move:
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueCollision.GetTriangles());
             break;
         case Gizmo::TranslationMode::Rotate:
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_RedX, eGizmo.RedRotateCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenRotateCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueRotateCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_RedX, eGizmo.RedRotateCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenRotateCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueRotateCollision.GetTriangles());
             break;
         case Gizmo::TranslationMode::Scale:
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedScaleCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenScaleCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueScaleCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedScaleCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenScaleCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueScaleCollision.GetTriangles());
             break;
 
     }
@@ -147,61 +148,10 @@ void ObjectPicker::Draw() {
 }
 
 void ObjectPicker::FindObject(Ray ray, std::vector<GameObject*> objects) {
-    bool found = false;
-    GameObject* closestObject = nullptr;
-    float closestDistance = FLT_MAX;
-
-    for (auto& object : objects) {
-        float boundingBox = object->BoundingBoxSize;
-        if (boundingBox == 0.0f) {
-            boundingBox = 2.0f;
-        }
-
-        switch(object->Collision) {
-            case GameObject::CollisionType::VTX_INTERSECT:
-                for (const auto& tri : object->Triangles) {
-                    float t;
-                    if (IntersectRayTriangleAndTransform(ray, *object->Pos, tri, t)) {
-                        if (t < closestDistance) {
-                            closestDistance = t;
-                            closestObject = object;
-                            printf("SELECTED OBJECT\n");
-                        }
-                    }
-                }
-                break;
-            case GameObject::CollisionType::BOUNDING_BOX: {
-                float max = 2.0f;
-                float min = -2.0f;
-                Vec3f boxMin = { object->Pos->x + boundingBox * min, 
-                                 object->Pos->y + boundingBox * min,
-                                 object->Pos->z + boundingBox * min };
-
-                Vec3f boxMax = { object->Pos->x + boundingBox * max, 
-                                 object->Pos->y + boundingBox * max, 
-                                 object->Pos->z + boundingBox * max };
-                float t;
-                if (QueryCollisionRayActor(&ray.Origin.x, &ray.Direction.x, boxMin, boxMax, &t)) {
-                    if (t < closestDistance) {
-                        closestDistance = t;
-                        closestObject = object;
-                        printf("FOUND BOUNDING BOX OBJECT\n");
-                    }
-                    break;
-                }
-                break;
-            }
-            case GameObject::CollisionType::BOUNDING_SPHERE:
-                printf("Editor::ObjectPicker.cpp Bounding sphere collision type not yet supported\n");
-                break;
-        }
-    }
-    if (closestObject != nullptr) {
-        _selected = closestObject;
-       // printf("FOUND COLLISION %d\n", type);
+    if (gFrameSettings.PickingBvh) {
+        _selected = _tree.FindObject(ray, objects);
     } else {
-       // printf("NO COLLISION\n");
-        _selected = nullptr;
+        _selected = FindObjectBruteForce(ray, objects);
     }
 }
 }
@@ -5,6 +5,7 @@
 #include "Collision.h"
 #include "Gizmo.h"
 #include "GameObject.h"
+#include "PickingBvh.h"
 
 namespace Editor {
     class ObjectPicker {
@@ -20,6 +21,7 @@ namespace Editor {
     private:
         bool _draw = false;
         GameObject* _lastSelected;
+        PickingTree _tree;
         s32 Inverse(MtxF* src, MtxF* dest);
         void Copy(MtxF* src, MtxF* dest);
         void Clear(MtxF* mf);
@@ -0,0 +1,486 @@
+#include <libultraship/libultraship.h>
+#include <libultra/gbi.h>
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+#include "PickingBvh.h"
+
+namespace Editor {
+
+namespace {
+
+constexpr uint32_t kMaxLeafTriangles = 4;
+constexpr uint32_t kMaxLeafObjects = 2;
+// Refitting stops paying off once the inner nodes have grown this much
+constexpr float kRebuildGrowth = 2.0f;
+
+PickBounds EmptyBounds() {
+    return { FVector(FLT_MAX, FLT_MAX, FLT_MAX), FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX) };
+}
+
+void Grow(PickBounds& bounds, const FVector& point) {
+    bounds.Min = FVector(std::min(bounds.Min.x, point.x), std::min(bounds.Min.y, point.y),
+                         std::min(bounds.Min.z, point.z));
+    bounds.Max = FVector(std::max(bounds.Max.x, point.x), std::max(bounds.Max.y, point.y),
+                         std::max(bounds.Max.z, point.z));
+}
+
+void Grow(PickBounds& bounds, const PickBounds& other) {
+    Grow(bounds, other.Min);
+    Grow(bounds, other.Max);
+}
+
+// Widens bounds around triangles, so the float error of the triangle test never lands a hit outside them
+PickBounds Padded(const PickBounds& bounds) {
+    auto pad = [](float value) { return 0.01f + std::abs(value) * 1e-5f; };
+
+    return { FVector(bounds.Min.x - pad(bounds.Min.x), bounds.Min.y - pad(bounds.Min.y),
+                     bounds.Min.z - pad(bounds.Min.z)),
+             FVector(bounds.Max.x + pad(bounds.Max.x), bounds.Max.y + pad(bounds.Max.y),
+                     bounds.Max.z + pad(bounds.Max.z)) };
+}
+
+float Area(const PickBounds& bounds) {
+    FVector size = bounds.Max - bounds.Min;
+    return (size.x * size.y) + (size.y * size.z) + (size.z * size.x);
+}
+
+bool operator==(const PickBounds& a, const PickBounds& b) {
+    return (a.Min.x == b.Min.x) && (a.Min.y == b.Min.y) && (a.Min.z == b.Min.z) && (a.Max.x == b.Max.x) &&
+           (a.Max.y == b.Max.y) && (a.Max.z == b.Max.z);
+}
+
+FVector Inverse(const FVector& dir) {
+    return FVector(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+}
+
+// Where the ray enters bounds holding triangles, if it does before limit. A ray running along an axis is
+// tested against the slab itself, so no triangle it could hit is ever skipped.
+bool EntersBounds(const PickBounds& bounds, const FVector& origin, const FVector& dir, const FVector& inv,
+                  float limit, float& enter) {
+    const float* o = &origin.x;
+    const float* d = &dir.x;
+    const float* invDir = &inv.x;
+    const float* min = &bounds.Min.x;
+    const float* max = &bounds.Max.x;
+    float tmin = 0.0f;
+    float tmax = limit;
+
+    for (size_t i = 0; i < 3; i++) {
+        if (d[i] == 0.0f) {
+            if ((o[i] < min[i]) || (o[i] > max[i])) {
+                return false;
+            }
+            continue;
+        }
+        float t1 = (min[i] - o[i]) * invDir[i];
+        float t2 = (max[i] - o[i]) * invDir[i];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmax < tmin) {
+            return false;
+        }
+    }
+    enter = tmin;
+    return true;
+}
+
+// Where the ray enters bounds holding bounding box objects, tested like the boxes themselves. The test only
+// gets more lenient as the bounds grow, so bounds never miss a box inside them, nor enter later than it.
+bool EntersBoxBounds(const PickBounds& bounds, const Ray& ray, float& enter) {
+    PickBounds copy = bounds;
+    Ray rayCopy = ray;
+    return QueryCollisionRayActor(&rayCopy.Origin.x, &rayCopy.Direction.x, &copy.Min.x, &copy.Max.x, &enter);
+}
+
+// Brute force's box around a bounding box object
+PickBounds ObjectBox(const GameObject* object) {
+    float boundingBox = object->BoundingBoxSize;
+    if (boundingBox == 0.0f) {
+        boundingBox = 2.0f;
+    }
+    float max = 2.0f;
+    float min = -2.0f;
+    return { FVector(object->Pos->x + boundingBox * min, object->Pos->y + boundingBox * min,
+                     object->Pos->z + boundingBox * min),
+             FVector(object->Pos->x + boundingBox * max, object->Pos->y + boundingBox * max,
+                     object->Pos->z + boundingBox * max) };
+}
+
+// Sorts items [start, end) of order into a subtree, split at the median along the widest spread of centres
+void BuildNodes(std::vector<PickNode>& nodes, std::vector<uint32_t>& order, const std::vector<PickBounds>& items,
+                uint32_t start, uint32_t end, uint32_t maxLeaf) {
+    uint32_t index = nodes.size();
+    PickBounds bounds = EmptyBounds();
+    PickBounds centres = EmptyBounds();
+
+    nodes.push_back({});
+    for (uint32_t i = start; i < end; i++) {
+        const PickBounds& item = items[order[i]];
+        Grow(bounds, item);
+        Grow(centres, (item.Min + item.Max) * 0.5f);
+    }
+    nodes[index].Bounds = bounds;
+
+    if ((end - start) <= maxLeaf) {
+        nodes[index].Start = start;
+        nodes[index].Count = end - start;
+        return;
+    }
+
+    FVector spread = centres.Max - centres.Min;
+    size_t axis = 0;
+    if (spread.y > spread.x) {
+        axis = 1;
+    }
+    if (spread.z > (&spread.x)[axis]) {
+        axis = 2;
+    }
+    uint32_t mid = start + (end - start) / 2;
+    std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + end,
+                     [&items, axis](uint32_t a, uint32_t b) {
+                         return ((&items[a].Min.x)[axis] + (&items[a].Max.x)[axis]) <
+                                ((&items[b].Min.x)[axis] + (&items[b].Max.x)[axis]);
+                     });
+
+    BuildNodes(nodes, order, items, start, mid, maxLeaf);
+    nodes[index].Right = nodes.size();
+    BuildNodes(nodes, order, items, mid, end, maxLeaf);
+}
+
+float InnerArea(const std::vector<PickNode>& nodes) {
+    float area = 0.0f;
+    for (const auto& node : nodes) {
+        if (node.Count == 0) {
+            area += Area(node.Bounds);
+        }
+    }
+    return area;
+}
+
+} // namespace
+
+TriangleTree::TriangleTree(std::shared_ptr<const std::vector<Triangle>> mesh) : mMesh(std::move(mesh)) {
+    std::vector<PickBounds> items;
+
+    items.reserve(mMesh->size());
+    for (const auto& tri : *mMesh) {
+        PickBounds bounds = EmptyBounds();
+        Grow(bounds, tri.v0);
+        Grow(bounds, tri.v1);
+        Grow(bounds, tri.v2);
+        items.push_back(Padded(bounds));
+        mOrder.push_back(mOrder.size());
+    }
+    BuildNodes(mNodes, mOrder, items, 0, mOrder.size(), kMaxLeafTriangles);
+}
+
+bool TriangleTree::Intersect(const Ray& ray, const FVector& pos, float limit, float& t) const {
+    // The triangles stay in model space, and the ray moves into it instead
+    FVector origin = ray.Origin - pos;
+    FVector inv = Inverse(ray.Direction);
+    std::array<std::pair<uint32_t, float>, 64> stack;
+    size_t size = 0;
+    float closest = limit;
+    float enter;
+    bool hit = false;
+
+    if (!EntersBounds(mNodes[0].Bounds, origin, ray.Direction, inv, closest, enter)) {
+        return false;
+    }
+    stack[size++] = { 0, enter };
+
+    while (size > 0) {
+        auto [index, nodeEnter] = stack[--size];
+        if (nodeEnter > closest) {
+            continue;
+        }
+        const PickNode& node = mNodes[index];
+
+        if (node.Count > 0) {
+            for (uint32_t i = node.Start; i < node.Start + node.Count; i++) {
+                float triT;
+                // Tested in world space like brute force, so the distances match exactly
+                if (IntersectRayTriangleAndTransform(ray, pos, (*mMesh)[mOrder[i]], triT) && (triT <= closest) &&
+                    (!hit || (triT < t))) {
+                    t = triT;
+                    closest = triT;
+                    hit = true;
+                }
+            }
+            continue;
+        }
+
+        float enterLeft;
+        float enterRight;
+        bool left = EntersBounds(mNodes[index + 1].Bounds, origin, ray.Direction, inv, closest, enterLeft);
+        bool right = EntersBounds(mNodes[node.Right].Bounds, origin, ray.Direction, inv, closest, enterRight);
+
+        // The nearer child goes on top
+        if (left && right && (enterLeft > enterRight)) {
+            stack[size++] = { index + 1, enterLeft };
+            stack[size++] = { node.Right, enterRight };
+        } else {
+            if (right) {
+                stack[size++] = { node.Right, enterRight };
+            }
+            if (left) {
+                stack[size++] = { index + 1, enterLeft };
+            }
+        }
+    }
+    return hit;
+}
+
+bool TriangleTree::Matches(const std::shared_ptr<const std::vector<Triangle>>& mesh) const {
+    return mesh == mMesh;
+}
+
+const PickBounds& TriangleTree::GetBounds() const {
+    return mNodes[0].Bounds;
+}
+
+PickingTree::LeafType PickingTree::GetLeafType(const GameObject* object) {
+    if (object->Pos == nullptr) {
+        return LeafType::NONE;
+    }
+    switch (object->Collision) {
+        case GameObject::CollisionType::VTX_INTERSECT:
+            return object->GetTriangles().empty() ? LeafType::NONE : LeafType::MESH;
+        case GameObject::CollisionType::BOUNDING_BOX:
+            return LeafType::BOX;
+        default:
+            return LeafType::NONE;
+    }
+}
+
+std::shared_ptr<TriangleTree> PickingTree::GetModelTree(GameObject* object) {
+    // The tree holds on to its mesh, so the address can't be reused by another mesh while the tree is cached
+    auto& tree = mModels[object->Triangles.get()];
+    if (tree == nullptr) {
+        tree = std::make_shared<TriangleTree>(object->Triangles);
+    }
+    return tree;
+}
+
+// Recomputes a leaf's bounds from its object, returning whether they changed
+bool PickingTree::UpdateBounds(Leaf& leaf) {
+    PickBounds bounds;
+
+    switch (leaf.Type) {
+        case LeafType::MESH: {
+            const PickBounds& model = leaf.Tree->GetBounds();
+            bounds = Padded({ model.Min + *leaf.Object->Pos, model.Max + *leaf.Object->Pos });
+            break;
+        }
+        case LeafType::BOX:
+            bounds = ObjectBox(leaf.Object);
+            break;
+        default:
+            return false;
+    }
+    if (bounds == leaf.Bounds) {
+        return false;
+    }
+    leaf.Bounds = bounds;
+    return true;
+}
+
+void PickingTree::Rebuild(const std::vector<GameObject*>& objects) {
+    std::vector<PickBounds> items;
+
+    mLeaves.clear();
+    mOrder.clear();
+    mNodes.clear();
+    for (uint32_t i = 0; i < objects.size(); i++) {
+        GameObject* object = objects[i];
+        Leaf leaf = { object, GetLeafType(object), nullptr, EmptyBounds() };
+
+        if (leaf.Type == LeafType::MESH) {
+            leaf.Tree = GetModelTree(object);
+        }
+        UpdateBounds(leaf);
+        mLeaves.push_back(leaf);
+        items.push_back(leaf.Bounds);
+        if (leaf.Type != LeafType::NONE) {
+            mOrder.push_back(i);
+        }
+    }
+
+    // Drop the trees of models no object draws anymore
+    for (auto it = mModels.begin(); it != mModels.end();) {
+        it = (it->second.use_count() == 1) ? mModels.erase(it) : std::next(it);
+    }
+
+    if (!mOrder.empty()) {
+        BuildNodes(mNodes, mOrder, items, 0, mOrder.size(), kMaxLeafObjects);
+    }
+    for (size_t i = mNodes.size(); i-- > 0;) {
+        PickNode& node = mNodes[i];
+        if (node.Count > 0) {
+            node.HasBoxes = false;
+            node.HasMeshes = false;
+            for (uint32_t j = node.Start; j < node.Start + node.Count; j++) {
+                bool mesh = (mLeaves[mOrder[j]].Type == LeafType::MESH);
+                node.HasBoxes |= !mesh;
+                node.HasMeshes |= mesh;
+            }
+        } else {
+            node.HasBoxes = mNodes[i + 1].HasBoxes || mNodes[node.Right].HasBoxes;
+            node.HasMeshes = mNodes[i + 1].HasMeshes || mNodes[node.Right].HasMeshes;
+        }
+    }
+    mBuiltArea = InnerArea(mNodes);
+    mRebuilds++;
+}
+
+// Grows and shrinks every node around the leaves' current bounds. Children come after their parent, so
+// walking the nodes backwards finishes both children first.
+float PickingTree::Refit() {
+    float area = 0.0f;
+
+    for (size_t i = mNodes.size(); i-- > 0;) {
+        PickNode& node = mNodes[i];
+        node.Bounds = EmptyBounds();
+        if (node.Count > 0) {
+            for (uint32_t j = node.Start; j < node.Start + node.Count; j++) {
+                Grow(node.Bounds, mLeaves[mOrder[j]].Bounds);
+            }
+        } else {
+            Grow(node.Bounds, mNodes[i + 1].Bounds);
+            Grow(node.Bounds, mNodes[node.Right].Bounds);
+            area += Area(node.Bounds);
+        }
+    }
+    mRefits++;
+    return area;
+}
+
+void PickingTree::Sync(const std::vector<GameObject*>& objects) {
+    bool rebuild = (objects.size() != mLeaves.size());
+
+    for (size_t i = 0; !rebuild && (i < objects.size()); i++) {
+        const Leaf& leaf = mLeaves[i];
+        GameObject* object = objects[i];
+
+        rebuild = (leaf.Object != object) || (leaf.Type != GetLeafType(object)) ||
+                  ((leaf.Type == LeafType::MESH) && !leaf.Tree->Matches(object->Triangles));
+    }
+    if (rebuild) {
+        Rebuild(objects);
+        return;
+    }
+
+    // Objects move through the gizmo, and actors move on their own
+    bool moved = false;
+    for (auto& leaf : mLeaves) {
+        moved |= UpdateBounds(leaf);
+    }
+    if (moved && (Refit() > kRebuildGrowth * mBuiltArea)) {
+        Rebuild(objects);
+    }
+}
+
+GameObject* PickingTree::FindObject(const Ray& ray, const std::vector<GameObject*>& objects) {
+    Sync(objects);
+    if (mNodes.empty()) {
+        return nullptr;
+    }
+
+    FVector inv = Inverse(ray.Direction);
+    std::array<uint32_t, 64> stack;
+    size_t size = 0;
+    float closest = FLT_MAX;
+    uint32_t closestIndex = UINT32_MAX;
+
+    stack[size++] = 0;
+    while (size > 0) {
+        const PickNode& node = mNodes[stack[--size]];
+        float enter = FLT_MAX;
+        float meshEnter;
+        float boxEnter;
+        bool entered = false;
+
+        if (node.HasMeshes && EntersBounds(node.Bounds, ray.Origin, ray.Direction, inv, closest, meshEnter)) {
+            entered = true;
+            enter = meshEnter;
+        }
+        if (node.HasBoxes && EntersBoxBounds(node.Bounds, ray, boxEnter)) {
+            entered = true;
+            enter = std::min(enter, boxEnter);
+        }
+        // An object the same distance away still wins if it comes first, like in brute force
+        if (!entered || (enter > closest)) {
+            continue;
+        }
+
+        if (node.Count == 0) {
+            stack[size++] = node.Right;
+            stack[size++] = (&node - mNodes.data()) + 1;
+            continue;
+        }
+
+        for (uint32_t i = node.Start; i < node.Start + node.Count; i++) {
+            uint32_t index = mOrder[i];
+            const Leaf& leaf = mLeaves[index];
+            float t;
+            bool hit;
+
+            if (leaf.Type == LeafType::MESH) {
+                hit = leaf.Tree->Intersect(ray, *leaf.Object->Pos, closest, t);
+            } else {
+                hit = EntersBoxBounds(leaf.Bounds, ray, t);
+            }
+            if (hit && ((t < closest) || ((t == closest) && (index < closestIndex)))) {
+                closest = t;
+                closestIndex = index;
+            }
+        }
+    }
+    return (closestIndex != UINT32_MAX) ? objects[closestIndex] : nullptr;
+}
+
+GameObject* FindObjectBruteForce(const Ray& ray, const std::vector<GameObject*>& objects) {
+    GameObject* closestObject = nullptr;
+    float closestDistance = FLT_MAX;
+
+    for (auto& object : objects) {
+        if (object->Pos == nullptr) {
+            continue;
+        }
+        switch (object->Collision) {
+            case GameObject::CollisionType::VTX_INTERSECT:
+                for (const auto& tri : object->GetTriangles()) {
+                    float t;
+                    if (IntersectRayTriangleAndTransform(ray, *object->Pos, tri, t)) {
+                        if (t < closestDistance) {
+                            closestDistance = t;
+                            closestObject = object;
+                        }
+                    }
+                }
+                break;
+            case GameObject::CollisionType::BOUNDING_BOX: {
+                PickBounds box = ObjectBox(object);
+                Ray rayCopy = ray;
+                float t;
+                if (QueryCollisionRayActor(&rayCopy.Origin.x, &rayCopy.Direction.x, &box.Min.x, &box.Max.x, &t)) {
+                    if (t < closestDistance) {
+                        closestDistance = t;
+                        closestObject = object;
+                    }
+                }
+                break;
+            }
+            case GameObject::CollisionType::BOUNDING_SPHERE:
+                break;
+        }
+    }
+    return closestObject;
+}
+
+} // namespace Editor
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <libultraship/libultraship.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "GameObject.h"
+#include "EditorMath.h"
+
+/**
+ * @file Editor picking trees
+ *
+ * Picking used to cast the mouse ray against every triangle of every object.
+ * Objects are now kept in a tree of their bounds, and each model's triangles in a tree of their own.
+ * A model's tree is built once and shared by every object that draws the model.
+ * Picking only ever moves a model, so its tree stays in model space and the ray is moved into it instead.
+ *
+ * The object tree is refit when an object moved since the last pick, and rebuilt when objects come and go
+ * or refitting left it too loose. Hits are tested exactly like the brute force search, so both pick the same object.
+ */
+
+namespace Editor {
+    struct PickBounds {
+        FVector Min;
+        FVector Max;
+    };
+
+    struct PickNode {
+        PickBounds Bounds;
+        uint32_t Start; // First item of a leaf
+        uint32_t Count; // Items in a leaf, 0 for an inner node
+        uint32_t Right; // Second child of an inner node. The first child follows the node.
+        bool HasBoxes;
+        bool HasMeshes;
+    };
+
+    class TriangleTree {
+    public:
+        explicit TriangleTree(std::shared_ptr<const std::vector<Triangle>> mesh);
+
+        // Closest hit, no further than limit, on the model placed at pos
+        bool Intersect(const Ray& ray, const FVector& pos, float limit, float& t) const;
+        // Whether the tree was built from this mesh
+        bool Matches(const std::shared_ptr<const std::vector<Triangle>>& mesh) const;
+        const PickBounds& GetBounds() const;
+
+    private:
+        std::vector<PickNode> mNodes;
+        std::vector<uint32_t> mOrder; // Mesh triangles in the order the leaves cover them
+        std::shared_ptr<const std::vector<Triangle>> mMesh;
+    };
+
+    class PickingTree {
+    public:
+        // The object the brute force search would pick, or nullptr
+        GameObject* FindObject(const Ray& ray, const std::vector<GameObject*>& objects);
+
+        size_t GetRebuildCount() const { return mRebuilds; }
+        size_t GetRefitCount() const { return mRefits; }
+
+    private:
+        enum class LeafType {
+            NONE, // Nothing to hit, like a sphere or a model without triangles
+            BOX,
+            MESH
+        };
+
+        struct Leaf {
+            GameObject* Object;
+            LeafType Type;
+            std::shared_ptr<TriangleTree> Tree;
+            PickBounds Bounds;
+        };
+
+        static LeafType GetLeafType(const GameObject* object);
+
+        bool UpdateBounds(Leaf& leaf);
+        void Sync(const std::vector<GameObject*>& objects);
+        void Rebuild(const std::vector<GameObject*>& objects);
+        float Refit();
+        std::shared_ptr<TriangleTree> GetModelTree(GameObject* object);
+
+        std::vector<Leaf> mLeaves; // One per object, in the order they were passed
+        std::vector<uint32_t> mOrder;
+        std::vector<PickNode> mNodes;
+        float mBuiltArea = 0.0f;
+        size_t mRebuilds = 0;
+        size_t mRefits = 0;
+
+        // Model trees by the shared mesh they were built from
+        std::unordered_map<const std::vector<Triangle>*, std::shared_ptr<TriangleTree>> mModels;
+    };
+
+    // The original search, testing every triangle of every object
+    GameObject* FindObjectBruteForce(const Ray& ray, const std::vector<GameObject*>& objects);
+}
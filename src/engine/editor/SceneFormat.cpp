@@ -0,0 +1,385 @@
+#include "SceneFormat.h"
+
+#include <libultraship/libultraship.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "port/ShipUtils.h"
+
+#define SCENE_MAGIC 0x43534B53        // "SKSC"
+#define SCENE_RECORD_MAGIC 0x48434B53 // "SKCH"
+
+namespace Editor {
+
+namespace {
+
+enum RecordKind : uint32_t {
+    RECORD_VALUE = 1, // A top-level value
+    RECORD_ARRAY,     // A part of a top-level array
+    RECORD_ROOT,      // The whole scene, when it isn't an object
+    RECORD_COMMIT,    // The parts that make up the scene
+};
+
+// Magic, version, and the CRC32 and size of the JSON source, each a u32
+constexpr size_t kFileHeaderSize = 4 * sizeof(uint32_t);
+// Magic, kind, part, name size and payload size, each a u32
+constexpr size_t kRecordHeaderSize = 5 * sizeof(uint32_t);
+
+struct SceneChunk {
+    RecordKind Kind;
+    std::string Name;
+    uint32_t Part;
+    std::vector<uint8_t> Payload;
+};
+
+// A chunk where it lies in a loaded file
+struct ChunkView {
+    RecordKind Kind;
+    const uint8_t* Payload;
+    uint32_t Size;
+};
+
+void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[4];
+    memcpy(bytes, &value, 4);
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+uint32_t GetU32(const uint8_t* in) {
+    uint32_t value;
+    memcpy(&value, in, 4);
+    return value;
+}
+
+std::string ChunkKey(const std::string& name, uint32_t part) {
+    return name + '#' + std::to_string(part);
+}
+
+uint64_t HashChunk(const SceneChunk& chunk) {
+    uint64_t hash = 0xCBF29CE484222325ULL ^ chunk.Kind;
+
+    for (uint8_t byte : chunk.Payload) {
+        hash = (hash ^ byte) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+std::vector<SceneChunk> SplitScene(const nlohmann::json& scene) {
+    std::vector<SceneChunk> chunks;
+
+    if (!scene.is_object()) {
+        chunks.push_back({ RECORD_ROOT, "", 0, nlohmann::json::to_cbor(scene) });
+        return chunks;
+    }
+    for (auto it = scene.begin(); it != scene.end(); ++it) {
+        const nlohmann::json& value = it.value();
+        if (!value.is_array()) {
+            chunks.push_back({ RECORD_VALUE, it.key(), 0, nlohmann::json::to_cbor(value) });
+            continue;
+        }
+        // An empty array still gets a part, so it comes back as an array
+        for (size_t start = 0, part = 0; (start < value.size()) || (part == 0); start += SCENE_CHUNK_ELEMENTS, part++) {
+            size_t end = std::min<size_t>(value.size(), start + SCENE_CHUNK_ELEMENTS);
+            SceneChunk& chunk = chunks.emplace_back(SceneChunk{ RECORD_ARRAY, it.key(), (uint32_t) part, {} });
+
+            // The CBOR of a slice of the array, without copying the slice out of it
+            static_assert(SCENE_CHUNK_ELEMENTS < 0x100);
+            if (end - start < 24) {
+                chunk.Payload.push_back(0x80 | (end - start));
+            } else {
+                chunk.Payload.push_back(0x98);
+                chunk.Payload.push_back(end - start);
+            }
+            for (size_t i = start; i < end; i++) {
+                nlohmann::json::to_cbor(value[i], chunk.Payload);
+            }
+        }
+    }
+    return chunks;
+}
+
+void PutRecord(std::vector<uint8_t>& out, RecordKind kind, const std::string& name, uint32_t part,
+               const std::vector<uint8_t>& payload) {
+    size_t start = out.size();
+
+    PutU32(out, SCENE_RECORD_MAGIC);
+    PutU32(out, kind);
+    PutU32(out, part);
+    PutU32(out, name.size());
+    PutU32(out, payload.size());
+    out.insert(out.end(), name.begin(), name.end());
+    out.insert(out.end(), payload.begin(), payload.end());
+    PutU32(out, Ship_Crc32(out.data() + start, out.size() - start));
+}
+
+void PutChunk(std::vector<uint8_t>& out, const SceneChunk& chunk) {
+    PutRecord(out, chunk.Kind, chunk.Name, chunk.Part, chunk.Payload);
+}
+
+// Lists the kind, part and name of every chunk in the scene, in order
+void PutCommit(std::vector<uint8_t>& out, const std::vector<SceneChunk>& chunks) {
+    std::vector<uint8_t> parts;
+
+    for (const auto& chunk : chunks) {
+        PutU32(parts, chunk.Kind);
+        PutU32(parts, chunk.Part);
+        PutU32(parts, chunk.Name.size());
+        parts.insert(parts.end(), chunk.Name.begin(), chunk.Name.end());
+    }
+    PutRecord(out, RECORD_COMMIT, "", 0, parts);
+}
+
+std::vector<uint8_t> EncodeChunks(const std::vector<SceneChunk>& chunks, uint32_t sourceCrc = 0,
+                                  uint32_t sourceSize = 0) {
+    std::vector<uint8_t> data;
+
+    PutU32(data, SCENE_MAGIC);
+    PutU32(data, SCENE_VERSION);
+    PutU32(data, sourceCrc);
+    PutU32(data, sourceSize);
+    for (const auto& chunk : chunks) {
+        PutChunk(data, chunk);
+    }
+    PutCommit(data, chunks);
+    return data;
+}
+
+// Looks up the parts a commit lists among the chunks read so far. False if one is missing or malformed.
+bool ReadCommit(const uint8_t* payload, uint32_t size, const std::unordered_map<std::string, ChunkView>& chunks,
+                std::vector<std::pair<std::string, ChunkView>>& parts) {
+    size_t pos = 0;
+
+    parts.clear();
+    while (pos < size) {
+        if (size - pos < 3 * sizeof(uint32_t)) {
+            return false;
+        }
+        uint32_t kind = GetU32(payload + pos);
+        uint32_t part = GetU32(payload + pos + 4);
+        uint32_t nameSize = GetU32(payload + pos + 8);
+        pos += 3 * sizeof(uint32_t);
+        if (nameSize > size - pos) {
+            return false;
+        }
+        std::string name((const char*) payload + pos, nameSize);
+        pos += nameSize;
+
+        auto it = chunks.find(ChunkKey(name, part));
+        if ((it == chunks.end()) || (it->second.Kind != kind)) {
+            return false;
+        }
+        parts.emplace_back(name, it->second);
+    }
+    return true;
+}
+
+bool WriteFile(const std::string& path, const std::vector<uint8_t>& data, const char* mode) {
+    FILE* file = fopen(path.c_str(), mode);
+
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = (data.empty() || (fwrite(data.data(), 1, data.size(), file) == data.size())) && (fflush(file) == 0);
+    return (fclose(file) == 0) && written;
+}
+
+} // namespace
+
+std::vector<uint8_t> EncodeScene(const nlohmann::json& scene, const uint8_t* source, size_t sourceSize) {
+    uint32_t sourceCrc = (source != nullptr) ? Ship_Crc32(source, sourceSize) : 0;
+    return EncodeChunks(SplitScene(scene), sourceCrc, (uint32_t) sourceSize);
+}
+
+bool IsSceneFrom(const uint8_t* data, size_t size, const uint8_t* source, size_t sourceSize) {
+    if ((size < kFileHeaderSize) || (GetU32(data) != SCENE_MAGIC) || (GetU32(data + 4) != SCENE_VERSION)) {
+        return false;
+    }
+    // The size is compared first, so a changed file is usually found without reading it through
+    return (GetU32(data + 12) == sourceSize) && (GetU32(data + 8) == Ship_Crc32(source, sourceSize));
+}
+
+bool VisitScene(const uint8_t* data, size_t size, const SceneVisitor& visitor) {
+    if ((size < kFileHeaderSize) || (GetU32(data) != SCENE_MAGIC) || (GetU32(data + 4) != SCENE_VERSION)) {
+        return false;
+    }
+
+    // The latest copy of each chunk, and the parts of the last complete commit
+    std::unordered_map<std::string, ChunkView> chunks;
+    std::vector<std::pair<std::string, ChunkView>> committed;
+    std::vector<std::pair<std::string, ChunkView>> parts;
+    bool bCommitted = false;
+    size_t pos = kFileHeaderSize;
+
+    while (size - pos >= kRecordHeaderSize + sizeof(uint32_t)) {
+        const uint8_t* record = data + pos;
+        uint32_t kind = GetU32(record + 4);
+        uint32_t part = GetU32(record + 8);
+        uint32_t nameSize = GetU32(record + 12);
+        uint32_t payloadSize = GetU32(record + 16);
+        size_t left = size - pos - kRecordHeaderSize - sizeof(uint32_t);
+
+        // Anything past a record that was cut short or fails its checksum was never completely written
+        if ((GetU32(record) != SCENE_RECORD_MAGIC) || (nameSize > left) || (payloadSize > left - nameSize)) {
+            break;
+        }
+        size_t length = kRecordHeaderSize + nameSize + payloadSize;
+        if (GetU32(record + length) != Ship_Crc32(record, length)) {
+            break;
+        }
+        std::string name((const char*) record + kRecordHeaderSize, nameSize);
+        const uint8_t* payload = record + kRecordHeaderSize + nameSize;
+        pos += length + sizeof(uint32_t);
+
+        if (kind != RECORD_COMMIT) {
+            chunks[ChunkKey(name, part)] = { (RecordKind) kind, payload, payloadSize };
+            continue;
+        }
+        if (!ReadCommit(payload, payloadSize, chunks, parts)) {
+            break;
+        }
+        committed.swap(parts);
+        bCommitted = true;
+    }
+    if (!bCommitted) {
+        return false;
+    }
+
+    // Only one chunk is decoded at a time
+    try {
+        for (const auto& [name, view] : committed) {
+            nlohmann::json value = nlohmann::json::from_cbor(view.Payload, view.Payload + view.Size);
+            switch (view.Kind) {
+                case RECORD_ROOT:
+                    visitor(SceneValueKind::Root, name, value);
+                    break;
+                case RECORD_VALUE:
+                    visitor(SceneValueKind::Value, name, value);
+                    break;
+                case RECORD_ARRAY:
+                    visitor(SceneValueKind::ArrayPart, name, value);
+                    break;
+                default:
+                    return false;
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        printf("Editor::VisitScene(): Could not decode a chunk: %s\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool DecodeScene(const uint8_t* data, size_t size, nlohmann::json& scene) {
+    nlohmann::json result = nlohmann::json::object();
+
+    bool decoded = VisitScene(data, size, [&result](SceneValueKind kind, const std::string& name, nlohmann::json& value) {
+        switch (kind) {
+            case SceneValueKind::Root:
+                result = std::move(value);
+                break;
+            case SceneValueKind::Value:
+                result[name] = std::move(value);
+                break;
+            case SceneValueKind::ArrayPart: {
+                nlohmann::json& array = result[name];
+                if (array.is_null()) {
+                    array = nlohmann::json::array();
+                }
+                for (auto& element : value) {
+                    array.push_back(std::move(element));
+                }
+                break;
+            }
+        }
+    });
+    if (!decoded) {
+        return false;
+    }
+    scene = std::move(result);
+    return true;
+}
+
+SceneAutosave::SceneAutosave(std::string path) : mPath(std::move(path)) {
+}
+
+void SceneAutosave::SetBaseline(const nlohmann::json& scene) {
+    mWritten.clear();
+    for (const auto& chunk : SplitScene(scene)) {
+        mWritten[ChunkKey(chunk.Name, chunk.Part)] = HashChunk(chunk);
+    }
+    bStarted = false;
+}
+
+size_t SceneAutosave::Rewrite(const std::vector<uint8_t>& data) {
+    std::error_code error;
+    std::string tempPath = mPath + ".tmp";
+
+    // The autosave of an earlier session may be all that is left of it
+    if (!bStarted && std::filesystem::exists(mPath, error)) {
+        std::filesystem::rename(mPath, mPath + ".prev", error);
+    }
+    if (!WriteFile(tempPath, data, "wb")) {
+        return 0;
+    }
+    // Renamed over the old file, so a crash leaves one or the other
+    std::filesystem::rename(tempPath, mPath, error);
+    return error ? 0 : data.size();
+}
+
+size_t SceneAutosave::Save(const nlohmann::json& scene) {
+    std::vector<SceneChunk> chunks = SplitScene(scene);
+    std::unordered_map<std::string, uint64_t> hashes;
+    std::vector<bool> changed(chunks.size());
+    bool anyChanged = (chunks.size() != mWritten.size());
+
+    for (size_t i = 0; i < chunks.size(); i++) {
+        std::string key = ChunkKey(chunks[i].Name, chunks[i].Part);
+        uint64_t hash = HashChunk(chunks[i]);
+        auto it = mWritten.find(key);
+
+        changed[i] = (it == mWritten.end()) || (it->second != hash);
+        anyChanged |= changed[i];
+        hashes.emplace(std::move(key), hash);
+    }
+    if (!anyChanged) {
+        return 0;
+    }
+
+    std::error_code error;
+    std::vector<uint8_t> data;
+    size_t written;
+
+    // A new file, or one grown too long to be worth replaying, gets the whole scene
+    if (!bStarted || (mFileSize > SCENE_AUTOSAVE_GROWTH * mSceneSize) || !std::filesystem::exists(mPath, error)) {
+        data = EncodeChunks(chunks);
+        written = Rewrite(data);
+        mSceneSize = data.size();
+        mFileSize = 0;
+    } else {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (changed[i]) {
+                PutChunk(data, chunks[i]);
+            }
+        }
+        PutCommit(data, chunks);
+        written = WriteFile(mPath, data, "ab") ? data.size() : 0;
+    }
+    if (written == 0) {
+        printf("Editor::SceneAutosave: Could not write %s\n", mPath.c_str());
+        return 0;
+    }
+    bStarted = true;
+    mFileSize += written;
+    mWritten = std::move(hashes);
+    return written;
+}
+
+void SceneAutosave::Discard() {
+    std::error_code error;
+    std::filesystem::remove(mPath, error);
+    bStarted = false;
+}
+
+} // namespace Editor
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <libultraship/libultraship.h>
+#include <nlohmann/json.hpp>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file Binary scene format
+ *
+ * A scene is stored as chunks, one per top-level value of its JSON. Long arrays like the static mesh actors are
+ * split into parts of SCENE_CHUNK_ELEMENTS elements, so moving one actor only changes one part. Each chunk is a
+ * record with a name, a part number, a CBOR payload and a CRC32, and a commit record lists the parts that make up
+ * the scene.
+ *
+ * A scene file holds one commit. An autosave file appends the chunks that changed since the previous autosave,
+ * followed by a new commit. Reading either one returns the last complete commit, so an autosave cut short by a
+ * crash comes back as the one before it. Chunks are decoded straight from the buffer the file was loaded into.
+ * CBOR holds every JSON value exactly, so a scene exported back to JSON is the one that was imported.
+ *
+ * A scene file also records the CRC32 and size of the scene.json saved with it. A scene.json that was edited,
+ * exported or replaced since no longer matches, and is loaded instead.
+ */
+
+#define SCENE_VERSION 2
+#define SCENE_CHUNK_ELEMENTS 64
+// An autosave file is rewritten from scratch once it grows this many times the size of the scene
+#define SCENE_AUTOSAVE_GROWTH 4
+
+namespace Editor {
+    enum class SceneValueKind {
+        Root,      // The whole scene, when it isn't an object
+        Value,     // A top-level value
+        ArrayPart, // Up to SCENE_CHUNK_ELEMENTS elements of a top-level array, in order
+    };
+    using SceneVisitor = std::function<void(SceneValueKind kind, const std::string& name, nlohmann::json& value)>;
+
+    // Encodes a scene as a scene file, saved along with the JSON text source if there is one
+    std::vector<uint8_t> EncodeScene(const nlohmann::json& scene, const uint8_t* source = nullptr,
+                                     size_t sourceSize = 0);
+    // Whether a scene file was saved along with this JSON text
+    bool IsSceneFrom(const uint8_t* data, size_t size, const uint8_t* source, size_t sourceSize);
+    // Decodes the last complete commit of a scene or autosave file. False if there is none.
+    bool DecodeScene(const uint8_t* data, size_t size, nlohmann::json& scene);
+    // Decodes the last complete commit one chunk at a time, without building the whole scene. The visitor may
+    // already have been given some chunks when a later one fails to decode.
+    bool VisitScene(const uint8_t* data, size_t size, const SceneVisitor& visitor);
+
+    class SceneAutosave {
+    public:
+        explicit SceneAutosave(std::string path);
+
+        // Remembers a scene that was just saved, so the next autosave only writes what changed since
+        void SetBaseline(const nlohmann::json& scene);
+        // Writes the chunks that changed since the last autosave, returning the bytes written.
+        // The first autosave writes a new file and keeps the previous one as .prev.
+        size_t Save(const nlohmann::json& scene);
+        // Deletes the autosave, once the scene was saved for real
+        void Discard();
+        const std::string& GetPath() const { return mPath; }
+
+    private:
+        size_t Rewrite(const std::vector<uint8_t>& data);
+
+        std::string mPath;
+        std::unordered_map<std::string, uint64_t> mWritten; // Payload hash of each chunk in the last commit
+        bool bStarted = false;
+        size_t mFileSize = 0;
+        size_t mSceneSize = 0;
+    };
+}
@@ -3,11 +3,17 @@
 #include "CoreMath.h"
 #include "World.h"
 #include "GameObject.h"
+#include "Lod.h"
+#include "SceneFormat.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include "port/Engine.h"
+#include "port/FrameSettings.h"
 #include <libultraship/src/resource/type/Json.h>
 #include "port/resource/type/Minimap.h"
 #include <libultraship/src/resource/File.h>
@@ -18,48 +24,184 @@ namespace Editor {
     std::shared_ptr<Ship::Archive> CurrentArchive;
     std::string SceneFile = "";
 
-    void SaveLevel() {
-        auto props = gWorldInstance.CurrentCourse->Props;
+    namespace {
+        std::unique_ptr<SceneAutosave> sAutosave;
+        std::chrono::steady_clock::time_point sLastAutosave;
 
-        if ((CurrentArchive) && (!SceneFile.empty())) {
-            nlohmann::json data;
-    
-            data["Props"] = props.to_json();
+        // One autosave per scene file, kept outside the archives since it is appended to
+        SceneAutosave& GetAutosave() {
+            std::string name = SceneFile;
+            std::replace_if(name.begin(), name.end(), [](char c) { return (c == '/') || (c == '\\') || (c == ':'); },
+                            '_');
+            std::string path = Ship::Context::GetPathRelativeToAppDirectory("autosave/" + name + ".bin");
+
+            if ((sAutosave == nullptr) || (sAutosave->GetPath() != path)) {
+                std::error_code error;
+                std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+                sAutosave = std::make_unique<SceneAutosave>(path);
+                sAutosave->SetBaseline(SerializeLevel());
+                sLastAutosave = std::chrono::steady_clock::now();
+            }
+            return *sAutosave;
+        }
 
-            nlohmann::json staticMesh;
+        void ClearStaticMeshActors() {
+            for (auto* actor : gWorldInstance.StaticMeshActors) {
+                actor->bPendingDestroy = true;
+                gEditor.RemoveObject(actor, sizeof(StaticMeshActor));
+            }
+            gWorldInstance.DeleteStaticMeshActors();
+        }
 
-            for (const auto& mesh : gWorldInstance.StaticMeshActors) {
-                staticMesh.push_back(mesh->to_json());
+        bool ReadJsonFile(const std::string& path, nlohmann::json& data) {
+            auto file = GameEngine::Instance->context->GetResourceManager()->LoadFileProcess(path);
+            if ((file == nullptr) || (file->Buffer == nullptr)) {
+                return false;
+            }
+            try {
+                data = nlohmann::json::parse(file->Buffer->begin(), file->Buffer->end());
+            } catch (const nlohmann::json::exception& e) {
+                printf("SceneManager: Could not parse %s: %s\n", path.c_str(), e.what());
+                return false;
             }
-            data["StaticMeshActors"] = staticMesh;
+            return true;
+        }
+    }
 
-            // nlohmann::json actors;
+    nlohmann::json SerializeLevel() {
+        nlohmann::json data;
 
-            // for (const auto& actor : gWorldInstance.Actors) {
-            //     actors.push_back(actor->to_json());
-            // }
-            // data["Actors"] = actors;
+        data["Props"] = gWorldInstance.CurrentCourse->Props.to_json();
 
-            // nlohmann::json objects;
+        nlohmann::json staticMesh;
 
-            // for (const auto& object : gWorldInstance.Objects) {
-            //     objects.push_back(object->to_json());
-            // }
-            // data["Objects"] = objects;
+        for (const auto& mesh : gWorldInstance.StaticMeshActors) {
+            staticMesh.push_back(mesh->to_json());
+        }
+        data["StaticMeshActors"] = staticMesh;
 
-            try {
-                auto dat = data.dump();
-                std::vector<uint8_t> stringify;
-                stringify.assign(dat.begin(), dat.end());
-
-                bool wrote = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->WriteFile(CurrentArchive, SceneFile, stringify);
-                if (wrote) {
-                    printf("Successfully wrote scene file!\n  Wrote: %s\n", SceneFile.c_str());
-                } else {
-                    printf("Failed to write scene file!\n");
+        // Levels declared for the models in this track's directory
+        nlohmann::json modelLods = Lod::to_json(SceneFile.substr(0, SceneFile.find_last_of('/') + 1));
+        if (!modelLods.empty()) {
+            data["ModelLods"] = modelLods;
+        }
+
+        // nlohmann::json actors;
+
+        // for (const auto& actor : gWorldInstance.Actors) {
+        //     actors.push_back(actor->to_json());
+        // }
+        // data["Actors"] = actors;
+
+        // nlohmann::json objects;
+
+        // for (const auto& object : gWorldInstance.Objects) {
+        //     objects.push_back(object->to_json());
+        // }
+        // data["Objects"] = objects;
+
+        return data;
+    }
+
+    namespace {
+        // Applies the top-level values of a scene, either from a whole JSON scene or one chunk of a scene file
+        // at a time
+        class LevelApplier {
+        public:
+            explicit LevelApplier(Course* course) : mCourse(course) {
+            }
+
+            // value is a whole top-level value, or the next elements of a top-level array
+            void Apply(const std::string& name, const nlohmann::json& value) {
+                if (name == "Props") {
+                    bProps = true;
+                    try {
+                        mCourse->Props.from_json(value);
+                    } catch(const std::exception& e) {
+                        std::cerr << "SceneManager::LoadLevel() Error parsing track properties: " << e.what() << std::endl;
+                        std::cerr << "  Is your scene.json file out of date?" << std::endl;
+                    }
+                } else if (name == "StaticMeshActors") {
+                    if (!bActors) {
+                        bActors = true;
+                        ClearStaticMeshActors();  // Clear existing actors, if any
+                    }
+                    for (const auto& actorJson : value) {
+                        Load_AddStaticMeshActor(actorJson);
+                    }
+                } else if (name == "ModelLods") {
+                    // Detail levels are optional
+                    try {
+                        Lod::from_json(value);
+                    } catch(const std::exception& e) {
+                        std::cerr << "SceneManager::LoadLevel() Error parsing model detail levels: " << e.what() << std::endl;
+                    }
                 }
-            } catch (const nlohmann::json::exception& e) {
-                printf("SceneManager::SaveLevel():\n  JSON error during dump: %s\n", e.what());
+            }
+
+            void Finish() {
+                if (!bProps) {
+                    std::cerr << "Props data not found in the JSON file!" << std::endl;
+                }
+                if (!bActors) {
+                    std::cerr << "Actors data not found in the JSON file!" << std::endl;
+                }
+            }
+
+        private:
+            Course* mCourse;
+            bool bProps = false;
+            bool bActors = false;
+        };
+    }
+
+    void ApplyLevel(Course* course, const nlohmann::json& data) {
+        if (data.is_null() || data.empty()) {
+            return;
+        }
+
+        LevelApplier applier(course);
+        if (data.is_object()) {
+            for (auto it = data.begin(); it != data.end(); ++it) {
+                applier.Apply(it.key(), it.value());
+            }
+        }
+        applier.Finish();
+    }
+
+    std::string BinaryScenePath(const std::string& sceneFile) {
+        size_t dot = sceneFile.find_last_of('.');
+        size_t slash = sceneFile.find_last_of('/');
+        if ((dot == std::string::npos) || ((slash != std::string::npos) && (dot < slash))) {
+            return sceneFile + ".bin";
+        }
+        return sceneFile.substr(0, dot) + ".bin";
+    }
+
+    void SaveLevel() {
+        if ((CurrentArchive) && (!SceneFile.empty())) {
+            nlohmann::json data = SerializeLevel();
+            std::string binaryFile = BinaryScenePath(SceneFile);
+            auto archives = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager();
+
+            // scene.json stays current for tools that read it. The scene file records which JSON it was saved
+            // with, so an edit to the JSON alone is noticed when loading.
+            std::string text = data.dump();
+            std::vector<uint8_t> source(text.begin(), text.end());
+            if (!archives->WriteFile(CurrentArchive, SceneFile, source)) {
+                printf("Failed to write scene file!\n  Could not write: %s\n", SceneFile.c_str());
+                return;
+            }
+
+            bool wrote = archives->WriteFile(CurrentArchive, binaryFile, EncodeScene(data, source.data(), source.size()));
+            if (wrote) {
+                printf("Successfully wrote scene file!\n  Wrote: %s and %s\n", SceneFile.c_str(), binaryFile.c_str());
+                // The autosave is only needed until the next save
+                SceneAutosave& autosave = GetAutosave();
+                autosave.Discard();
+                autosave.SetBaseline(data);
+            } else {
+                printf("Failed to write scene file!\n");
             }
         } else {
             printf("Could not save scene file, SceneFile or CurrentArchive not set\n");
@@ -70,6 +212,35 @@ namespace Editor {
         SceneFile = sceneFile;
 
         if (archive && (course != nullptr)) {
+            auto resources = GameEngine::Instance->context->GetResourceManager();
+
+            // The scene file is applied one chunk at a time, straight from the loaded file, unless scene.json was
+            // changed after it was saved. Tracks saved before it existed only have JSON.
+            auto file = resources->LoadFileProcess(BinaryScenePath(sceneFile));
+            if ((file != nullptr) && (file->Buffer != nullptr)) {
+                const uint8_t* data = (const uint8_t*) file->Buffer->data();
+                size_t size = file->Buffer->size();
+                auto source = resources->LoadFileProcess(sceneFile);
+                bool bCurrent = (source == nullptr) || (source->Buffer == nullptr) ||
+                                IsSceneFrom(data, size, (const uint8_t*) source->Buffer->data(), source->Buffer->size());
+
+                if (bCurrent) {
+                    LevelApplier applier(course);
+                    bool applied = VisitScene(data, size, [&applier](SceneValueKind kind, const std::string& name,
+                                                                     nlohmann::json& value) {
+                        if (kind != SceneValueKind::Root) {
+                            applier.Apply(name, value);
+                        }
+                    });
+                    if (applied) {
+                        applier.Finish();
+                        return;
+                    }
+                }
+                printf("SceneManager::LoadLevel(): %s is %s, loading %s instead\n", BinaryScenePath(sceneFile).c_str(),
+                       bCurrent ? "damaged" : "older than the JSON", sceneFile.c_str());
+            }
+
             auto initData = std::make_shared<Ship::ResourceInitData>();
             initData->Parent = archive;
             initData->Format = RESOURCE_FORMAT_BINARY;
@@ -77,38 +248,89 @@ namespace Editor {
             initData->Type = static_cast<uint32_t>(Ship::ResourceType::Json);
             initData->ResourceVersion = 0;
 
-            nlohmann::json data = std::static_pointer_cast<Ship::Json>(
-                GameEngine::Instance->context->GetResourceManager()->LoadResource(sceneFile, true, initData))->Data;
-
-            if (data.is_null() || data.empty()) {
-                return;
+            auto json = std::static_pointer_cast<Ship::Json>(
+                resources->LoadResource(sceneFile, true, initData));
+            if (json != nullptr) {
+                ApplyLevel(course, json->Data);
             }
+        }
+    }
 
-            // Load the Props (deserialize it)
-            if (data.contains("Props")) {
-                auto& propsJson = data["Props"];
-                try {
-                    course->Props.from_json(propsJson);
-                } catch(const std::exception& e) {
-                    std::cerr << "SceneManager::LoadLevel() Error parsing track properties: " << e.what() << std::endl;
-                    std::cerr << "  Is your scene.json file out of date?" << std::endl;
-                }
+    void ExportLevelJson() {
+        if ((!CurrentArchive) || SceneFile.empty()) {
+            printf("Could not export scene file, SceneFile or CurrentArchive not set\n");
+            return;
+        }
+        try {
+            auto dat = SerializeLevel().dump();
+            std::vector<uint8_t> stringify;
+            stringify.assign(dat.begin(), dat.end());
+
+            bool wrote = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->WriteFile(CurrentArchive, SceneFile, stringify);
+            if (wrote) {
+                printf("Exported scene file to %s\n", SceneFile.c_str());
             } else {
-                std::cerr << "Props data not found in the JSON file!" << std::endl;
+                printf("Failed to export scene file!\n");
             }
+        } catch (const nlohmann::json::exception& e) {
+            printf("SceneManager::ExportLevelJson():\n  JSON error during dump: %s\n", e.what());
+        }
+    }
 
-            // Load the Actors (deserialize them)
-            if (data.contains("StaticMeshActors")) {
-                auto& actorsJson = data["StaticMeshActors"];
-                gWorldInstance.StaticMeshActors.clear();  // Clear existing actors, if any
-                
-                for (const auto& actorJson : actorsJson) {
-                    Load_AddStaticMeshActor(actorJson);
-                }
-            } else {
-                std::cerr << "Actors data not found in the JSON file!" << std::endl;
+    void ImportLevelJson() {
+        nlohmann::json data;
+
+        if ((gWorldInstance.CurrentCourse == nullptr) || SceneFile.empty()) {
+            printf("Could not import scene file, no track is loaded\n");
+            return;
+        }
+        if (!ReadJsonFile(SceneFile, data)) {
+            printf("Could not import scene file %s\n", SceneFile.c_str());
+            return;
+        }
+        ApplyLevel(gWorldInstance.CurrentCourse, data);
+        printf("Imported scene file %s\n", SceneFile.c_str());
+    }
+
+    void TickAutosave() {
+        if ((gWorldInstance.CurrentCourse == nullptr) || (!CurrentArchive) || SceneFile.empty() ||
+            (gFrameSettings.EditorAutosaveSeconds <= 0)) {
+            return;
+        }
+        SceneAutosave& autosave = GetAutosave();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - sLastAutosave < std::chrono::seconds(gFrameSettings.EditorAutosaveSeconds)) {
+            return;
+        }
+        sLastAutosave = now;
+
+        size_t written = autosave.Save(SerializeLevel());
+        if (written != 0) {
+            printf("Autosaved %zu bytes to %s\n", written, autosave.GetPath().c_str());
+        }
+    }
+
+    void RestoreAutosave() {
+        if ((gWorldInstance.CurrentCourse == nullptr) || SceneFile.empty()) {
+            printf("Could not restore autosave, no track is loaded\n");
+            return;
+        }
+        SceneAutosave& autosave = GetAutosave();
+
+        // An autosave from an earlier session is kept as .prev once this session autosaves
+        for (const std::string& path : { autosave.GetPath(), autosave.GetPath() + ".prev" }) {
+            std::ifstream file(path, std::ios::binary);
+            std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            nlohmann::json data;
+
+            if (!buffer.empty() && DecodeScene(buffer.data(), buffer.size(), data)) {
+                ApplyLevel(gWorldInstance.CurrentCourse, data);
+                printf("Restored autosave %s\n", path.c_str());
+                return;
             }
         }
+        printf("No autosave to restore for %s\n", SceneFile.c_str());
     }
 
     void Load_AddStaticMeshActor(const nlohmann::json& actorJson) {
@@ -153,4 +375,49 @@ namespace Editor {
             }
         }
     }
+
+    void RunSceneFormatBenchmark() {
+        auto timeMs = [](auto&& fn) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        auto measure = [&](const std::string& name, const nlohmann::json& scene) {
+            std::vector<uint8_t> binary;
+            nlohmann::json decoded;
+            std::string text;
+            nlohmann::json parsed;
+
+            double encodeMs = timeMs([&]() { binary = EncodeScene(scene); });
+            double decodeMs = timeMs([&]() { DecodeScene(binary.data(), binary.size(), decoded); });
+            double dumpMs = timeMs([&]() { text = scene.dump(); });
+            double parseMs = timeMs([&]() { parsed = nlohmann::json::parse(text); });
+
+            printf("[SceneFormat] %s: JSON %zu bytes, written in %.3f ms and read in %.3f ms. Binary %zu bytes, "
+                   "written in %.3f ms and read in %.3f ms%s\n",
+                   name.c_str(), text.size(), dumpMs, parseMs, binary.size(), encodeMs, decodeMs,
+                   (decoded == scene) ? "" : ", and did not read back the same");
+        };
+
+        // Every track's scene in the loaded archives
+        auto resources = GameEngine::Instance->context->GetResourceManager();
+        auto files = resources->GetArchiveManager()->ListFiles("tracks/*/scene.json");
+        if (files != nullptr) {
+            for (const auto& path : *files) {
+                auto file = resources->LoadFileProcess(path);
+                if ((file == nullptr) || (file->Buffer == nullptr)) {
+                    continue;
+                }
+                try {
+                    measure(path, nlohmann::json::parse(file->Buffer->begin(), file->Buffer->end()));
+                } catch (const nlohmann::json::exception& e) {
+                    printf("[SceneFormat] Skipped %s, which is not valid JSON: %s\n", path.c_str(), e.what());
+                }
+            }
+        }
+
+        if (gWorldInstance.CurrentCourse != nullptr) {
+            measure("Current level", SerializeLevel());
+        }
+    }
 }
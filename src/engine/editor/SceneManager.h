@@ -1,12 +1,28 @@
+#pragma once
+
 #include <libultraship/libultraship.h>
 #include "engine/courses/Course.h"
 
 namespace Editor {
+        // Saves the scene to the binary file next to SceneFile
         void SaveLevel();
+        // Loads the binary scene file, or the JSON one if the track has no binary file yet
         void LoadLevel(std::shared_ptr<Ship::Archive> archive, Course* course, std::string sceneFile);
+        nlohmann::json SerializeLevel();
+        void ApplyLevel(Course* course, const nlohmann::json& data);
+        // scene.json -> scene.bin
+        std::string BinaryScenePath(const std::string& sceneFile);
+        // JSON copies of the scene, for tools and for sharing
+        void ExportLevelJson();
+        void ImportLevelJson();
+        // Autosaves the changes to the scene every gEditorAutosaveSeconds
+        void TickAutosave();
+        void RestoreAutosave();
         void Load_AddStaticMeshActor(const nlohmann::json& actorJson);
         void SetSceneFile(std::shared_ptr<Ship::Archive> archive, std::string sceneFile);
         void LoadMinimap(std::shared_ptr<Ship::Archive> archive, Course* course, std::string filePath);
+        // Times writing and reading the tracks' scenes and the current level as scene files and as JSON
+        void RunSceneFormatBenchmark();
 
         extern std::shared_ptr<Ship::Archive> CurrentArchive; // This is used to retrieve and write the scene data file
         extern std::string SceneFile;
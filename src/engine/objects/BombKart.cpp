@@ -31,6 +31,7 @@ size_t OBombKart::_count = 0;
 
 OBombKart::OBombKart(FVector pos, TrackPathPoint* waypoint, uint16_t waypointIndex, uint16_t state, f32 unk_3C) {
     Name = "Bomb Kart";
+    Class = ObjectClass::BombKart;
     _idx = _count;
     Vec3f _pos = {0, 0, 0};
 
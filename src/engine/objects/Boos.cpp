@@ -2,6 +2,7 @@
 #include "World.h"
 #include "CoreMath.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/FrameSettings.h"
 
 extern "C" {
 #include "render_objects.h"
@@ -85,7 +86,7 @@ void OBoos::Draw(s32 cameraId) {
         objectIndex = _indices[i]; // indexObjectList3[i];
         if (gObjectList[objectIndex].state >= 2) {
             temp_s2 = func_8008A364(objectIndex, cameraId, 0x4000U, 0x00000320);
-            if (CVarGetInteger("gNoCulling", 0) == 1) {
+            if (gFrameSettings.NoCulling == 1) {
                 temp_s2 = MIN(temp_s2, 0x15F91U);
             }
 
@@ -61,6 +61,15 @@ Vtx common_vtx_crab[] = {
     { { { -32, 31, 0 }, 0, { 0, 3968 }, { 255, 255, 255, 255 } } },
 };
 
+bool OCrab::GetDrawBounds(FVector& center, f32& radius) {
+    Object* object = &gObjectList[_objectIndex];
+
+    // Half the diagonal of common_vtx_crab
+    center = FVector(object->pos[0], object->pos[1], object->pos[2]);
+    radius = 46.0f * object->sizeScaling;
+    return true;
+}
+
 void OCrab::Draw(s32 cameraId) {
     Camera* camera;
     s32 objectIndex = _objectIndex;
@@ -34,6 +34,7 @@ public:
 
     virtual void Tick() override;
     virtual void Draw(s32 cameraId) override;
+    virtual bool GetDrawBounds(FVector& center, f32& radius) override;
     void DrawModel(s32 cameraId);
 
     void init_ktb_crab(s32 objectIndex);
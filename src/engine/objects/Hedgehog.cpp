@@ -12,6 +12,7 @@ extern "C" {
 #include "code_80057C60.h"
 }
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/FrameSettings.h"
 
 size_t OHedgehog::_count = 0;
 
@@ -50,7 +51,7 @@ void OHedgehog::Draw(s32 cameraId) {
     s32 objectIndex = indexObjectList2[_idx];
     u32 something = func_8008A364(objectIndex, cameraId, 0x4000U, 0x000003E8);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         something = MIN(something, 0x52211U - 1);
     }
     if (is_obj_flag_status_active(objectIndex, VISIBLE) != 0) {
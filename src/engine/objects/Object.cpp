@@ -18,6 +18,9 @@ void OObject::Tick60fps() {}
 void OObject::Draw(s32 cameraId) { }
 void OObject::Expire() { }
 void OObject::Destroy() {
-    bPendingDestroy = true;
+    gWorldInstance.DestroyObject(this);
 }
 void OObject::Reset() { }
+bool OObject::IsParallelTickSafe() { return false; }
+bool OObject::GetDrawBounds(FVector& center, f32& radius) { return false; }
+void OObject::TickCommit() { }
@@ -1,12 +1,22 @@
 #pragma once
 
 #include <libultraship.h>
+#include "EntityHandle.h"
+#include "CoreMath.h"
 
 extern "C" {
     #include "camera.h"
     #include "objects.h"
 }
 
+// Object classes that engine code looks up by type, see ActorClass
+enum class ObjectClass : uint8_t {
+    Other,
+    BombKart,
+    Thwomp,
+    Count,
+};
+
 class OObject {
 public:
     uint8_t uuid[16];
@@ -14,6 +24,8 @@ public:
     const char* Name = "";
     bool bPendingDestroy = false;
     s32 _objectIndex = -1;
+    EntityHandle Handle; // Assigned by World when the object is added
+    ObjectClass Class = ObjectClass::Other; // Set by the constructors of the classes in ObjectClass
 
     virtual ~OObject() = default;
 
@@ -22,7 +34,14 @@ public:
     virtual void Tick();
     virtual void Tick60fps();
     virtual void Draw(s32 cameraId);
+    // See AActor::GetDrawBounds. Only for objects whose Draw() changes nothing but the display list.
+    virtual bool GetDrawBounds(FVector& center, f32& radius);
     virtual void Expire();
-    virtual void Destroy(); // Mark object for deletion at the start of the next frame
+    virtual void Destroy(); // Mark object for deletion at the end of the frame
     virtual void Reset();
+    // True if Tick() and Tick60fps() only write this object, and only read state that no other object's
+    // tick or commit writes. Such objects may be ticked on worker threads.
+    virtual bool IsParallelTickSafe();
+    // Runs on the game thread after Tick(), in object list order. Side effects go here.
+    virtual void TickCommit();
 };
@@ -72,6 +72,8 @@ OPenguin::OPenguin(FVector pos, u16 direction, PenguinType type, Behaviour behav
     }
 }
 
+// Not parallel-safe: its state machine draws random numbers and plays sounds between the steps that move it, and
+// func_80089820 pushes the players it runs into.
 void OPenguin::Tick(void) {
     s32 objectIndex = _objectIndex;
 
@@ -5,6 +5,7 @@
 #include "World.h"
 
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 
 extern "C" {
 #include "macros.h"
@@ -60,37 +61,53 @@ OSeagull::OSeagull(FVector pos) {
     _count++;
 }
 
+// Following the spline only touches the seagull's own object. Setting a seagull up draws random numbers, and the
+// squawk timers are shared by every seagull, so those wait for TickCommit().
+bool OSeagull::IsParallelTickSafe() {
+    return true;
+}
+
 void OSeagull::Tick() {
+    s32 state = gObjectList[_objectIndex].state;
+
+    _moved = (state != 0) && (state != 1);
+    if (_moved) {
+        OSeagull::func_8008275C(_objectIndex);
+    }
+}
+
+void OSeagull::TickCommit() {
     Object* object;
     s32 objectIndex = _objectIndex;
 
-        object = &gObjectList[objectIndex];
-        if (object->state == 0) {
-            return;
-        }
+    object = &gObjectList[objectIndex];
+    if (object->state == 0) {
+        return;
+    }
 
+    if (!_moved) {
         OSeagull::func_80082714(objectIndex, _idx);
         OSeagull::func_8008275C(objectIndex);
-        if (func_80072320(objectIndex, 2) != 0) {
-            func_800722CC(objectIndex, 2);
-            if (D_80165A90 != 0) {
-                D_80165A90 = 0;
-                D_80183E40[0] = 0.0f;
-                D_80183E40[1] = 0.0f;
-                D_80183E40[2] = 0.0f;
-                if (gGamestate != CREDITS_SEQUENCE) {
-                    func_800C98B8(object->pos, D_80183E40, SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x43));
-                } else {
-                    if (_idx == 1) {
-                        if (gCutsceneShotTimer <= 150) {
-                            object = &gObjectList[_objectIndex];
-                            func_800C98B8(object->pos, D_80183E40, SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x43));
-                        }
+    }
+    if (func_80072320(objectIndex, 2) != 0) {
+        func_800722CC(objectIndex, 2);
+        if (D_80165A90 != 0) {
+            D_80165A90 = 0;
+            D_80183E40[0] = 0.0f;
+            D_80183E40[1] = 0.0f;
+            D_80183E40[2] = 0.0f;
+            if (gGamestate != CREDITS_SEQUENCE) {
+                func_800C98B8(object->pos, D_80183E40, SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x43));
+            } else {
+                if (_idx == 1) {
+                    if (gCutsceneShotTimer <= 150) {
+                        object = &gObjectList[_objectIndex];
+                        func_800C98B8(object->pos, D_80183E40, SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x43));
                     }
                 }
             }
         }
-    //}
+    }
     if (D_80165900 != 0) {
         D_80165900 -= 1;
     } else {
@@ -109,7 +126,7 @@ void OSeagull::Tick() {
 void OSeagull::Draw(s32 cameraId) { // render_object_seagulls
     s32 objectIndex = _objectIndex;
 
-    if (func_8008A364(objectIndex, cameraId, 0x5555U, 0x000005DC) < 0x9C401 && CVarGetInteger("gNoCulling", 0) == 0) {
+    if (func_8008A364(objectIndex, cameraId, 0x5555U, 0x000005DC) < 0x9C401 && gFrameSettings.NoCulling == 0) {
         D_80165908 = 1;
         _toggle = true;
     }
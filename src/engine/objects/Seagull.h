@@ -30,6 +30,8 @@ public:
     }
 
     virtual void Tick() override;
+    virtual bool IsParallelTickSafe() override;
+    virtual void TickCommit() override;
     virtual void Draw(s32 cameraId) override;
 
     void func_800552BC(s32 objectIndex);
@@ -42,6 +44,7 @@ private:
     static size_t _count;
     s32 _idx;
     bool _toggle;
+    bool _moved = false; // Tick() already moved the seagull, so TickCommit() doesn't
 
     SplineData *spline;
 };
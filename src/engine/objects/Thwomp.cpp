@@ -50,6 +50,7 @@ size_t OThwomp::_rand = 0;
 
 OThwomp::OThwomp(s16 x, s16 z, s16 direction, f32 scale, s16 behaviour, s16 primAlpha, u16 boundingBoxSize) {
     Name = "Thwomp";
+    Class = ObjectClass::Thwomp;
     _idx = _count;
     _faceDirection = direction;
     _boundingBoxSize = boundingBoxSize;
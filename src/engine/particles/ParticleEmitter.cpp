@@ -11,3 +11,5 @@ void ParticleEmitter::Tick() {  }
 void ParticleEmitter::Draw(s32  cameraId) { }
 
 bool ParticleEmitter::IsMod() { return false; }
+bool ParticleEmitter::IsParallelTickSafe() { return false; }
+void ParticleEmitter::TickCommit() { }
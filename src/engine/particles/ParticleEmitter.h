@@ -18,6 +18,10 @@ public:
     virtual void Tick();
     virtual void Draw(s32 cameraId);
     virtual bool IsMod();
+    // True if Tick() only writes this emitter. Such emitters may be ticked on worker threads.
+    virtual bool IsParallelTickSafe();
+    // Runs on the game thread after Tick(), in emitter list order
+    virtual void TickCommit();
 };
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "StarEmitter.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/Frustum.h"
 
 extern "C" {
 #include "render_objects.h"
@@ -110,7 +111,8 @@ void StarEmitter::Draw(s32 cameraId) { // func_80054BE8
         temp_a0 = ObjectIndex[var_s0];
         // @port: Tag the transform.
         FrameInterpolation_RecordOpenChild("Ceremony Stars", (uintptr_t) &ObjectIndex[var_s0]);
-        if ((temp_a0 != -1) && (gObjectList[temp_a0].state >= 2)) {
+        if ((temp_a0 != -1) && (gObjectList[temp_a0].state >= 2) &&
+            Frustum_IsSphereVisible(gObjectList[temp_a0].pos, 50.0f)) {
             StarEmitter::func_80054AFC(temp_a0, camera->pos);
         }
         // @port Pop the transform id.
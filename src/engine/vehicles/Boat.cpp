@@ -18,6 +18,7 @@ size_t ABoat::_count = 0;
 
 ABoat::ABoat(f32 speed, u32 waypoint) {
     Name = "Paddle Steam Boat";
+    Class = ActorClass::Boat;
     Path2D* temp_a2;
     u16 waypointOffset;
     Index = _count;
@@ -61,6 +62,11 @@ bool ABoat::IsMod() {
     return true;
 }
 
+// Following the path only touches the boat and its actor slot. Smoke and the random horn wait for TickCommit().
+bool ABoat::IsParallelTickSafe() {
+    return true;
+}
+
 void ABoat::Tick() {
     Path2D* waypoint;
     struct Actor* paddleBoatActor;
@@ -73,36 +79,14 @@ void ABoat::Tick() {
     Vec3f sp94;
     Vec3f sp88;
     UNUSED s32 pad;
-    Vec3f smokePos;
-    UNUSED s32 pad2;
     AnotherSmokeTimer += 1;
     if (IsActive == 1) {
         temp_f26 = Position[0];
         temp_f28 = Position[1];
         temp_f30 = Position[2];
         update_vehicle_following_path(Position, (s16*) &WaypointIndex, Speed);
-        SomeFlags = set_vehicle_render_distance_flags(Position, BOAT_SMOKE_RENDER_DISTANCE, SomeFlags);
-        if ((((s16) AnotherSmokeTimer % 10) == 0) && (SomeFlags != 0)) {
-            smokePos[0] = (f32) ((f64) Position[0] - 30.0);
-            smokePos[1] = (f32) ((f64) Position[1] + 180.0);
-            smokePos[2] = (f32) ((f64) Position[2] + 45.0);
-            adjust_position_by_angle(smokePos, Position, RotY);
-            // spawn_ferry_smoke(Index, smokePos, 1.1f);
-            AddSmoke(Index, smokePos, 1.1f);
-            smokePos[0] = (f32) ((f64) Position[0] + 30.0);
-            smokePos[1] = (f32) ((f64) Position[1] + 180.0);
-            smokePos[2] = (f32) ((f64) Position[2] + 45.0);
-            adjust_position_by_angle(smokePos, Position, RotY);
-            // spawn_ferry_smoke(Index, smokePos, 1.1f);
-            AddSmoke(Index, smokePos, 1.1f);
-        }
-        if (random_int(100) == 0) {
-            if (random_int(2) == 0) {
-                func_800C98B8(Position, Velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x47));
-            } else {
-                func_800C98B8(Position, Velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x48));
-            }
-        }
+        // The smoke leaves from where the boat faced before turning
+        _smokeRotY = RotY;
         sp94[0] = temp_f26;
         sp94[1] = temp_f28;
         sp94[2] = temp_f30;
@@ -158,6 +142,42 @@ void ABoat::Tick() {
     }
 }
 
+void ABoat::TickCommit() {
+    Vec3f smokePos;
+    if (IsActive == 1) {
+        SomeFlags = set_vehicle_render_distance_flags(Position, BOAT_SMOKE_RENDER_DISTANCE, SomeFlags);
+        if ((((s16) AnotherSmokeTimer % 10) == 0) && (SomeFlags != 0)) {
+            smokePos[0] = (f32) ((f64) Position[0] - 30.0);
+            smokePos[1] = (f32) ((f64) Position[1] + 180.0);
+            smokePos[2] = (f32) ((f64) Position[2] + 45.0);
+            adjust_position_by_angle(smokePos, Position, _smokeRotY);
+            // spawn_ferry_smoke(Index, smokePos, 1.1f);
+            AddSmoke(Index, smokePos, 1.1f);
+            smokePos[0] = (f32) ((f64) Position[0] + 30.0);
+            smokePos[1] = (f32) ((f64) Position[1] + 180.0);
+            smokePos[2] = (f32) ((f64) Position[2] + 45.0);
+            adjust_position_by_angle(smokePos, Position, _smokeRotY);
+            // spawn_ferry_smoke(Index, smokePos, 1.1f);
+            AddSmoke(Index, smokePos, 1.1f);
+        }
+        if (random_int(100) == 0) {
+            if (random_int(2) == 0) {
+                func_800C98B8(Position, Velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x47));
+            } else {
+                func_800C98B8(Position, Velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x48));
+            }
+        }
+    }
+}
+
+bool ABoat::GetVehicleCollisionArea(f32 area[4]) {
+    area[0] = Position[0] - 300.0f;
+    area[1] = Position[2] - 300.0f;
+    area[2] = Position[0] + 300.0f;
+    area[3] = Position[2] + 300.0f;
+    return true;
+}
+
 void ABoat::VehicleCollision(s32 playerId, Player* player) {
     f32 x_diff;
     f32 y_diff;
@@ -39,11 +39,16 @@ class ABoat : public AActor {
     }
 
     virtual void Tick() override;
+    virtual bool IsParallelTickSafe() override;
+    virtual void TickCommit() override;
     virtual void Draw(Camera* camera) override;
     virtual void VehicleCollision(s32 playerId, Player* player) override;
+    virtual bool GetVehicleCollisionArea(f32 area[4]) override;
     virtual s32 AddSmoke(size_t, Vec3f, f32);
     virtual bool IsMod() override;
 private:
     static size_t _count;
 
+    s16 _smokeRotY = 0; // Left by Tick() for TickCommit()
+
 };
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include <libultraship.h>
+#include "Traffic.h"
+#include "Utils.h"
+#include "Car.h"
+#include "engine/JobSystem.h"
+#include "port/Game.h"
+#include "port/GfxPool.h"
+#include "port/Frustum.h"
+#include <port/interpolation/FrameInterpolation.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+extern "C" {
+#include "macros.h"
+#include "main.h"
+#include "defines.h"
+#include "code_80005FD0.h"
+#include "actors.h"
+#include "actor_types.h"
+#include "math_util.h"
+#include "sounds.h"
+#include "buffers.h"
+}
+
+// Fewer vehicles than this are not worth handing to worker threads
+#define TRAFFIC_PARALLEL_MIN_VEHICLES 256
+
+struct TrafficKindInfo {
+    s16 ActorType;
+    f32 Length;
+    f32 Width;
+    u32 SoundBits;
+    void (*Render)(Camera*, struct Actor*);
+};
+
+// Same values as the vehicle actors, indexed by TrafficKind
+static const TrafficKindInfo sTrafficKinds[] = {
+    { ACTOR_BOX_TRUCK, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03), render_actor_box_truck },
+    { ACTOR_SCHOOL_BUS, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03), render_actor_school_bus },
+    { ACTOR_TANKER_TRUCK, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03), render_actor_tanker_truck },
+    { ACTOR_CAR, 11.5f, 8.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x05), render_actor_car },
+};
+
+void RoadTraffic::Add(TrafficKind kind, f32 speedA, f32 speedB, TrackPathPoint* path, uint32_t waypoint) {
+    Lane& lane = _lanes[(size_t) kind];
+    size_t index = lane.Count;
+
+    if ((index % BlockSize) == 0) {
+        lane.Blocks.push_back(std::make_unique<Block>());
+    }
+    Block& block = *lane.Blocks.back();
+    size_t i = block.Count;
+
+    // Mirrors the vehicle actor constructors
+    TrackPathPoint* point = &path[waypoint];
+    f32* position = block.Position[i];
+    f32* velocity = block.Velocity[i];
+    s16* rotation = block.Rotation[i];
+
+    position[0] = (f32) point->posX;
+    position[1] = (f32) point->posY;
+    position[2] = (f32) point->posZ;
+    block.WaypointIndex[i] = (u16) waypoint;
+    velocity[0] = 0.0f;
+    velocity[1] = 0.0f;
+    velocity[2] = 0.0f;
+    if (gModeSelection == TIME_TRIALS) {
+        block.SomeType[i] = ((index - 1) % 3);
+    } else {
+        block.SomeType[i] = random_int(3);
+    }
+    block.Multiplier[i] = (f32) ((f64) (f32) (block.SomeType[i] - 1) * 0.6);
+    if (((gCCSelection > CC_50) || (gModeSelection == TIME_TRIALS)) && (block.SomeType[i] == 2)) {
+        block.Speed[i] = speedA;
+    } else {
+        block.Speed[i] = speedB;
+    }
+    rotation[0] = 0;
+    rotation[2] = 0;
+    if (gIsInExtra == 0) {
+        rotation[1] = func_8000D6D0(position, (s16*) &block.WaypointIndex[i], block.Speed[i], block.Multiplier[i], 0, 3);
+    } else {
+        rotation[1] = func_8000D940(position, (s16*) &block.WaypointIndex[i], block.Speed[i], block.Multiplier[i], 0);
+    }
+    sVehicleSoundRenderCounter = 10;
+
+    spawn_vehicle_on_road(position, rotation, velocity, block.WaypointIndex[i], block.Multiplier[i], block.Speed[i]);
+
+    // Box trucks cycle through their paint jobs the same way actor_init() does
+    block.State[i] = 0;
+    if (kind == TrafficKind::Truck) {
+        if ((s32) D_802BA260 >= 3) {
+            D_802BA260 = 0;
+        }
+        block.State[i] = (s16) D_802BA260;
+        D_802BA260 += 1;
+    }
+    block.SoundFlags[i] = 0;
+    block.PassFlags[i] = 0;
+
+    block.Count++;
+    lane.Count++;
+}
+
+void RoadTraffic::Clear() {
+    for (Lane& lane : _lanes) {
+        lane.Blocks.clear();
+        lane.Count = 0;
+    }
+}
+
+size_t RoadTraffic::GetCount() const {
+    size_t count = 0;
+    for (const Lane& lane : _lanes) {
+        count += lane.Count;
+    }
+    return count;
+}
+
+static void TickTrafficBlock(f32 (*position)[3], f32 (*velocity)[3], s16 (*rotation)[3], u16* waypointIndex,
+                             f32* multiplier, const f32* speed, const s16* type, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        RoadVehicleTick(position[i], velocity[i], rotation[i], &waypointIndex[i], &multiplier[i], speed[i], type[i]);
+    }
+}
+
+void RoadTraffic::Tick(JobSystem* jobs) {
+    static std::vector<Block*> sBlocks;
+
+    sBlocks.clear();
+    for (Lane& lane : _lanes) {
+        for (auto& block : lane.Blocks) {
+            sBlocks.push_back(block.get());
+        }
+    }
+
+    // Every vehicle only writes its own slots, so blocks can be ticked in any order
+    auto tick = [](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; b++) {
+            Block* block = sBlocks[b];
+            TickTrafficBlock(block->Position, block->Velocity, block->Rotation, block->WaypointIndex,
+                             block->Multiplier, block->Speed, block->SomeType, block->Count);
+        }
+    };
+
+    if ((jobs != nullptr) && (GetCount() >= TRAFFIC_PARALLEL_MIN_VEHICLES)) {
+        jobs->ParallelFor(sBlocks.size(), 1, tick);
+    } else {
+        tick(0, sBlocks.size());
+    }
+}
+
+void RoadTraffic::Draw(Camera* camera) {
+    struct Actor actor;
+
+    memset(&actor, 0, sizeof(actor));
+    actor.flags = -0x8000;
+
+    for (size_t kind = 0; kind < (size_t) TrafficKind::Count; kind++) {
+        const TrafficKindInfo& info = sTrafficKinds[kind];
+
+        actor.type = info.ActorType;
+        f32 cullRadius = get_actor_cull_radius(&actor);
+        for (auto& block : _lanes[kind].Blocks) {
+            for (size_t i = 0; i < block->Count; i++) {
+                // Steers the CPU racers away from the vehicle, so it runs whether or not the vehicle is in view
+                RoadVehicleAvoidance(camera, block->WaypointIndex[i], block->SomeType[i]);
+                if (!Frustum_IsSphereVisible(block->Position[i], cullRadius)) {
+                    continue;
+                }
+
+                // The renderers only read these, so one scratch actor serves every vehicle
+                vec3f_copy_return(actor.pos, block->Position[i]);
+                vec3f_copy_return(actor.velocity, block->Velocity[i]);
+                vec3s_copy(actor.rot, block->Rotation[i]);
+                if (gIsMirrorMode != 0) {
+                    actor.rot[1] = -actor.rot[1];
+                }
+                actor.state = block->State[i];
+
+                GfxPool_Ensure();
+                FrameInterpolation_RecordOpenChild(block->Position[i], kind);
+                info.Render(camera, &actor);
+                FrameInterpolation_RecordCloseChild();
+            }
+        }
+    }
+}
+
+void RoadTraffic::VehicleCollision(s32 playerId, Player* player) {
+    f32 x = player->pos[0];
+    f32 y = player->pos[1];
+    f32 z = player->pos[2];
+
+    for (size_t kind = 0; kind < (size_t) TrafficKind::Count; kind++) {
+        const TrafficKindInfo& info = sTrafficKinds[kind];
+
+        for (auto& block : _lanes[kind].Blocks) {
+            for (size_t i = 0; i < block->Count; i++) {
+                f32 dx = x - block->Position[i][0];
+                f32 dy = y - block->Position[i][1];
+                f32 dz = z - block->Position[i][2];
+
+                // Outside of the sound range with nothing to undo, RoadVehicleCollision() does nothing
+                if ((block->SoundFlags[i] == 0) && (block->PassFlags[i] == 0) &&
+                    !((dx > -300.0) && (dx < 300.0) && (dy > -20.0) && (dy < 20.0) && (dz > -300.0) &&
+                      (dz < 300.0))) {
+                    continue;
+                }
+                RoadVehicleCollision(playerId, player, block->Position[i], block->Velocity[i],
+                                     block->WaypointIndex[i], block->Speed[i], info.Length, info.Width, info.SoundBits,
+                                     &block->SoundFlags[i], &block->PassFlags[i]);
+            }
+        }
+    }
+}
+
+namespace {
+
+// Ticks like ACar, but into a C actor of its own, so that the benchmark leaves the race's actors alone
+class BenchmarkCar : public AActor {
+  public:
+    Vec3f CarPosition;
+    Vec3f CarVelocity;
+    Vec3s CarRotation;
+    f32 CarSpeed;
+    f32 Multiplier;
+    u16 WaypointIndex;
+    s16 SomeType;
+    struct Actor Slot = {};
+
+    void Tick() override {
+        RoadVehicleTick(CarPosition, CarVelocity, CarRotation, &WaypointIndex, &Multiplier, CarSpeed, SomeType);
+
+        Slot.pos[0] = CarPosition[0];
+        Slot.pos[1] = CarPosition[1];
+        Slot.pos[2] = CarPosition[2];
+        Slot.rot[0] = CarRotation[0];
+        if (gIsMirrorMode != 0) {
+            Slot.rot[1] = -CarRotation[1];
+        } else {
+            Slot.rot[1] = CarRotation[1];
+        }
+        Slot.rot[2] = CarRotation[2];
+        Slot.velocity[0] = CarVelocity[0];
+        Slot.velocity[1] = CarVelocity[1];
+        Slot.velocity[2] = CarVelocity[2];
+    }
+};
+
+} // namespace
+
+/**
+ * Builds count cars in a scratch RoadTraffic and the same cars as actors, then times 60 ticks of each.
+ * The actors mirror ACar::Tick and are ticked one virtual call at a time like World::TickActors() does with
+ * parallel ticking off. They are not spawned, so the race's actor slots and ACar count stay as they were.
+ * RoadTraffic is timed serially and across the job system. Every run starts from the same state and is
+ * compared against the actors. The random seed and vehicle sound counter that building the cars changes are
+ * put back afterwards.
+ */
+void RunTrafficBenchmark(size_t count) {
+    const size_t ticks = 60;
+
+    if ((gGamestate != RACING) || (gPathCountByPathIndex[0] == 0)) {
+        printf("RunTrafficBenchmark() needs a race with a track path\n");
+        return;
+    }
+
+    u16 randomSeed = gRandomSeed16;
+    s16 soundRenderCounter = sVehicleSoundRenderCounter;
+
+    RoadTraffic initial;
+    for (size_t i = 0; i < count; i++) {
+        initial.Add(TrafficKind::Car, 2.0f, 2.5f, &gTrackPaths[0][0], (i * 7) % gPathCountByPathIndex[0]);
+    }
+    auto restore = [&initial](RoadTraffic& traffic) {
+        traffic.Clear();
+        for (auto& block : initial._lanes[(size_t) TrafficKind::Car].Blocks) {
+            traffic._lanes[(size_t) TrafficKind::Car].Blocks.push_back(std::make_unique<RoadTraffic::Block>(*block));
+        }
+        traffic._lanes[(size_t) TrafficKind::Car].Count = initial.GetCount();
+    };
+
+    std::vector<std::unique_ptr<BenchmarkCar>> cars;
+    std::vector<AActor*> actors;
+    for (size_t i = 0; i < count; i++) {
+        const RoadTraffic::Block& block = *initial._lanes[(size_t) TrafficKind::Car].Blocks[i / RoadTraffic::BlockSize];
+        size_t j = i % RoadTraffic::BlockSize;
+        BenchmarkCar* car = cars.emplace_back(std::make_unique<BenchmarkCar>()).get();
+
+        vec3f_copy_return(car->CarPosition, (f32*) block.Position[j]);
+        vec3f_copy_return(car->CarVelocity, (f32*) block.Velocity[j]);
+        vec3s_copy(car->CarRotation, (s16*) block.Rotation[j]);
+        car->CarSpeed = block.Speed[j];
+        car->Multiplier = block.Multiplier[j];
+        car->WaypointIndex = block.WaypointIndex[j];
+        car->SomeType = block.SomeType[j];
+        actors.push_back(car);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < ticks; t++) {
+        for (AActor* actor : actors) {
+            actor->Tick();
+        }
+    }
+    long long actorTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    printf("RunTrafficBenchmark() %zu cars, %zu ticks. Actors: %lld us\n", count, ticks, actorTime);
+
+    RoadTraffic traffic;
+    JobSystem* runs[] = { nullptr, &GetJobSystem() };
+    for (JobSystem* jobs : runs) {
+        restore(traffic);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < ticks; t++) {
+            traffic.Tick(jobs);
+        }
+        long long time =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; i++) {
+            const RoadTraffic::Block& block = *traffic._lanes[(size_t) TrafficKind::Car].Blocks[i / RoadTraffic::BlockSize];
+            size_t j = i % RoadTraffic::BlockSize;
+            const BenchmarkCar* car = cars[i].get();
+
+            mismatches += (memcmp(car->CarPosition, block.Position[j], sizeof(Vec3f)) != 0) ||
+                          (memcmp(car->CarVelocity, block.Velocity[j], sizeof(Vec3f)) != 0) ||
+                          (memcmp(car->CarRotation, block.Rotation[j], sizeof(Vec3s)) != 0) ||
+                          (car->Multiplier != block.Multiplier[j]) || (car->WaypointIndex != block.WaypointIndex[j]);
+        }
+        printf("RunTrafficBenchmark() RoadTraffic, %s: %lld us (%.2fx), %zu mismatches\n",
+               (jobs != nullptr) ? "job system" : "serial", time,
+               (double) actorTime / (double) std::max(time, 1LL), mismatches);
+    }
+
+    gRandomSeed16 = randomSeed;
+    sVehicleSoundRenderCounter = soundRenderCounter;
+}
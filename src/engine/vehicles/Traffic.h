@@ -0,0 +1,79 @@
+#pragma once
+
+#include <libultraship.h>
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include "camera.h"
+#include "common_structs.h"
+#include "waypoints.h"
+}
+
+class JobSystem;
+
+enum class TrafficKind {
+    Truck,
+    Bus,
+    TankerTruck,
+    Car,
+    Count,
+};
+
+/**
+ * Road vehicles that need no actor. Each kind is stored as a structure of arrays in fixed size blocks,
+ * so that ticking, collision and drawing walk tightly packed arrays instead of one heap actor and one
+ * C actor slot per vehicle. Blocks are never moved or freed before Clear(), which keeps the position
+ * and velocity addresses handed to the audio code valid.
+ *
+ * A vehicle follows the path, collides and plays sounds like the ACar, ATruck, ABus and ATankerTruck actor
+ * of the same kind, with two differences:
+ *  - In time trials SomeType cycles with the vehicle's index in its lane, where the actors use the static
+ *    count of their class, which ACar::_count and the others carry across races.
+ *  - The avoidance hint for CPU racers runs for every vehicle each frame, where an actor only runs it from
+ *    Draw() when the actor is not culled.
+ */
+class RoadTraffic {
+public:
+    static constexpr size_t BlockSize = 256;
+
+    void Add(TrafficKind kind, f32 speedA, f32 speedB, TrackPathPoint* path, uint32_t waypoint);
+    void Clear();
+
+    // Ticks every block, across the job system if one is given
+    void Tick(JobSystem* jobs);
+    void Draw(Camera* camera);
+    void VehicleCollision(s32 playerId, Player* player);
+
+    size_t GetCount() const;
+    size_t GetCount(TrafficKind kind) const {
+        return _lanes[(size_t) kind].Count;
+    }
+
+private:
+    friend void RunTrafficBenchmark(size_t count);
+
+    struct Block {
+        size_t Count = 0;
+        Vec3f Position[BlockSize];
+        Vec3f Velocity[BlockSize];
+        Vec3s Rotation[BlockSize];
+        f32 Speed[BlockSize];
+        f32 Multiplier[BlockSize];
+        u16 WaypointIndex[BlockSize];
+        s16 SomeType[BlockSize];
+        s16 State[BlockSize]; // Actor state, picks the box truck's paint
+        s8 SoundFlags[BlockSize];
+        s8 PassFlags[BlockSize];
+    };
+
+    struct Lane {
+        std::vector<std::unique_ptr<Block>> Blocks;
+        size_t Count = 0;
+    };
+
+    Lane _lanes[(size_t) TrafficKind::Count];
+};
+
+// Times the actor and RoadTraffic versions of count cars over the same ticks and checks that they agree
+void RunTrafficBenchmark(size_t count);
@@ -26,6 +26,7 @@ size_t ATrain::_count = 0;
 
 ATrain::ATrain(ATrain::TenderStatus tender, size_t numCarriages, f32 speed, uint32_t waypoint) {
     Name = "Train";
+    Class = ActorClass::Train;
     u16 waypointOffset;
     TrainCarStuff* ptr1;
     Path2D* pos;
@@ -147,53 +148,38 @@ void ATrain::SyncComponents(TrainCarStuff* trainCar, s16 orientationY) {
     trainCarActor->velocity[2] = trainCar->velocity[2];
 }
 
+// Following the path only touches the train's own cars and their actor slots. Sounds, the random whistle and
+// smoke wait for TickCommit().
+bool ATrain::IsParallelTickSafe() {
+    return true;
+}
+
 void ATrain::Tick() {
     f32 temp_f20;
     TrainCarStuff* car;
-    u16 oldWaypointIndex;
-    s16 orientationYUpdate;
     f32 temp_f22;
     s32 j;
-    Vec3f smokePos;
 
     AnotherSmokeTimer += 1;
 
-    oldWaypointIndex = (u16) Locomotive.waypointIndex;
+    _oldWaypointIndex = (u16) Locomotive.waypointIndex;
 
     temp_f20 = Locomotive.position[0];
     temp_f22 = Locomotive.position[2];
 
-    orientationYUpdate = update_vehicle_following_path(Locomotive.position, (s16*) &Locomotive.waypointIndex, Speed);
+    _locomotiveRotY = update_vehicle_following_path(Locomotive.position, (s16*) &Locomotive.waypointIndex, Speed);
 
     Locomotive.velocity[0] = Locomotive.position[0] - temp_f20;
     Locomotive.velocity[2] = Locomotive.position[2] - temp_f22;
 
-    sync_train_components(&Locomotive, orientationYUpdate);
-
-    if ((oldWaypointIndex != Locomotive.waypointIndex) &&
-        ((Locomotive.waypointIndex == 0x00BE) || (Locomotive.waypointIndex == 0x0140))) { // play crossing bell sound
-        func_800C98B8(Locomotive.position, Locomotive.velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x0E));
-    } else if (random_int(100) == 0) { // play train whistle sound
-        func_800C98B8(Locomotive.position, Locomotive.velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x0D));
-    }
-
-    SomeFlags = set_vehicle_render_distance_flags(Locomotive.position, TRAIN_SMOKE_RENDER_DISTANCE, SomeFlags);
-    // Renders locomotive smoke on all screens if any player is within range.
-    if ((((s16) AnotherSmokeTimer % 5) == 0) && (SomeFlags != 0)) {
-        smokePos[0] = Locomotive.position[0];
-        smokePos[1] = (f32) ((f64) Locomotive.position[1] + 65.0);
-        smokePos[2] = (f32) ((f64) Locomotive.position[2] + 25.0);
-        adjust_position_by_angle(smokePos, Locomotive.position, orientationYUpdate);
-        // spawn_train_smoke(Index, smokePos, 1.1f);
-        AddSmoke(Index, smokePos, 1.1f);
-    }
+    sync_train_components(&Locomotive, _locomotiveRotY);
 
     car = &Tender;
 
     if (car->isActive == 1) {
         temp_f20 = car->position[0];
         temp_f22 = car->position[2];
-        orientationYUpdate = update_vehicle_following_path(car->position, (s16*) &car->waypointIndex, Speed);
+        s16 orientationYUpdate = update_vehicle_following_path(car->position, (s16*) &car->waypointIndex, Speed);
         car->velocity[0] = car->position[0] - temp_f20;
         car->velocity[2] = car->position[2] - temp_f22;
         sync_train_components(car, orientationYUpdate);
@@ -205,7 +191,7 @@ void ATrain::Tick() {
             temp_f20 = car->position[0];
             temp_f22 = car->position[2];
 
-            orientationYUpdate = update_vehicle_following_path(car->position, (s16*) &car->waypointIndex, Speed);
+            s16 orientationYUpdate = update_vehicle_following_path(car->position, (s16*) &car->waypointIndex, Speed);
             car->velocity[0] = car->position[0] - temp_f20;
             car->velocity[2] = car->position[2] - temp_f22;
             sync_train_components(car, orientationYUpdate);
@@ -213,6 +199,47 @@ void ATrain::Tick() {
     }
 }
 
+void ATrain::TickCommit() {
+    Vec3f smokePos;
+
+    if ((_oldWaypointIndex != Locomotive.waypointIndex) &&
+        ((Locomotive.waypointIndex == 0x00BE) || (Locomotive.waypointIndex == 0x0140))) { // play crossing bell sound
+        func_800C98B8(Locomotive.position, Locomotive.velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x0E));
+    } else if (random_int(100) == 0) { // play train whistle sound
+        func_800C98B8(Locomotive.position, Locomotive.velocity, SOUND_ARG_LOAD(0x19, 0x01, 0x80, 0x0D));
+    }
+
+    SomeFlags = set_vehicle_render_distance_flags(Locomotive.position, TRAIN_SMOKE_RENDER_DISTANCE, SomeFlags);
+    // Renders locomotive smoke on all screens if any player is within range.
+    if ((((s16) AnotherSmokeTimer % 5) == 0) && (SomeFlags != 0)) {
+        smokePos[0] = Locomotive.position[0];
+        smokePos[1] = (f32) ((f64) Locomotive.position[1] + 65.0);
+        smokePos[2] = (f32) ((f64) Locomotive.position[2] + 25.0);
+        adjust_position_by_angle(smokePos, Locomotive.position, _locomotiveRotY);
+        // spawn_train_smoke(Index, smokePos, 1.1f);
+        AddSmoke(Index, smokePos, 1.1f);
+    }
+}
+
+bool ATrain::GetVehicleCollisionArea(f32 area[4]) {
+    // The tender is only checked while the player is near the locomotive
+    area[0] = area[2] = Locomotive.position[0];
+    area[1] = area[3] = Locomotive.position[2];
+    for (auto& car : PassengerCars) {
+        if (car.isActive == 1) {
+            area[0] = MIN(area[0], car.position[0]);
+            area[1] = MIN(area[1], car.position[2]);
+            area[2] = MAX(area[2], car.position[0]);
+            area[3] = MAX(area[3], car.position[2]);
+        }
+    }
+    area[0] -= 100.0f;
+    area[1] -= 100.0f;
+    area[2] += 100.0f;
+    area[3] += 100.0f;
+    return true;
+}
+
 void ATrain::VehicleCollision(s32 playerId, Player* player) {
     TrainCarStuff* trainCar;
     f32 playerPosX;
@@ -48,12 +48,19 @@ class ATrain : public AActor {
     }
 
     virtual void Tick() override;
+    virtual bool IsParallelTickSafe() override;
+    virtual void TickCommit() override;
     virtual void Draw(Camera* camera) override;
     virtual void VehicleCollision(s32 playerId, Player* player) override;
+    virtual bool GetVehicleCollisionArea(f32 area[4]) override;
     virtual bool IsMod() override;
     s32 AddSmoke(s32 trainIndex, Vec3f pos, f32 velocity);
     void SyncComponents(TrainCarStuff* trainCar, s16 orientationY);
 
 private:
     static size_t _count;
+
+    // Left by Tick() for TickCommit()
+    u16 _oldWaypointIndex = 0;
+    s16 _locomotiveRotY = 0;
 };
\ No newline at end of file
@@ -43,7 +43,10 @@ class ATruck : public AActor {
     virtual void Tick() override;
     virtual void Draw(Camera* camera) override;
     virtual void VehicleCollision(s32 playerId, Player* player) override;
+    virtual bool GetVehicleCollisionArea(f32 area[4]) override;
+    virtual bool HasVehicleCollisionState() override;
     virtual bool IsMod() override;
+    virtual bool IsParallelTickSafe() override;
 
   private:
     static size_t _count;
@@ -4,9 +4,218 @@
 extern "C" {
 #include "macros.h"
 #include "defines.h"
+#include "main.h"
 #include "code_80005FD0.h"
+#include "math_util.h"
+#include "sounds.h"
+#include "update_objects.h"
+#include "render_player.h"
+#include "external.h"
 }
 
 uint32_t CalculateWaypointDistribution(size_t i, uint32_t numVehicles, size_t numWaypoints, uint32_t centerWaypoint) {
     return (uint32_t)(((i * numWaypoints) / numVehicles) + centerWaypoint) % numWaypoints;
 }
+
+void RoadVehicleTick(Vec3f position, Vec3f velocity, Vec3s rotation, u16* waypointIndex, f32* multiplier, f32 speed,
+                     s16 type) {
+    f32 temp_f0_2;
+    f32 temp_f0_3;
+    f32 sp5C;
+    f32 sp58;
+    f32 sp54;
+    f32 temp_f2_2;
+    s16 var_a1;
+    s16 thing;
+    Vec3f sp40;
+    Vec3f sp34;
+
+    sp5C = position[0];
+    sp58 = position[1];
+    sp54 = position[2];
+    sp40[0] = sp58;
+    sp40[1] = 0.0f;
+    sp40[2] = 0.0f;
+    temp_f0_2 = func_80013C74(type, *waypointIndex);
+    if (*multiplier < temp_f0_2) {
+        *multiplier = *multiplier + 0.06;
+        if (temp_f0_2 < *multiplier) {
+            *multiplier = temp_f0_2;
+        }
+    }
+    if (temp_f0_2 < *multiplier) {
+        *multiplier = *multiplier - 0.06;
+        if (*multiplier < temp_f0_2) {
+            *multiplier = temp_f0_2;
+        }
+    }
+    if (gIsInExtra == 0) {
+        var_a1 = func_8000D6D0(position, (s16*) waypointIndex, speed, *multiplier, 0, 3);
+    } else {
+        var_a1 = func_8000D940(position, (s16*) waypointIndex, speed, *multiplier, 0);
+    }
+    adjust_angle(&rotation[1], var_a1, 100);
+    temp_f0_3 = position[0] - sp5C;
+    temp_f2_2 = position[2] - sp54;
+    sp34[0] = position[1];
+    sp34[1] = 0.0f;
+    sp34[2] = sqrtf((temp_f0_3 * temp_f0_3) + (temp_f2_2 * temp_f2_2));
+    thing = get_angle_between_two_vectors(sp40, sp34);
+    adjust_angle(&rotation[0], -thing, 100);
+    velocity[0] = position[0] - sp5C;
+    velocity[1] = position[1] - sp58;
+    velocity[2] = position[2] - sp54;
+}
+
+void RoadVehicleAvoidance(Camera* camera, u16 waypointIndex, s16 type) {
+    s32 var_v0;
+    s32 var_s2;
+    s32 waypointCount;
+    u16 temp_a1;
+
+    waypointCount = gPathCountByPathIndex[0];
+    if (!(gPlayers[camera->playerId].speed < 1.6666666666666667)) {
+        temp_a1 = waypointIndex;
+        for (var_v0 = 0; var_v0 < 0x18; var_v0 += 3) {
+            if (((sSomeNearestPathPoint + var_v0) % waypointCount) == temp_a1) {
+                gPlayerTrackPositionFactorInstruction[camera->playerId].target =
+                    player_track_position_factor_vehicle(type, gTrackPositionFactor[camera->playerId], temp_a1);
+                return;
+            }
+        }
+    }
+}
+
+void RoadVehicleCollision(s32 playerId, Player* player, Vec3f position, Vec3f velocity, u16 waypointIndex, f32 speed,
+                          f32 length, f32 width, u32 soundBits, s8* flags, s8* passFlags) {
+    f32 temp_f12;
+    f32 temp_f14;
+    f32 temp_f22;
+
+    f32 spC4;
+    f32 spC0;
+    f32 spBC;
+
+    if (((D_801631E0[playerId] != 1) || ((((player->type & PLAYER_HUMAN) != 0)) && !(player->type & PLAYER_CPU))) &&
+        !(player->effects & 0x01000000)) {
+
+        spC4 = player->pos[0];
+        spC0 = player->pos[1];
+        spBC = player->pos[2];
+
+        temp_f12 = spC4 - position[0];
+        temp_f22 = spC0 - position[1];
+        temp_f14 = spBC - position[2];
+
+        if (((temp_f12) > -100.0) && ((temp_f12) < 100.0)) {
+            if ((temp_f22 > -20.0) && (temp_f22 < 20.0)) {
+
+                if (((temp_f14) > -100.0) && ((temp_f14) < 100.0)) {
+                    if (is_collide_with_vehicle(position[0], position[2], velocity[0], velocity[2], length, width,
+                                                spC4, spBC) == (s32) 1) {
+                        player->soundEffects |= REVERSE_SOUND_EFFECT;
+                    }
+                }
+            }
+        }
+        if ((player->type & PLAYER_HUMAN) && !(player->type & PLAYER_CPU)) {
+            if (((temp_f12) > -300.0) && ((temp_f12) < 300.0) && ((temp_f22 > -20.0)) && (temp_f22 < 20.0) &&
+                (((temp_f14) > -300.0)) && ((temp_f14) < 300.0)) {
+                if ((sVehicleSoundRenderCounter > 0) && (*flags == 0)) {
+                    sVehicleSoundRenderCounter -= 1;
+                    *flags |= (RENDER_VEHICLE << playerId);
+                    func_800C9D80(position, velocity, soundBits);
+                }
+            } else {
+                if (*flags != 0) {
+                    *flags &= ~(RENDER_VEHICLE << playerId);
+                    if (*flags == 0) {
+                        sVehicleSoundRenderCounter += 1;
+                        func_800C9EF4(position, soundBits);
+                    }
+                }
+            }
+
+            if (((temp_f12) > -200.0) && ((temp_f12) < 200.0) && ((temp_f22 > -20.0)) && (temp_f22 < 20.0) &&
+                (((temp_f14) > -200.0)) && ((temp_f14) < 200.0)) {
+                if (!(*passFlags & ((1 << playerId)))) {
+
+                    s32 var_s1 = 0;
+                    u16 path = gPathCountByPathIndex[0];
+                    s32 t1;
+                    s32 t2;
+
+                    switch (gIsInExtra) {
+                        case 0:
+                            t1 = is_path_point_in_range(waypointIndex, gNearestPathPointByPlayerId[playerId], 10, 0,
+                                                        path);
+                            if ((gIsPlayerWrongDirection[playerId] == 0) && (t1 > 0) && (player->speed < speed)) {
+                                var_s1 = 1;
+                            }
+                            if ((gIsPlayerWrongDirection[playerId] == 1) && (t1 > 0)) {
+                                var_s1 = 1;
+                            }
+                            break;
+                        case 1:
+                            t2 = is_path_point_in_range(waypointIndex, gNearestPathPointByPlayerId[playerId], 0, 10,
+                                                        path);
+                            if (t2 > 0) {
+                                if (random_int(2) == 0) {
+                                    // temp_v1_2 = gIsPlayerWrongDirection[playerId];
+                                    if (gIsPlayerWrongDirection[playerId] == 0) {
+                                        var_s1 = 1;
+                                    }
+                                    if ((gIsPlayerWrongDirection[playerId] == 1) && (player->speed < speed)) {
+                                        var_s1 = 1;
+                                    }
+                                } else {
+                                    *passFlags |= ((1 << playerId));
+                                }
+                            }
+                            break;
+                    }
+                    if (var_s1 == 1) {
+
+                        u32 soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3B);
+
+                        switch (soundBits) {
+                            case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x05):
+                                soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3B);
+                                if (random_int(4) == 0) {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3C);
+                                }
+                                break;
+                            case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x02):
+                                if (random_int(2) != 0) {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3D);
+                                } else {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3E);
+                                }
+                                break;
+                            case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03):
+                                if (random_int(2) != 0) {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3F);
+                                } else {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x40);
+                                }
+                                break;
+                            case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x04):
+                                if (random_int(2) != 0) {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x41);
+                                } else {
+                                    soundBits2 = SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x42);
+                                }
+                                break;
+                        }
+                        *passFlags |= ((1 << playerId));
+                        func_800C98B8(position, velocity, soundBits2);
+                    }
+                }
+            } else {
+                if (*passFlags & ((1 << playerId))) {
+                    *passFlags &= ~((1 << playerId));
+                }
+            }
+        }
+    }
+}
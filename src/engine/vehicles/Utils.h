@@ -2,4 +2,23 @@
 
 #include <libultraship.h>
 
+extern "C" {
+#include "camera.h"
+#include "common_structs.h"
+}
+
 uint32_t CalculateWaypointDistribution(size_t i, uint32_t numVehicles, size_t numWaypoints, uint32_t centerWaypoint);
+
+/**
+ * Behaviour shared by the cars, trucks, buses and tanker trucks of Toad's Turnpike.
+ * The state is passed in pieces so that both the vehicle actors and RoadTraffic can use it.
+ */
+
+// Follows the path one step and updates the velocity and rotation. Only touches the arguments.
+void RoadVehicleTick(Vec3f position, Vec3f velocity, Vec3s rotation, u16* waypointIndex, f32* multiplier, f32 speed,
+                     s16 type);
+// Asks the camera's player to move aside if the vehicle is just ahead of it
+void RoadVehicleAvoidance(Camera* camera, u16 waypointIndex, s16 type);
+// Bumps the player, and plays the engine and honk sounds. flags and passFlags hold a bit per player.
+void RoadVehicleCollision(s32 playerId, Player* player, Vec3f position, Vec3f velocity, u16 waypointIndex, f32 speed,
+                          f32 length, f32 width, u32 soundBits, s8* flags, s8* passFlags);
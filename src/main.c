@@ -44,7 +44,13 @@
 #include "port/interpolation/FrameInterpolation.h"
 #include "engine/wasm.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
+#include "port/GfxPool.h"
+#include "port/Frustum.h"
+#include "port/FrameTimer.h"
 #include "engine/Matrix.h"
+#include "engine/Lod.h"
+#include "port/KartTextures.h"
 
 // Declarations (not in this file)
 void func_80091B78(void);
@@ -108,7 +114,10 @@ OSContStatus gControllerStatuses[4];
 OSContPad gControllerPads[4];
 u8 gControllerBits;
 // Contains a 32x32 grid of indices into gCollisionIndices containing indices into gCollisionMesh
-CollisionGrid gCollisionGrid[1024];
+// Large tracks replace it with a finer grid allocated from the memory pool
+CollisionGrid gDefaultCollisionGrid[GRID_SIZE * GRID_SIZE];
+CollisionGrid* gCollisionGrid = gDefaultCollisionGrid;
+s32 gCollisionGridSize = GRID_SIZE;
 u16 gNumActors;
 u16 gMatrixObjectCount;
 s32 gTickLogic;   // Tick game physics at 60fps
@@ -421,7 +430,7 @@ void update_controller(s32 index) {
 
     // Prevents pause menu intereference while controlling flycam
     // Freecam only works with controller 1
-    if ((CVarGetInteger("gFreecam", 0) == 1) && (gGamestate == RACING) && (index == 0)) {
+    if ((gFrameSettings.Freecam == 1) && (gGamestate == RACING) && (index == 0)) {
         freecam_update_controller();
         return;
     }
@@ -491,6 +500,100 @@ void read_controllers(void) {
     gControllerFive->stickDepressed =
         (s16) (((gControllerOne->stickDepressed | gControllerTwo->stickDepressed) | gControllerThree->stickDepressed) |
                gControllerFour->stickDepressed);
+    FrameTimer_MarkInputSampled();
+}
+
+/**
+ * @brief Reads the controllers again right before a later game tick of the frame.
+ *
+ * The held buttons and sticks are replaced with the latest state, so a tick runs with input that is at most
+ * one tick old instead of one frame old. Presses and releases are added to the ones seen earlier in the
+ * frame, so every tick still sees a press made since the frame started, as it did when the controllers were
+ * only read once, and so does the code that runs once per frame after the ticks.
+ *
+ * Replays, demos and netplay feed their own input through the controllers once per frame, so they keep it.
+ */
+void read_controllers_for_tick(void) {
+    struct Controller previous[5];
+    s32 i;
+
+    if ((gFrameSettings.LateInputSampling == 0) || (gModeSelection == TIME_TRIALS) || (gDemoMode != 0) ||
+        gNetwork.enabled) {
+        return;
+    }
+
+    for (i = 0; i < 5; i++) {
+        previous[i] = gControllers[i];
+    }
+    read_controllers();
+    for (i = 0; i < 5; i++) {
+        gControllers[i].buttonPressed |= previous[i].buttonPressed;
+        gControllers[i].buttonDepressed |= previous[i].buttonDepressed;
+        gControllers[i].stickPressed |= previous[i].stickPressed;
+        gControllers[i].stickDepressed |= previous[i].stickDepressed;
+    }
+}
+
+// Presses and releases from frames that ran no game tick, for the ticks of the next frame that runs some
+struct Controller sCarriedControllerEdges[5];
+
+/**
+ * @brief Keeps the presses and releases of a frame that ran no game tick.
+ *
+ * The next frame reads the controllers against the buttons held now, so without this a press made in a
+ * frame without a tick would never reach a tick. The code that runs once per frame has already seen them.
+ */
+void carry_controller_edges(void) {
+    s32 i;
+
+    for (i = 0; i < 5; i++) {
+        sCarriedControllerEdges[i].buttonPressed |= gControllers[i].buttonPressed;
+        sCarriedControllerEdges[i].buttonDepressed |= gControllers[i].buttonDepressed;
+        sCarriedControllerEdges[i].stickPressed |= gControllers[i].stickPressed;
+        sCarriedControllerEdges[i].stickDepressed |= gControllers[i].stickDepressed;
+    }
+}
+
+/**
+ * @brief Adds the carried presses and releases to the controllers for this frame's ticks.
+ *
+ * @param frameEdges Receives the presses and releases read for this frame, to restore after the ticks.
+ */
+void apply_carried_controller_edges(struct Controller* frameEdges) {
+    s32 i;
+
+    for (i = 0; i < 5; i++) {
+        frameEdges[i] = gControllers[i];
+        gControllers[i].buttonPressed |= sCarriedControllerEdges[i].buttonPressed;
+        gControllers[i].buttonDepressed |= sCarriedControllerEdges[i].buttonDepressed;
+        gControllers[i].stickPressed |= sCarriedControllerEdges[i].stickPressed;
+        gControllers[i].stickDepressed |= sCarriedControllerEdges[i].stickDepressed;
+    }
+}
+
+/**
+ * @brief Takes the carried presses and releases back out once the ticks have seen them.
+ *
+ * The code that runs once per frame after the ticks saw them in the frame they were read, so it must not see
+ * them twice. Presses read again during the ticks stay.
+ */
+void drop_carried_controller_edges(const struct Controller* frameEdges) {
+    s32 i;
+
+    for (i = 0; i < 5; i++) {
+        gControllers[i].buttonPressed &=
+            ~(sCarriedControllerEdges[i].buttonPressed & ~frameEdges[i].buttonPressed);
+        gControllers[i].buttonDepressed &=
+            ~(sCarriedControllerEdges[i].buttonDepressed & ~frameEdges[i].buttonDepressed);
+        gControllers[i].stickPressed &= ~(sCarriedControllerEdges[i].stickPressed & ~frameEdges[i].stickPressed);
+        gControllers[i].stickDepressed &=
+            ~(sCarriedControllerEdges[i].stickDepressed & ~frameEdges[i].stickDepressed);
+    }
+    clear_carried_controller_edges();
+}
+
+void clear_carried_controller_edges(void) {
+    bzero(sCarriedControllerEdges, sizeof(sCarriedControllerEdges));
 }
 
 /**
@@ -553,6 +656,10 @@ void init_rcp(void) {
  * End the master display list and initialize the graphics task structure for the next frame to be rendered.
  */
 void end_master_display_list(void) {
+    GfxPool_EndFrame();
+    Frustum_EndFrame();
+    Lod_EndFrame();
+    KartTextures_EndFrame();
     gDPFullSync(gDisplayListHead++);
     gSPEndDisplayList(gDisplayListHead++);
     create_gfx_task_structure();
@@ -594,7 +701,7 @@ void rendering_init(void) {
     gGfxPool = &gGfxPools[0];
     set_segment_base_addr_x64(1, gGfxPool);
     gGfxSPTask = &gGfxPool->spTask;
-    gDisplayListHead = gGfxPool->gfxPool;
+    GfxPool_BeginFrame(gGfxPool->gfxPool, GFX_POOL_SIZE, 0);
     init_rcp();
     clear_framebuffer(0);
     end_master_display_list();
@@ -613,7 +720,7 @@ void rendering_init(void) {
 void config_gfx_pool(void) {
     gGfxPool = &gGfxPools[gGlobalTimer & 1];
     set_segment_base_addr_x64(1, gGfxPool);
-    gDisplayListHead = gGfxPool->gfxPool;
+    GfxPool_BeginFrame(gGfxPool->gfxPool, GFX_POOL_SIZE, gGlobalTimer & 1);
     gGfxSPTask = &gGfxPool->spTask;
 }
 
@@ -768,73 +875,23 @@ void game_init_clear_framebuffer(void) {
     clear_framebuffer(0);
 }
 
-//! @deprecated
-// This function was made to tick the game logic at native 60 fps.
-// However, many game objects are not in that special tick loop and run at native 30fps.
-// Thus adding `if (gTickVisuals) { // stuff here }` would prevent double speed and allow ticking visuals once every 30 fps.
-// This does not however, create extra interpolated frames. Whereas a possible solution, it is not the best solution.
-// This function should be cleaned up and removed, since frame interpolation now exists.
+/**
+ * @brief Sets how many game ticks this frame runs.
+ *
+ * Game physics tick at 60 fps on a fixed timestep, see FrameTimer.h. At the native 30 fps that is two ticks
+ * per frame, with a third to catch up after a late frame. Objects outside the tick loop still run once per
+ * frame, and frame interpolation smooths the frames in between.
+ */
 void calculate_updaterate(void) {
-    static u32 prevtime = 0;
-    static u32 remainder = 0;
-    static u32 logicAccumulator = 0;
-    static u32 visualsAccumulator = 0;
-    static u32 frameCounter = 0; // For tracking frames for logic updates
-    u32 now = SDL_GetTicks();    // Replaces osGetTime()
-    u32 frameRate = 0;
-    s32 total;
-
-    // Get target FPS from configuration variable
-    s32 targetFPS = 30;
-
-    if (targetFPS < 30) {
-        targetFPS = 30;
-    }
-
-    // Detect frame rate based on time passed
-    if (now > prevtime) {
-        total = (now - prevtime) + remainder;
-    } else {
-        // Handle counter reset (shouldn't happen with SDL_GetTicks, but kept for logic parity)
-        total = (0xffffffff - prevtime) + 1 + now + remainder;
+    gTickLogic = FrameTimer_Update();
+    gTickVisuals = 1;
+
+    // Replays, ghosts and demos record and play back input once per frame, and netplay peers must run the same
+    // ticks, so these keep the native two ticks per frame
+    if ((gModeSelection == TIME_TRIALS) || (gDemoMode != 0) || gNetwork.enabled) {
+        gTickLogic = FRAME_TIMER_NOMINAL_TICKS;
+        FrameTimer_Restart();
     }
-
-    prevtime = now;
-
-    // Avoid division by zero
-    if (total > 0) {
-        // Calculate approximate frame rate (milliseconds per frame)
-        frameRate = 1000 / total; // Frame rate in frames per second
-    } else {
-        frameRate = targetFPS; // Fallback to target FPS
-    }
-
-    // Default both to no updates
-    gTickLogic = 0;
-    gTickVisuals = 0;
-
-    // Calculate the update rates based on target FPS
-    s32 logicUpdateInterval = 1000 / 60;   // Time in ms between logic updates
-    s32 visualsUpdateInterval = 1000 / 30; // 30 FPS for visuals
-
-    // Accumulate time for logic updates
-    logicAccumulator += total;
-    if (logicAccumulator >= logicUpdateInterval) {
-        logicAccumulator -= logicUpdateInterval; // Subtract full interval
-        if (targetFPS < 60) {
-            gTickLogic = 2;
-        } else {
-            gTickLogic = 2;    // Perform logic update
-        }
-    }
-
-    // Visual updates (based on 30 FPS equivalent)
-    visualsAccumulator += total;                       // Increment for each frame
-    if (visualsAccumulator >= visualsUpdateInterval) { // Check if it's time to update visuals
-        visualsAccumulator -= visualsUpdateInterval;
-        // gTickVisuals <-- Goes here to use the native 60fps system
-    }
-    gTickVisuals = 1;    // Perform visual update
 }
 
 /**
@@ -994,8 +1051,20 @@ void race_logic_loop(void) {
     }
 
     if (gIsGamePaused == false) {
-        for (size_t i = 0; i < gTickLogic; i++) {
-            process_game_tick();
+        if (gTickLogic == 0) {
+            carry_controller_edges();
+        } else {
+            struct Controller frameEdges[5];
+
+            apply_carried_controller_edges(frameEdges);
+            for (size_t i = 0; i < gTickLogic; i++) {
+                if (i > 0) {
+                    read_controllers_for_tick();
+                }
+                FrameTimer_MarkTick();
+                process_game_tick();
+            }
+            drop_carried_controller_edges(frameEdges);
         }
         if (gIsEditorPaused == false) {
             func_80022744();
@@ -1012,6 +1081,7 @@ void race_logic_loop(void) {
         select_framebuffer();
     }
 
+    CM_PrepareViewports();
     switch (gActiveScreenMode) {
         case SCREEN_MODE_1P:
             render_screens(RENDER_SCREEN_MODE_1P_PLAYER_ONE, 0, 0);
@@ -1501,6 +1571,7 @@ void thread5_game_loop(void) {
 void thread5_iteration(void) {
     func_800CB2C4();
     calculate_delta_time();
+    FrameSettings_Refresh();
 #ifdef TARGET_N64
     while (true) {
         func_800CB2C4();
@@ -1515,6 +1586,9 @@ void thread5_iteration(void) {
     if (gGamestateNext != gGamestate) {
         gGamestate = gGamestateNext;
         update_gamestate();
+        // Loading must not be caught up on by the next frame
+        FrameTimer_Restart();
+        clear_carried_controller_edges();
     }
     profiler_log_thread5_time(THREAD5_START);
     config_gfx_pool();
@@ -59,8 +59,8 @@ struct GfxPool {
 }; // size = 0x28B70
 
 typedef struct {
-    u16 triangle; // Index for gCollisionIndices which has indexes for gCollisionMesh
-    u16 numTriangles;
+    u32 triangle; // Index for gCollisionIndices which has indexes for gCollisionMesh
+    u32 numTriangles;
 } CollisionGrid;
 
 void create_thread(OSThread*, OSId, void (*entry)(void*), void*, void*, OSPri);
@@ -72,6 +72,11 @@ void create_gfx_task_structure(void);
 void init_controllers(void);
 void update_controller(s32);
 void read_controllers(void);
+void read_controllers_for_tick(void);
+void carry_controller_edges(void);
+void apply_carried_controller_edges(struct Controller*);
+void drop_carried_controller_edges(const struct Controller*);
+void clear_carried_controller_edges(void);
 void func_80000BEC(void);
 void dispatch_audio_sptask(struct SPTask*);
 void exec_display_list(struct SPTask*);
@@ -156,7 +161,9 @@ extern OSContStatus gControllerStatuses[];
 extern OSContPad gControllerPads[];
 extern u8 gControllerBits;
 
-extern CollisionGrid gCollisionGrid[];
+extern CollisionGrid gDefaultCollisionGrid[];
+extern CollisionGrid* gCollisionGrid;
+extern s32 gCollisionGridSize;
 extern u16 gNumActors;
 extern u16 gMatrixObjectCount;
 extern s32 gTickLogic;
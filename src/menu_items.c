@@ -43,9 +43,11 @@
 #include "stdio.h"
 #include "port/Engine.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 
 #include "engine/courses/Course.h"
 #include "engine/Matrix.h"
+#include "engine/TextBatch.h"
 #include "src/engine/HM_Intro.h"
 #include "src/port/interpolation/FrameInterpolation.h"
 #include "heap.h"
@@ -75,6 +77,8 @@ struct_8018E0E8_entry D_8018E0E8[D_8018E0E8_SIZE];
 s32 sMenuTextureListIndex;
 TextureMap sMenuTextureMap[TEXTURE_MAP_MAX];
 s32 sMenuTextureEntries;
+// Bumped whenever textures leave the menu texture list, so the glyphs list theirs again
+u32 sMenuTextureGeneration = 1;
 Gfx* sGfxPtr;
 s32 gNumD_8018E768Entries;
 struct_8018E768_entry D_8018E768[D_8018E768_SIZE];
@@ -1400,16 +1404,16 @@ void func_80091B78(void) {
         }
     }
     if (gMenuSelection == LOGO_INTRO_MENU) {
-        gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
+        memory_pool_begin_course();
 #ifdef TARGET_N64
         set_segment_base_addr(6, decompress_segments((u8*) STARTUP_LOGO_ROM_START, (u8*) STARTUP_LOGO_ROM_END));
 #endif
     }
-    gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
+    memory_pool_begin_course();
     // Hypothetically, this should be a ptr... But only hypothetically.
     // sMenuTextureList = get_next_available_memory_addr(0x000900B0);
-    sTKMK00_LowResBuffer = (u8*) get_next_available_memory_addr(SCREEN_WIDTH * SCREEN_HEIGHT);
-    gSomeDLBuffer = (struct_8018EE10_entry*) get_next_available_memory_addr(0x00001000);
+    sTKMK00_LowResBuffer = (u8*) get_next_available_memory_addr(SCREEN_WIDTH * SCREEN_HEIGHT, MEMORY_TAG_MENUS);
+    gSomeDLBuffer = (struct_8018EE10_entry*) get_next_available_memory_addr(0x00001000, MEMORY_TAG_MENUS);
     func_800AF9B0();
     unref_D_8018EE0C = 0;
 
@@ -1506,8 +1510,8 @@ void func_80091FA4(void) {
     s32 i;
     //! @todo These sizes need to be sizeof() for shiftability if possible
     // sMenuTextureList = (u16*) get_next_available_memory_addr(0x000124F8);
-    sTKMK00_LowResBuffer = (u8*) get_next_available_memory_addr(0x00001000);
-    sGPPointsCopy = get_next_available_memory_addr(4);
+    sTKMK00_LowResBuffer = (u8*) get_next_available_memory_addr(0x00001000, MEMORY_TAG_MENUS);
+    sGPPointsCopy = get_next_available_memory_addr(4, MEMORY_TAG_MENUS);
 
     for (i = 0; i < 5; i++) {
         gTransitionType[i] = 0;
@@ -2038,6 +2042,30 @@ UNUSED void func_800930E4(s32 arg0, s32 arg1, char* arg2) {
     print_text_mode_1(arg0, arg1, arg2, 0, 1.0, 1.0);
 }
 
+// Generation of the menu texture list in which each glyph last listed its textures
+static u32 sGlyphGeneration[ARRAY_COUNT(gGlyphTextureLUT)];
+
+// load_menu_img searches the whole menu texture list, which used to happen for every glyph of every line drawn
+static MenuTexture* load_glyph(s32 glyphIndex) {
+    MenuTexture* glyphTexture = (MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]);
+
+    if (sGlyphGeneration[glyphIndex] != sMenuTextureGeneration) {
+        load_menu_img(glyphTexture);
+        sGlyphGeneration[glyphIndex] = sMenuTextureGeneration;
+    }
+    return glyphTexture;
+}
+
+static void begin_text_line(void) {
+    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    TextBatch_Begin();
+}
+
+static void end_text_line(void) {
+    gDisplayListHead = TextBatch_End(gDisplayListHead);
+    gSPDisplayList(gDisplayListHead++, D_020077D8);
+}
+
 // "tracking" is a uniform spacing between all characters in a given word
 void print_text0(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32 scaleY, s32 mode) {
     s32 stringWidth = 0;
@@ -2051,21 +2079,18 @@ void print_text0(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
     // @port Skip Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(false);
 
-    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    begin_text_line();
     if (*text != 0) {
         do {
             glyphIndex = char_to_glyph_index(text);
             if (glyphIndex >= 0) {
-                load_menu_img((MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]));
-                gDisplayListHead =
-                    print_letter(gDisplayListHead,
-                                 (MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]),
-                                 column + (stringWidth * scaleX), row, mode, scaleX, scaleY);
+                gDisplayListHead = print_letter(gDisplayListHead, load_glyph(glyphIndex),
+                                                column + (stringWidth * scaleX), row, mode, scaleX, scaleY);
                 stringWidth += gGlyphDisplayWidth[glyphIndex] + tracking;
             } else if ((glyphIndex != -2) && (glyphIndex == -1)) {
                 stringWidth += tracking + 7;
             } else {
-                gSPDisplayList(gDisplayListHead++, D_020077D8);
+                end_text_line();
                 return;
             }
             if (glyphIndex >= 0x30) {
@@ -2075,7 +2100,7 @@ void print_text0(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
             }
         } while (*text != 0);
     }
-    gSPDisplayList(gDisplayListHead++, D_020077D8);
+    end_text_line();
 
     // @port Resume Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(true);
@@ -2094,21 +2119,18 @@ void print_text0_wide_right(s32 column, s32 row, char* text, s32 tracking, f32 s
     // @port Skip Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(false);
 
-    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    begin_text_line();
     if (*text != 0) {
         do {
             glyphIndex = char_to_glyph_index(text);
             if (glyphIndex >= 0) {
-                load_menu_img((MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]));
-                gDisplayListHead = print_letter_wide_right(
-                    gDisplayListHead,
-                    (MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]),
-                    column + (stringWidth * scaleX), row, mode, scaleX, scaleY);
+                gDisplayListHead = print_letter_wide_right(gDisplayListHead, load_glyph(glyphIndex),
+                                                           column + (stringWidth * scaleX), row, mode, scaleX, scaleY);
                 stringWidth += gGlyphDisplayWidth[glyphIndex] + tracking;
             } else if ((glyphIndex != -2) && (glyphIndex == -1)) {
                 stringWidth += tracking + 7;
             } else {
-                gSPDisplayList(gDisplayListHead++, D_020077D8);
+                end_text_line();
                 return;
             }
             if (glyphIndex >= 0x30) {
@@ -2118,7 +2140,7 @@ void print_text0_wide_right(s32 column, s32 row, char* text, s32 tracking, f32 s
             }
         } while (*text != 0);
     }
-    gSPDisplayList(gDisplayListHead++, D_020077D8);
+    end_text_line();
 
     // @port Resume Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(true);
@@ -2193,18 +2215,17 @@ void print_text1(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
         sp60 = 2;
     }
 
-    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    begin_text_line();
     while (*text != 0) {
         glyphIndex = char_to_glyph_index(text);
         if (glyphIndex >= 0) {
-            load_menu_img(segmented_to_virtual_dupe(gGlyphTextureLUT[glyphIndex]));
-            gDisplayListHead = print_letter(gDisplayListHead, segmented_to_virtual_dupe(gGlyphTextureLUT[glyphIndex]),
-                                            column, row, sp60, scaleX, scaleY);
+            gDisplayListHead =
+                print_letter(gDisplayListHead, load_glyph(glyphIndex), column, row, sp60, scaleX, scaleY);
             column = column + (s32) ((gGlyphDisplayWidth[glyphIndex] + tracking) * scaleX);
         } else if ((glyphIndex != -2) && (glyphIndex == -1)) {
             column = column + (s32) ((tracking + 7) * scaleX);
         } else {
-            gSPDisplayList(gDisplayListHead++, D_020077D8);
+            end_text_line();
             return;
         }
         if (glyphIndex >= 0x30) {
@@ -2213,7 +2234,7 @@ void print_text1(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
             text += 1;
         }
     }
-    gSPDisplayList(gDisplayListHead++, D_020077D8);
+    end_text_line();
 
     // @port Resume Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(true);
@@ -2248,13 +2269,12 @@ void print_text2(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
     // @port Skip Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(false);
 
-    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    begin_text_line();
     if (*text != 0) {
         do {
             glyphIndex = char_to_glyph_index(text);
             if (glyphIndex >= 0) {
-                glyphTexture = (MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]);
-                load_menu_img(glyphTexture);
+                glyphTexture = load_glyph(glyphIndex);
                 gDisplayListHead =
                     print_letter(gDisplayListHead, glyphTexture, column - (gGlyphDisplayWidth[glyphIndex] / 2), row,
                                  arg6, scaleX, scaleY);
@@ -2267,7 +2287,7 @@ void print_text2(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
             } else if ((glyphIndex != -2) && (glyphIndex == -1)) {
                 column = column + (s32) ((tracking + 7) * scaleX);
             } else {
-                gSPDisplayList(gDisplayListHead++, D_020077D8);
+                end_text_line();
                 return;
             }
             if (glyphIndex >= 0x30) {
@@ -2278,7 +2298,7 @@ void print_text2(s32 column, s32 row, char* text, s32 tracking, f32 scaleX, f32
         } while (*text != 0);
     }
 
-    gSPDisplayList(gDisplayListHead++, D_020077D8);
+    end_text_line();
 
     // @port Resume Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(true);
@@ -2297,13 +2317,12 @@ void print_text2_wide(s32 column, s32 row, char* text, s32 tracking, f32 scaleX,
     // @port Skip Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(false);
 
-    gSPDisplayList(gDisplayListHead++, D_020077A8);
+    begin_text_line();
     if (*text != 0) {
         do {
             glyphIndex = char_to_glyph_index(text);
             if (glyphIndex >= 0) {
-                glyphTexture = (MenuTexture*) segmented_to_virtual_dupe((const void*) gGlyphTextureLUT[glyphIndex]);
-                load_menu_img(glyphTexture);
+                glyphTexture = load_glyph(glyphIndex);
                 gDisplayListHead =
                     print_letter_wide_right(gDisplayListHead, glyphTexture,
                                             column - (gGlyphDisplayWidth[glyphIndex] / 2), row, arg6, scaleX, scaleY);
@@ -2316,7 +2335,7 @@ void print_text2_wide(s32 column, s32 row, char* text, s32 tracking, f32 scaleX,
             } else if ((glyphIndex != -2) && (glyphIndex == -1)) {
                 column = column + (s32) ((tracking + 7) * scaleX);
             } else {
-                gSPDisplayList(gDisplayListHead++, D_020077D8);
+                end_text_line();
                 return;
             }
             if (glyphIndex >= 0x30) {
@@ -2327,7 +2346,7 @@ void print_text2_wide(s32 column, s32 row, char* text, s32 tracking, f32 scaleX,
         } while (*text != 0);
     }
 
-    gSPDisplayList(gDisplayListHead++, D_020077D8);
+    end_text_line();
 
     // @port Resume Interpolation, if interpolated later remove this tag
     FrameInterpolation_ShouldInterpolateFrame(true);
@@ -2454,8 +2473,8 @@ void func_80093E60(void) {
     s32 i;
 
     // sMenuTextureList = (u16*) get_next_available_memory_addr(0x000124F8);
-    sTKMK00_LowResBuffer = get_next_available_memory_addr(0x00001000);
-    sGPPointsCopy = get_next_available_memory_addr(4U);
+    sTKMK00_LowResBuffer = get_next_available_memory_addr(0x00001000, MEMORY_TAG_MENUS);
+    sGPPointsCopy = get_next_available_memory_addr(4U, MEMORY_TAG_MENUS);
 
     for (i = 0; i < 5; i++) {
         gTransitionType[i] = 0;
@@ -2911,7 +2930,11 @@ Gfx* draw_flash_select_case_fast(Gfx* displayListHead, s32 ulx, s32 uly, s32 lrx
 
 Gfx* func_800959F8(Gfx* displayListHead, Vtx* arg1) {
     s32 index;
-    gSPClearGeometryMode(displayListHead++, G_ZBUFFER);
+    // A line of text clears it once for all its glyphs
+    bool inTextLine = TextBatch_IsOpen();
+    if (!inTextLine) {
+        gSPClearGeometryMode(displayListHead++, G_ZBUFFER);
+    }
     if ((s32) gTextColor < TEXT_BLUE_GREEN_RED_CYCLE_1) {
         index = gTextColor;
     } else {
@@ -2931,7 +2954,9 @@ Gfx* func_800959F8(Gfx* displayListHead, Vtx* arg1) {
         gSPDisplayList(displayListHead++, D_800E850C[index]);
     }
 #endif
-    gSPSetGeometryMode(displayListHead++, G_ZBUFFER);
+    if (!inTextLine) {
+        gSPSetGeometryMode(displayListHead++, G_ZBUFFER);
+    }
     return displayListHead;
 }
 
@@ -3027,9 +3052,11 @@ Gfx* func_80095BD0(Gfx* displayListHead, u8* arg1, f32 arg2, f32 arg3, u32 arg4,
 
     displayListHead = AddTextMatrix(displayListHead, mf);
     // gSPMatrix(displayListHead++, mtx, G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
-    gDPLoadTextureTile_4b(displayListHead++, arg1, G_IM_FMT_I, arg4, 0, 0, 0, arg4, arg5 + 2, 0,
-                          G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOMASK, G_TX_NOLOD,
-                          G_TX_NOLOD);
+    if (TextBatch_LoadsTexture(arg1, arg4, arg5)) {
+        gDPLoadTextureTile_4b(displayListHead++, arg1, G_IM_FMT_I, arg4, 0, 0, 0, arg4, arg5 + 2, 0,
+                              G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOMASK,
+                              G_TX_NOLOD, G_TX_NOLOD);
+    }
     switch (arg4) {
         default:
             var_a1 = D_02007CD8;
@@ -3070,9 +3097,11 @@ Gfx* func_80095BD0_wide_right(Gfx* displayListHead, u8* arg1, f32 arg2, f32 arg3
     displayListHead = AddTextMatrix(displayListHead, mf);
     // gSPMatrix(displayListHead++, VIRTUAL_TO_PHYSICAL(&gGfxPool->mtxEffect[gMatrixEffectCount++]),
     //           G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
-    gDPLoadTextureTile_4b(displayListHead++, arg1, G_IM_FMT_I, arg4, 0, 0, 0, arg4, arg5 + 2, 0,
-                          G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOMASK, G_TX_NOLOD,
-                          G_TX_NOLOD);
+    if (TextBatch_LoadsTexture(arg1, arg4, arg5)) {
+        gDPLoadTextureTile_4b(displayListHead++, arg1, G_IM_FMT_I, arg4, 0, 0, 0, arg4, arg5 + 2, 0,
+                              G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOMASK,
+                              G_TX_NOLOD, G_TX_NOLOD);
+    }
     switch (arg4) {
         default:
             var_a1 = D_02007CD8;
@@ -3721,6 +3750,7 @@ void load_texture_reset_cache(const char* texture) {
 void replace_texture(s32 index, const char* newTexture) {
     sMenuTextureList[sMenuTextureMap[index].offset] = newTexture;
     sMenuTextureMap[index].textureData = newTexture;
+    sMenuTextureGeneration++;
     // printf("\nTEST %s %p %s idx %d\n\n", sMenuTextureList[index], sMenuTextureList[sMenuTextureListIndex],
     // newTexture, sMenuTextureListIndex);
 }
@@ -3732,6 +3762,7 @@ void clear_menu_textures(void) {
 
     sMenuTextureListIndex = 0;
     sMenuTextureEntries = 0;
+    sMenuTextureGeneration++;
 }
 
 /**
@@ -4739,12 +4770,12 @@ Gfx* print_letter(Gfx* arg0, MenuTexture* glyphTexture, f32 arg2, f32 arg3, s32
             if (var_s0->textureData != 0) {
                 switch (mode) {
                     case 1:
-                        gSPDisplayList(arg0++, D_020077F8);
+                        arg0 = TextBatch_SetMode(arg0, (const Gfx*) D_020077F8);
                         arg0 = func_80095BD0(arg0, var_s0->textureData, var_s0->dX + arg2, var_s0->dY + arg3,
                                              var_s0->width, var_s0->height, scaleX, scaleY);
                         break;
                     case 2:
-                        gSPDisplayList(arg0++, D_02007818);
+                        arg0 = TextBatch_SetMode(arg0, (const Gfx*) D_02007818);
                         arg0 = func_80095BD0(arg0, var_s0->textureData, var_s0->dX + arg2, var_s0->dY + arg3,
                                              var_s0->width, var_s0->height, scaleX, scaleY);
                         break;
@@ -4792,12 +4823,12 @@ Gfx* print_letter_wide_right(Gfx* arg0, MenuTexture* glyphTexture, f32 arg2, f32
             if (temp_v0_2 != 0) {
                 switch (mode) {
                     case 1:
-                        gSPDisplayList(arg0++, D_020077F8);
+                        arg0 = TextBatch_SetMode(arg0, (const Gfx*) D_020077F8);
                         arg0 = func_80095BD0_wide_right(arg0, temp_v0_2, var_s0->dX + arg2, var_s0->dY + arg3,
                                                         var_s0->width, var_s0->height, scaleX, scaleY);
                         break;
                     case 2:
-                        gSPDisplayList(arg0++, D_02007818);
+                        arg0 = TextBatch_SetMode(arg0, (const Gfx*) D_02007818);
                         arg0 = func_80095BD0_wide_right(arg0, temp_v0_2, var_s0->dX + arg2, var_s0->dY + arg3,
                                                         var_s0->width, var_s0->height, scaleX, scaleY);
                         break;
@@ -6375,7 +6406,7 @@ GLOBAL_ASM("asm/non_matchings/menu_items/add_menu_item.s")
 #endif
 
 static void draw_debug(void) {
-    if (CVarGetInteger("gEnableDebugMode", 0) != 0) {
+    if (gFrameSettings.EnableDebugMode != 0) {
         set_text_color(TEXT_RED);
         print_text1_right(0x138, 0xEA, "DEBUG", 0, 0.5f, 0.5f);
     }
@@ -6384,7 +6415,7 @@ static void draw_debug(void) {
 static void draw_version(void) {
     s32 column = 0x138;
 
-    if (CVarGetInteger("gEnableDebugMode", 0) != 0) {
+    if (gFrameSettings.EnableDebugMode != 0) {
         column -= (s32) ((f32) (get_string_width("DEBUG") + 5 )) * 0.5f;
     }
 
@@ -6534,7 +6565,7 @@ void render_menus(MenuItem* arg0) {
             case MENU_ITEM_UI_GAME_SELECT:
                 gDisplayListHead =
                     render_menu_textures(gDisplayListHead, seg2_game_select_texture, arg0->column, arg0->row);
-                if (CVarGetInteger("gShowSpaghettiVersion", true)) {
+                if (gFrameSettings.ShowSpaghettiVersion) {
                     draw_version();
                     draw_debug();
                 }
@@ -1,12 +1,13 @@
 #include "libultra_internal.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/FrameSettings.h"
 
 void guPerspectiveF(float mf[4][4], u16* perspNorm, float fovy, float aspect, float near, float far, float scale) {
     float yscale;
     int row;
     int col;
-    if (CVarGetInteger("gNoCulling", 0)) {
-        far = CVarGetFloat("gFarFrustrum", 10000.0f);
+    if (gFrameSettings.NoCulling) {
+        far = gFrameSettings.FarFrustrum;
     }
     guMtxIdentF(mf);
     fovy *= GU_PI / 180.0;
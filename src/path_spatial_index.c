@@ -0,0 +1,435 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <defines.h>
+#include <stdlib.h>
+#include "path_spatial_index.h"
+#include "code_80005FD0.h"
+#include "racing/memory.h"
+#include "math_util.h"
+#include "port/Game.h"
+
+// One per entry in gTrackPaths
+PathSpatialIndex gPathSpatialIndex[4];
+static TrackPathPoint* sIndexedPaths[4];
+
+static TrackPathPoint* sSortPath;
+static s32 sSortAxis;
+
+static s32 path_point_axis(TrackPathPoint* point, s32 axis) {
+    switch (axis) {
+        case 0:
+            return point->posX;
+        case 1:
+            return point->posY;
+        default:
+            return point->posZ;
+    }
+}
+
+static s32 compare_path_point_section(const void* a, const void* b) {
+    u32 indexA = *(const u32*) a;
+    u32 indexB = *(const u32*) b;
+    u16 sectionA = sSortPath[indexA].trackSectionId;
+    u16 sectionB = sSortPath[indexB].trackSectionId;
+
+    if (sectionA != sectionB) {
+        return (sectionA < sectionB) ? -1 : 1;
+    }
+    return (indexA < indexB) ? -1 : (indexA > indexB);
+}
+
+static s32 compare_path_point_axis(const void* a, const void* b) {
+    u32 indexA = *(const u32*) a;
+    u32 indexB = *(const u32*) b;
+    s32 valueA = path_point_axis(&sSortPath[indexA], sSortAxis);
+    s32 valueB = path_point_axis(&sSortPath[indexB], sSortAxis);
+
+    if (valueA != valueB) {
+        return (valueA < valueB) ? -1 : 1;
+    }
+    return (indexA < indexB) ? -1 : (indexA > indexB);
+}
+
+/**
+ * Orders points[lo, hi) into an implicit k-d tree, splitting on the axis with the largest extent.
+ */
+static void build_path_kd_tree(TrackPathPoint* path, u32* points, u8* axes, s32 lo, s32 hi) {
+    s32 min[3] = { 0x7FFF, 0x7FFF, 0x7FFF };
+    s32 max[3] = { -0x8000, -0x8000, -0x8000 };
+    s32 axis;
+    s32 mid;
+    s32 i;
+
+    if (hi - lo <= 0) {
+        return;
+    }
+
+    for (i = lo; i < hi; i++) {
+        for (axis = 0; axis < 3; axis++) {
+            s32 value = path_point_axis(&path[points[i]], axis);
+            min[axis] = MIN(min[axis], value);
+            max[axis] = MAX(max[axis], value);
+        }
+    }
+
+    axis = 0;
+    if ((max[1] - min[1]) > (max[axis] - min[axis])) {
+        axis = 1;
+    }
+    if ((max[2] - min[2]) > (max[axis] - min[axis])) {
+        axis = 2;
+    }
+
+    sSortPath = path;
+    sSortAxis = axis;
+    qsort(&points[lo], hi - lo, sizeof(u32), compare_path_point_axis);
+
+    mid = (lo + hi) / 2;
+    axes[mid] = axis;
+    build_path_kd_tree(path, points, axes, lo, mid);
+    build_path_kd_tree(path, points, axes, mid + 1, hi);
+}
+
+/**
+ * Builds the index for every loaded path. Called once the paths are loaded for a course.
+ */
+void generate_path_spatial_index(void) {
+    s32 pathIndex;
+    u32 i;
+
+    for (pathIndex = 0; pathIndex < 4; pathIndex++) {
+        PathSpatialIndex* index = &gPathSpatialIndex[pathIndex];
+        TrackPathPoint* path = gTrackPaths[pathIndex];
+        u32 numPoints = gPathCountByPathIndex[pathIndex];
+        u32 numSections;
+
+        bzero(index, sizeof(PathSpatialIndex));
+        sIndexedPaths[pathIndex] = NULL;
+
+        if ((D_80163368[pathIndex] < 2) || (numPoints == 0)) {
+            continue;
+        }
+
+        index->allPoints = get_next_available_memory_addr(numPoints * sizeof(u32), MEMORY_TAG_PATHS);
+        index->allAxes = get_next_available_memory_addr(numPoints, MEMORY_TAG_PATHS);
+        index->sectionPoints = get_next_available_memory_addr(numPoints * sizeof(u32), MEMORY_TAG_PATHS);
+        index->sectionAxes = get_next_available_memory_addr(numPoints, MEMORY_TAG_PATHS);
+
+        for (i = 0; i < numPoints; i++) {
+            index->allPoints[i] = i;
+            index->sectionPoints[i] = i;
+        }
+
+        // Group the points by section, then count the sections
+        sSortPath = path;
+        qsort(index->sectionPoints, numPoints, sizeof(u32), compare_path_point_section);
+        numSections = 1;
+        for (i = 1; i < numPoints; i++) {
+            if (path[index->sectionPoints[i]].trackSectionId != path[index->sectionPoints[i - 1]].trackSectionId) {
+                numSections++;
+            }
+        }
+
+        index->sections = get_next_available_memory_addr(numSections * sizeof(PathSectionBucket), MEMORY_TAG_PATHS);
+        index->numSections = 0;
+        for (i = 0; i < numPoints; i++) {
+            u16 sectionId = path[index->sectionPoints[i]].trackSectionId;
+
+            if ((i == 0) || (sectionId != index->sections[index->numSections - 1].trackSectionId)) {
+                index->sections[index->numSections].trackSectionId = sectionId;
+                index->sections[index->numSections].first = i;
+                index->sections[index->numSections].count = 0;
+                index->numSections++;
+            }
+            index->sections[index->numSections - 1].count++;
+        }
+
+        for (i = 0; i < index->numSections; i++) {
+            PathSectionBucket* bucket = &index->sections[i];
+            build_path_kd_tree(path, index->sectionPoints, index->sectionAxes, bucket->first,
+                               bucket->first + bucket->count);
+        }
+        build_path_kd_tree(path, index->allPoints, index->allAxes, 0, numPoints);
+
+        index->numPoints = numPoints;
+        sIndexedPaths[pathIndex] = path;
+    }
+}
+
+static bool is_path_indexed(s32 pathIndex) {
+    return (pathIndex >= 0) && (pathIndex < 4) && (gPathSpatialIndex[pathIndex].numPoints != 0) &&
+           (sIndexedPaths[pathIndex] == gTrackPaths[pathIndex]) &&
+           (gPathSpatialIndex[pathIndex].numPoints == gPathCountByPathIndex[pathIndex]);
+}
+
+static PathSectionBucket* find_path_section(PathSpatialIndex* index, u16 trackSectionId) {
+    s32 lo = 0;
+    s32 hi = index->numSections;
+
+    while (lo < hi) {
+        s32 mid = (lo + hi) / 2;
+        u16 sectionId = index->sections[mid].trackSectionId;
+
+        if (sectionId == trackSectionId) {
+            return &index->sections[mid];
+        }
+        if (sectionId < trackSectionId) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Finds the closest point with an index below limit the same way a linear scan would: a point
+ * only replaces the best one if it is strictly closer, or equally close with a lower index.
+ * While *bestIndex is -1 a point must be strictly closer than *bestDistance.
+ *
+ * Distances use the same expression as find_closest_path_point_track_section_linear so
+ * that both produce bit identical values. cellOffsets holds the distance from the query to
+ * the current cell along each axis. A subtree is only skipped once the split plane, or the
+ * cell with some slack for rounding, is farther away than the best point, so ties are never lost.
+ */
+static void search_path_kd_node(TrackPathPoint* path, u32* points, u8* axes, s32 lo, s32 hi, u32 limit,
+                                const f32* cellOffsets, f32 posX, f32 posY, f32 posZ, f32* bestDistance,
+                                s32* bestIndex) {
+    f32 offsets[3] = { cellOffsets[0], cellOffsets[1], cellOffsets[2] };
+
+    while (lo < hi) {
+        s32 mid = (lo + hi) / 2;
+        s32 axis = axes[mid];
+        u32 pointIndex = points[mid];
+        TrackPathPoint* point = &path[pointIndex];
+        f32 x_dist = (f32) point->posX - posX;
+        f32 y_dist = (f32) point->posY - posY;
+        f32 z_dist = (f32) point->posZ - posZ;
+        f32 squaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
+        f32 planeDistance;
+        f32 cellDistance;
+
+        if ((pointIndex < limit) &&
+            ((squaredDistance < *bestDistance) ||
+             ((squaredDistance == *bestDistance) && (*bestIndex >= 0) && ((s32) pointIndex < *bestIndex)))) {
+            *bestDistance = squaredDistance;
+            *bestIndex = pointIndex;
+        }
+
+        switch (axis) {
+            case 0:
+                planeDistance = x_dist;
+                break;
+            case 1:
+                planeDistance = y_dist;
+                break;
+            default:
+                planeDistance = z_dist;
+                break;
+        }
+
+        // Visit the side of the split that contains the query first
+        if (planeDistance > 0.0f) {
+            search_path_kd_node(path, points, axes, lo, mid, limit, offsets, posX, posY, posZ, bestDistance,
+                                bestIndex);
+            lo = mid + 1;
+        } else {
+            search_path_kd_node(path, points, axes, mid + 1, hi, limit, offsets, posX, posY, posZ, bestDistance,
+                                bestIndex);
+            hi = mid;
+        }
+
+        offsets[axis] = planeDistance;
+        cellDistance = (offsets[0] * offsets[0]) + (offsets[1] * offsets[1]) + (offsets[2] * offsets[2]);
+        if (((planeDistance * planeDistance) > *bestDistance) || (cellDistance > (*bestDistance * 1.0001f))) {
+            return;
+        }
+    }
+}
+
+static void search_path_kd_tree(TrackPathPoint* path, u32* points, u8* axes, s32 lo, s32 hi, u32 limit, f32 posX,
+                                f32 posY, f32 posZ, f32* bestDistance, s32* bestIndex) {
+    f32 cellOffsets[3] = { 0.0f, 0.0f, 0.0f };
+
+    search_path_kd_node(path, points, axes, lo, hi, limit, cellOffsets, posX, posY, posZ, bestDistance, bestIndex);
+}
+
+/**
+ * Scans the current path for the closest point of the section, then the other paths, then falls back to path 0.
+ * Used while the paths are not indexed.
+ */
+s16 find_closest_path_point_track_section_linear(f32 posX, f32 posY, f32 posZ, u16 trackSectionId, s32* pathIndex) {
+    TrackPathPoint* pathWaypoints;
+    TrackPathPoint* considerWaypoint;
+    f32 x_dist;
+    f32 y_dist;
+    f32 z_dist;
+    f32 considerSquaredDistance;
+    f32 minimumSquaredDistance;
+    s32 considerWaypointIndex;
+    s32 pathWaypointCount;
+    s32 temp_t0;
+    s32 var_a1;
+    s32 var_t1;
+    s32 considerPathIndex;
+    s32 var_t4;
+    s16 nearestWaypointIndex;
+
+    minimumSquaredDistance = 1000000.0f;
+    temp_t0 = *pathIndex;
+    nearestWaypointIndex = 0;
+    var_t1 = 0;
+    var_a1 = 0;
+    pathWaypoints = gTrackPaths[temp_t0];
+    pathWaypointCount = gPathCountByPathIndex[temp_t0];
+    considerWaypoint = &pathWaypoints[0];
+    for (considerWaypointIndex = 0; considerWaypointIndex < pathWaypointCount;
+         considerWaypointIndex++, considerWaypoint++) {
+        if ((considerWaypoint->trackSectionId == trackSectionId) || (IsPodiumCeremony())) {
+            var_t1 = 1;
+            x_dist = (f32) considerWaypoint->posX - posX;
+            y_dist = (f32) considerWaypoint->posY - posY;
+            z_dist = (f32) considerWaypoint->posZ - posZ;
+            considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
+            if (considerSquaredDistance < minimumSquaredDistance) {
+                nearestWaypointIndex = considerWaypointIndex;
+                var_a1 = 1;
+                minimumSquaredDistance = considerSquaredDistance;
+            }
+        }
+    }
+    if (var_t1 == 0) {
+        for (considerPathIndex = 0; considerPathIndex < 4; considerPathIndex++) {
+            if ((considerPathIndex != temp_t0) && (D_80163368[considerPathIndex] >= 2)) {
+                pathWaypoints = gTrackPaths[considerPathIndex];
+                considerWaypoint = &pathWaypoints[0];
+                pathWaypointCount = gPathCountByPathIndex[considerPathIndex];
+                for (considerWaypointIndex = 0; considerWaypointIndex < pathWaypointCount;
+                     considerWaypointIndex++, considerWaypoint++) {
+                    if (considerWaypoint->trackSectionId == trackSectionId) {
+                        x_dist = (f32) considerWaypoint->posX - posX;
+                        y_dist = (f32) considerWaypoint->posY - posY;
+                        z_dist = (f32) considerWaypoint->posZ - posZ;
+                        considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
+                        if (considerSquaredDistance < minimumSquaredDistance) {
+                            nearestWaypointIndex = considerWaypointIndex;
+                            var_t4 = considerPathIndex;
+                            var_a1 = 2;
+                            minimumSquaredDistance = considerSquaredDistance;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (var_a1 == 0) {
+        pathWaypoints = gTrackPaths[0];
+        pathWaypointCount = gPathCountByPathIndex[0];
+        considerWaypoint = &pathWaypoints[0];
+        x_dist = (f32) considerWaypoint->posX - posX;
+        y_dist = (f32) considerWaypoint->posY - posY;
+        z_dist = (f32) considerWaypoint->posZ - posZ;
+        minimumSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
+        nearestWaypointIndex = 0;
+        for (considerWaypointIndex = 1; considerWaypointIndex < pathWaypointCount;
+             considerWaypoint++, considerWaypointIndex++) {
+            x_dist = (f32) considerWaypoint->posX - posX;
+            y_dist = (f32) considerWaypoint->posY - posY;
+            z_dist = (f32) considerWaypoint->posZ - posZ;
+            considerSquaredDistance = (x_dist * x_dist) + (y_dist * y_dist) + (z_dist * z_dist);
+            if (considerSquaredDistance < minimumSquaredDistance) {
+                nearestWaypointIndex = considerWaypointIndex;
+                var_t4 = 0;
+                var_a1 = 2;
+                minimumSquaredDistance = considerSquaredDistance;
+            }
+        }
+    }
+    if (var_a1 == 2) {
+        *pathIndex = var_t4;
+    }
+    return nearestWaypointIndex;
+}
+
+/**
+ * Indexed version of find_closest_path_point_track_section_linear with identical results.
+ * @return -1 if the paths involved are not indexed
+ */
+s16 find_closest_path_point_track_section_indexed(f32 posX, f32 posY, f32 posZ, u16 trackSectionId,
+                                                  s32* pathIndex) {
+    PathSpatialIndex* index;
+    PathSectionBucket* bucket;
+    f32 minimumSquaredDistance = 1000000.0f;
+    s32 nearestWaypointIndex = -1;
+    s32 nearestPathIndex = -1;
+    bool hasSection;
+    s32 considerPathIndex;
+
+    if (!is_path_indexed(*pathIndex) || !is_path_indexed(0)) {
+        return -1;
+    }
+
+    // Closest point of this section on the current path
+    index = &gPathSpatialIndex[*pathIndex];
+    if (IsPodiumCeremony()) {
+        hasSection = true;
+        search_path_kd_tree(gTrackPaths[*pathIndex], index->allPoints, index->allAxes, 0, index->numPoints,
+                            index->numPoints, posX, posY, posZ, &minimumSquaredDistance, &nearestWaypointIndex);
+    } else {
+        bucket = find_path_section(index, trackSectionId);
+        hasSection = bucket != NULL;
+        if (hasSection) {
+            search_path_kd_tree(gTrackPaths[*pathIndex], index->sectionPoints, index->sectionAxes, bucket->first,
+                                bucket->first + bucket->count, index->numPoints, posX, posY, posZ,
+                                &minimumSquaredDistance, &nearestWaypointIndex);
+        }
+    }
+    if (nearestWaypointIndex >= 0) {
+        return nearestWaypointIndex;
+    }
+
+    // The current path has no such section, look through the other paths in order
+    if (!hasSection) {
+        for (considerPathIndex = 0; considerPathIndex < 4; considerPathIndex++) {
+            s32 pathNearest = -1;
+
+            if ((considerPathIndex == *pathIndex) || (D_80163368[considerPathIndex] < 2)) {
+                continue;
+            }
+            if (!is_path_indexed(considerPathIndex)) {
+                return -1;
+            }
+            index = &gPathSpatialIndex[considerPathIndex];
+            bucket = find_path_section(index, trackSectionId);
+            if (bucket == NULL) {
+                continue;
+            }
+            // An earlier path wins ties, so this path must be strictly closer
+            search_path_kd_tree(gTrackPaths[considerPathIndex], index->sectionPoints, index->sectionAxes,
+                                bucket->first, bucket->first + bucket->count, index->numPoints, posX, posY, posZ,
+                                &minimumSquaredDistance, &pathNearest);
+            if (pathNearest >= 0) {
+                nearestWaypointIndex = pathNearest;
+                nearestPathIndex = considerPathIndex;
+            }
+        }
+        if (nearestWaypointIndex >= 0) {
+            *pathIndex = nearestPathIndex;
+            return nearestWaypointIndex;
+        }
+    }
+
+    // Fall back to the closest point on path 0.
+    // The linear scan pairs point i - 1 with index i and never looks at the last point,
+    // and it only switches path if a point is strictly closer than point 0.
+    index = &gPathSpatialIndex[0];
+    minimumSquaredDistance = 3.4028235e38f;
+    nearestWaypointIndex = -1;
+    search_path_kd_tree(gTrackPaths[0], index->allPoints, index->allAxes, 0, index->numPoints, index->numPoints - 1,
+                        posX, posY, posZ, &minimumSquaredDistance, &nearestWaypointIndex);
+    if (nearestWaypointIndex > 0) {
+        *pathIndex = 0;
+        return nearestWaypointIndex + 1;
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef PATH_SPATIAL_INDEX_H
+#define PATH_SPATIAL_INDEX_H
+
+#include <common_structs.h>
+#include "waypoints.h"
+
+/**
+ * Nearest path point lookups for find_closest_path_point_track_section.
+ *
+ * Each loaded path gets one k-d tree over all of its points and one per trackSectionId.
+ * Trees are implicit: for a range [lo, hi) the node is the point at (lo + hi) / 2,
+ * its left subtree is [lo, mid) and its right subtree is [mid + 1, hi).
+ */
+
+typedef struct {
+    u16 trackSectionId;
+    u32 first; // Start of this section's tree in PathSpatialIndex::sectionPoints
+    u32 count;
+} PathSectionBucket;
+
+typedef struct {
+    u32 numPoints; // 0 if the path is not indexed
+    u32 numSections;
+    PathSectionBucket* sections; // Sorted by trackSectionId
+    u32* sectionPoints;
+    u8* sectionAxes;
+    u32* allPoints;
+    u8* allAxes;
+} PathSpatialIndex;
+
+extern PathSpatialIndex gPathSpatialIndex[4];
+
+void generate_path_spatial_index(void);
+s16 find_closest_path_point_track_section_linear(f32, f32, f32, u16, s32*);
+s16 find_closest_path_point_track_section_indexed(f32, f32, f32, u16, s32*);
+
+#endif // PATH_SPATIAL_INDEX_H
@@ -11,6 +11,7 @@
 #include "render_player.h"
 #include "effects.h"
 #include "collision.h"
+#include "collision_batch.h"
 #include "waypoints.h"
 #include "audio/external.h"
 #include "code_8003DC40.h"
@@ -21,6 +22,7 @@
 #include "code_80005FD0.h"
 #include "sounds.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include "src/enhancements/moon_jump.h"
 #include "engine/Matrix.h"
 
@@ -549,7 +551,7 @@ u16 check_player_camera_collision_rubberbanding(Player* player, Camera* camera,
     s16 var_v0;
     u16 ret;
 
-    if (CVarGetInteger("gDisableRubberbanding", 0) != 0) {
+    if (gFrameSettings.DisableRubberbanding != 0) {
         return true;
     }
 
@@ -1042,7 +1044,7 @@ void func_80029B4C(Player* player, UNUSED f32 arg1, f32 arg2, UNUSED f32 arg3) {
     f32 c;
     f32 d;
     Vec3f sp8C;
-    Vec3f sp80;
+    Vec3f prevTyrePos[NUM_TYRES];
     Mat3 sp5C;
     UNUSED s32 pad;
     f32 temp_f0_2;
@@ -1061,46 +1063,35 @@ void func_80029B4C(Player* player, UNUSED f32 arg1, f32 arg2, UNUSED f32 arg3) {
     sp8C[1] = -player->boundingBoxSize;
     sp8C[2] = var_f12 - 2.0f;
     mtxf_translate_vec3f_mat3(sp8C, sp5C);
-    sp80[0] = player->tyres[FRONT_LEFT].pos[0];
-    sp80[1] = player->tyres[FRONT_LEFT].pos[1];
-    sp80[2] = player->tyres[FRONT_LEFT].pos[2];
+    vec3f_copy_return(prevTyrePos[FRONT_LEFT], player->tyres[FRONT_LEFT].pos);
     player->tyres[FRONT_LEFT].pos[0] = player->pos[0] + sp8C[0];
     player->tyres[FRONT_LEFT].pos[1] = player->pos[1] + sp8C[1];
     player->tyres[FRONT_LEFT].pos[2] = player->pos[2] + sp8C[2];
-    player_terrain_collision(player, &player->tyres[FRONT_LEFT], sp80[0], sp80[1], sp80[2]);
     sp8C[0] = (-var_f12) + 3.6;
     sp8C[1] = -player->boundingBoxSize;
     sp8C[2] = var_f12 - 2.0f;
     mtxf_translate_vec3f_mat3(sp8C, sp5C);
-    sp80[0] = player->tyres[FRONT_RIGHT].pos[0];
-    sp80[1] = player->tyres[FRONT_RIGHT].pos[1];
-    sp80[2] = player->tyres[FRONT_RIGHT].pos[2];
+    vec3f_copy_return(prevTyrePos[FRONT_RIGHT], player->tyres[FRONT_RIGHT].pos);
     player->tyres[FRONT_RIGHT].pos[0] = player->pos[0] + sp8C[0];
     player->tyres[FRONT_RIGHT].pos[1] = player->pos[1] + sp8C[1];
     player->tyres[FRONT_RIGHT].pos[2] = player->pos[2] + sp8C[2];
-    player_terrain_collision(player, &player->tyres[FRONT_RIGHT], sp80[0], sp80[1], sp80[2]);
     sp8C[0] = var_f12 - 2.6;
     sp8C[1] = -player->boundingBoxSize;
     sp8C[2] = (-var_f12) + 4.0f;
     mtxf_translate_vec3f_mat3(sp8C, sp5C);
-    sp80[0] = player->tyres[BACK_LEFT].pos[0];
-    sp80[1] = player->tyres[BACK_LEFT].pos[1];
-    sp80[2] = player->tyres[BACK_LEFT].pos[2];
+    vec3f_copy_return(prevTyrePos[BACK_LEFT], player->tyres[BACK_LEFT].pos);
     player->tyres[BACK_LEFT].pos[0] = player->pos[0] + sp8C[0];
     player->tyres[BACK_LEFT].pos[1] = player->pos[1] + sp8C[1];
     player->tyres[BACK_LEFT].pos[2] = player->pos[2] + sp8C[2];
-    player_terrain_collision(player, &player->tyres[BACK_LEFT], sp80[0], sp80[1], sp80[2]);
     sp8C[0] = (-var_f12) + 2.6;
     sp8C[1] = -player->boundingBoxSize;
     sp8C[2] = (-var_f12) + 4.0f;
     mtxf_translate_vec3f_mat3(sp8C, sp5C);
-    sp80[0] = player->tyres[BACK_RIGHT].pos[0];
-    sp80[1] = player->tyres[BACK_RIGHT].pos[1];
-    sp80[2] = player->tyres[BACK_RIGHT].pos[2];
+    vec3f_copy_return(prevTyrePos[BACK_RIGHT], player->tyres[BACK_RIGHT].pos);
     player->tyres[BACK_RIGHT].pos[0] = player->pos[0] + sp8C[0];
     player->tyres[BACK_RIGHT].pos[1] = player->pos[1] + sp8C[1];
     player->tyres[BACK_RIGHT].pos[2] = player->pos[2] + sp8C[2];
-    player_terrain_collision(player, &player->tyres[BACK_RIGHT], sp80[0], sp80[1], sp80[2]);
+    player_terrain_collision_batch(player, prevTyrePos);
     if (!(player->effects & 8)) {
         a = (player->tyres[BACK_LEFT].baseHeight + player->tyres[FRONT_LEFT].baseHeight) / 2;
         move_f32_towards(&player->unk_230, a, 0.5f);
@@ -2736,8 +2727,8 @@ void func_8002D268(Player* player, UNUSED Camera* camera, s8 screenId, s8 player
         player->pos[2] = nextZ;
     }
     player->pos[1] = nextY;
-    if (CVarGetInteger("gNoWallColision", 0)) {
-        player->pos[1] = nextY < CVarGetFloat("gMinHeight", 0.0f) ? CVarGetFloat("gMinHeight", 0.0f) : nextY;
+    if (gFrameSettings.NoWallCollision) {
+        player->pos[1] = nextY < gFrameSettings.MinHeight ? gFrameSettings.MinHeight : nextY;
     }
     if ((player->type & PLAYER_HUMAN) && (!(player->type & PLAYER_CPU))) {
         func_8002BB9C(player, &nextX, &nextZ, screenId, playerId, newVelocity);
@@ -4950,7 +4941,7 @@ void func_80037BB4(Player* player, Vec3f arg1) {
 
 void func_80037CFC(Player* player, struct Controller* controller, s8 arg2) {
 
-    if (CVarGetInteger("gEnableMoonJump", 0)) {
+    if (gFrameSettings.EnableMoonJump) {
         moon_jump(player, controller);
     }
 
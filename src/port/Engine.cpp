@@ -27,6 +27,8 @@
 #include "SpaghettiGui.h"
 
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/FrameSettings.h"
+#include "engine/editor/Collision.h"
 #include <graphic/Fast3D/Fast3dWindow.h>
 #include <graphic/Fast3D/interpreter.h>
 // #include <Fast3D/gfx_rendering_api.h>
@@ -302,16 +304,16 @@ bool GameEngine::GenAssetFile() {
 }
 
 uint32_t GameEngine::GetInterpolationFPS() {
-    if (CVarGetInteger("gMatchRefreshRate", 0)) {
+    if (gFrameSettings.MatchRefreshRate) {
         return Ship::Context::GetInstance()->GetWindow()->GetCurrentRefreshRate();
 
-    } else if (CVarGetInteger("gVsyncEnabled", 1) ||
+    } else if (gFrameSettings.VsyncEnabled ||
                !Ship::Context::GetInstance()->GetWindow()->CanDisableVerticalSync()) {
         return std::min<uint32_t>(Ship::Context::GetInstance()->GetWindow()->GetCurrentRefreshRate(),
-                                  CVarGetInteger("gInterpolationFPS", 30));
+                                  gFrameSettings.InterpolationFPS);
     }
 
-    return CVarGetInteger("gInterpolationFPS", 30);
+    return gFrameSettings.InterpolationFPS;
 }
 
 uint32_t GameEngine::GetInterpolationFrameCount() {
@@ -405,7 +407,10 @@ void GameEngine::StartFrame() const {
 //     Instance->context->GetWindow()->MainLoop(run_one_game_iter);
 // }
 
-void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map<Mtx*, MtxF>>& mtx_replacements) {
+// targetFps is measured by the game thread along with the replacements, as it reads settings the game thread
+// refreshes
+void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map<Mtx*, MtxF>>& mtx_replacements,
+                             uint32_t targetFps) {
     auto wnd = std::dynamic_pointer_cast<Fast::Fast3dWindow>(Ship::Context::GetInstance()->GetWindow());
 
     if (wnd == nullptr) {
@@ -414,6 +419,9 @@ void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map
 
     auto interpreter = wnd->GetInterpreterWeak().lock().get();
 
+    wnd->SetTargetFps(targetFps);
+    wnd->SetMaximumFrameLatency(1);
+
     // Process window events for resize, mouse, keyboard events
     wnd->HandleEvents();
 
@@ -423,20 +431,30 @@ void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map
         wnd->DrawAndRunGraphicsCommands(Commands, m);
         interpreter->mInterpolationIndex++;
     }
+}
+
+bool GameEngine::AltAssetsChanged() {
+    return prevAltAssets != (CVarGetInteger("gEnhancements.Mods.AlternateAssets", 0) != 0);
+}
 
-    bool curAltAssets = CVarGetInteger("gEnhancements.Mods.AlternateAssets", 0);
-    if (prevAltAssets != curAltAssets) {
-        prevAltAssets = curAltAssets;
-        Ship::Context::GetInstance()->GetResourceManager()->SetAltAssetsEnabled(curAltAssets);
-        gfx_texture_cache_clear();
+// Swaps the loaded assets, which frees textures and meshes the game and the queued display list may use. Must
+// run on the main thread while the game thread is idle and no frame is queued.
+void GameEngine::ApplyAltAssets() {
+    if (!AltAssetsChanged()) {
+        return;
     }
+    prevAltAssets = !prevAltAssets;
+    Ship::Context::GetInstance()->GetResourceManager()->SetAltAssetsEnabled(prevAltAssets);
+    gfx_texture_cache_clear();
+    Editor::ClearCollisionMeshCache();
 }
 
-void GameEngine::ProcessGfxCommands(Gfx* commands) {
+// Must run on the game thread, before the next frame starts recording
+std::vector<std::unordered_map<Mtx*, MtxF>> GameEngine::InterpolateGfxCommands() {
     std::vector<std::unordered_map<Mtx*, MtxF>> mtx_replacements;
     int target_fps = GameEngine::Instance->GetInterpolationFPS();
-    if (CVarGetInteger("gModifyInterpolationTargetFPS", 0)) {
-        target_fps = CVarGetInteger("gInterpolationTargetFPS", 60);
+    if (gFrameSettings.ModifyInterpolationTargetFPS) {
+        target_fps = gFrameSettings.InterpolationTargetFPS;
     }
     static int last_fps;
     static int last_update_rate;
@@ -467,15 +485,13 @@ void GameEngine::ProcessGfxCommands(Gfx* commands) {
 
     time -= fps;
 
-    auto wnd = std::dynamic_pointer_cast<Fast::Fast3dWindow>(Ship::Context::GetInstance()->GetWindow());
-    if (wnd != nullptr) {
-        wnd->SetTargetFps(GetInterpolationFPS());
-        wnd->SetMaximumFrameLatency(1);
-    }
-    RunCommands(commands, mtx_replacements);
-
     last_fps = fps;
     last_update_rate = 2;
+    return mtx_replacements;
+}
+
+void GameEngine::ProcessGfxCommands(Gfx* commands) {
+    RunCommands(commands, InterpolateGfxCommands(), GetInterpolationFPS());
 }
 
 // Audio
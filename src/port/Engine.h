@@ -68,9 +68,13 @@ class GameEngine {
     static uint32_t GetInterpolationFPS();
     static uint32_t GetInterpolationFrameCount();
     void StartFrame() const;
-    static void RunCommands(Gfx* Commands, const std::vector<std::unordered_map<Mtx*, MtxF>>& mtx_replacements);
+    static void RunCommands(Gfx* Commands, const std::vector<std::unordered_map<Mtx*, MtxF>>& mtx_replacements,
+                            uint32_t targetFps);
+    static bool AltAssetsChanged();
+    static void ApplyAltAssets();
     void ProcessFrame(void (*run_one_game_iter)()) const;
     static void Destroy();
+    static std::vector<std::unordered_map<Mtx*, MtxF>> InterpolateGfxCommands();
     static void ProcessGfxCommands(Gfx* commands);
     static uint8_t GetBankIdByName(const std::string& name);
     static int ShowYesNoBox(const char* title, const char* box);
@@ -0,0 +1,222 @@
+#include "FramePipeline.h"
+#include <libultraship.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <bridge/gfxdebuggerbridge.h>
+
+#include "port/Engine.h"
+#include "port/FrameSettings.h"
+
+extern "C" {
+#include "main.h"
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Everything the draw needs from the game thread, taken when the frame is finished
+struct PendingFrame {
+    Gfx* Commands = nullptr;
+    std::vector<std::unordered_map<Mtx*, MtxF>> Replacements;
+    uint32_t TargetFps = 30;
+};
+
+struct {
+    std::thread Thread;
+    std::condition_variable ToThread, FromThread;
+    std::mutex Mutex;
+    void (*Iteration)(void) = nullptr;
+    bool Running = false;
+    bool Processing = false;
+} sGameThread;
+
+PendingFrame sPending;
+bool sHasPending = false;
+// Set while the game thread runs a pipelined iteration. Only changed while the game thread is idle.
+bool sPipelining = false;
+
+// Milliseconds spent in the current report window
+struct FrameTimes {
+    f64 Game = 0.0;
+    f64 Draw = 0.0;
+    f64 Frame = 0.0;
+    f64 Overlap = 0.0;
+    u32 Frames = 0;
+    u32 Pipelined = 0;
+};
+FrameTimes sTimes;
+f64 sFrameDraw = 0.0; // Drawing done by the current frame
+
+f64 MsSince(Clock::time_point start) {
+    return std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+}
+
+void HandleGameThread() {
+    while (true) {
+        void (*iteration)(void);
+        {
+            std::unique_lock<std::mutex> lock(sGameThread.Mutex);
+            while (!sGameThread.Processing && sGameThread.Running) {
+                sGameThread.ToThread.wait(lock);
+            }
+            if (!sGameThread.Running) {
+                break;
+            }
+            iteration = sGameThread.Iteration;
+        }
+
+        iteration();
+
+        {
+            std::unique_lock<std::mutex> lock(sGameThread.Mutex);
+            sGameThread.Processing = false;
+        }
+        sGameThread.FromThread.notify_one();
+    }
+}
+
+void Draw(const PendingFrame& frame) {
+    auto start = Clock::now();
+    GameEngine::RunCommands(frame.Commands, frame.Replacements, frame.TargetFps);
+    sFrameDraw += MsSince(start);
+}
+
+// Called by the game thread once the frame's display list is finished
+PendingFrame FinishFrame(Gfx* commands) {
+    PendingFrame frame;
+    frame.Commands = commands;
+    frame.Replacements = GameEngine::InterpolateGfxCommands();
+    frame.TargetFps = GameEngine::GetInterpolationFPS();
+    return frame;
+}
+
+void DrawPending() {
+    if (!sHasPending) {
+        return;
+    }
+    sHasPending = false;
+    Draw(sPending);
+}
+
+// Takes the queued frame, so the game thread can queue the next one while it is drawn
+bool TakePending(PendingFrame& frame) {
+    if (!sHasPending) {
+        return false;
+    }
+    sHasPending = false;
+    frame = std::move(sPending);
+    sPending = {};
+    return true;
+}
+
+bool CanPipeline() {
+    if (!gFrameSettings.PipelinedRendering || gFrameSettings.EditorEnabled) {
+        return false;
+    }
+    // update_gamestate loads the next scene, which frees what the queued display list points to. Swapping the
+    // alternate assets frees the textures it uses.
+    if ((gGamestateNext != gGamestate) || GameEngine::AltAssetsChanged()) {
+        return false;
+    }
+    if (GfxDebuggerIsDebugging() || GfxDebuggerIsDebuggingRequested()) {
+        return false;
+    }
+    return !Ship::Context::GetInstance()->GetWindow()->GetGui()->GetMenuOrMenubarVisible();
+}
+
+void Report() {
+    if (!gFrameSettings.ReportFramePipeline) {
+        return;
+    }
+    f64 frames = sTimes.Frames;
+    printf("[FramePipeline] %u of %u frames pipelined. Per frame: game %.2f ms, draw %.2f ms, total %.2f ms, "
+           "%.2f ms of the game overlapped with drawing\n",
+           sTimes.Pipelined, sTimes.Frames, sTimes.Game / frames, sTimes.Draw / frames, sTimes.Frame / frames,
+           sTimes.Overlap / frames);
+}
+
+} // namespace
+
+extern "C" void FramePipeline_RunFrame(void (*gameIteration)(void)) {
+    auto frameStart = Clock::now();
+    f64 game;
+
+    sFrameDraw = 0.0;
+    if (!CanPipeline()) {
+        // Frames are drawn in order, and the queued one before the game can change what it points to
+        DrawPending();
+        sPipelining = false;
+        GameEngine::ApplyAltAssets();
+
+        f64 drawnBefore = sFrameDraw;
+        auto gameStart = Clock::now();
+        gameIteration();
+        game = MsSince(gameStart) - (sFrameDraw - drawnBefore);
+    } else {
+        if (!sGameThread.Running) {
+            sGameThread.Running = true;
+            sGameThread.Thread = std::thread(HandleGameThread);
+        }
+        sPipelining = true;
+
+        PendingFrame drawing;
+        bool hasDrawing = TakePending(drawing);
+        auto gameStart = Clock::now();
+        {
+            std::unique_lock<std::mutex> lock(sGameThread.Mutex);
+            sGameThread.Iteration = gameIteration;
+            sGameThread.Processing = true;
+        }
+        sGameThread.ToThread.notify_one();
+
+        if (hasDrawing) {
+            Draw(drawing);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(sGameThread.Mutex);
+            while (sGameThread.Processing) {
+                sGameThread.FromThread.wait(lock);
+            }
+        }
+        game = MsSince(gameStart);
+        sTimes.Pipelined++;
+    }
+
+    f64 frame = MsSince(frameStart);
+    sTimes.Game += game;
+    sTimes.Draw += sFrameDraw;
+    sTimes.Frame += frame;
+    sTimes.Overlap += std::max(0.0, game + sFrameDraw - frame);
+    if (++sTimes.Frames >= 60) {
+        Report();
+        sTimes = {};
+    }
+}
+
+extern "C" void FramePipeline_PushFrame(Gfx* commands) {
+    if (!sPipelining) {
+        Draw(FinishFrame(commands));
+        return;
+    }
+    // Drawn by the main thread while the game runs the next frame
+    sPending = FinishFrame(commands);
+    sHasPending = true;
+}
+
+extern "C" void FramePipeline_Destroy(void) {
+    if (!sGameThread.Running) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(sGameThread.Mutex);
+        sGameThread.Running = false;
+    }
+    sGameThread.ToThread.notify_all();
+    sGameThread.Thread.join();
+}
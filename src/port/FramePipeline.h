@@ -0,0 +1,37 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <libultraship.h>
+
+/**
+ * Overlaps the game logic of a frame with drawing the frame before it.
+ *
+ * Normally a frame runs the game and then interprets its display list, one after the other on the main
+ * thread. With gPipelinedRendering set, the game runs on a thread of its own while the main thread draws the
+ * display list submitted by the previous frame. The N64 overlapped its CPU and RSP the same way, and the port
+ * keeps to the same rule: the display list and the matrices it points to come from one of two pools that
+ * alternate between frames, so the game writes one while the other is drawn.
+ *
+ * The queued frame is drawn before the game runs, instead of alongside it, when a gamestate change is about
+ * to load or free resources the display list may point to, and while the menu, the editor or the gfx
+ * debugger is open, since those change game state from the main thread.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Runs one game iteration, on the game thread when the frame can be pipelined
+void FramePipeline_RunFrame(void (*gameIteration)(void));
+
+// Takes the finished display list of a game iteration. Draws it right away unless the frame is pipelined.
+void FramePipeline_PushFrame(Gfx* commands);
+
+// Stops the game thread
+void FramePipeline_Destroy(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PIPELINE_H
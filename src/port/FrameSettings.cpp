@@ -0,0 +1,51 @@
+#include "FrameSettings.h"
+#include <libultraship.h>
+#include <atomic>
+#include <cstdio>
+
+#define FRAME_SETTINGS_DEFAULT(field, name, defaultValue) defaultValue,
+
+// Holds the defaults until the first refresh
+FrameSettings gFrameSettings = { FRAME_SETTINGS_INTEGERS(FRAME_SETTINGS_DEFAULT)
+                                     FRAME_SETTINGS_FLOATS(FRAME_SETTINGS_DEFAULT) };
+
+#undef FRAME_SETTINGS_DEFAULT
+
+static std::atomic<uint32_t> sLookups = 0;
+static uint32_t sLastFrameLookups = 0;
+static uint32_t sFramesSinceReport = 0;
+
+extern "C" s32 FrameSettings_GetInteger(const char* name, s32 defaultValue) {
+    sLookups.fetch_add(1, std::memory_order_relaxed);
+    return CVarGetInteger(name, defaultValue);
+}
+
+extern "C" f32 FrameSettings_GetFloat(const char* name, f32 defaultValue) {
+    sLookups.fetch_add(1, std::memory_order_relaxed);
+    return CVarGetFloat(name, defaultValue);
+}
+
+extern "C" u32 FrameSettings_GetLookupCount(void) {
+    return sLastFrameLookups;
+}
+
+extern "C" void FrameSettings_Refresh(void) {
+    sLastFrameLookups = sLookups.exchange(0, std::memory_order_relaxed);
+
+#define FRAME_SETTINGS_READ_INTEGER(field, name, defaultValue) \
+    gFrameSettings.field = FrameSettings_GetInteger(name, defaultValue);
+#define FRAME_SETTINGS_READ_FLOAT(field, name, defaultValue) \
+    gFrameSettings.field = FrameSettings_GetFloat(name, defaultValue);
+
+    FRAME_SETTINGS_INTEGERS(FRAME_SETTINGS_READ_INTEGER)
+    FRAME_SETTINGS_FLOATS(FRAME_SETTINGS_READ_FLOAT)
+
+#undef FRAME_SETTINGS_READ_INTEGER
+#undef FRAME_SETTINGS_READ_FLOAT
+
+    // Once a second at 60 fps is plenty for the console
+    if (gFrameSettings.ReportCVarLookups && ++sFramesSinceReport >= 60) {
+        sFramesSinceReport = 0;
+        printf("FrameSettings: %u CVar lookups last frame\n", sLastFrameLookups);
+    }
+}
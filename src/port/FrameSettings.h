@@ -0,0 +1,90 @@
+#ifndef FRAME_SETTINGS_H
+#define FRAME_SETTINGS_H
+
+#include <libultraship.h>
+
+/**
+ * CVars read by per-frame code, copied into plain fields once per frame.
+ *
+ * Every CVar lookup hashes its name, which used to happen once per actor per frame for things like
+ * gNoCulling. To cache another CVar, add a line to one of the lists below and read
+ * gFrameSettings.Field instead of calling CVarGetInteger. The default must be the one every old caller used.
+ */
+
+//  Field                         CVar                                    Default
+#define FRAME_SETTINGS_INTEGERS(X)                                                     \
+    X(NoCulling,                    "gNoCulling",                           0)         \
+    X(DisableLod,                   "gDisableLod",                          1)         \
+    X(Freecam,                      "gFreecam",                             0)         \
+    X(EnableDebugMode,              "gEnableDebugMode",                     0)         \
+    X(EditorEnabled,                "gEditorEnabled",                       0)         \
+    X(HarderCPU,                    "gHarderCPU",                           0)         \
+    X(EnableCustomCC,               "gEnableCustomCC",                      0)         \
+    X(NoWallCollision,              "gNoWallColision",                      0)         \
+    X(DisableRubberbanding,         "gDisableRubberbanding",                0)         \
+    X(EnableMoonJump,               "gEnableMoonJump",                      0)         \
+    X(EnableDigitalSpeedometer,     "gEnableDigitalSpeedometer",            0)         \
+    X(BetterResultPortraits,        "gBetterResultPortraits",               0)         \
+    X(ShowSpaghettiVersion,         "gShowSpaghettiVersion",                1)         \
+    X(RenderCollisionMesh,          "gRenderCollisionMesh",                 0)         \
+    X(MatchRefreshRate,             "gMatchRefreshRate",                    0)         \
+    X(VsyncEnabled,                 "gVsyncEnabled",                        1)         \
+    X(InterpolationFPS,             "gInterpolationFPS",                    30)        \
+    X(ModifyInterpolationTargetFPS, "gModifyInterpolationTargetFPS",        0)         \
+    X(InterpolationTargetFPS,       "gInterpolationTargetFPS",              60)        \
+    X(AlternateAssets,              "gEnhancements.Mods.AlternateAssets",   0)         \
+    X(ReportCVarLookups,            "gReportCVarLookups",                   0)         \
+    X(ReportGfxPool,                "gReportGfxPool",                       0)         \
+    X(ReportCulling,                "gReportCulling",                       0)         \
+    X(LateInputSampling,            "gLateInputSampling",                   1)         \
+    X(ReportFrameTiming,            "gReportFrameTiming",                   0)         \
+    X(PipelinedRendering,           "gPipelinedRendering",                  0)         \
+    X(ReportFramePipeline,          "gReportFramePipeline",                 0)         \
+    X(ReportLod,                    "gReportLod",                           0)         \
+    X(BatchDraws,                   "gBatchDraws",                          1)         \
+    X(StableKartPalettes,           "gStableKartPalettes",                  1)         \
+    X(ReportKartTextures,           "gReportKartTextures",                  0)         \
+    X(BatchText,                    "gBatchText",                           1)         \
+    X(PickingBvh,                   "gPickingBvh",                          1)         \
+    X(EditorAutosaveSeconds,        "gEditorAutosaveSeconds",               30)         \
+    X(ValidateEntityHandles,        "gValidateEntityHandles",               0)         \
+    X(ParallelTick,                 "gParallelTick",                        1)         \
+    X(ParallelViewports,            "gParallelViewports",                   1)
+
+#define FRAME_SETTINGS_FLOATS(X)                                                       \
+    X(CustomCC,                     "gCustomCC",                            150.0f)    \
+    X(MinHeight,                    "gMinHeight",                           0.0f)      \
+    X(FarFrustrum,                  "gFarFrustrum",                         10000.0f)
+
+#define FRAME_SETTINGS_INTEGER_FIELD(field, name, defaultValue) s32 field;
+#define FRAME_SETTINGS_FLOAT_FIELD(field, name, defaultValue) f32 field;
+
+typedef struct {
+    FRAME_SETTINGS_INTEGERS(FRAME_SETTINGS_INTEGER_FIELD)
+    FRAME_SETTINGS_FLOATS(FRAME_SETTINGS_FLOAT_FIELD)
+} FrameSettings;
+
+#undef FRAME_SETTINGS_INTEGER_FIELD
+#undef FRAME_SETTINGS_FLOAT_FIELD
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern FrameSettings gFrameSettings;
+
+// Rereads every cached CVar. Called once at the start of each game frame.
+void FrameSettings_Refresh(void);
+
+// CVar lookups that are counted towards the per frame total, for settings that are not cached
+s32 FrameSettings_GetInteger(const char* name, s32 defaultValue);
+f32 FrameSettings_GetFloat(const char* name, f32 defaultValue);
+
+// Number of counted CVar lookups made during the previous frame, including the refresh itself
+u32 FrameSettings_GetLookupCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_SETTINGS_H
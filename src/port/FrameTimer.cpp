@@ -0,0 +1,139 @@
+#include "FrameTimer.h"
+#include <libultraship.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "port/FrameSettings.h"
+
+namespace {
+
+constexpr uint64_t NsPerSecond = 1000000000ULL;
+
+uint64_t TickToNs(uint64_t ticks) {
+    return (ticks * NsPerSecond) / FRAME_TIMER_TICK_RATE;
+}
+
+f64 NsToMs(f64 ns) {
+    return ns / 1000000.0;
+}
+
+FrameTickAccumulator sAccumulator;
+FrameTimingStats sStats;
+uint64_t sLastSample = 0;
+
+uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+s32 FrameTickAccumulator::Advance(uint64_t now) {
+    if (!mStarted) {
+        mStarted = true;
+        mLast = now;
+        return FRAME_TIMER_NOMINAL_TICKS;
+    }
+    mUnits += (now - mLast) * FRAME_TIMER_TICK_RATE;
+    mLast = now;
+
+    uint64_t ticks = mUnits / NsPerSecond;
+    mUnits %= NsPerSecond;
+    if (ticks > FRAME_TIMER_MAX_TICKS) {
+        mDropped += TickToNs(ticks - FRAME_TIMER_MAX_TICKS);
+        ticks = FRAME_TIMER_MAX_TICKS;
+    }
+    return (s32) ticks;
+}
+
+uint64_t FrameTickAccumulator::TakeDropped() {
+    uint64_t dropped = mDropped;
+    mDropped = 0;
+    return dropped;
+}
+
+void FrameTimingStats::AddFrame(uint64_t now, s32 ticks, uint64_t dropped) {
+    if ((Frames == 0) && (TicksGranted == 0)) {
+        // The first frame's ticks stand for the time just before it
+        Origin = now - TickToNs(ticks);
+    }
+    FrameFirstTick = TicksGranted;
+    TickInFrame = 0;
+    TicksGranted += ticks;
+    DroppedTotal += dropped;
+    Dropped += dropped;
+    ShortFrames += (ticks < FRAME_TIMER_NOMINAL_TICKS);
+    LongFrames += (ticks > FRAME_TIMER_NOMINAL_TICKS);
+    Frames++;
+}
+
+void FrameTimingStats::AddTick(uint64_t now, uint64_t sampled) {
+    // A tick can run once the 1/60 of a second it stands for has passed
+    uint64_t gameTime = Origin + DroppedTotal + TickToNs(FrameFirstTick + ++TickInFrame);
+    f64 offset = NsToMs((f64) (int64_t) (now - gameTime));
+
+    OffsetSum += offset;
+    OffsetSquares += offset * offset;
+
+    uint64_t age = (now > sampled) ? (now - sampled) : 0;
+    AgeTotal += age;
+    AgeMax = std::max(AgeMax, age);
+    Ticks++;
+}
+
+f64 FrameTimingStats::JitterMs() const {
+    if (Ticks == 0) {
+        return 0.0;
+    }
+    f64 mean = OffsetSum / Ticks;
+    return sqrt(std::max(0.0, (OffsetSquares / Ticks) - (mean * mean)));
+}
+
+f64 FrameTimingStats::AverageAgeMs() const {
+    return (Ticks > 0) ? NsToMs((f64) AgeTotal / Ticks) : 0.0;
+}
+
+void FrameTimingStats::ResetWindow() {
+    Frames = 0;
+    Ticks = 0;
+    ShortFrames = 0;
+    LongFrames = 0;
+    OffsetSum = 0.0;
+    OffsetSquares = 0.0;
+    AgeTotal = 0;
+    AgeMax = 0;
+    Dropped = 0;
+}
+
+extern "C" s32 FrameTimer_Update(void) {
+    uint64_t now = Now();
+    s32 ticks = sAccumulator.Advance(now);
+
+    sStats.AddFrame(now, ticks, sAccumulator.TakeDropped());
+    if (sStats.Frames >= 60) {
+        if (gFrameSettings.ReportFrameTiming) {
+            printf("[FrameTimer] %u frames ran %u ticks, %u frames with fewer and %u with more than two, tick jitter "
+                   "%.2f ms, input age at tick %.2f ms avg %.2f ms max, %.1f ms dropped\n",
+                   sStats.Frames, sStats.Ticks, sStats.ShortFrames, sStats.LongFrames, sStats.JitterMs(),
+                   sStats.AverageAgeMs(), NsToMs((f64) sStats.AgeMax), NsToMs((f64) sStats.Dropped));
+        }
+        sStats.ResetWindow();
+    }
+    return ticks;
+}
+
+extern "C" void FrameTimer_Restart(void) {
+    sAccumulator = FrameTickAccumulator();
+    sStats = FrameTimingStats();
+}
+
+extern "C" void FrameTimer_MarkInputSampled(void) {
+    sLastSample = Now();
+}
+
+extern "C" void FrameTimer_MarkTick(void) {
+    sStats.AddTick(Now(), sLastSample);
+}
@@ -0,0 +1,88 @@
+#ifndef FRAME_TIMER_H
+#define FRAME_TIMER_H
+
+#include <libultraship.h>
+
+/**
+ * Fixed timestep for the game ticks.
+ *
+ * The time since the last game frame is added to an accumulator counted in nanoseconds, and every whole
+ * 1/60 of a second in it runs one game tick. A frame that comes late runs an extra tick to catch up, and one
+ * that comes early runs one fewer, so the race runs at the same speed however the frames are paced. What is
+ * left over carries into the next frame, so no time is lost to rounding.
+ */
+
+#define FRAME_TIMER_TICK_RATE 60
+// Ticks run by the first frame, the same as a frame at the native 30 fps
+#define FRAME_TIMER_NOMINAL_TICKS 2
+// Most ticks one frame can run. The rest of a longer hitch is dropped instead of caught up on.
+#define FRAME_TIMER_MAX_TICKS 6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Measures the time since the previous call and returns the number of game ticks it covers
+s32 FrameTimer_Update(void);
+
+// Makes the next update run the nominal ticks, as after a load that took many frames' worth of time
+void FrameTimer_Restart(void);
+
+// Called when the controllers are read and right before each game tick, to measure the time between them
+void FrameTimer_MarkInputSampled(void);
+void FrameTimer_MarkTick(void);
+
+#ifdef __cplusplus
+}
+
+/**
+ * The accumulator FrameTimer_Update runs on the real clock, and tests/frame_timer_checks.cpp on a mocked one.
+ * Time is counted in nanoseconds times the tick rate, so one tick is exactly a second's worth of units and a
+ * frame never loses the part of a nanosecond that 1/60 of a second does not divide into.
+ */
+class FrameTickAccumulator {
+  public:
+    // Takes the clock in nanoseconds and returns the ticks the time since the previous call covers
+    s32 Advance(uint64_t now);
+
+    // Time dropped by hitches since the last call
+    uint64_t TakeDropped();
+
+  private:
+    bool mStarted = false;
+    uint64_t mLast = 0;
+    uint64_t mUnits = 0;
+    uint64_t mDropped = 0;
+};
+
+/**
+ * Compares when each tick ran against the game time it stands for. Tick jitter is the standard deviation of
+ * that offset, and the input age is how old the controller state a tick ran with was.
+ */
+struct FrameTimingStats {
+    uint64_t Origin = 0;
+    uint64_t TicksGranted = 0;
+    uint64_t DroppedTotal = 0;
+    s32 TickInFrame = 0;
+    uint64_t FrameFirstTick = 0;
+
+    // Reset every window
+    u32 Frames = 0;
+    u32 Ticks = 0;
+    u32 ShortFrames = 0; // Ran fewer ticks than a frame at 30 fps
+    u32 LongFrames = 0;  // Ran more
+    f64 OffsetSum = 0.0;
+    f64 OffsetSquares = 0.0;
+    uint64_t AgeTotal = 0;
+    uint64_t AgeMax = 0;
+    uint64_t Dropped = 0;
+
+    void AddFrame(uint64_t now, s32 ticks, uint64_t dropped);
+    void AddTick(uint64_t now, uint64_t sampled);
+    f64 JitterMs() const;
+    f64 AverageAgeMs() const;
+    void ResetWindow();
+};
+#endif
+
+#endif // FRAME_TIMER_H
@@ -0,0 +1,206 @@
+#include "Frustum.h"
+#include <libultraship.h>
+#include <cmath>
+#include <cstdio>
+
+#include "port/FrameSettings.h"
+
+namespace {
+
+// Interpolated frames draw the display list from cameras between two game frames, and the screen may be
+// wider than gScreenAspect. The sides of the frustum are widened by this much so nothing pops in at the edges.
+constexpr f32 SideMargin = 1.2f;
+
+struct ViewportCounts {
+    u32 Drawn;
+    u32 Culled;
+};
+
+FrustumView sView;
+bool sValid = false;
+ViewportCounts sCounts[FRUSTUM_MAX_VIEWPORTS];
+ViewportCounts sLastCounts[FRUSTUM_MAX_VIEWPORTS];
+uint32_t sFramesSinceReport = 0;
+
+f32 Dot(const f32 a[3], const f32 b[3]) {
+    return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]);
+}
+
+void Normalize(f32 v[3]) {
+    f32 length = sqrtf(Dot(v, v));
+    if (length > 0.0f) {
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+}
+
+// The first three floats of a plane are its normal, the fourth its distance
+void SetPlane(f32 plane[4], const f32 normal[3], const f32 point[3]) {
+    plane[0] = normal[0];
+    plane[1] = normal[1];
+    plane[2] = normal[2];
+    Normalize(plane);
+    plane[3] = -Dot(plane, point);
+}
+
+bool Count(bool visible) {
+    ViewportCounts& counts = sCounts[sView.Viewport];
+    if (visible) {
+        counts.Drawn++;
+    } else {
+        counts.Culled++;
+    }
+    return visible;
+}
+
+} // namespace
+
+extern "C" void Frustum_BuildView(FrustumView* view, s32 viewport, Vec3f pos, Vec3f lookAt, Vec3f up, f32 fovY,
+                                  f32 aspect, f32 nearPlane, f32 farPlane) {
+    f32 forward[3] = { lookAt[0] - pos[0], lookAt[1] - pos[1], lookAt[2] - pos[2] };
+    Normalize(forward);
+
+    // Same basis as guLookAt
+    f32 right[3] = { (forward[1] * up[2]) - (forward[2] * up[1]), (forward[2] * up[0]) - (forward[0] * up[2]),
+                     (forward[0] * up[1]) - (forward[1] * up[0]) };
+    Normalize(right);
+    f32 trueUp[3] = { (right[1] * forward[2]) - (right[2] * forward[1]),
+                      (right[2] * forward[0]) - (right[0] * forward[2]),
+                      (right[0] * forward[1]) - (right[1] * forward[0]) };
+
+    f32 tanY = tanf(fovY * (M_PI / 360.0f)) * SideMargin;
+    f32 tanX = tanY * aspect;
+    f32 nearPoint[3] = { pos[0] + forward[0] * nearPlane, pos[1] + forward[1] * nearPlane,
+                         pos[2] + forward[2] * nearPlane };
+    f32 farPoint[3] = { pos[0] + forward[0] * farPlane, pos[1] + forward[1] * farPlane,
+                        pos[2] + forward[2] * farPlane };
+    f32 back[3] = { -forward[0], -forward[1], -forward[2] };
+    f32 normal[3];
+
+    SetPlane(view->Planes[0], forward, nearPoint);
+    SetPlane(view->Planes[1], back, farPoint);
+    // A point at x along right and z along forward is inside the left and right planes while |x| <= z * tanX
+    for (s32 i = 0; i < 3; i++) {
+        normal[i] = right[i] + forward[i] * tanX;
+    }
+    SetPlane(view->Planes[2], normal, pos);
+    for (s32 i = 0; i < 3; i++) {
+        normal[i] = -right[i] + forward[i] * tanX;
+    }
+    SetPlane(view->Planes[3], normal, pos);
+    for (s32 i = 0; i < 3; i++) {
+        normal[i] = trueUp[i] + forward[i] * tanY;
+    }
+    SetPlane(view->Planes[4], normal, pos);
+    for (s32 i = 0; i < 3; i++) {
+        normal[i] = -trueUp[i] + forward[i] * tanY;
+    }
+    SetPlane(view->Planes[5], normal, pos);
+
+    view->Viewport = ((viewport >= 0) && (viewport < FRUSTUM_MAX_VIEWPORTS)) ? viewport : 0;
+    view->CameraPos[0] = pos[0];
+    view->CameraPos[1] = pos[1];
+    view->CameraPos[2] = pos[2];
+}
+
+extern "C" void Frustum_SetCamera(s32 viewport, Vec3f pos, Vec3f lookAt, Vec3f up, f32 fovY, f32 aspect,
+                                  f32 nearPlane, f32 farPlane) {
+    Frustum_BuildView(&sView, viewport, pos, lookAt, up, fovY, aspect, nearPlane, farPlane);
+    sValid = true;
+}
+
+extern "C" bool Frustum_GetView(FrustumView* view) {
+    if (!sValid) {
+        return false;
+    }
+    *view = sView;
+    return true;
+}
+
+extern "C" bool Frustum_TestSphere(Vec3f center, f32 radius) {
+    if (!sValid || gFrameSettings.NoCulling) {
+        return true;
+    }
+    for (const f32* plane : sView.Planes) {
+        if (Dot(plane, center) + plane[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+extern "C" bool Frustum_TestBoxInView(const FrustumView* view, Vec3f min, Vec3f max) {
+    if (gFrameSettings.NoCulling) {
+        return true;
+    }
+    for (const f32* plane : view->Planes) {
+        // The corner furthest along the plane's normal
+        f32 corner[3];
+        for (s32 i = 0; i < 3; i++) {
+            corner[i] = (plane[i] >= 0.0f) ? max[i] : min[i];
+        }
+        if (Dot(plane, corner) + plane[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+extern "C" bool Frustum_TestBox(Vec3f min, Vec3f max) {
+    return !sValid || Frustum_TestBoxInView(&sView, min, max);
+}
+
+extern "C" bool Frustum_IsSphereVisible(Vec3f center, f32 radius) {
+    return Count(Frustum_TestSphere(center, radius));
+}
+
+extern "C" bool Frustum_IsBoxVisible(Vec3f min, Vec3f max) {
+    return Count(Frustum_TestBox(min, max));
+}
+
+extern "C" void Frustum_AddCounts(u32 drawn, u32 culled) {
+    ViewportCounts& counts = sCounts[sView.Viewport];
+    counts.Drawn += drawn;
+    counts.Culled += culled;
+}
+
+extern "C" bool Frustum_GetCamera(Vec3f pos, s32* viewport) {
+    if (!sValid) {
+        return false;
+    }
+    pos[0] = sView.CameraPos[0];
+    pos[1] = sView.CameraPos[1];
+    pos[2] = sView.CameraPos[2];
+    *viewport = sView.Viewport;
+    return true;
+}
+
+extern "C" void Frustum_ClearCamera(void) {
+    sValid = false;
+}
+
+extern "C" void Frustum_EndFrame(void) {
+    for (s32 i = 0; i < FRUSTUM_MAX_VIEWPORTS; i++) {
+        sLastCounts[i] = sCounts[i];
+        sCounts[i] = {};
+    }
+    Frustum_ClearCamera();
+
+    if (gFrameSettings.ReportCulling && ++sFramesSinceReport >= 60) {
+        sFramesSinceReport = 0;
+        printf("[Frustum] Drawn/culled per viewport: %u/%u, %u/%u, %u/%u, %u/%u\n", sLastCounts[0].Drawn,
+               sLastCounts[0].Culled, sLastCounts[1].Drawn, sLastCounts[1].Culled, sLastCounts[2].Drawn,
+               sLastCounts[2].Culled, sLastCounts[3].Drawn, sLastCounts[3].Culled);
+    }
+}
+
+extern "C" void Frustum_GetCounts(s32 viewport, u32* drawn, u32* culled) {
+    if ((viewport < 0) || (viewport >= FRUSTUM_MAX_VIEWPORTS)) {
+        *drawn = 0;
+        *culled = 0;
+        return;
+    }
+    *drawn = sLastCounts[viewport].Drawn;
+    *culled = sLastCounts[viewport].Culled;
+}
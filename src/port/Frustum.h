@@ -0,0 +1,67 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <libultraship.h>
+#include <common_structs.h>
+
+/**
+ * View frustum of the camera the current viewport is drawn from.
+ *
+ * setup_camera builds the frustum right after it loads the perspective and lookAt matrices. Draw code then
+ * tests an entity's bounds before doing any matrix work for it, so an entity that is off screen in one
+ * splitscreen viewport costs nothing there. The tests always pass while gNoCulling is set, or when no
+ * camera has been set up this frame.
+ */
+
+#define FRUSTUM_MAX_VIEWPORTS 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A viewport's frustum on its own, so a viewport can be planned ahead of being drawn, on any thread
+typedef struct {
+    f32 Planes[6][4]; // Normal pointing into the frustum, then distance
+    Vec3f CameraPos;
+    s32 Viewport;
+} FrustumView;
+
+// Takes the same camera as the guPerspective and guLookAt calls of the viewport
+void Frustum_SetCamera(s32 viewport, Vec3f pos, Vec3f lookAt, Vec3f up, f32 fovY, f32 aspect, f32 nearPlane,
+                       f32 farPlane);
+// Builds the frustum Frustum_SetCamera would, without making it current
+void Frustum_BuildView(FrustumView* view, s32 viewport, Vec3f pos, Vec3f lookAt, Vec3f up, f32 fovY, f32 aspect,
+                       f32 nearPlane, f32 farPlane);
+// Copies out the current viewport's frustum, false if no camera is set up
+bool Frustum_GetView(FrustumView* view);
+
+// Both tests count the entity as drawn or culled in the current viewport
+bool Frustum_IsSphereVisible(Vec3f center, f32 radius);
+bool Frustum_IsBoxVisible(Vec3f min, Vec3f max);
+
+// The same tests without counting, for tools that check the culling itself
+bool Frustum_TestSphere(Vec3f center, f32 radius);
+bool Frustum_TestBox(Vec3f min, Vec3f max);
+// Tests against a view instead of the current viewport. Safe to call from worker threads.
+bool Frustum_TestBoxInView(const FrustumView* view, Vec3f min, Vec3f max);
+
+// Counts entities tested against the current viewport's view elsewhere
+void Frustum_AddCounts(u32 drawn, u32 culled);
+
+// Position and viewport of the camera the current viewport is drawn from, false if none is set up
+bool Frustum_GetCamera(Vec3f pos, s32* viewport);
+
+// Forgets the camera, so every test passes until the next Frustum_SetCamera
+void Frustum_ClearCamera(void);
+
+// Resets the counters and forgets the camera. Called once the frame's display list is finished.
+void Frustum_EndFrame(void);
+
+// Entities drawn and culled in a viewport during the last finished frame
+void Frustum_GetCounts(s32 viewport, u32* drawn, u32* culled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRUSTUM_H
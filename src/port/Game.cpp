@@ -2,6 +2,12 @@
 
 #include "Game.h"
 #include "port/Engine.h"
+#include "port/FrameSettings.h"
+#include "port/VirtualMemory.h"
+#include "port/GfxPool.h"
+#include "port/Frustum.h"
+#include "port/FramePipeline.h"
+#include "port/pak.h"
 
 #include <graphic/Fast3D/Fast3dWindow.h>
 #include "engine/World.h"
@@ -54,6 +60,8 @@
 #include <locale.h>
 #endif
 
+#include <chrono>
+
 extern "C" {
 #include "main.h"
 #include "audio/load.h"
@@ -62,11 +70,13 @@ extern "C" {
 #include "render_courses.h"
 #include "menus.h"
 #include "update_objects.h"
+#include "memory.h"
+#include "code_800029B0.h"
 // #include "engine/wasm.h"
 }
 
 extern "C" void Graphics_PushFrame(Gfx* data) {
-    GameEngine::ProcessGfxCommands(data);
+    FramePipeline_PushFrame(data);
 }
 
 extern "C" void Timer_Update();
@@ -268,20 +278,13 @@ void SetCourseById(s32 course) {
 }
 
 void CM_VehicleCollision(s32 playerId, Player* player) {
-    for (auto& actor : gWorldInstance.Actors) {
-        if (actor) {
-            actor->VehicleCollision(playerId, player);
-        }
-    }
+    gWorldInstance.Vehicles.Collide(playerId, player);
+    gWorldInstance.Traffic.VehicleCollision(playerId, player);
 }
 
 void CM_BombKartsWaypoint(s32 cameraId) {
-    for (auto& object : gWorldInstance.Objects) {
-        if (auto kart = dynamic_cast<OBombKart*>(object)) {
-            if (kart) {
-                kart->Waypoint(cameraId);
-            }
-        }
+    for (OObject* object : gWorldInstance.GetObjectsOfClass(ObjectClass::BombKart)) {
+        static_cast<OBombKart*>(object)->Waypoint(cameraId);
     }
 }
 
@@ -341,7 +344,7 @@ void CM_LoadTextures() {
 
 void CM_RenderCourse(struct UnkStruct_800DC5EC* arg0) {
     if (gWorldInstance.CurrentCourse->IsMod() == false) {
-        if ((CVarGetInteger("gFreecam", 0) == true)) {
+        if ((gFrameSettings.Freecam == true)) {
             // Render credits courses
             //gSPClearGeometryMode(gDisplayListHead++, G_LIGHTING);
             //gSPSetGeometryMode(gDisplayListHead++, G_SHADE | G_CULL_BACK | G_SHADING_SMOOTH);
@@ -351,10 +354,37 @@ void CM_RenderCourse(struct UnkStruct_800DC5EC* arg0) {
     }
 
     if (gWorldInstance.CurrentCourse) {
+        GfxPool_Ensure();
         gWorldInstance.CurrentCourse->Render(arg0);
     }
 }
 
+void CM_PrepareViewports(void) {
+    FrustumView views[FRUSTUM_MAX_VIEWPORTS];
+    size_t count = 0;
+
+    if (gWorldInstance.CurrentCourse == nullptr) {
+        return;
+    }
+    switch (gActiveScreenMode) {
+        case SCREEN_MODE_2P_SPLITSCREEN_HORIZONTAL:
+        case SCREEN_MODE_2P_SPLITSCREEN_VERTICAL:
+            count = 2;
+            break;
+        case SCREEN_MODE_3P_4P_SPLITSCREEN:
+            // The fourth screen of a three player race draws no course
+            count = (gPlayerCountSelection1 == 3) ? 3 : 4;
+            break;
+    }
+    // The same camera setup_camera gives viewport i
+    for (size_t i = 0; i < count; i++) {
+        Camera* camera = &cameras[i];
+        Frustum_BuildView(&views[i], i, camera->pos, camera->lookAt, camera->up, gCameraZoom[i], gScreenAspect,
+                          CM_GetProps()->NearPersp, CM_GetProps()->FarPersp);
+    }
+    gWorldInstance.CurrentCourse->PrepareViewports(views, count);
+}
+
 void CM_RenderCredits() {
     if (gWorldInstance.CurrentCourse) {
         gWorldInstance.CurrentCourse->RenderCredits();
@@ -369,11 +399,24 @@ void CM_TickActors() {
 
 void CM_DrawActors(Camera* camera, struct Actor* actor) {
     AActor* a = gWorldInstance.ConvertActorToAActor(actor);
+    FVector center;
+    f32 radius;
+
     if (a->IsMod()) {
+        if (a->GetDrawBounds(center, radius)) {
+            Vec3f pos = { center.x, center.y, center.z };
+            if (!Frustum_IsSphereVisible(pos, radius)) {
+                return;
+            }
+        }
         a->Draw(camera);
     }
 }
 
+void CM_DrawTraffic(Camera* camera) {
+    gWorldInstance.Traffic.Draw(camera);
+}
+
 void CM_DrawStaticMeshActors() {
     gWorldInstance.DrawStaticMeshActors();
 }
@@ -442,12 +485,7 @@ void CM_DrawParticles(s32 cameraId) {
 
 // Helps prevents users from forgetting to add a finishline to their course
 bool CM_DoesFinishlineExist() {
-    for (AActor* actor : gWorldInstance.Actors) {
-        if (dynamic_cast<AFinishline*>(actor)) {
-            return true;
-        }
-    }
-    return false;
+    return !gWorldInstance.GetActorsOfClass(ActorClass::Finishline).empty();
 }
 
 void CM_InitClouds() {
@@ -629,7 +667,12 @@ size_t CM_FindActorIndex(Actor* actor) {
     // Move the ptr back to look at the vtable.
     // This gets us the proper C++ class instead of just the variables used in C.
     AActor* a = reinterpret_cast<AActor*>(reinterpret_cast<char*>(actor) - sizeof(void*));
-    auto actors = gWorldInstance.Actors;
+    auto& actors = gWorldInstance.Actors;
+
+    // The handle index is the actor's position in the list
+    if (gWorldInstance.ActorHandles.IsValid(a->Handle) && (actors[a->Handle.Index] == a)) {
+        return a->Handle.Index;
+    }
 
     auto it = std::find(actors.begin(), actors.end(), static_cast<AActor*>(a));
     if (it != actors.end()) {
@@ -640,24 +683,24 @@ size_t CM_FindActorIndex(Actor* actor) {
 }
 
 void CM_DeleteActor(size_t index) {
-    std::vector<AActor*> actors = gWorldInstance.Actors;
-    if (index < actors.size()) {
-        actors.erase(actors.begin() + index);
+    if (index < gWorldInstance.Actors.size()) {
+        gWorldInstance.DestroyActor(gWorldInstance.Actors[index]);
     }
 }
 
+/**
+ * Queues the actor for destruction. Its slot is recycled after the end of frame garbage collection.
+ */
+void CM_DestroyActor(struct Actor* actor) {
+    gWorldInstance.DestroyActor(gWorldInstance.ConvertActorToAActor(actor));
+}
+
 /**
  * Clean up actors and other game objects.
  */
 void CM_CleanWorld(void) {
     World* world = &gWorldInstance;
-    for (auto& actor : world->Actors) {
-        delete actor;
-    }
-
-    for (auto& object : world->Objects) {
-        delete object;
-    }
+    world->ClearEntities();
 
     for (auto& emitter : world->Emitters) {
         delete emitter;
@@ -673,9 +716,7 @@ void CM_CleanWorld(void) {
     }
 
     gEditor.ClearObjects();
-    gWorldInstance.Actors.clear();
     gWorldInstance.StaticMeshActors.clear();
-    gWorldInstance.Objects.clear();
     gWorldInstance.Emitters.clear();
     gWorldInstance.Lakitus.clear();
     gWorldInstance.Reset();
@@ -716,28 +757,33 @@ f32 CM_GetWaterLevel(Vec3f pos, Collision* collision) {
     return gWorldInstance.CurrentCourse->GetWaterLevel(fPos, collision);
 }
 
+static CourseType GetCourseType() {
+    Course* course = gWorldInstance.CurrentCourse.get();
+    return (course != nullptr) ? course->Type : CourseType::Custom;
+}
+
 // clang-format off
-bool IsMarioRaceway()     { return dynamic_cast<MarioRaceway*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsLuigiRaceway()     { return dynamic_cast<LuigiRaceway*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsChocoMountain()    { return dynamic_cast<ChocoMountain*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsBowsersCastle()    { return dynamic_cast<BowsersCastle*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsBansheeBoardwalk() { return dynamic_cast<BansheeBoardwalk*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsYoshiValley()      { return dynamic_cast<YoshiValley*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsFrappeSnowland()   { return dynamic_cast<FrappeSnowland*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsKoopaTroopaBeach() { return dynamic_cast<KoopaTroopaBeach*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsRoyalRaceway()     { return dynamic_cast<RoyalRaceway*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsMooMooFarm()       { return dynamic_cast<MooMooFarm*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsToadsTurnpike()    { return dynamic_cast<ToadsTurnpike*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsKalimariDesert()   { return dynamic_cast<KalimariDesert*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsSherbetLand()      { return dynamic_cast<SherbetLand*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsRainbowRoad()      { return dynamic_cast<RainbowRoad*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsWarioStadium()     { return dynamic_cast<WarioStadium*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsBlockFort()        { return dynamic_cast<BlockFort*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsSkyscraper()       { return dynamic_cast<Skyscraper*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsDoubleDeck()       { return dynamic_cast<DoubleDeck*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsDkJungle()         { return dynamic_cast<DKJungle*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsBigDonut()         { return dynamic_cast<BigDonut*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
-bool IsPodiumCeremony()   { return dynamic_cast<PodiumCeremony*>(gWorldInstance.CurrentCourse.get()) != nullptr; }
+bool IsMarioRaceway()     { return GetCourseType() == CourseType::MarioRaceway; }
+bool IsLuigiRaceway()     { return GetCourseType() == CourseType::LuigiRaceway; }
+bool IsChocoMountain()    { return GetCourseType() == CourseType::ChocoMountain; }
+bool IsBowsersCastle()    { return GetCourseType() == CourseType::BowsersCastle; }
+bool IsBansheeBoardwalk() { return GetCourseType() == CourseType::BansheeBoardwalk; }
+bool IsYoshiValley()      { return GetCourseType() == CourseType::YoshiValley; }
+bool IsFrappeSnowland()   { return GetCourseType() == CourseType::FrappeSnowland; }
+bool IsKoopaTroopaBeach() { return GetCourseType() == CourseType::KoopaTroopaBeach; }
+bool IsRoyalRaceway()     { return GetCourseType() == CourseType::RoyalRaceway; }
+bool IsMooMooFarm()       { return GetCourseType() == CourseType::MooMooFarm; }
+bool IsToadsTurnpike()    { return GetCourseType() == CourseType::ToadsTurnpike; }
+bool IsKalimariDesert()   { return GetCourseType() == CourseType::KalimariDesert; }
+bool IsSherbetLand()      { return GetCourseType() == CourseType::SherbetLand; }
+bool IsRainbowRoad()      { return GetCourseType() == CourseType::RainbowRoad; }
+bool IsWarioStadium()     { return GetCourseType() == CourseType::WarioStadium; }
+bool IsBlockFort()        { return GetCourseType() == CourseType::BlockFort; }
+bool IsSkyscraper()       { return GetCourseType() == CourseType::Skyscraper; }
+bool IsDoubleDeck()       { return GetCourseType() == CourseType::DoubleDeck; }
+bool IsDkJungle()         { return GetCourseType() == CourseType::DKJungle; }
+bool IsBigDonut()         { return GetCourseType() == CourseType::BigDonut; }
+bool IsPodiumCeremony()   { return GetCourseType() == CourseType::PodiumCeremony; }
 
 void SelectMarioRaceway()       { gWorldInstance.SetCourseByType<MarioRaceway>(); }
 void SelectLuigiRaceway()       { gWorldInstance.SetCourseByType<LuigiRaceway>(); }
@@ -762,6 +808,118 @@ void SelectBigDonut()           { gWorldInstance.SetCourseByType<BigDonut>(); }
 void SelectPodiumCeremony()     { gWorldInstance.CurrentCourse = gPodiumCeremony; }
 // clang-format on
 
+/**
+ * Times the course checks and the per-class actor lookups against the dynamic_cast versions
+ * they replaced, and reports if the two ever disagree.
+ */
+void RunTypeDispatchBenchmark(void) {
+    using Clock = std::chrono::steady_clock;
+    const size_t courseChecks = 1000000;
+    const size_t actorPasses = 1000;
+    size_t castMatches = 0;
+    size_t tagMatches = 0;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < courseChecks; i++) {
+        Course* course = gWorldInstance.CurrentCourse.get();
+        castMatches += (dynamic_cast<BowsersCastle*>(course) != nullptr) + (dynamic_cast<BigDonut*>(course) != nullptr);
+    }
+    auto castTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+    // Called through pointers like the C code would, so the checks can't be hoisted out of the loop
+    bool (*volatile isBowsersCastle)() = IsBowsersCastle;
+    bool (*volatile isBigDonut)() = IsBigDonut;
+    start = Clock::now();
+    for (size_t i = 0; i < courseChecks; i++) {
+        tagMatches += isBowsersCastle() + isBigDonut();
+    }
+    auto tagTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    printf("RunTypeDispatchBenchmark() %zu course checks. dynamic_cast: %lld us, type tag: %lld us%s\n",
+           courseChecks * 2, (long long) castTime, (long long) tagTime,
+           (castMatches == tagMatches) ? "" : " MISMATCH");
+
+    castMatches = 0;
+    tagMatches = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < actorPasses; i++) {
+        for (AActor* actor : gWorldInstance.Actors) {
+            castMatches += (dynamic_cast<ATrain*>(actor) != nullptr) + (dynamic_cast<ABoat*>(actor) != nullptr);
+        }
+    }
+    castTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (size_t i = 0; i < actorPasses; i++) {
+        for (AActor* actor : gWorldInstance.GetActorsOfClass(ActorClass::Train)) {
+            tagMatches += (actor != nullptr);
+        }
+        for (AActor* actor : gWorldInstance.GetActorsOfClass(ActorClass::Boat)) {
+            tagMatches += (actor != nullptr);
+        }
+    }
+    tagTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    printf("RunTypeDispatchBenchmark() %zu passes over %zu actors. dynamic_cast: %lld us, class lists: %lld us%s\n",
+           actorPasses, gWorldInstance.Actors.size(), (long long) castTime, (long long) tagTime,
+           (castMatches == tagMatches) ? "" : " MISMATCH");
+}
+
+/**
+ * Loads every stock course twice in a row. The second pass must not use more memory than the first,
+ * or unloading a course is leaking.
+ */
+void RunCourseMemoryTest(void) {
+    // Tolerance for the rest of the process, such as the renderer's caches
+    const size_t processSlack = 4 * 1024 * 1024;
+    std::shared_ptr<Course> previousCourse = gWorldInstance.CurrentCourse;
+    std::vector<size_t> firstPassResident;
+    size_t processResident[2];
+    size_t numCourses = 0;
+    bool flat = true;
+
+    if (gGamestate == RACING) {
+        printf("RunCourseMemoryTest() Can only run from the menus\n");
+        return;
+    }
+
+    for (size_t pass = 0; pass < 2; pass++) {
+        size_t i = 0;
+        for (auto& course : gWorldInstance.Courses) {
+            if (course->Type == CourseType::Custom) {
+                continue;
+            }
+            gWorldInstance.CurrentCourse = course;
+            memory_pool_begin_course();
+            load_course(gCurrentCourseId);
+            memory_pool_end_course();
+
+            size_t resident = memory_pool_get_resident_size();
+            if (pass == 0) {
+                firstPassResident.push_back(resident);
+            } else if (resident > firstPassResident[i]) {
+                printf("RunCourseMemoryTest() %s grew from 0x%zX to 0x%zX bytes on the second load\n",
+                       course->Props.Name, firstPassResident[i], resident);
+                flat = false;
+            }
+            i++;
+        }
+        numCourses = i;
+        processResident[pass] = VirtualMemory_GetResidentSize();
+    }
+
+    // Leave no course loaded, so the next race loads its own
+    memory_pool_begin_course();
+    CM_CleanWorld();
+    gWorldInstance.CurrentCourse = previousCourse;
+    gCurrentlyLoadedCourseId = COURSE_NULL;
+
+    if (processResident[1] > processResident[0] + processSlack) {
+        flat = false;
+    }
+    printf("RunCourseMemoryTest() Loaded %zu courses twice. Process resident after each pass: 0x%zX, 0x%zX bytes%s\n",
+           numCourses, processResident[0], processResident[1], flat ? "" : " GREW");
+    memory_pool_print_usage();
+}
+
 void* GetMushroomCup(void) {
     return gMushroomCup;
 }
@@ -791,7 +949,7 @@ void CM_RunGarbageCollector(void) {
 void push_frame() {
     GameEngine::StartAudioFrame();
     GameEngine::Instance->StartFrame();
-    thread5_iteration();
+    FramePipeline_RunFrame(thread5_iteration);
     GameEngine::EndAudioFrame();
     // thread5_game_loop();
     // Graphics_ThreadUpdate();w
@@ -834,7 +992,7 @@ extern "C"
     }
 
     // Debug mode override gSkipIntro
-    if (CVarGetInteger("gEnableDebugMode", 0) == true) {
+    if (gFrameSettings.EnableDebugMode == true) {
         gMenuSelection = START_MENU;
     }
 
@@ -843,6 +1001,8 @@ extern "C"
     while (WindowIsRunning()) {
         push_frame();
     }
+    FramePipeline_Destroy();
+    Pfs_Pak_Close();
     CustomEngineDestroy();
     // GameEngine::Instance->ProcessFrame(push_frame);
     GameEngine::Instance->Destroy();
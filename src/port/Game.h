@@ -56,6 +56,8 @@ void CM_SetCupIndex(size_t index);
 void CM_LoadTextures();
 
 void CM_RenderCourse(struct UnkStruct_800DC5EC* arg0);
+// Plans the course of every splitscreen viewport ahead of render_screens drawing them
+void CM_PrepareViewports(void);
 
 void CM_RenderCredits();
 
@@ -70,6 +72,7 @@ bool CM_DoesFinishlineExist();
 void CM_InitClouds();
 
 void CM_DrawActors(Camera* camera, struct Actor* actor);
+void CM_DrawTraffic(Camera* camera);
 void CM_DrawStaticMeshActors();
 
 void CM_TickObjects();
@@ -147,6 +150,7 @@ void SetCourseById(s32 course);
 
 struct Actor* CM_GetActor(size_t index);
 void CM_DeleteActor(size_t index);
+void CM_DestroyActor(struct Actor* actor);
 struct Actor* CM_AddBaseActor();
 void CM_AddEditorObject(struct Actor* actor, const char* name);
 void Editor_AddLight(s8* direction);
@@ -215,6 +219,9 @@ void* GetCup();
 
 void CM_RunGarbageCollector(void);
 
+void RunTypeDispatchBenchmark(void);
+void RunCourseMemoryTest(void);
+
 #ifdef __cplusplus
 }
 #endif
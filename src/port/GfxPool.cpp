@@ -0,0 +1,111 @@
+#include "GfxPool.h"
+#include <libultraship.h>
+#include <memory>
+#include <vector>
+#include <cstdio>
+
+#include "engine/World.h"
+#include "port/FrameSettings.h"
+
+Gfx* gGfxPoolBlockEnd = nullptr;
+
+namespace {
+
+// Written to the last command of every block. If it changes, something wrote past the reserve.
+constexpr uintptr_t CanaryW0 = 0xDEADBEEF;
+constexpr uintptr_t CanaryW1 = 0xFEEDFACE;
+
+struct PoolChain {
+    std::vector<std::unique_ptr<Gfx[]>> Blocks;
+};
+
+PoolChain sChains[2];
+s32 sPoolIndex = 0;
+size_t sNextBlock = 0;
+Gfx* sBaseBlock = nullptr;
+size_t sBaseSize = 0;
+Gfx* sBlockStart = nullptr;
+size_t sFinishedUsage = 0; // Commands written to the blocks already branched away from this frame
+size_t sFrameUsage = 0;
+size_t sPeakUsage = 0;
+size_t sPeakBlocks = 0;
+size_t sPeakMatrices = 0;
+uint32_t sFramesSinceReport = 0;
+
+void SetCanary(Gfx* block, size_t size) {
+    block[size - 1].words.w0 = CanaryW0;
+    block[size - 1].words.w1 = CanaryW1;
+}
+
+bool CheckCanary(Gfx* block, size_t size) {
+    return (block[size - 1].words.w0 == CanaryW0) && (block[size - 1].words.w1 == CanaryW1);
+}
+
+} // namespace
+
+extern "C" void GfxPool_BeginFrame(Gfx* base, size_t size, s32 poolIndex) {
+    sPoolIndex = poolIndex & 1;
+    sNextBlock = 0;
+    sBaseBlock = base;
+    sBaseSize = size;
+    sBlockStart = base;
+    sFinishedUsage = 0;
+
+    SetCanary(base, size);
+    gDisplayListHead = base;
+    gGfxPoolBlockEnd = base + size - 1;
+}
+
+extern "C" void GfxPool_Grow(void) {
+    auto& blocks = sChains[sPoolIndex].Blocks;
+
+    if (sNextBlock == blocks.size()) {
+        blocks.push_back(std::make_unique<Gfx[]>(GFX_POOL_BLOCK_SIZE));
+        SetCanary(blocks.back().get(), GFX_POOL_BLOCK_SIZE);
+    }
+    Gfx* next = blocks[sNextBlock++].get();
+
+    gSPBranchList(gDisplayListHead++, next);
+    sFinishedUsage += gDisplayListHead - sBlockStart;
+
+    sBlockStart = next;
+    gDisplayListHead = next;
+    gGfxPoolBlockEnd = next + GFX_POOL_BLOCK_SIZE - 1;
+}
+
+extern "C" void GfxPool_EndFrame(void) {
+    auto& blocks = sChains[sPoolIndex].Blocks;
+    bool overran = !CheckCanary(sBaseBlock, sBaseSize);
+
+    for (size_t i = 0; i < sNextBlock; i++) {
+        overran |= !CheckCanary(blocks[i].get(), GFX_POOL_BLOCK_SIZE);
+    }
+    if (overran || (gDisplayListHead > gGfxPoolBlockEnd)) {
+        printf("[GfxPool] More than %d commands were written without a GfxPool_Ensure check. "
+               "The display list may be corrupt.\n",
+               GFX_POOL_RESERVE);
+    }
+
+    // Room for the full sync and end commands
+    GfxPool_Ensure();
+
+    sFrameUsage = sFinishedUsage + (gDisplayListHead - sBlockStart);
+    sPeakUsage = std::max(sPeakUsage, sFrameUsage);
+    sPeakBlocks = std::max(sPeakBlocks, sNextBlock);
+    sPeakMatrices = std::max(sPeakMatrices, gWorldInstance.Mtx.Objects.size());
+
+    if (gFrameSettings.ReportGfxPool && ++sFramesSinceReport >= 60) {
+        sFramesSinceReport = 0;
+        printf("[GfxPool] Frame: %zu commands in %zu chained blocks, %zu object matrices. "
+               "Peak: %zu commands, %zu blocks, %zu matrices\n",
+               sFrameUsage, sNextBlock, gWorldInstance.Mtx.Objects.size(), sPeakUsage, sPeakBlocks, sPeakMatrices);
+    }
+}
+
+extern "C" size_t GfxPool_GetFrameUsage(void) {
+    return sFrameUsage;
+}
+
+extern "C" size_t GfxPool_GetPeakUsage(void) {
+    return sPeakUsage;
+}
@@ -0,0 +1,47 @@
+#ifndef GFX_POOL_H
+#define GFX_POOL_H
+
+#include <libultraship.h>
+
+/**
+ * Lets the master display list grow past gGfxPool->gfxPool.
+ *
+ * Commands are written through gDisplayListHead as before. At check points between draws, GfxPool_Ensure
+ * looks at the space left in the current block. If it is below GFX_POOL_RESERVE commands, it branches to
+ * a new block with gSPBranchList. The chained blocks belong to one of the two gfx pools and are reused
+ * every frame, so a heavy scene costs an allocation once, not every frame.
+ */
+
+// Commands per chained block
+#define GFX_POOL_BLOCK_SIZE 16384
+// Most commands written between two check points. This much of every block is kept free as slack.
+#define GFX_POOL_RESERVE 2048
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern Gfx* gDisplayListHead;
+// End of the usable part of the block gDisplayListHead is writing to
+extern Gfx* gGfxPoolBlockEnd;
+
+void GfxPool_BeginFrame(Gfx* base, size_t size, s32 poolIndex);
+void GfxPool_Grow(void);
+// Checks for overruns and records the frame's usage. Call before the final commands are written.
+void GfxPool_EndFrame(void);
+
+// Commands used by the last finished frame, and the most used by any frame
+size_t GfxPool_GetFrameUsage(void);
+size_t GfxPool_GetPeakUsage(void);
+
+static inline void GfxPool_Ensure(void) {
+    if (gGfxPoolBlockEnd - gDisplayListHead < GFX_POOL_RESERVE) {
+        GfxPool_Grow();
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GFX_POOL_H
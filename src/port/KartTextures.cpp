@@ -0,0 +1,110 @@
+#include "KartTextures.h"
+#include <libultraship.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "port/Engine.h"
+#include "port/FrameSettings.h"
+
+extern "C" {
+#include "main.h"
+}
+
+namespace {
+
+// Shared palettes by the hash of their colors. They are never freed, since the renderer keys cached
+// textures by the palette's address.
+std::unordered_map<u64, std::vector<std::unique_ptr<struct_D_802F1F80>>> sPalettes;
+size_t sPaletteCount = 0;
+
+// Palettes each frame was decoded with since it was last evicted, mirroring the renderer's texture cache
+std::unordered_map<const char*, std::unordered_set<const struct_D_802F1F80*>> sDecoded;
+bool sStable = false;
+bool sEvict = false; // Whether the frame bound last has to be evicted once drawn
+
+u32 sDraws = 0;
+u32 sUploads = 0;
+u32 sReportDraws = 0;
+u32 sReportUploads = 0;
+uint32_t sFramesSinceReport = 0;
+
+u64 HashPalette(const struct_D_802F1F80* palette) {
+    const u8* bytes = (const u8*) palette;
+    u64 hash = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0; i < sizeof(struct_D_802F1F80); i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+struct_D_802F1F80* SharePalette(const struct_D_802F1F80* palette) {
+    auto& bucket = sPalettes[HashPalette(palette)];
+
+    for (auto& shared : bucket) {
+        if (memcmp(shared.get(), palette, sizeof(struct_D_802F1F80)) == 0) {
+            return shared.get();
+        }
+    }
+    if (sPaletteCount >= KART_TEXTURES_MAX_PALETTES) {
+        return nullptr;
+    }
+    bucket.push_back(std::make_unique<struct_D_802F1F80>(*palette));
+    sPaletteCount++;
+    return bucket.back().get();
+}
+
+} // namespace
+
+extern "C" struct_D_802F1F80* KartTextures_BindFrame(const char* texture, struct_D_802F1F80* palette) {
+    bool stable = gFrameSettings.StableKartPalettes;
+    struct_D_802F1F80* shared = stable ? SharePalette(palette) : nullptr;
+
+    // Switching over leaves frames the old way evicted, or frames the new way never will
+    if (stable != sStable) {
+        sStable = stable;
+        sDecoded.clear();
+    }
+    sEvict = (shared == nullptr);
+    if (sEvict) {
+        shared = palette;
+    }
+    sDraws++;
+    sUploads += sDecoded[texture].insert(shared).second;
+    return shared;
+}
+
+extern "C" void KartTextures_ReleaseFrame(const char* texture) {
+    if (!sEvict) {
+        return;
+    }
+    sEvict = false;
+    // Only a CI frame takes its colors from the palette
+    if (GameEngine_ResourceGetTexTypeByName(texture) != 1) {
+        gSPInvalidateTexCache(gDisplayListHead++, texture);
+        sDecoded.erase(texture);
+    }
+}
+
+extern "C" void KartTextures_EndFrame(void) {
+    sReportDraws += sDraws;
+    sReportUploads += sUploads;
+    sDraws = 0;
+    sUploads = 0;
+
+    if (++sFramesSinceReport < 60) {
+        return;
+    }
+    if (gFrameSettings.ReportKartTextures) {
+        printf("[KartTextures] Per frame: %.1f kart draws, %.1f kart texture uploads, %zu shared palettes%s\n",
+               sReportDraws / 60.0f, sReportUploads / 60.0f, sPaletteCount,
+               gFrameSettings.StableKartPalettes ? "" : " (gStableKartPalettes off)");
+    }
+    sFramesSinceReport = 0;
+    sReportDraws = 0;
+    sReportUploads = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef KART_TEXTURES_H
+#define KART_TEXTURES_H
+
+#include <libultraship.h>
+#include "buffers.h"
+
+/**
+ * Palettes the kart frames are drawn with.
+ *
+ * Each player's palette lives in gPlayerPalettesList, and update_wheel_palette rewrites its wheel colors
+ * every frame to spin the wheels. The renderer decodes a CI frame with the palette it finds at the TLUT's
+ * address, so render_player used to evict the frame from the texture cache after every draw, and every kart
+ * was decoded and uploaded again in every viewport each frame.
+ *
+ * With gStableKartPalettes set, a kart is drawn with a copy of its palette that is never written again and
+ * is shared by every kart whose palette has the same colors. The renderer then keeps one decoded texture per
+ * frame and wheel palette, the way an atlas of each character's frames would, and nothing is evicted.
+ */
+
+// Copies kept before the player's own palette is used instead, 1 MB worth
+#define KART_TEXTURES_MAX_PALETTES 2048
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The palette to load with a kart frame. Called once per player and viewport, before the kart is drawn.
+struct_D_802F1F80* KartTextures_BindFrame(const char* texture, struct_D_802F1F80* palette);
+// Called once the kart, its reflection and its boost are drawn. Evicts the frame if its palette can change.
+void KartTextures_ReleaseFrame(const char* texture);
+
+// Prints the kart draws and texture uploads per frame once a second if gReportKartTextures is set
+void KartTextures_EndFrame(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KART_TEXTURES_H
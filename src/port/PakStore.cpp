@@ -0,0 +1,387 @@
+#include "PakStore.h"
+
+#include <filesystem>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "pak.h"
+#include "ShipUtils.h"
+
+#define PAK_IMAGE_MAGIC 0x494B4150   // "PAKI"
+#define PAK_JOURNAL_MAGIC 0x4A4B4150 // "PAKJ"
+#define PAK_IMAGE_VERSION 1
+
+namespace {
+
+// Magic, type, slot, offset and payload size, each a u32
+constexpr size_t kRecordHeaderSize = 5 * sizeof(u32);
+
+void PutU32(std::vector<u8>& out, u32 value) {
+    u8 bytes[4];
+    memcpy(bytes, &value, 4);
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+u32 GetU32(const u8* in) {
+    u32 value;
+    memcpy(&value, in, 4);
+    return value;
+}
+
+void EncodeEntry(const PakEntry& entry, u8* out) {
+    memset(out, 0, kEntrySize);
+    memcpy(out + 0x00, &entry.FileSize, 4);
+    memcpy(out + 0x04, &entry.GameCode, 4);
+    memcpy(out + 0x08, &entry.CompanyCode, 2);
+    memcpy(out + 0x0C, entry.ExtName, EXT_NAME_SIZE);
+    memcpy(out + 0x10, entry.GameName, GAME_NAME_SIZE);
+}
+
+// Pushes a flushed file to the disk, so a power cut can't lose it once a later write depends on it
+bool SyncFile(FILE* file) {
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Makes a rename inside the directory survive a power cut. Windows commits renames with the file.
+void SyncDirectory(const std::filesystem::path& path) {
+#ifndef _WIN32
+    int dir = open(path.empty() ? "." : path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+#endif
+}
+
+// Applies a record to the image, for both live changes and journal replay
+bool ApplyRecord(PakImage& image, u32 type, u32 slot, u32 offset, const u8* payload, u32 size) {
+    if (slot >= MAX_FILES) {
+        return false;
+    }
+    switch (type) {
+        case RECORD_ENTRY:
+            if (size != kEntrySize) {
+                return false;
+            }
+            image.Entries[slot] = DecodeEntry(payload);
+            image.Files[slot].assign(offset, 0);
+            return true;
+        case RECORD_WRITE:
+            if (image.Files[slot].size() < (size_t) offset + size) {
+                image.Files[slot].resize((size_t) offset + size, 0);
+            }
+            memcpy(image.Files[slot].data() + offset, payload, size);
+            return true;
+        case RECORD_DELETE:
+            image.Entries[slot] = PakEntry();
+            image.Files[slot].clear();
+            return true;
+    }
+    return false;
+}
+
+// Replays the complete records at the start of a journal, returning how many bytes they took
+size_t ReplayJournal(PakImage& image, const std::vector<u8>& journal, size_t* records) {
+    size_t pos = 0;
+    *records = 0;
+
+    while (journal.size() - pos >= kRecordHeaderSize + sizeof(u32)) {
+        const u8* record = journal.data() + pos;
+        u32 size = GetU32(record + 16);
+
+        if ((GetU32(record) != PAK_JOURNAL_MAGIC) || (size > journal.size() - pos - kRecordHeaderSize - sizeof(u32))) {
+            break;
+        }
+        size_t length = kRecordHeaderSize + size;
+        if (GetU32(record + length) != Ship_Crc32(record, length)) {
+            break;
+        }
+        if (!ApplyRecord(image, GetU32(record + 4), GetU32(record + 8), GetU32(record + 12),
+                         record + kRecordHeaderSize, size)) {
+            break;
+        }
+        pos += length + sizeof(u32);
+        (*records)++;
+    }
+    return pos;
+}
+
+} // namespace
+
+PakEntry DecodeEntry(const u8* in) {
+    PakEntry entry;
+    memcpy(&entry.FileSize, in + 0x00, 4);
+    memcpy(&entry.GameCode, in + 0x04, 4);
+    memcpy(&entry.CompanyCode, in + 0x08, 2);
+    memcpy(entry.ExtName, in + 0x0C, EXT_NAME_SIZE);
+    memcpy(entry.GameName, in + 0x10, GAME_NAME_SIZE);
+    return entry;
+}
+
+std::vector<u8> ReadWholeFile(const std::string& path, bool* exists) {
+    std::vector<u8> data;
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (exists != nullptr) {
+        *exists = (file != nullptr);
+    }
+    if (file == nullptr) {
+        return data;
+    }
+    u8 buffer[0x1000];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return data;
+}
+
+bool WriteWholeFile(const std::string& path, const std::vector<u8>& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = (data.empty() || (fwrite(data.data(), 1, data.size(), file) == data.size())) &&
+                   (fflush(file) == 0) && SyncFile(file);
+    return (fclose(file) == 0) && written;
+}
+
+std::vector<u8> EncodeRecord(u32 type, u32 slot, u32 offset, const u8* payload, u32 size) {
+    std::vector<u8> record;
+    record.reserve(kRecordHeaderSize + size + sizeof(u32));
+
+    PutU32(record, PAK_JOURNAL_MAGIC);
+    PutU32(record, type);
+    PutU32(record, slot);
+    PutU32(record, offset);
+    PutU32(record, size);
+    record.insert(record.end(), payload, payload + size);
+    PutU32(record, Ship_Crc32(record.data(), record.size()));
+    return record;
+}
+
+std::vector<u8> EncodeImage(const PakImage& image) {
+    std::vector<u8> data;
+    u8 entry[kEntrySize];
+
+    PutU32(data, PAK_IMAGE_MAGIC);
+    PutU32(data, PAK_IMAGE_VERSION);
+    for (size_t i = 0; i < MAX_FILES; i++) {
+        EncodeEntry(image.Entries[i], entry);
+        data.insert(data.end(), entry, entry + kEntrySize);
+        PutU32(data, image.Files[i].size());
+        data.insert(data.end(), image.Files[i].begin(), image.Files[i].end());
+    }
+    PutU32(data, Ship_Crc32(data.data(), data.size()));
+    return data;
+}
+
+bool DecodeImage(const std::vector<u8>& data, PakImage& image) {
+    if ((data.size() < 3 * sizeof(u32)) || (GetU32(data.data()) != PAK_IMAGE_MAGIC) ||
+        (GetU32(data.data() + 4) != PAK_IMAGE_VERSION)) {
+        return false;
+    }
+    size_t end = data.size() - sizeof(u32);
+    if (GetU32(data.data() + end) != Ship_Crc32(data.data(), end)) {
+        return false;
+    }
+
+    size_t pos = 2 * sizeof(u32);
+    for (size_t i = 0; i < MAX_FILES; i++) {
+        if (end - pos < kEntrySize + sizeof(u32)) {
+            return false;
+        }
+        image.Entries[i] = DecodeEntry(data.data() + pos);
+        u32 size = GetU32(data.data() + pos + kEntrySize);
+        pos += kEntrySize + sizeof(u32);
+        if (end - pos < size) {
+            return false;
+        }
+        image.Files[i].assign(data.begin() + pos, data.begin() + pos + size);
+        pos += size;
+    }
+    return pos == end;
+}
+
+PakStore::PakStore(std::string imagePath, std::string journalPath)
+    : mImagePath(std::move(imagePath)), mJournalPath(std::move(journalPath)) {
+}
+
+PakStore::~PakStore() {
+    Close();
+}
+
+bool PakStore::Load(bool bReport) {
+    bool exists;
+    bool valid = DecodeImage(ReadWholeFile(mImagePath, &exists), mImage);
+    if (!valid) {
+        if (exists && bReport) {
+            printf("[Pak] %s failed its checksum and was ignored\n", mImagePath.c_str());
+        }
+        mImage = PakImage();
+    }
+
+    std::vector<u8> journal = ReadWholeFile(mJournalPath);
+    size_t records;
+    size_t replayed = ReplayJournal(mImage, journal, &records);
+    size_t tornBytes = journal.size() - replayed;
+    if ((tornBytes != 0) && bReport) {
+        printf("[Pak] Dropped %zu bytes at the end of %s after %zu complete records\n", tornBytes,
+               mJournalPath.c_str(), records);
+    }
+    // Folding the journal in also drops a torn tail, which new records must not land behind
+    if (!journal.empty()) {
+        QueueSnapshot();
+    }
+    return valid;
+}
+
+void PakStore::Import(const PakImage& image) {
+    mImage = image;
+    QueueSnapshot();
+}
+
+void PakStore::SetEntry(u32 slot, const PakEntry& entry, u32 allocatedSize) {
+    u8 payload[kEntrySize];
+    EncodeEntry(entry, payload);
+    Change(RECORD_ENTRY, slot, allocatedSize, payload, kEntrySize);
+}
+
+void PakStore::Write(u32 slot, u32 offset, const u8* data, u32 size) {
+    Change(RECORD_WRITE, slot, offset, data, size);
+}
+
+void PakStore::Delete(u32 slot) {
+    Change(RECORD_DELETE, slot, 0, nullptr, 0);
+}
+
+void PakStore::Flush() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mJobs.empty() || mWriting) {
+        mIdle.wait(lock);
+    }
+}
+
+void PakStore::Close() {
+    Flush();
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mRunning = false;
+    }
+    mWake.notify_one();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    if (mJournal != nullptr) {
+        fclose(mJournal);
+        mJournal = nullptr;
+    }
+}
+
+void PakStore::Change(u32 type, u32 slot, u32 offset, const u8* payload, u32 size) {
+    ApplyRecord(mImage, type, slot, offset, payload, size);
+    std::vector<u8> record = EncodeRecord(type, slot, offset, payload, size);
+    mJournalSize += record.size();
+    Queue({ false, std::move(record) });
+
+    if (mJournalSize > PAK_JOURNAL_LIMIT) {
+        QueueSnapshot();
+    }
+}
+
+void PakStore::QueueSnapshot() {
+    mJournalSize = 0;
+    Queue({ true, EncodeImage(mImage) });
+}
+
+void PakStore::Queue(Job job) {
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+        if (!mRunning) {
+            mRunning = true;
+            mThread = std::thread(&PakStore::HandleJobs, this);
+        }
+    }
+    mWake.notify_one();
+}
+
+void PakStore::HandleJobs() {
+    while (true) {
+        std::vector<Job> jobs;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (mJobs.empty() && mRunning) {
+                mWake.wait(lock);
+            }
+            if (mJobs.empty()) {
+                break;
+            }
+            jobs.swap(mJobs);
+            mWriting = true;
+        }
+
+        for (Job& job : jobs) {
+            if (job.bSnapshot) {
+                WriteSnapshot(job.Data);
+            } else {
+                AppendRecord(job.Data);
+            }
+        }
+        if ((mJournal != nullptr) && ((fflush(mJournal) != 0) || !SyncFile(mJournal))) {
+            printf("[Pak] Could not sync %s\n", mJournalPath.c_str());
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWriting = false;
+        }
+        mIdle.notify_all();
+    }
+}
+
+void PakStore::AppendRecord(const std::vector<u8>& record) {
+    if (mJournal == nullptr) {
+        mJournal = fopen(mJournalPath.c_str(), "ab");
+    }
+    if ((mJournal == nullptr) || (fwrite(record.data(), 1, record.size(), mJournal) != record.size())) {
+        printf("[Pak] Could not append to %s\n", mJournalPath.c_str());
+    }
+}
+
+void PakStore::WriteSnapshot(const std::vector<u8>& image) {
+    std::string tempPath = mImagePath + ".tmp";
+    std::error_code error;
+
+    if (mJournal != nullptr) {
+        fflush(mJournal);
+    }
+    // The old image stays in place until the new one is complete
+    if (!WriteWholeFile(tempPath, image)) {
+        printf("[Pak] Could not write %s\n", tempPath.c_str());
+        return;
+    }
+    std::filesystem::rename(tempPath, mImagePath, error);
+    if (error) {
+        printf("[Pak] Could not replace %s: %s\n", mImagePath.c_str(), error.message().c_str());
+        return;
+    }
+    // The journal may only be emptied once the rename can't be undone by a power cut
+    SyncDirectory(std::filesystem::path(mImagePath).parent_path());
+
+    // Everything in the journal is in the new image now
+    if (mJournal != nullptr) {
+        fclose(mJournal);
+    }
+    mJournal = fopen(mJournalPath.c_str(), "wb");
+}
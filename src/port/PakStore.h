@@ -0,0 +1,121 @@
+#ifndef PAK_STORE_H
+#define PAK_STORE_H
+
+#include <libultraship.h>
+#include <libultraship/libultra.h>
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * The controller pak image behind the osPfs functions, and the journal and image files that keep it on disk.
+ * See pak.h for how the two are written and read back.
+ */
+
+#define MAX_FILES 16
+#define EXT_NAME_SIZE 4
+#define GAME_NAME_SIZE 16
+
+// A directory entry, stored the way controllerPak_header.sav laid them out
+struct PakEntry {
+    u32 FileSize = 0;
+    u32 GameCode = 0;
+    u16 CompanyCode = 0;
+    char ExtName[EXT_NAME_SIZE] = {};
+    char GameName[GAME_NAME_SIZE] = {};
+
+    bool IsUsed() const {
+        return (CompanyCode != 0) && (GameCode != 0);
+    }
+
+    bool operator==(const PakEntry& other) const {
+        return (FileSize == other.FileSize) && (GameCode == other.GameCode) && (CompanyCode == other.CompanyCode) &&
+               (memcmp(ExtName, other.ExtName, EXT_NAME_SIZE) == 0) &&
+               (memcmp(GameName, other.GameName, GAME_NAME_SIZE) == 0);
+    }
+};
+
+constexpr size_t kEntrySize = sizeof(OSPfsState);
+
+struct PakImage {
+    std::array<PakEntry, MAX_FILES> Entries;
+    std::array<std::vector<u8>, MAX_FILES> Files;
+
+    bool operator==(const PakImage& other) const {
+        return (Entries == other.Entries) && (Files == other.Files);
+    }
+};
+
+enum RecordType : u32 {
+    RECORD_ENTRY = 1, // Offset is the size of the file data allocated with the entry
+    RECORD_WRITE,
+    RECORD_DELETE,
+};
+
+PakEntry DecodeEntry(const u8* in);
+std::vector<u8> ReadWholeFile(const std::string& path, bool* exists = nullptr);
+// Writes the file and syncs it to the disk before returning
+bool WriteWholeFile(const std::string& path, const std::vector<u8>& data);
+// A journal record, checksummed
+std::vector<u8> EncodeRecord(u32 type, u32 slot, u32 offset, const u8* payload, u32 size);
+// The whole pak as controllerPak.sav holds it, checksummed
+std::vector<u8> EncodeImage(const PakImage& image);
+bool DecodeImage(const std::vector<u8>& data, PakImage& image);
+
+// The image and its journal on disk, with the thread that writes them
+class PakStore {
+  public:
+    PakStore(std::string imagePath, std::string journalPath);
+    ~PakStore();
+
+    // Reads the image and replays the journal. False if there is no valid image, in which case the pak starts
+    // empty plus whatever the journal holds.
+    bool Load(bool bReport);
+    // Replaces the whole pak, as when importing the files older builds wrote
+    void Import(const PakImage& image);
+    const PakImage& GetImage() const {
+        return mImage;
+    }
+
+    void SetEntry(u32 slot, const PakEntry& entry, u32 allocatedSize);
+    void Write(u32 slot, u32 offset, const u8* data, u32 size);
+    void Delete(u32 slot);
+
+    // Blocks until everything queued so far is on disk
+    void Flush();
+    void Close();
+
+  private:
+    struct Job {
+        bool bSnapshot;
+        std::vector<u8> Data;
+    };
+
+    void Change(u32 type, u32 slot, u32 offset, const u8* payload, u32 size);
+    void QueueSnapshot();
+    void Queue(Job job);
+    void HandleJobs();
+    void AppendRecord(const std::vector<u8>& record);
+    void WriteSnapshot(const std::vector<u8>& image);
+
+    std::string mImagePath;
+    std::string mJournalPath;
+    PakImage mImage;
+    size_t mJournalSize = 0; // Bytes queued for the journal since the last snapshot
+
+    // Shared with the writer thread
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mWake, mIdle;
+    std::vector<Job> mJobs;
+    bool mRunning = false;
+    bool mWriting = false;
+    FILE* mJournal = nullptr; // Only touched by the writer thread, or once it has stopped
+};
+
+#endif // PAK_STORE_H
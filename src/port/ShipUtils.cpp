@@ -1,5 +1,6 @@
 #include "ShipUtils.h"
 #include <libultraship/libultraship.h>
+#include <array>
 
 extern "C" {
 #include "macros.h"
@@ -11,6 +12,27 @@ extern "C" bool Ship_IsCStringEmpty(const char* str) {
     return str == NULL || str[0] == '\0';
 }
 
+extern "C" u32 Ship_Crc32(const u8* data, size_t size) {
+    // Built on first use, which is thread safe for a function's static
+    static const std::array<u32, 256> sTable = []() {
+        std::array<u32, 256> table;
+        for (u32 i = 0; i < 256; i++) {
+            u32 crc = i;
+            for (s32 bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    u32 crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc = sTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
 // Build vertex coordinates for a quad command
 // In order of top left, top right, bottom left, then bottom right
 // Supports flipping the texture horizontally
@@ -11,6 +11,8 @@ extern "C" {
 #endif
 
 bool Ship_IsCStringEmpty(const char* str);
+// CRC-32 of a buffer, as used by zip and PNG
+u32 Ship_Crc32(const u8* data, size_t size);
 
 #ifdef __cplusplus
 }
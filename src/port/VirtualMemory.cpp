@@ -0,0 +1,104 @@
+#include "VirtualMemory.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__SWITCH__) || defined(__WIIU__)
+#include <cstring>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+#endif
+
+extern "C" size_t VirtualMemory_GetPageSize(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#elif defined(__SWITCH__) || defined(__WIIU__)
+    return 0x1000;
+#else
+    return (size_t) sysconf(_SC_PAGESIZE);
+#endif
+}
+
+extern "C" void* VirtualMemory_Reserve(size_t size, size_t guardSize) {
+#if defined(_WIN32)
+    uint8_t* base = (uint8_t*) VirtualAlloc(NULL, size + guardSize, MEM_RESERVE, PAGE_NOACCESS);
+    // Committed pages still aren't given physical memory until they are first written
+    if (base == NULL || VirtualAlloc(base, size, MEM_COMMIT, PAGE_READWRITE) == NULL) {
+        printf("[VirtualMemory] Failed to reserve 0x%zX bytes\n", size);
+        abort();
+    }
+    return base;
+#elif defined(__SWITCH__) || defined(__WIIU__)
+    // No overcommit on consoles, so the memory is really allocated and there is no guard
+    void* base = calloc(1, size);
+    if (base == NULL) {
+        printf("[VirtualMemory] Failed to allocate 0x%zX bytes\n", size);
+        abort();
+    }
+    return base;
+#else
+    uint8_t* base = (uint8_t*) mmap(NULL, size + guardSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED || mprotect(base, size, PROT_READ | PROT_WRITE) != 0) {
+        printf("[VirtualMemory] Failed to reserve 0x%zX bytes\n", size);
+        abort();
+    }
+    return base;
+#endif
+}
+
+extern "C" void VirtualMemory_Release(void* addr, size_t size) {
+    if (size == 0) {
+        return;
+    }
+#if defined(_WIN32)
+    VirtualFree(addr, size, MEM_DECOMMIT);
+    VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__SWITCH__) || defined(__WIIU__)
+    memset(addr, 0, size);
+#else
+    madvise(addr, size, MADV_DONTNEED);
+#if defined(__APPLE__)
+    // MADV_DONTNEED is only a hint on macOS, remapping is what actually frees the pages
+    mmap(addr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+#endif
+#endif
+}
+
+extern "C" size_t VirtualMemory_GetResidentSize(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+    return 0;
+#elif defined(__linux__)
+    FILE* file = fopen("/proc/self/statm", "r");
+    long pages = 0;
+    if (file == NULL) {
+        return 0;
+    }
+    if (fscanf(file, "%*ld %ld", &pages) != 1) {
+        pages = 0;
+    }
+    fclose(file);
+    return (size_t) pages * VirtualMemory_GetPageSize();
+#else
+    return 0;
+#endif
+}
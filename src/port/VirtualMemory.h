@@ -0,0 +1,28 @@
+#ifndef VIRTUAL_MEMORY_H
+#define VIRTUAL_MEMORY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Thin wrappers over the platform's virtual memory calls.
+ * Memory from VirtualMemory_Reserve only takes up physical pages once it is touched.
+ */
+
+// Reserves size bytes of read/write address space followed by guardSize bytes that fault on access
+void* VirtualMemory_Reserve(size_t size, size_t guardSize);
+// Gives the pages in the range back to the OS. They stay usable and read back as zero.
+void VirtualMemory_Release(void* addr, size_t size);
+size_t VirtualMemory_GetPageSize(void);
+// Resident memory of the whole process in bytes, or 0 where the platform can't tell
+size_t VirtualMemory_GetResidentSize(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VIRTUAL_MEMORY_H
@@ -11,16 +11,18 @@
 #include <libultraship.h>
 #include <libultraship/libultra.h>
 #include <save.h>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <memory>
 
-#define MAX_FILES 16
-#define EXT_NAME_SIZE 4
-#define GAME_NAME_SIZE 16
+#include "pak.h"
+#include "PakStore.h"
 
-typedef struct ControllerPak {
-    FILE* header;
-    FILE* file;
-} ControllerPak;
+// 256 byte pages free on an empty pak
+#define PAK_PAGES 123
+
+namespace {
 
 std::string Pfs_PakFile_GetPath(u8 file_no) {
     return Ship::Context::GetPathRelativeToAppDirectory(fmt("controllerPak_file_{}.sav", file_no));
@@ -30,73 +32,46 @@ std::string Pfs_PakHeader_GetPath() {
     return Ship::Context::GetPathRelativeToAppDirectory("controllerPak_header.sav");
 }
 
-bool Pfs_PakHeader_Write(u32* file_size, u32* game_code, u16* company_code, u8* ext_name, u8* game_name, u8 fileIndex) {
-    ControllerPak pak;
-
-    std::string filename = Pfs_PakHeader_GetPath();
-    pak.header = fopen(filename.c_str(), "w+b");
+// Reads the header and file saves of older builds. False if there are none.
+bool Pfs_Legacy_Read(PakImage& image) {
+    bool exists;
+    std::vector<u8> header = ReadWholeFile(Pfs_PakHeader_GetPath(), &exists);
 
-    if (!pak.header) {
+    if (!exists) {
         return false;
     }
-
-    /* Set file parameters to header */
-    u32 seek = fileIndex * sizeof(OSPfsState);
-
-    // file_size
-    fseek(pak.header, seek + 0x00, SEEK_SET);
-    fwrite(file_size, 1, 4, pak.header);
-    // game_code
-    fseek(pak.header, seek + 0x04, SEEK_SET);
-    fwrite(game_code, 1, 4, pak.header);
-    // company_code
-    fseek(pak.header, seek + 0x08, SEEK_SET);
-    fwrite(company_code, 1, 2, pak.header);
-    // ext_name
-    fseek(pak.header, seek + 0x0C, SEEK_SET);
-    fwrite(ext_name, 1, EXT_NAME_SIZE, pak.header);
-    // game_name
-    fseek(pak.header, seek + 0x10, SEEK_SET);
-    fwrite(game_name, 1, GAME_NAME_SIZE, pak.header);
-    fclose(pak.header);
-
+    for (size_t i = 0; (i < MAX_FILES) && ((i + 1) * kEntrySize <= header.size()); i++) {
+        image.Entries[i] = DecodeEntry(header.data() + (i * kEntrySize));
+        if (image.Entries[i].IsUsed()) {
+            image.Files[i] = ReadWholeFile(Pfs_PakFile_GetPath(i));
+        }
+    }
     return true;
 }
 
-bool Pfs_PakHeader_Read(u32* file_size, u32* game_code, u16* company_code, char* ext_name, char* game_name,
-                        u8 fileIndex) {
-    ControllerPak pak;
-
-    std::string filename = Pfs_PakHeader_GetPath();
-    pak.header = fopen(filename.c_str(), "rb");
+std::unique_ptr<PakStore> sPak;
 
-    if(!pak.header) {
-        return false;
+PakStore& GetPak() {
+    if (sPak == nullptr) {
+        sPak = std::make_unique<PakStore>(Ship::Context::GetPathRelativeToAppDirectory("controllerPak.sav"),
+                                          Ship::Context::GetPathRelativeToAppDirectory("controllerPak.journal"));
+        if (!sPak->Load(true)) {
+            PakImage legacy;
+            if (Pfs_Legacy_Read(legacy)) {
+                sPak->Import(legacy);
+            }
+        }
     }
+    return *sPak;
+}
 
-    /* Set file parameters to header */
-    u32 seek = fileIndex * sizeof(OSPfsState);
-
-    // file_size
-    fseek(pak.header, seek + 0x00, SEEK_SET);
-    fread(file_size, 1, 4, pak.header);
-    // game_code
-    fseek(pak.header, seek + 0x04, SEEK_SET);
-    fread(game_code, 1, 4, pak.header);
-    // company_code
-    fseek(pak.header, seek + 0x08, SEEK_SET);
-    fread(company_code, 1, 2, pak.header);
-    // ext_name
-    fseek(pak.header, seek + 0x0C, SEEK_SET);
-    fread(ext_name, 1, EXT_NAME_SIZE, pak.header);
-    // game_name
-    fseek(pak.header, seek + 0x10, SEEK_SET);
-    fread(game_name, 1, GAME_NAME_SIZE, pak.header);
-    fclose(pak.header);
-
-    return true;
+bool NamesMatch(const PakEntry& entry, const u8* game_name, const u8* ext_name) {
+    return (strncmp((const char*) game_name, entry.GameName, GAME_NAME_SIZE) == 0) &&
+           (strncmp((const char*) ext_name, entry.ExtName, EXT_NAME_SIZE) == 0);
 }
 
+} // namespace
+
 extern "C" s32 osPfsIsPlug(OSMesgQueue* queue, u8* pattern) {
     *pattern = 1;
     return PFS_NO_ERROR;
@@ -107,55 +82,20 @@ extern "C" s32 osPfsInit(OSMesgQueue* queue, OSPfs* pfs, int channel) {
     pfs->channel = channel;
     pfs->status = PFS_INITIALIZED;
 
-    ControllerPak pak;
-    std::string header_file = Pfs_PakHeader_GetPath();
-
-    pak.header = fopen(header_file.c_str(), "rb");
-
-    // If a header file doesn't exist, create it.
-    if(!pak.header) {
-        pak.header = fopen(header_file.c_str(), "w+b");
-        if (!pak.header) {
-            return PFS_ERR_INVALID;
-        }
-        fclose(pak.header);
-    }
-
+    GetPak();
     return PFS_NO_ERROR;
 }
 
 extern "C" s32 osPfsFreeBlocks(OSPfs* pfs, s32* bytes_not_used) {
-    ControllerPak pak;
-    std::string header_file = Pfs_PakHeader_GetPath();
-
-    pak.header = fopen(header_file.c_str(), "rb");
-
-    if (!pak.header) {
-        return PFS_ERR_INVALID;
-    }
-
     s32 usedSpace = 0;
-    for (size_t i = 0; i < MAX_FILES; i++) {
-        u32 file_size = 0;
-        u32 game_code = 0;
-        u16 company_code = 0;
-        char ext_name[EXT_NAME_SIZE] = { 0 };
-        char game_name[GAME_NAME_SIZE] = { 0 };
-
-        if (!Pfs_PakHeader_Read(&file_size, &game_code, &company_code, ext_name, game_name, i)) {
-            return PFS_ERR_INVALID;
-        }
 
-        if ((company_code == 0) || (game_code == 0)) {
-            continue;
-        } else {
-            usedSpace += file_size >> 8;
+    for (const PakEntry& entry : GetPak().GetImage().Entries) {
+        if (entry.IsUsed()) {
+            usedSpace += entry.FileSize >> 8;
         }
     }
 
-    fclose(pak.header);
-
-    *bytes_not_used = (123 - usedSpace) << 8;
+    *bytes_not_used = (PAK_PAGES - usedSpace) << 8;
 
     return PFS_NO_ERROR;
 }
@@ -167,54 +107,27 @@ extern "C" s32 osPfsAllocateFile(OSPfs* pfs, u16 company_code, u32 game_code, u8
         return PFS_ERR_INVALID;
     }
 
-    ControllerPak pak;
+    PakStore& pak = GetPak();
 
     /* Search for a free slot */
-    u8 freeFileIndex = 0;
-    for (size_t i = 0; i < MAX_FILES; i++) {
-        u32 file_size_ = 0;
-        u32 game_code_ = 0;
-        u16 company_code_ = 0;
-        char ext_name_[EXT_NAME_SIZE] = { 0 };
-        char game_name_[GAME_NAME_SIZE] = { 0 };
-
-        if (!Pfs_PakHeader_Read(&file_size_, &game_code_, &company_code_, ext_name_, game_name_, i)) {
-            return PFS_ERR_INVALID;
-        }
-
-        if ((company_code_ == 0) || (game_code_ == 0)) {
-            freeFileIndex = i;
-            break;
-        }
+    size_t freeFileIndex = 0;
+    while ((freeFileIndex < MAX_FILES) && pak.GetImage().Entries[freeFileIndex].IsUsed()) {
+        freeFileIndex++;
     }
 
     if (freeFileIndex == MAX_FILES) {
         return PFS_DIR_FULL;
     }
 
-    if (!Pfs_PakHeader_Write((u32*) &file_size_in_bytes, &game_code, &company_code, ext_name, game_name, freeFileIndex)) {
-        return PFS_ERR_INVALID;
-    }
+    PakEntry entry;
+    entry.FileSize = file_size_in_bytes;
+    entry.GameCode = game_code;
+    entry.CompanyCode = company_code;
+    memcpy(entry.ExtName, ext_name, EXT_NAME_SIZE);
+    memcpy(entry.GameName, game_name, GAME_NAME_SIZE);
 
-    /* Create empty file */
-    std::string filename = Pfs_PakFile_GetPath(freeFileIndex);
-    pak.file = fopen(filename.c_str(), "w+b");
-
-    if (!pak.file) {
-        return PFS_ERR_INVALID;
-    }
-
-    file_size_in_bytes = (file_size_in_bytes + 31) & ~31;
-
-    char* zero_block = (char*) malloc(file_size_in_bytes);
-    for (size_t i = 0; i < file_size_in_bytes; i++) {
-        zero_block[i] = 0;
-    }
-
-    fseek(pak.file, 0, SEEK_SET);
-    fwrite(zero_block, 1, file_size_in_bytes, pak.file);
-    free(zero_block);
-    fclose(pak.file);
+    /* The file starts out zeroed */
+    pak.SetEntry(freeFileIndex, entry, (file_size_in_bytes + 31) & ~31);
 
     *file_no = freeFileIndex;
 
@@ -222,67 +135,44 @@ extern "C" s32 osPfsAllocateFile(OSPfs* pfs, u16 company_code, u32 game_code, u8
 }
 
 extern "C" s32 osPfsFileState(OSPfs* pfs, s32 file_no, OSPfsState* state) {
-    u32 file_size = 0;
-    u32 game_code = 0;
-    u16 company_code = 0;
-    char ext_name[EXT_NAME_SIZE] = { 0 };
-    char game_name[GAME_NAME_SIZE] = { 0 };
-
     // should pass the state of the requested file_no to the incoming state pointer,
     // games call this function 16 times, once per file
     // fills the incoming state with the information inside the header of the pak.
 
-    std::string filename = Pfs_PakFile_GetPath(file_no);
-    FILE* file = fopen(filename.c_str(), "rb");
-    if (file) {
-        fclose(file);
-    } else {
+    if ((file_no < 0) || (file_no >= MAX_FILES)) {
         return PFS_ERR_INVALID;
     }
 
-    /* Read game info from pak */
-    if (!Pfs_PakHeader_Read(&file_size, &game_code, &company_code, ext_name, game_name, file_no)) {
+    const PakEntry& entry = GetPak().GetImage().Entries[file_no];
+    if (!entry.IsUsed()) {
         return PFS_ERR_INVALID;
     }
 
-    state->file_size = file_size;
-    state->company_code = game_code;
-    state->game_code = game_code;
+    state->file_size = entry.FileSize;
+    state->company_code = entry.GameCode;
+    state->game_code = entry.GameCode;
 
     for (size_t j = 0; j < GAME_NAME_SIZE; j++) {
-        state->game_name[j] = game_name[j];
+        state->game_name[j] = entry.GameName[j];
     }
     for (size_t j = 0; j < EXT_NAME_SIZE; j++) {
-        state->ext_name[j] = ext_name[j];
+        state->ext_name[j] = entry.ExtName[j];
     }
 
     return PFS_NO_ERROR;
 }
 
 extern "C" s32 osPfsFindFile(OSPfs* pfs, u16 company_code, u32 game_code, u8* game_name, u8* ext_name, s32* file_no) {
-    ControllerPak pak;
+    const PakImage& image = GetPak().GetImage();
 
     for (size_t i = 0; i < MAX_FILES; i++) {
-        u32 file_size_ = 0;
-        u32 game_code_ = 0;
-        u16 company_code_ = 0;
-        char ext_name_[EXT_NAME_SIZE] = { 0 };
-        char game_name_[GAME_NAME_SIZE] = { 0 };
-
-        if (!Pfs_PakHeader_Read(&file_size_, &game_code_, &company_code_, ext_name_, game_name_, i)) {
-            return PFS_ERR_INVALID;
-        }
+        const PakEntry& entry = image.Entries[i];
 
-        if ((company_code_ == 0) || (game_code_ == 0)) {
-            continue;
-        } else {
-            if ((game_code == game_code_) && (company_code == company_code_) &&
-                (strcmp((const char*) game_name, (const char*) game_name_) == 0) &&
-                strcmp((const char*) ext_name, (const char*) ext_name_) == 0) {
-                // File found
-                *file_no = i;
-                return PFS_NO_ERROR;
-            }
+        if (entry.IsUsed() && (game_code == entry.GameCode) && (company_code == entry.CompanyCode) &&
+            NamesMatch(entry, game_name, ext_name)) {
+            // File found
+            *file_no = i;
+            return PFS_NO_ERROR;
         }
     }
 
@@ -291,42 +181,34 @@ extern "C" s32 osPfsFindFile(OSPfs* pfs, u16 company_code, u32 game_code, u8* ga
 }
 
 extern "C" s32 osPfsReadWriteFile(OSPfs* pfs, s32 file_no, u8 flag, int offset, int size_in_bytes, u8* data_buffer) {
-    ControllerPak pak;
-    std::string filename = Pfs_PakFile_GetPath(file_no);
+    if ((file_no < 0) || (file_no >= MAX_FILES) || (offset < 0) || (size_in_bytes < 0)) {
+        return PFS_ERR_INVALID;
+    }
 
-    pak.file = fopen(filename.c_str(), flag == 0 ? "r+b" : "w+b");
+    PakStore& pak = GetPak();
+    const std::vector<u8>& file = pak.GetImage().Files[file_no];
 
-    if (!pak.file) {
+    if (!pak.GetImage().Entries[file_no].IsUsed()) {
         return PFS_ERR_INVALID;
     }
 
     if (flag == 0) {
-        fseek(pak.file, offset, SEEK_SET);
-        fread(data_buffer, 1, size_in_bytes, pak.file);
+        // Like the fread this replaced, bytes past the end of the file are left alone
+        if ((size_t) offset < file.size()) {
+            memcpy(data_buffer, file.data() + offset, std::min<size_t>(size_in_bytes, file.size() - offset));
+        }
     } else {
-        fseek(pak.file, offset, SEEK_SET);
-        fwrite(data_buffer, 1, size_in_bytes, pak.file);
+        pak.Write(file_no, offset, data_buffer, size_in_bytes);
     }
 
-    fclose(pak.file);
-
     return PFS_NO_ERROR;
 }
 
 extern "C" s32 osPfsNumFiles(OSPfs* pfs, s32* max_files, s32* files_used) {
     u8 files = 0;
-    for (size_t i = 0; i < MAX_FILES; i++) {
-        u32 file_size = 0;
-        u32 game_code = 0;
-        u16 company_code = 0;
-        char ext_name[EXT_NAME_SIZE] = { 0 };
-        char game_name[GAME_NAME_SIZE] = { 0 };
-
-        if (!Pfs_PakHeader_Read(&file_size, &game_code, &company_code, ext_name, game_name, i)) {
-            return PFS_ERR_INVALID;
-        }
 
-        if ((company_code != 0) || (game_code != 0)) {
+    for (const PakEntry& entry : GetPak().GetImage().Entries) {
+        if ((entry.CompanyCode != 0) || (entry.GameCode != 0)) {
             files++;
         }
     }
@@ -342,55 +224,24 @@ extern "C" s32 osPfsDeleteFile(OSPfs* pfs, u16 company_code, u32 game_code, u8*
         return PFS_ERR_INVALID;
     }
 
-    ControllerPak pak;
-
-    for (int i = 0; i < MAX_FILES; i++) {
-        u32 file_size_ = 0;
-        u32 game_code_ = 0;
-        u16 company_code_ = 0;
-        char ext_name_[EXT_NAME_SIZE] = { 0 };
-        char game_name_[GAME_NAME_SIZE] = { 0 };
-
-        if (!Pfs_PakHeader_Read(&file_size_, &game_code_, &company_code_, ext_name_, game_name_, i)) {
-            return PFS_ERR_INVALID;
-        }
-
-        if ((company_code_ == 0) || (game_code_ == 0)) {
-            continue;
-        } else {
-            if ((game_code == game_code_) && (strcmp((const char*) game_name, (const char*) game_name_) == 0) &&
-                strcmp((const char*) ext_name, (const char*) ext_name_) == 0) {
-                // File found
-                std::string header_file = Pfs_PakHeader_GetPath();
-                pak.header = fopen(header_file.c_str(), "w+b");
-
-                if(!pak.header) {
-                    return PFS_ERR_INVALID;
-                }
-
-                u32 seek = i * sizeof(OSPfsState);
-
-                // Zero out the header for this file.
-                u8* zero_block = (u8*) malloc(sizeof(OSPfsState));
-                for (size_t i = 0; i < sizeof(OSPfsState); i++) {
-                    zero_block[i] = 0;
-                }
+    PakStore& pak = GetPak();
 
-                fseek(pak.header, seek + 0x0, SEEK_SET);
-                fwrite(zero_block, 1, sizeof(OSPfsState), pak.header);
-
-                free(zero_block);
-
-                fclose(pak.header);
-
-                std::string filename = Pfs_PakFile_GetPath(i);
-                remove(filename.c_str());
+    for (size_t i = 0; i < MAX_FILES; i++) {
+        const PakEntry& entry = pak.GetImage().Entries[i];
 
-                return PFS_NO_ERROR;
-            }
+        if (entry.IsUsed() && (game_code == entry.GameCode) && NamesMatch(entry, game_name, ext_name)) {
+            // File found
+            pak.Delete(i);
+            return PFS_NO_ERROR;
         }
     }
 
     // File not found
     return PFS_ERR_INVALID;
 }
+
+extern "C" void Pfs_Pak_Close(void) {
+    if (sPak != nullptr) {
+        sPak->Close();
+    }
+}
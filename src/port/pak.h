@@ -0,0 +1,33 @@
+#ifndef PAK_H
+#define PAK_H
+
+#include <libultraship.h>
+
+/**
+ * Controller pak kept in memory.
+ *
+ * The osPfs functions are served from an image of the whole pak, loaded the first time the game touches it.
+ * Each change is applied to the image and queued as a checksummed record. A background thread appends the
+ * records to controllerPak.journal. Once the journal grows past PAK_JOURNAL_LIMIT, the thread writes the
+ * image to a temporary file and renames it over controllerPak.sav before emptying the journal, so a crash
+ * at any point leaves either the old image or the new one. Loading replays the journal on top of the image
+ * and stops at the first record that was cut short or fails its checksum. Records only set bytes and
+ * entries, so replaying one that the image already holds changes nothing. A pak saved by older builds as
+ * controllerPak_header.sav and controllerPak_file_N.sav is imported the first time.
+ */
+
+// Journal bytes written before it is folded into the image
+#define PAK_JOURNAL_LIMIT 0x10000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Writes out everything queued and stops the background thread. Called once the game loop ends.
+void Pfs_Pak_Close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAK_H
@@ -233,10 +233,11 @@ namespace Editor {
             for (const std::string& dir : dirs) {
                 std::string name = dir.substr(dir.find_last_of('/') + 1);
                 std::string sceneFile = dir + "/scene.json";
+                std::string binaryFile = BinaryScenePath(sceneFile);
                 std::string minimapFile = dir + "/minimap.png";
-                // The track has a valid scene file
-                if (manager->HasFile(sceneFile)) {
-                    auto archive = manager->GetArchiveFromFile(sceneFile);
+                // The track has a valid scene file, binary or JSON
+                if (manager->HasFile(binaryFile) || manager->HasFile(sceneFile)) {
+                    auto archive = manager->GetArchiveFromFile(manager->HasFile(binaryFile) ? binaryFile : sceneFile);
                     
                     auto course = std::make_shared<Course>();
                     course->LoadO2R(dir);
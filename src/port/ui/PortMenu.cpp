@@ -9,8 +9,11 @@
 #include <variant>
 #include <tuple>
 #include "ResolutionEditor.h"
+#include "engine/DrawBatch.h"
+#include "engine/editor/SceneManager.h"
 
 #include "courses/Course.h"
+#include "GarbageCollector.h"
 #include "courses/KalimariDesert.h"
 #include "courses/ToadsTurnpike.h"
 
@@ -431,6 +434,14 @@ void PortMenu::AddEnhancements() {
             Ship::Context::GetInstance()->GetWindow()->GetGui()->GetGuiWindow("Properties")->ToggleVisibility();
         })
         .Options(UIWidgets::CheckboxOptions({ { .tooltip = "Edit the universe!" } }));
+    AddWidget(path, "Autosave every %d seconds", WIDGET_CVAR_SLIDER_INT)
+        .CVar("gEditorAutosaveSeconds")
+        .Options(IntSliderOptions()
+                     .Tooltip("How often the editor saves the changes to the scene to an autosave file, which the "
+                              "Tools window can restore. 0 turns autosaving off.")
+                     .Min(0)
+                     .Max(600)
+                     .DefaultValue(30));
 #endif
 }
 
@@ -495,16 +506,16 @@ void PortMenu::AddRulesets() {
 
     AddWidget(path, "Trucks", WIDGET_CVAR_SLIDER_INT)
         .CVar("gNumTrucks")
-        .Options(UIWidgets::IntSliderOptions().Min(0).Max(50).Step(1).DefaultValue(7));
+        .Options(UIWidgets::IntSliderOptions().Min(0).Max(500).Step(1).DefaultValue(7));
     AddWidget(path, "Buses", WIDGET_CVAR_SLIDER_INT)
         .CVar("gNumBuses")
-        .Options(UIWidgets::IntSliderOptions().Min(0).Max(50).Step(1).DefaultValue(7));
+        .Options(UIWidgets::IntSliderOptions().Min(0).Max(500).Step(1).DefaultValue(7));
     AddWidget(path, "Tanker Trucks", WIDGET_CVAR_SLIDER_INT)
         .CVar("gNumTankerTrucks")
-        .Options(UIWidgets::IntSliderOptions().Min(0).Max(50).Step(1).DefaultValue(7));
+        .Options(UIWidgets::IntSliderOptions().Min(0).Max(500).Step(1).DefaultValue(7));
     AddWidget(path, "Cars", WIDGET_CVAR_SLIDER_INT)
         .CVar("gNumCars")
-        .Options(UIWidgets::IntSliderOptions().Min(0).Max(50).Step(1).DefaultValue(7));
+        .Options(UIWidgets::IntSliderOptions().Min(0).Max(500).Step(1).DefaultValue(7));
 }
 
 void PortMenu::AddDevTools() {
@@ -543,6 +554,123 @@ void PortMenu::AddDevTools() {
     AddWidget(path, "Render Collision", WIDGET_CVAR_CHECKBOX)
         .CVar("gRenderCollisionMesh")
         .Options(CheckboxOptions().Tooltip("Renders the collision mesh instead of the course mesh"));
+    AddWidget(path, "Validate Entity Handles", WIDGET_CVAR_CHECKBOX)
+        .CVar("gValidateEntityHandles")
+        .Options(CheckboxOptions().Tooltip("Logs use of destroyed actors and objects to the console"));
+    AddWidget(path, "Parallel Tick", WIDGET_CVAR_CHECKBOX)
+        .CVar("gParallelTick")
+        .Options(CheckboxOptions()
+                     .Tooltip("Ticks parallel-safe actors and objects on worker threads when there are enough of them")
+                     .DefaultValue(true));
+    AddWidget(path, "Parallel Viewports", WIDGET_CVAR_CHECKBOX)
+        .CVar("gParallelViewports")
+        .Options(CheckboxOptions()
+                     .Tooltip("Culls, sorts and picks detail levels for a custom track's sections in every "
+                              "splitscreen viewport at once on worker threads, before the viewports are drawn")
+                     .DefaultValue(true));
+    AddWidget(path, "Late Input Sampling", WIDGET_CVAR_CHECKBOX)
+        .CVar("gLateInputSampling")
+        .Options(CheckboxOptions()
+                     .Tooltip("Reads the controllers again before every game tick of a frame instead of once per "
+                              "frame. Replays, demos and netplay always read them once per frame.")
+                     .DefaultValue(true));
+    AddWidget(path, "Pipelined Rendering", WIDGET_CVAR_CHECKBOX)
+        .CVar("gPipelinedRendering")
+        .Options(CheckboxOptions().Tooltip("Runs the game on its own thread while the main thread draws the previous "
+                                           "frame. Frames are drawn one at a time while this menu or the editor is "
+                                           "open."));
+    AddWidget(path, "Batch Prop Draws", WIDGET_CVAR_CHECKBOX)
+        .CVar("gBatchDraws")
+        .Options(CheckboxOptions()
+                     .Tooltip("Draws trees, cacti, signs and static meshes grouped by model, with their shared "
+                              "state set once per model instead of once per prop")
+                     .DefaultValue(true));
+    AddWidget(path, "Batch Text", WIDGET_CVAR_CHECKBOX)
+        .CVar("gBatchText")
+        .Options(CheckboxOptions()
+                     .Tooltip("Sets the letter mode and depth test once per line of menu text, and only loads a "
+                              "glyph's texture when the glyph before it used a different one")
+                     .DefaultValue(true));
+    AddWidget(path, "Stable Kart Palettes", WIDGET_CVAR_CHECKBOX)
+        .CVar("gStableKartPalettes")
+        .Options(CheckboxOptions()
+                     .Tooltip("Draws karts with shared copies of their palettes, so the renderer keeps each decoded "
+                              "kart frame instead of decoding it again after every draw")
+                     .DefaultValue(true));
+    AddWidget(path, "Editor Picking Trees", WIDGET_CVAR_CHECKBOX)
+        .CVar("gPickingBvh")
+        .Options(CheckboxOptions()
+                     .Tooltip("Picks editor objects through a tree of their bounds and a tree of each model's "
+                              "triangles, instead of testing every triangle of every object")
+                     .DefaultValue(true));
+
+    // Console reports and one-off tests of the options in General
+    path = { "Developer", "Benchmarks", SECTION_COLUMN_1 };
+    AddSidebarEntry("Developer", "Benchmarks", 2);
+    AddWidget(path, "Reports", WIDGET_SEPARATOR_TEXT);
+    AddWidget(path, "Report Display List Usage", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportGfxPool")
+        .Options(CheckboxOptions().Tooltip("Prints the display list commands, chained blocks and object matrices "
+                                           "used per frame, and their peaks, to the console once a second"));
+    AddWidget(path, "Report Culling", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportCulling")
+        .Options(CheckboxOptions().Tooltip("Prints how many actors, objects, static meshes, particles and track "
+                                           "sections were drawn and frustum culled in each viewport to the console "
+                                           "once a second"));
+    AddWidget(path, "Report Frame Timing", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportFrameTiming")
+        .Options(CheckboxOptions().Tooltip("Prints how many game ticks the frames ran, the tick jitter and how old "
+                                           "the controller input was at each tick to the console once a second"));
+    AddWidget(path, "Report Frame Pipeline", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportFramePipeline")
+        .Options(CheckboxOptions().Tooltip("Prints how long the game and drawing took per frame, and how much of "
+                                           "them overlapped, to the console once a second"));
+    AddWidget(path, "Report LOD", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportLod")
+        .Options(CheckboxOptions().Tooltip("Prints the triangles drawn in each viewport to the console once a "
+                                           "second"));
+    AddWidget(path, "Report Kart Textures", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportKartTextures")
+        .Options(CheckboxOptions().Tooltip("Prints how many kart frames were drawn and how many had to be decoded "
+                                           "and uploaded per frame to the console once a second"));
+    AddWidget(path, "Report CVar Lookups", WIDGET_CVAR_CHECKBOX)
+        .CVar("gReportCVarLookups")
+        .Options(CheckboxOptions().Tooltip("Prints how many CVar lookups the game made in a frame to the console "
+                                           "once a second"));
+    path.column = SECTION_COLUMN_2;
+    AddWidget(path, "Tests", WIDGET_SEPARATOR_TEXT);
+    AddWidget(path, "Run Entity Stress Test", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { RunEntityStressTest(50000); })
+        .Options(ButtonOptions().Tooltip("Spawns and destroys 50000 actors and objects in a scratch world and "
+                                         "reports any stale or leaked handles"));
+    AddWidget(path, "Run Parallel Tick Benchmark", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { RunParallelTickBenchmark(4000); })
+        .Options(ButtonOptions().Tooltip("Builds 4000 cars on the current track, without spawning them, and times "
+                                         "ticking them serially and across worker threads"));
+    AddWidget(path, "Run Traffic Benchmark", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { RunTrafficBenchmark(2000); })
+        .Options(ButtonOptions().Tooltip("Times ticking 2000 cars as actors and as road traffic on the current track "
+                                         "and checks that both end up in the same state"));
+    AddWidget(path, "Run Type Dispatch Benchmark", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { RunTypeDispatchBenchmark(); })
+        .Options(ButtonOptions().Tooltip("Times course type checks and per-class actor lookups against dynamic_cast"));
+    AddWidget(path, "Run Course Memory Test", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { RunCourseMemoryTest(); })
+        .Options(ButtonOptions().Tooltip("Loads every stock course twice from the menus and checks that memory use "
+                                         "stays flat, then prints the memory pool's peak use per scope"));
+    AddWidget(path, "Run Draw Batch Benchmark", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { DrawBatch_RunBenchmark(); })
+        .Options(ButtonOptions().Tooltip("Builds the display list for the loaded track's static meshes and a grid of "
+                                         "stock props with and without batching, and prints the commands each "
+                                         "emitted"));
+    AddWidget(path, "Run Collision Mesh Test", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { Editor::RunCollisionMeshTest(500); })
+        .Options(ButtonOptions().Tooltip("Places 500 copies of each editor object's model, extracting the triangles "
+                                         "for every copy and sharing them, and prints the time and memory each took"));
+    AddWidget(path, "Run Scene Format Benchmark", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { Editor::RunSceneFormatBenchmark(); })
+        .Options(ButtonOptions().Tooltip("Times writing and reading the tracks' scenes and the current level in the "
+                                         "binary scene format against JSON"));
 
     path = { "Developer", "Gfx Debugger", SECTION_COLUMN_1 };
     AddSidebarEntry("Developer", "Gfx Debugger", 1);
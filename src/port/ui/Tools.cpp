@@ -37,6 +37,38 @@ namespace Editor {
         if (ImGui::Button(ICON_FA_FLOPPY_O, ImVec2(50, 25))) {
             SaveLevel();
         }
+        if (ImGui::IsItemHovered()) {
+            ImGui::BeginTooltip();
+            ImGui::Text("Save");
+            ImGui::EndTooltip();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_FA_UPLOAD, ImVec2(50, 25))) {
+            ExportLevelJson();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::BeginTooltip();
+            ImGui::Text("Export the scene to scene.json");
+            ImGui::EndTooltip();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_FA_DOWNLOAD, ImVec2(50, 25))) {
+            ImportLevelJson();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::BeginTooltip();
+            ImGui::Text("Import the scene from scene.json");
+            ImGui::EndTooltip();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_FA_HISTORY, ImVec2(50, 25))) {
+            RestoreAutosave();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::BeginTooltip();
+            ImGui::Text("Restore the last autosave");
+            ImGui::EndTooltip();
+        }
 
         ImGui::SameLine();
 
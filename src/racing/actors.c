@@ -34,6 +34,10 @@
 #include <assets/wario_stadium_data.h>
 #include <assets/frappe_snowland_data.h>
 #include "port/Game.h"
+#include "port/FrameSettings.h"
+#include "port/GfxPool.h"
+#include "port/Frustum.h"
+#include "engine/DrawBatch.h"
 #include "port/interpolation/FrameInterpolation.h"
 
 // Appears to be textures
@@ -670,7 +674,7 @@ void render_palm_trees(Camera* camera, Mat4 arg1) {
 
         if (is_within_render_distance(camera->pos, spD4, camera->rot[1], 0.0f, gCameraZoom[camera - camera1], var_f22) <
                 0.0f &&
-            CVarGetInteger("gNoCulling", 0) == 0) {
+            gFrameSettings.NoCulling == 0) {
             var_s1++;
             continue;
         }
@@ -735,7 +739,7 @@ void render_actor_shell(Camera* camera, Mat4 matrix, struct ShellActor* shell) {
 
     f32 temp_f0 =
         is_within_render_distance(camera->pos, shell->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 490000.0f);
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         temp_f0 = CLAMP(temp_f0, 0.0f, 40000.0f);
     }
     s32 maxObjectsReached;
@@ -816,7 +820,7 @@ UNUSED void func_8029ABD4(f32* pos, s16 state) {
 void func_8029AC18(Camera* camera, Mat4 arg1, struct Actor* arg2) {
     if (is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1],
                                   4000000.0f) < 0 &&
-        CVarGetInteger("gNoCulling", 0) == 0) {
+        gFrameSettings.NoCulling == 0) {
         return;
     }
 
@@ -1234,7 +1238,7 @@ void spawn_course_actors(void) {
  */
 void init_actors_and_load_textures(void) {
     set_segment_base_addr_x64(3, (void*) gNextFreeMemoryAddress);
-    allocate_memory(0x400 * 16);
+    allocate_memory(0x400 * 16, MEMORY_TAG_TEXTURES);
     dma_textures(gTextureFinishLineBanner1, 0x0000028EU, 0x00000800U); // 0x03004000
     dma_textures(gTextureFinishLineBanner2, 0x000002FBU, 0x00000800U); // 0x03004800
     dma_textures(gTextureFinishLineBanner3, 0x00000302U, 0x00000800U); // 0x03005000
@@ -1291,6 +1295,8 @@ void destroy_actor(struct Actor* actor) {
     actor->flags = 0;
     actor->type = 0;
     gNumActors--;
+    // The slot is handed back to add_actor_to_empty_slot after the end of frame garbage collection
+    CM_DestroyActor(actor);
 }
 
 s16 try_remove_destructable_item(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actorType) {
@@ -1414,25 +1420,16 @@ s16 try_remove_destructable_item(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actor
 
 // returns actor index if any available actor type is -1
 s16 add_actor_to_empty_slot(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actorType) {
-    size_t index;
-
     // if (gNumActors >= CM_GetActorSize()) {
     //     return try_remove_destructable_item(pos, rot, velocity, actorType);
     // }
 
-    // Cleanup unused actors
-    for (index = 0; index < CM_GetActorSize(); index++) {
-        // if (CM_GetActor(index)->flags == 0) {
-        //! @todo Commented out because deletes too soon.
-        // CM_DeleteActor(index);
-        // gNumActors--;
-        //}
-    }
+    // Reuses the slot of an actor destroyed in a previous frame if there is one
     gNumActors++;
     struct Actor* actor = CM_AddBaseActor();
     actor_init(actor, pos, rot, velocity, actorType);
     CM_AddEditorObject(actor, get_actor_name(actor->type));
-    return (s16) CM_GetActorSize() - 1; // Return current index;
+    return (s16) CM_FindActorIndex(actor);
 }
 
 UNUSED s16 spawn_actor_at_pos(Vec3f pos, s16 actorType) {
@@ -2407,6 +2404,14 @@ void render_item_boxes(struct UnkStruct_800DC5EC* arg0) {
             continue;
         }
 
+        if ((actor->type == ACTOR_FAKE_ITEM_BOX) || (actor->type == ACTOR_ITEM_BOX) ||
+            (actor->type == ACTOR_HOT_AIR_BALLOON_ITEM_BOX)) {
+            // The radius covers the box's shadow on the ground below it
+            if (!Frustum_IsSphereVisible(actor->pos, 50.0f)) {
+                continue;
+            }
+        }
+
         switch (actor->type) {
             case ACTOR_FAKE_ITEM_BOX:
                 render_actor_fake_item_box(camera, (struct FakeItemBox*) actor);
@@ -2421,11 +2426,61 @@ void render_item_boxes(struct UnkStruct_800DC5EC* arg0) {
     }
 }
 
+/**
+ * Radius of a sphere around the actor's position that holds everything its render function draws,
+ * or 0 if the actor is not culled here. Custom actors are culled by CM_DrawActors, and RoadTraffic uses the
+ * vehicle radii for the traffic it draws through scratch actors.
+ */
+f32 get_actor_cull_radius(struct Actor* actor) {
+    switch (actor->type) {
+        case ACTOR_BANANA:
+        case ACTOR_GREEN_SHELL:
+        case ACTOR_RED_SHELL:
+        case ACTOR_BLUE_SPINY_SHELL:
+        case ACTOR_KIWANO_FRUIT:
+            return 30.0f;
+        case ACTOR_FALLING_ROCK:
+        case ACTOR_COW:
+        case ACTOR_PIRANHA_PLANT:
+        case ACTOR_RAILROAD_CROSSING:
+            return 80.0f;
+        case ACTOR_BOX_TRUCK:
+        case ACTOR_SCHOOL_BUS:
+        case ACTOR_TANKER_TRUCK:
+        case ACTOR_CAR:
+        case ACTOR_TRAIN_ENGINE:
+        case ACTOR_TRAIN_TENDER:
+        case ACTOR_TRAIN_PASSENGER_CAR:
+            return 120.0f;
+        case ACTOR_TREE_MARIO_RACEWAY:
+        case ACTOR_TREE_YOSHI_VALLEY:
+        case ACTOR_TREE_ROYAL_RACEWAY:
+        case ACTOR_TREE_MOO_MOO_FARM:
+        case ACTOR_TREE_BOWSERS_CASTLE:
+        case ACTOR_BUSH_BOWSERS_CASTLE:
+        case ACTOR_TREE_FRAPPE_SNOWLAND:
+        case ACTOR_CACTUS1_KALAMARI_DESERT:
+        case ACTOR_CACTUS2_KALAMARI_DESERT:
+        case ACTOR_CACTUS3_KALAMARI_DESERT:
+        case ACTOR_PALM_TREE:
+            return 150.0f;
+        case ACTOR_YOSHI_EGG:
+        case ACTOR_MARIO_SIGN:
+        case ACTOR_WARIO_SIGN:
+            return 250.0f;
+        case ACTOR_PADDLE_BOAT:
+            return 400.0f;
+        default:
+            return 0.0f;
+    }
+}
+
 void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
     Camera* camera = arg0->camera;
     u16 pathCounter = arg0->pathCounter;
     UNUSED s32 pad[12];
     s32 i;
+    f32 cullRadius;
 
     struct Actor* actor;
     UNUSED Vec3f sp4C = { 0.0f, 5.0f, 10.0f };
@@ -2433,7 +2488,7 @@ void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
     // Freecam rotY is reversed in the engine for whatever reason
     f32 sp48 = 0;
     f32 temp_f0 = 0;
-    if (CVarGetInteger("gFreecam", 0) == true) {
+    if (gFrameSettings.Freecam == true) {
         sp48 = sins(-camera->rot[1] - 0x8000);
         temp_f0 = coss(-camera->rot[1] - 0x8000);
     } else {
@@ -2464,6 +2519,9 @@ void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
     }
     D_8015F8E0 = 0;
 
+    // Trees, cacti and signs are queued and drawn grouped by model after the loop
+    DrawBatch_Begin();
+
     for (i = 0; i < CM_GetActorSize(); i++) {
         actor = CM_GetActor(i);
 
@@ -2471,6 +2529,12 @@ void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
             continue;
         }
 
+        cullRadius = get_actor_cull_radius(actor);
+        if ((cullRadius > 0.0f) && !Frustum_IsSphereVisible(actor->pos, cullRadius)) {
+            continue;
+        }
+
+        GfxPool_Ensure();
         FrameInterpolation_RecordOpenChild(actor, i);
 
         switch (actor->type) {
@@ -2580,6 +2644,8 @@ void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
         }
         FrameInterpolation_RecordCloseChild();
     }
+    DrawBatch_Flush();
+    CM_DrawTraffic(camera);
     if (IsMooMooFarm()) {
         render_cows(camera, sBillBoardMtx);
     } else if (IsDkJungle()) {
@@ -110,6 +110,7 @@ void render_actor_railroad_crossing(Camera*, struct RailroadCrossing*);
 void render_actor_palm_tree(Camera*, Mat4, struct PalmTree*);
 void render_item_boxes(struct UnkStruct_800DC5EC*);
 void render_course_actors(struct UnkStruct_800DC5EC*);
+f32 get_actor_cull_radius(struct Actor*);
 void update_course_actors(void);
 const char* get_actor_name(s32);
 
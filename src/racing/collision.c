@@ -11,6 +11,7 @@
 #include "code_800029B0.h"
 #include <defines.h>
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include <stdio.h>
 
 #pragma intrinsic(sqrtf)
@@ -43,7 +44,7 @@ f32 get_water_level(Player* player) {
     return CM_GetWaterLevel(player->pos, &player->collision);
 }
 
-s32 check_collision_zx(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u16 index) {
+s32 check_collision_zx(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     UNUSED f32 pad;
     f32 x3;
@@ -152,7 +153,7 @@ s32 check_collision_zx(Collision* collision, f32 boundingBoxSize, f32 posX, f32
     return 0;
 }
 
-s32 check_collision_yx(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u16 index) {
+s32 check_collision_yx(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     UNUSED f32 pad[6];
     f32 x3;
@@ -260,7 +261,7 @@ s32 check_collision_yx(Collision* collision, f32 boundingBoxSize, f32 posX, f32
     return 0;
 }
 
-s32 check_collision_zy(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u16 index) {
+s32 check_collision_zy(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     s32 b = true;
     UNUSED f32 pad[7];
@@ -369,7 +370,7 @@ s32 check_collision_zy(Collision* collision, f32 boundingBoxSize, f32 posX, f32
     return 0;
 }
 
-s32 check_horizontally_colliding_with_triangle(f32 posX, f32 posZ, u16 index) {
+s32 check_horizontally_colliding_with_triangle(f32 posX, f32 posZ, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     UNUSED f32 pad;
     f32 x3;
@@ -429,12 +430,12 @@ s32 check_horizontally_colliding_with_triangle(f32 posX, f32 posZ, u16 index) {
     return b;
 }
 
-s8 get_surface_type(u16 index) {
+s8 get_surface_type(u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     return triangle->surfaceType;
 }
 
-s16 get_track_section_id(u16 index) {
+s16 get_track_section_id(u32 index) {
     if (index >= gCollisionMeshCount) {
         // printf("[collision.c] [get_track_section_id] Warning: Trying to access a collision triangle index %d\n
         //  Which is overflows gCollisionMesh, as its total size is %d\n", index, gCollisionMeshCount);
@@ -444,22 +445,22 @@ s16 get_track_section_id(u16 index) {
     return triangle->flags & 0xFF;
 }
 
-s16 func_802ABD7C(u16 index) {
+s16 func_802ABD7C(u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     return triangle->flags & 0x1000;
 }
 
-s16 func_802ABDB8(u16 index) {
+s16 func_802ABDB8(u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     return triangle->flags & 0x400;
 }
 
-s16 func_802ABDF4(u16 index) {
+s16 func_802ABDF4(u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     return triangle->flags & 0x800;
 }
 
-f32 calculate_surface_height(f32 x, f32 y, f32 z, u16 index) {
+f32 calculate_surface_height(f32 x, f32 y, f32 z, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     if (triangle->normalY == 0.0f) {
         return y;
@@ -578,18 +579,14 @@ void adjust_pos_orthogonally(Vec3f pos1, f32 boundingBoxSize, Vec3f pos2, UNUSED
 UNUSED s32 detect_tyre_collision(KartTyre* tyre) {
     Collision collision;
     UNUSED s32 pad[12];
-    s32 courseLengthX;
-    s32 courseLengthZ;
     f32 tyreX;
     f32 tyreY;
     f32 tyreZ;
-    s16 sectionIndexX;
-    s16 sectionIndexZ;
-    u16 i;
-    u16 numTriangles;
-    u16 meshIndex;
-    s16 gridIndex;
-    u16 sectionIndex;
+    u32 i;
+    u32 numTriangles;
+    u32 meshIndex;
+    s32 gridIndex;
+    u32 sectionIndex;
 
     collision.unk30 = 0;
     collision.unk32 = 0;
@@ -602,19 +599,19 @@ UNUSED s32 detect_tyre_collision(KartTyre* tyre) {
     tyreZ = tyre->pos[2];
     switch (tyre->surfaceFlags) { /* irregular */
         case 0x80:
-            if (check_collision_zy(&collision, 5.0f, tyreX, tyreY, tyreZ, (u16) (s32) tyre->collisionMeshIndex) == 1) {
+            if (check_collision_zy(&collision, 5.0f, tyreX, tyreY, tyreZ, tyre->collisionMeshIndex) == 1) {
                 tyre->baseHeight = calculate_surface_height(tyreX, tyreY, tyreZ, tyre->collisionMeshIndex);
                 return 1;
             }
             break;
         case 0x40:
-            if (check_collision_zx(&collision, 5.0f, tyreX, tyreY, tyreZ, (u16) (s32) tyre->collisionMeshIndex) == 1) {
+            if (check_collision_zx(&collision, 5.0f, tyreX, tyreY, tyreZ, tyre->collisionMeshIndex) == 1) {
                 tyre->baseHeight = calculate_surface_height(tyreX, tyreY, tyreZ, tyre->collisionMeshIndex);
                 return 1;
             }
             break;
         case 0x20:
-            if (check_collision_yx(&collision, 5.0f, tyreX, tyreY, tyreZ, (u16) (s32) tyre->collisionMeshIndex) == 1) {
+            if (check_collision_yx(&collision, 5.0f, tyreX, tyreY, tyreZ, tyre->collisionMeshIndex) == 1) {
                 tyre->baseHeight = calculate_surface_height(tyreX, tyreY, tyreZ, tyre->collisionMeshIndex);
                 return 1;
             }
@@ -622,24 +619,11 @@ UNUSED s32 detect_tyre_collision(KartTyre* tyre) {
         default:
             break;
     }
-    courseLengthX = gCourseMaxX - gCourseMinX;
-    courseLengthZ = gCourseMaxZ - gCourseMinZ;
-    sectionIndexX = (tyreX - gCourseMinX) / (courseLengthX / GRID_SIZE);
-    sectionIndexZ = (tyreZ - gCourseMinZ) / (courseLengthZ / GRID_SIZE);
-    if (sectionIndexX < 0) {
-        return 0;
-    }
-    if (sectionIndexZ < 0) {
-        return 0;
-    }
-    if (sectionIndexX >= GRID_SIZE) {
-        return 0;
-    }
-    if (sectionIndexZ >= GRID_SIZE) {
+    gridIndex = get_collision_grid_index(tyreX, tyreZ);
+    if (gridIndex < 0) {
         return 0;
     }
 
-    gridIndex = (sectionIndexX + sectionIndexZ * GRID_SIZE);
     numTriangles = gCollisionGrid[gridIndex].numTriangles;
     if (numTriangles == 0) {
         return 0;
@@ -692,7 +676,7 @@ UNUSED s32 detect_tyre_collision(KartTyre* tyre) {
 }
 
 s32 is_colliding_with_drivable_surface(Collision* collision, f32 boundingBoxSize, f32 newX, f32 newY, f32 newZ,
-                                       u16 index, f32 oldX, f32 oldY, f32 oldZ) {
+                                       u32 index, f32 oldX, f32 oldY, f32 oldZ) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     UNUSED s32 pad;
     f32 x4;
@@ -806,9 +790,9 @@ s32 is_colliding_with_drivable_surface(Collision* collision, f32 boundingBoxSize
 /**
  * Wall collision
  */
-s32 is_colliding_with_wall2(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u16 surfaceIndex, f32 posX,
+s32 is_colliding_with_wall2(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u32 surfaceIndex, f32 posX,
                             f32 posY, f32 posZ) {
-    if (CVarGetInteger("gNoWallColision", 0)) {
+    if (gFrameSettings.NoWallCollision) {
         return NO_COLLISION;
     }
     CollisionTriangle* triangle = &gCollisionMesh[surfaceIndex];
@@ -991,9 +975,9 @@ s32 is_colliding_with_wall2(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1,
 /**
  * This is actually more like colliding with face X/Y/Z
  */
-s32 is_colliding_with_wall1(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u16 surfaceIndex, f32 posX,
+s32 is_colliding_with_wall1(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u32 surfaceIndex, f32 posX,
                             f32 posY, f32 posZ) {
-    if (CVarGetInteger("gNoWallColision", 0)) {
+    if (gFrameSettings.NoWallCollision) {
         return NO_COLLISION;
     }
     CollisionTriangle* triangle = &gCollisionMesh[surfaceIndex];
@@ -1176,20 +1160,14 @@ s32 is_colliding_with_wall1(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1,
 
 u16 actor_terrain_collision(Collision* collision, f32 boundingBoxSize, f32 newX, f32 newY, f32 newZ, f32 oldX, f32 oldY,
                             f32 oldZ) {
-    s32 courseLengthX;
-    s32 courseLengthZ;
-    s16 sectionIndexX;
-    s16 sectionIndexZ;
-    u16 numTriangles;
-    u16 collisionIndex;
-    s16 gridIndex;
+    u32 numTriangles;
+    u32 collisionIndex;
+    s32 gridIndex;
 
-    u16 sectionIndex;
+    u32 sectionIndex;
 
     u16 flags = 0;
-    s32 sectionX;
-    s32 sectionZ;
-    u16 i;
+    u32 i;
 
     collision->unk30 = 0;
     collision->unk32 = 0;
@@ -1224,28 +1202,11 @@ u16 actor_terrain_collision(Collision* collision, f32 boundingBoxSize, f32 newX,
         return flags;
     }
 
-    courseLengthX = (s32) gCourseMaxX - gCourseMinX;
-    courseLengthZ = (s32) gCourseMaxZ - gCourseMinZ;
-
-    sectionX = courseLengthX / GRID_SIZE;
-    sectionZ = courseLengthZ / GRID_SIZE;
-
-    sectionIndexX = (newX - gCourseMinX) / sectionX;
-    sectionIndexZ = (newZ - gCourseMinZ) / sectionZ;
-    if (sectionIndexX < 0) {
-        return 0;
-    }
-    if (sectionIndexZ < 0) {
-        return 0;
-    }
-    if (sectionIndexX >= GRID_SIZE) {
-        return 0;
-    }
-    if (sectionIndexZ >= GRID_SIZE) {
+    gridIndex = get_collision_grid_index(newX, newZ);
+    if (gridIndex < 0) {
         return 0;
     }
 
-    gridIndex = (sectionIndexX + sectionIndexZ * GRID_SIZE);
     numTriangles = gCollisionGrid[gridIndex].numTriangles;
 
     if (numTriangles == 0) {
@@ -1293,18 +1254,12 @@ u16 actor_terrain_collision(Collision* collision, f32 boundingBoxSize, f32 newX,
 }
 
 u16 check_bounding_collision(Collision* collision, f32 boundingBoxSize, f32 posX, f32 posY, f32 posZ) {
-    u16 numTriangles;
-    s32 courseLengthX;
-    s32 courseLengthZ;
-    u16 meshIndex;
-    s32 sectionX;
-    s32 sectionZ;
-    s16 sectionIndexX;
-    s16 sectionIndexZ;
-    s16 gridIndex;
-    u16 i;
+    u32 numTriangles;
+    u32 meshIndex;
+    s32 gridIndex;
+    u32 i;
 
-    u16 sectionIndex;
+    u32 sectionIndex;
     u16 flags;
 
     collision->unk30 = 0;
@@ -1333,29 +1288,11 @@ u16 check_bounding_collision(Collision* collision, f32 boundingBoxSize, f32 posX
         return flags;
     }
 
-    courseLengthX = (s32) gCourseMaxX - gCourseMinX;
-    courseLengthZ = (s32) gCourseMaxZ - gCourseMinZ;
-
-    sectionX = courseLengthX / GRID_SIZE;
-    sectionZ = courseLengthZ / GRID_SIZE;
-
-    sectionIndexX = (posX - gCourseMinX) / sectionX;
-    sectionIndexZ = (posZ - gCourseMinZ) / sectionZ;
-
-    if (sectionIndexX < 0) {
-        return 0;
-    }
-    if (sectionIndexZ < 0) {
-        return 0;
-    }
-    if (sectionIndexX >= GRID_SIZE) {
-        return 0;
-    }
-    if (sectionIndexZ >= GRID_SIZE) {
+    gridIndex = get_collision_grid_index(posX, posZ);
+    if (gridIndex < 0) {
         return 0;
     }
 
-    gridIndex = sectionIndexX + sectionIndexZ * GRID_SIZE;
     numTriangles = gCollisionGrid[gridIndex].numTriangles;
     if (numTriangles == 0) {
         return flags;
@@ -1405,47 +1342,21 @@ extern u8 D_8014F1110;
  */
 f32 spawn_actor_on_surface(f32 posX, f32 posY, f32 posZ) {
     f32 height;
-    s16 sectionIndexX;
-    s16 sectionIndexZ;
-    s16 gridSection;
+    s32 gridSection;
 
-    u16 index;
-    u16 numTriangles;
-    u16 sectionIndex;
+    u32 index;
+    u32 numTriangles;
+    u32 sectionIndex;
     f32 phi_f20 = -3000.0f;
-    u16 i;
-
-    s32 courseLengthX;
-    s32 courseLengthZ;
-    s32 sectionX;
-    s32 sectionZ;
-
-    courseLengthX = (gCourseMaxX - gCourseMinX);
-    courseLengthZ = (gCourseMaxZ - gCourseMinZ);
-    sectionX = courseLengthX / GRID_SIZE;
-    sectionZ = courseLengthZ / GRID_SIZE;
-
-    sectionIndexX = (s16) ((posX - gCourseMinX) / sectionX);
-    sectionIndexZ = (s16) ((posZ - gCourseMinZ) / sectionZ);
-    gridSection = sectionIndexX + (sectionIndexZ * GRID_SIZE);
-    numTriangles = gCollisionGrid[gridSection].numTriangles;
+    u32 i;
 
-    if (sectionIndexX < 0) {
-        printf("collision.c: actor outside of -sectionX %d\n", sectionIndexX);
-        return 3000.0f;
-    }
-    if (sectionIndexZ < 0) {
-        printf("collision.c: actor outside of -sectionZ %d\n", sectionIndexZ);
-        return 3000.0f;
-    }
-    if (sectionIndexX >= GRID_SIZE) {
-        printf("collision.c: actor outside of sectionX %d\n", sectionIndexX);
-        return 3000.0f;
-    }
-    if (sectionIndexZ >= GRID_SIZE) {
-        printf("collision.c: actor outside of sectionZ %d\n", sectionIndexZ);
+    gridSection = get_collision_grid_index(posX, posZ);
+    if (gridSection < 0) {
+        printf("collision.c: actor outside of the collision grid at x %f z %f\n", posX, posZ);
         return 3000.0f;
     }
+
+    numTriangles = gCollisionGrid[gridSection].numTriangles;
     if (numTriangles == 0) {
         printf("collision.c: No collision triangles in track!\n  Something is wrong with the tracks geometry\n");
         return 3000.0f;
@@ -1828,7 +1739,7 @@ s32 is_line_intersecting_rectangle(s16 minX, s16 maxX, s16 minZ, s16 maxZ, s16 x
     return 0;
 }
 
-s32 is_triangle_intersecting_bounding_box(s16 minX, s16 maxX, s16 minZ, s16 maxZ, u16 index) {
+s32 is_triangle_intersecting_bounding_box(s16 minX, s16 maxX, s16 minZ, s16 maxZ, u32 index) {
     CollisionTriangle* triangle = &gCollisionMesh[index];
     s16 x1;
     s16 z1;
@@ -1864,15 +1775,60 @@ s32 is_triangle_intersecting_bounding_box(s16 minX, s16 maxX, s16 minZ, s16 maxZ
     return 0;
 }
 
+/**
+ * Picks the collision grid resolution for the loaded mesh. Stock courses keep the 32x32 grid,
+ * large custom tracks get a finer grid allocated from the memory pool so each cell stays small.
+ */
+void allocate_collision_grid(void) {
+    s32 courseLengthX = (s32) gCourseMaxX - gCourseMinX;
+    s32 courseLengthZ = (s32) gCourseMaxZ - gCourseMinZ;
+    s32 gridSize = GRID_SIZE;
+
+    while ((gridSize < GRID_SIZE_MAX) &&
+           (gCollisionMeshCount > (u32) (gridSize * gridSize * GRID_TRIANGLES_PER_CELL)) &&
+           ((courseLengthX / (gridSize * 2)) >= GRID_MIN_CELL_LENGTH) &&
+           ((courseLengthZ / (gridSize * 2)) >= GRID_MIN_CELL_LENGTH)) {
+        gridSize *= 2;
+    }
+
+    gCollisionGridSize = gridSize;
+    if (gridSize == GRID_SIZE) {
+        gCollisionGrid = gDefaultCollisionGrid;
+        return;
+    }
+    gCollisionGrid =
+        (CollisionGrid*) allocate_memory(gridSize * gridSize * sizeof(CollisionGrid), MEMORY_TAG_COLLISION);
+    printf("collision.c: %u triangles, using a %dx%d collision grid\n", gCollisionMeshCount, gridSize, gridSize);
+}
+
+/**
+ * Length of a grid cell along an axis of the course. The stock grid rounds down like it always has, which can
+ * leave up to 31 units past the last cell. Finer grids round up, since their remainder can reach 255 units,
+ * more than the 20 units of padding gCourseMax gets past the mesh.
+ */
+s32 get_collision_grid_cell_length(s32 courseLength) {
+    if (gCollisionGridSize == GRID_SIZE) {
+        return courseLength / GRID_SIZE;
+    }
+    return (courseLength + gCollisionGridSize - 1) / gCollisionGridSize;
+}
+
 /**
  * Splits the collision mesh into 32x32 sections. This allows the game to check only
  * nearby geography for a collision rather than checking against the whole collision mesh.
  * (checking against the whole mesh for every actor would be expensive)
+ *
+ * Each triangle is only tested against the cells its bounding box reaches. The first pass counts
+ * the triangles per cell and the second writes them out, visiting triangles in order so every
+ * cell lists them in the same order as a cell by cell scan of the whole mesh.
  */
 void generate_collision_grid(void) {
     CollisionTriangle* triangle;
-    s32 i, j, k;
-    UNUSED s32 pad[5];
+    s32 gridSize = gCollisionGridSize;
+    s32 numCells = gridSize * gridSize;
+    s32 pass, j, k;
+    s32 minJ, maxJ, minK, maxK;
+    u32 i;
     s16 maxX;
     s16 maxZ;
     s16 minX;
@@ -1882,57 +1838,86 @@ void generate_collision_grid(void) {
     s32 courseLengthX;
     s32 courseLengthZ;
     s32 index;
+    u32 total;
 
     courseLengthX = (s32) gCourseMaxX - gCourseMinX;
     courseLengthZ = (s32) gCourseMaxZ - gCourseMinZ;
 
-    // Separate the course into 32 sections
-    sectionX = courseLengthX / GRID_SIZE;
-    sectionZ = courseLengthZ / GRID_SIZE;
+    // Separate the course into sections
+    sectionX = get_collision_grid_cell_length(courseLengthX);
+    sectionZ = get_collision_grid_cell_length(courseLengthZ);
 
     // Reset the collision grid
-    for (i = 0; i < 1024; i++) {
-        gCollisionGrid[i].numTriangles = 0;
+    for (index = 0; index < numCells; index++) {
+        gCollisionGrid[index].triangle = 0;
+        gCollisionGrid[index].numTriangles = 0;
     }
 
     gNumCollisionTriangles = 0;
 
-    // 32x32 grid
-    for (j = 0; j < GRID_SIZE; j++) {
-        for (k = 0; k < GRID_SIZE; k++) {
-            index = k + j * GRID_SIZE;
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            // Point each grid section to the first triangle in the section
+            total = 0;
+            for (index = 0; index < numCells; index++) {
+                gCollisionGrid[index].triangle = total;
+                total += gCollisionGrid[index].numTriangles;
+                gCollisionGrid[index].numTriangles = 0;
+            }
+            gNumCollisionTriangles = total;
+        }
 
-            // Select a section of the course using min/max akin to drawing a bounding-box
-            minX = (gCourseMinX + (sectionX * k)) - 20;
-            minZ = (gCourseMinZ + (sectionZ * j)) - 20;
+        for (i = 0; i < gCollisionMeshCount; i++) {
+            triangle = gCollisionMesh + i;
+
+            // Range of sections the bounding-box may reach, padded for the 20 unit overlap
+            if ((sectionX > 0) && (sectionZ > 0)) {
+                minK = ((s32) triangle->minX - gCourseMinX - 20) / sectionX - 2;
+                maxK = ((s32) triangle->maxX - gCourseMinX + 20) / sectionX + 1;
+                minJ = ((s32) triangle->minZ - gCourseMinZ - 20) / sectionZ - 2;
+                maxJ = ((s32) triangle->maxZ - gCourseMinZ + 20) / sectionZ + 1;
+                minK = MAX(minK, 0);
+                minJ = MAX(minJ, 0);
+                maxK = MIN(maxK, gridSize - 1);
+                maxJ = MIN(maxJ, gridSize - 1);
+            } else {
+                minK = 0;
+                minJ = 0;
+                maxK = gridSize - 1;
+                maxJ = gridSize - 1;
+            }
 
-            maxX = minX + sectionX + 40;
-            maxZ = minZ + sectionZ + 40;
+            for (j = minJ; j <= maxJ; j++) {
+                for (k = minK; k <= maxK; k++) {
+                    index = k + j * gridSize;
 
-            for (i = 0; i < gCollisionMeshCount; i++) {
-                triangle = gCollisionMesh + i;
-                if (triangle->maxZ < minZ) {
-                    continue;
-                }
-                if (triangle->minZ > maxZ) {
-                    continue;
-                }
-                if (triangle->maxX < minX) {
-                    continue;
-                }
-                if (triangle->minX > maxX) {
-                    continue;
-                }
+                    // Select a section of the course using min/max akin to drawing a bounding-box
+                    minX = (gCourseMinX + (sectionX * k)) - 20;
+                    minZ = (gCourseMinZ + (sectionZ * j)) - 20;
+
+                    maxX = minX + sectionX + 40;
+                    maxZ = minZ + sectionZ + 40;
+
+                    if (triangle->maxZ < minZ) {
+                        continue;
+                    }
+                    if (triangle->minZ > maxZ) {
+                        continue;
+                    }
+                    if (triangle->maxX < minX) {
+                        continue;
+                    }
+                    if (triangle->minX > maxX) {
+                        continue;
+                    }
 
-                // Add the collision triangle to the list if it's inside the bounding-box
-                if (is_triangle_intersecting_bounding_box(minX, maxX, minZ, maxZ, (u16) i) == 1) {
-                    // Point this grid section to the first triangle in the section
-                    if (gCollisionGrid[index].numTriangles == 0) {
-                        gCollisionGrid[index].triangle = gNumCollisionTriangles;
+                    // Add the collision triangle to the list if it's inside the bounding-box
+                    if (is_triangle_intersecting_bounding_box(minX, maxX, minZ, maxZ, i) == 1) {
+                        if (pass == 1) {
+                            gCollisionIndices[gCollisionGrid[index].triangle + gCollisionGrid[index].numTriangles] = i;
+                        }
+                        gCollisionGrid[index].numTriangles++;
                     }
-                    gCollisionGrid[index].numTriangles++;
-                    gCollisionIndices[gNumCollisionTriangles] = (u16) i;
-                    gNumCollisionTriangles++;
                 }
             }
         }
@@ -1959,7 +1944,6 @@ u32 numTimes = 0;
 /**
  * Generate via a recursive search and set for vertex data.
  */
-bool is_cull_box(const char* filePath);
 void generate_collision_mesh(Gfx* addr, s8 surfaceType, u16 sectionId) {
     int8_t opcode;
     uintptr_t lo;
@@ -2160,44 +2144,18 @@ void subtract_scaled_vector(Vec3f pos1, f32 boundingBoxSize, Vec3f pos2) {
     pos2[2] -= pos1[2] * boundingBoxSize;
 }
 
-u16 player_terrain_collision(Player* player, KartTyre* tyre, f32 tyre2X, f32 tyre2Y, f32 tyre2Z) {
-    Collision wtf;
-    Collision* collision = &wtf;
-    UNUSED s32 pad;
-    u16 i;
-    u16 meshIndex;
-    u16 numTriangles;
-    u16 sectionIndex;
-    f32 tyreX;
-    f32 tyreY;
-    f32 tyreZ;
-    f32 boundingBoxSize;
+/**
+ * Re-tests the triangle the tyre was resting on last tick.
+ * @return 1 if the tyre is still on that triangle, 0 otherwise.
+ */
+s32 tyre_previous_surface_collision(Player* player, KartTyre* tyre, Collision* collision, f32 tyre2X, f32 tyre2Y,
+                                    f32 tyre2Z) {
+    f32 boundingBoxSize = player->boundingBoxSize;
+    f32 tyreX = tyre->pos[0];
+    f32 tyreY = tyre->pos[1];
+    f32 tyreZ = tyre->pos[2];
     f32 height;
 
-    s32 courseLengthX;
-    s32 courseLengthZ;
-
-    s16 sectionIndexX;
-    s16 sectionIndexZ;
-    s16 gridIndex;
-
-    s32 sectionX;
-    s32 sectionZ;
-    UNUSED s32 pad2[9];
-
-    collision->surfaceDistance[0] = 1000.0f;
-    collision->surfaceDistance[1] = 1000.0f;
-    collision->surfaceDistance[2] = 1000.0f;
-    boundingBoxSize = player->boundingBoxSize;
-    collision->meshIndexYX = 5000;
-    collision->meshIndexZY = 5000;
-    collision->meshIndexZX = 5000;
-    collision->unk30 = 0;
-    collision->unk32 = 0;
-    collision->unk34 = 0;
-    tyreX = tyre->pos[0];
-    tyreY = tyre->pos[1];
-    tyreZ = tyre->pos[2];
     switch (tyre->surfaceFlags) {
         case 0x80:
             if (is_colliding_with_wall1(collision, boundingBoxSize, tyreX, tyreY, tyreZ, tyre->collisionMeshIndex,
@@ -2235,32 +2193,155 @@ u16 player_terrain_collision(Player* player, KartTyre* tyre, f32 tyre2X, f32 tyr
         case 0:
             break;
     }
+    return 0;
+}
 
-    // If the surface flags are not set then try setting them.
+/**
+ * Tests a tyre against a single triangle from the collision grid and, on contact,
+ * moves the tyre onto it and records the new surface.
+ * @return 1 if the tyre landed on the triangle, 0 otherwise.
+ */
+s32 tyre_triangle_collision(Player* player, KartTyre* tyre, Collision* collision, u32 meshIndex, f32 tyreX, f32 tyreY,
+                            f32 tyreZ, f32 tyre2X, f32 tyre2Y, f32 tyre2Z) {
+    CollisionTriangle* triangle = &gCollisionMesh[meshIndex];
+    f32 boundingBoxSize = player->boundingBoxSize;
+    f32 height;
+
+    if (meshIndex == tyre->collisionMeshIndex) {
+        return 0;
+    }
+
+    if (triangle->flags & FACING_Y_AXIS) {
+        if (is_colliding_with_drivable_surface(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex, tyre2X,
+                                               tyre2Y, tyre2Z) == 1) {
+            height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
+
+            if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
+                subtract_scaled_vector(collision->orientationVector, collision->surfaceDistance[2], tyre->pos);
+                tyre->baseHeight = height;
+                tyre->surfaceType = (u8) triangle->surfaceType;
+                tyre->surfaceFlags = 0x40;
+                tyre->collisionMeshIndex = meshIndex;
+                if (triangle->flags & 0x1000) {
+                    tyre->unk_14 = 1;
+                } else {
+                    tyre->unk_14 = 0;
+                }
+                return 1;
+            }
+        }
+    } else if (triangle->flags & FACING_X_AXIS) {
+        if (triangle->normalY != 0.0f) {
+            if (is_colliding_with_wall1(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex, tyre2X, tyre2Y,
+                                        tyre2Z) == 1) {
+                height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
+                if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
+                    tyre->baseHeight = height;
+                    subtract_scaled_vector(collision->unk54, collision->surfaceDistance[1], tyre->pos);
+                    tyre->baseHeight = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
+                    tyre->surfaceType = (u8) triangle->surfaceType;
+                    tyre->surfaceFlags = 0x80;
+                    tyre->collisionMeshIndex = meshIndex;
+                    return 1;
+                }
+            }
+        }
+    } else {
+        if (triangle->normalY != 0.0f) {
+            if (is_colliding_with_wall2(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex, tyre2X, tyre2Y,
+                                        tyre2Z) == 1) {
+                height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
+                if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
+                    tyre->baseHeight = height;
+                    subtract_scaled_vector(collision->unk48, collision->surfaceDistance[0], tyre->pos);
+                    tyre->surfaceType = (u8) triangle->surfaceType;
+                    tyre->surfaceFlags = 0x20;
+                    tyre->collisionMeshIndex = meshIndex;
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Resets the scratch collision used by a single tyre query.
+ */
+void tyre_collision_init(Collision* collision) {
+    collision->surfaceDistance[0] = 1000.0f;
+    collision->surfaceDistance[1] = 1000.0f;
+    collision->surfaceDistance[2] = 1000.0f;
+    collision->meshIndexYX = 5000;
+    collision->meshIndexZY = 5000;
+    collision->meshIndexZX = 5000;
+    collision->unk30 = 0;
+    collision->unk32 = 0;
+    collision->unk34 = 0;
+}
+
+/**
+ * @return The collision grid cell containing the point, or -1 if it lies outside the grid.
+ */
+s32 get_collision_grid_index(f32 posX, f32 posZ) {
+    s32 courseLengthX;
+    s32 courseLengthZ;
+    s32 sectionX;
+    s32 sectionZ;
+    s16 sectionIndexX;
+    s16 sectionIndexZ;
 
     courseLengthX = (s32) gCourseMaxX - gCourseMinX;
     courseLengthZ = (s32) gCourseMaxZ - gCourseMinZ;
 
-    sectionX = courseLengthX / GRID_SIZE;
-    sectionZ = courseLengthZ / GRID_SIZE;
+    sectionX = get_collision_grid_cell_length(courseLengthX);
+    sectionZ = get_collision_grid_cell_length(courseLengthZ);
 
-    sectionIndexX = (tyreX - gCourseMinX) / sectionX;
-    sectionIndexZ = (tyreZ - gCourseMinZ) / sectionZ;
+    sectionIndexX = (posX - gCourseMinX) / sectionX;
+    sectionIndexZ = (posZ - gCourseMinZ) / sectionZ;
 
     if (sectionIndexX < 0) {
-        return 0;
+        return -1;
     }
     if (sectionIndexZ < 0) {
-        return 0;
+        return -1;
     }
-    if (sectionIndexX >= GRID_SIZE) {
-        return 0;
+    if (sectionIndexX >= gCollisionGridSize) {
+        return -1;
+    }
+    if (sectionIndexZ >= gCollisionGridSize) {
+        return -1;
+    }
+    return sectionIndexX + sectionIndexZ * gCollisionGridSize;
+}
+
+u16 player_terrain_collision(Player* player, KartTyre* tyre, f32 tyre2X, f32 tyre2Y, f32 tyre2Z) {
+    Collision wtf;
+    Collision* collision = &wtf;
+    u32 i;
+    u32 meshIndex;
+    u32 numTriangles;
+    u32 sectionIndex;
+    f32 tyreX;
+    f32 tyreY;
+    f32 tyreZ;
+    s32 gridIndex;
+
+    tyre_collision_init(collision);
+    if (tyre_previous_surface_collision(player, tyre, collision, tyre2X, tyre2Y, tyre2Z) == 1) {
+        return 1;
     }
-    if (sectionIndexZ >= GRID_SIZE) {
+
+    // If the surface flags are not set then try setting them.
+    tyreX = tyre->pos[0];
+    tyreY = tyre->pos[1];
+    tyreZ = tyre->pos[2];
+
+    gridIndex = get_collision_grid_index(tyreX, tyreZ);
+    if (gridIndex < 0) {
         return 0;
     }
 
-    gridIndex = sectionIndexX + sectionIndexZ * GRID_SIZE;
     numTriangles = gCollisionGrid[gridIndex].numTriangles;
 
     if (numTriangles == 0) {
@@ -2271,62 +2352,9 @@ u16 player_terrain_collision(Player* player, KartTyre* tyre, f32 tyre2X, f32 tyr
 
     for (i = 0; i < numTriangles; i++) {
         meshIndex = gCollisionIndices[sectionIndex];
-        if (gCollisionMesh[meshIndex].flags & FACING_Y_AXIS) {
-            if (meshIndex != tyre->collisionMeshIndex) {
-                if (is_colliding_with_drivable_surface(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex,
-                                                       tyre2X, tyre2Y, tyre2Z) == 1) {
-                    height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
-
-                    if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
-                        subtract_scaled_vector(collision->orientationVector, collision->surfaceDistance[2], tyre->pos);
-                        tyre->baseHeight = height;
-                        tyre->surfaceType = (u8) gCollisionMesh[meshIndex].surfaceType;
-                        tyre->surfaceFlags = 0x40;
-                        tyre->collisionMeshIndex = meshIndex;
-                        if (gCollisionMesh[meshIndex].flags & 0x1000) {
-                            tyre->unk_14 = 1;
-                        } else {
-                            tyre->unk_14 = 0;
-                        }
-                        return 1;
-                    }
-                }
-            }
-        } else if (gCollisionMesh[meshIndex].flags & FACING_X_AXIS) {
-            if (gCollisionMesh[meshIndex].normalY != 0.0f) {
-                if (meshIndex != tyre->collisionMeshIndex) {
-                    if (is_colliding_with_wall1(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex, tyre2X,
-                                                tyre2Y, tyre2Z) == 1) {
-                        height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
-                        if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
-                            tyre->baseHeight = height;
-                            subtract_scaled_vector(collision->unk54, collision->surfaceDistance[1], tyre->pos);
-                            tyre->baseHeight = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
-                            tyre->surfaceType = (u8) gCollisionMesh[meshIndex].surfaceType;
-                            tyre->surfaceFlags = 0x80;
-                            tyre->collisionMeshIndex = meshIndex;
-                            return 1;
-                        }
-                    }
-                }
-            }
-        } else {
-            if (gCollisionMesh[meshIndex].normalY != 0.0f) {
-                if (meshIndex != tyre->collisionMeshIndex) {
-                    if (is_colliding_with_wall2(collision, boundingBoxSize, tyreX, tyreY, tyreZ, meshIndex, tyre2X,
-                                                tyre2Y, tyre2Z) == 1) {
-                        height = calculate_surface_height(tyreX, tyreY, tyreZ, meshIndex);
-                        if (!(player->pos[1] < height) && !((2 * boundingBoxSize) < (player->pos[1] - height))) {
-                            tyre->baseHeight = height;
-                            subtract_scaled_vector(collision->unk48, collision->surfaceDistance[0], tyre->pos);
-                            tyre->surfaceType = (u8) gCollisionMesh[meshIndex].surfaceType;
-                            tyre->surfaceFlags = 0x20;
-                            tyre->collisionMeshIndex = meshIndex;
-                            return 1;
-                        }
-                    }
-                }
-            }
+        if (tyre_triangle_collision(player, tyre, collision, meshIndex, tyreX, tyreY, tyreZ, tyre2X, tyre2Y,
+                                    tyre2Z) == 1) {
+            return 1;
         }
         sectionIndex++;
     }
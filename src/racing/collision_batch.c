@@ -0,0 +1,262 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <mk64.h>
+#include <common_structs.h>
+#include <defines.h>
+#include "main.h"
+#include "collision.h"
+#include "collision_batch.h"
+#include "code_800029B0.h"
+#include "memory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISION_BATCH_SIMD
+#elif defined(__aarch64__)
+#include "sse2neon.h"
+#define COLLISION_BATCH_SIMD
+#endif
+
+// Candidates that can never be touched fill the unused lanes of a block
+#define BOUNDS_EMPTY_MIN 1.0e30f
+#define BOUNDS_EMPTY_MAX -1.0e30f
+#define BOUNDS_OPEN_MAX 1.0e30f
+
+// Widens every box slightly so float rounding can never make the prefilter
+// reject a triangle that the exact test would have accepted.
+#define BOUNDS_SLACK 1.0f
+
+static CollisionBoundsCell* sCollisionBoundsCells = NULL;
+static CollisionBoundsBlock* sCollisionBoundsBlocks = NULL;
+static CollisionTriangle* sCollisionBoundsMesh = NULL;
+static u32 sCollisionBoundsMeshCount = 0;
+static CollisionGrid* sCollisionBoundsGrid = NULL;
+
+static void clear_bounds_lane(CollisionBoundsBlock* block, s32 lane) {
+    block->minX[lane] = BOUNDS_EMPTY_MIN;
+    block->maxX[lane] = BOUNDS_EMPTY_MAX;
+    block->minY[lane] = BOUNDS_EMPTY_MIN;
+    block->maxY[lane] = BOUNDS_EMPTY_MAX;
+    block->minZ[lane] = BOUNDS_EMPTY_MIN;
+    block->maxZ[lane] = BOUNDS_EMPTY_MAX;
+    block->growX[lane] = 0.0f;
+    block->growY[lane] = 0.0f;
+    block->growZ[lane] = 0.0f;
+    block->meshIndex[lane] = 0xFFFFFFFF;
+}
+
+/**
+ * Mirrors the early-outs of is_colliding_with_drivable_surface, is_colliding_with_wall1
+ * and is_colliding_with_wall2 so a lane only passes if the exact test could succeed.
+ * @return false if the triangle can never be touched by a tyre.
+ */
+static bool set_bounds_lane(CollisionBoundsBlock* block, s32 lane, u32 meshIndex) {
+    CollisionTriangle* triangle = &gCollisionMesh[meshIndex];
+
+    block->minX[lane] = triangle->minX - BOUNDS_SLACK;
+    block->maxX[lane] = triangle->maxX + BOUNDS_SLACK;
+    block->minY[lane] = triangle->minY - BOUNDS_SLACK;
+    block->maxY[lane] = triangle->maxY + BOUNDS_SLACK;
+    block->minZ[lane] = triangle->minZ - BOUNDS_SLACK;
+    block->maxZ[lane] = triangle->maxZ + BOUNDS_SLACK;
+    block->growX[lane] = 0.0f;
+    block->growY[lane] = 0.0f;
+    block->growZ[lane] = 0.0f;
+    block->meshIndex[lane] = meshIndex;
+
+    if (triangle->flags & FACING_Y_AXIS) {
+        // Floors only reject tyres sitting well below them
+        block->maxY[lane] = BOUNDS_OPEN_MAX;
+        block->growY[lane] = 1.0f;
+        return true;
+    }
+    // Walls with a flat normal are never driven on
+    if (triangle->normalY == 0.0f) {
+        return false;
+    }
+    if (triangle->flags & FACING_X_AXIS) {
+        block->growX[lane] = 1.0f;
+    } else {
+        block->growZ[lane] = 1.0f;
+    }
+    return true;
+}
+
+/**
+ * Gathers the triangles of each collision grid cell into blocks of four bounding boxes.
+ * Must run after generate_collision_grid, allocates from the memory pool.
+ */
+void generate_collision_bounds(void) {
+    CollisionBoundsBlock* block;
+    s32 numCells = gCollisionGridSize * gCollisionGridSize;
+    u32 numBlocks = 0;
+    s32 cell;
+    s32 lane;
+    u32 i;
+    u32 sectionIndex;
+
+    sCollisionBoundsCells = (CollisionBoundsCell*) allocate_memory(numCells * sizeof(CollisionBoundsCell),
+                                                                    MEMORY_TAG_COLLISION);
+    sCollisionBoundsBlocks = (CollisionBoundsBlock*) gNextFreeMemoryAddress;
+
+    for (cell = 0; cell < numCells; cell++) {
+        sCollisionBoundsCells[cell].firstBlock = numBlocks;
+        sCollisionBoundsCells[cell].numBlocks = 0;
+
+        if (gCollisionGrid[cell].numTriangles == 0) {
+            continue;
+        }
+
+        sectionIndex = gCollisionGrid[cell].triangle;
+        lane = 4;
+        block = NULL;
+        for (i = 0; i < gCollisionGrid[cell].numTriangles; i++) {
+            if (lane == 4) {
+                block = &sCollisionBoundsBlocks[numBlocks++];
+                sCollisionBoundsCells[cell].numBlocks++;
+                lane = 0;
+            }
+            // Keep the grid order so the first hit matches the scalar search
+            if (set_bounds_lane(block, lane, gCollisionIndices[sectionIndex])) {
+                lane++;
+            }
+            sectionIndex++;
+        }
+        for (; lane < 4; lane++) {
+            clear_bounds_lane(block, lane);
+        }
+    }
+
+    // The blocks were filled in place, so this only claims them
+    allocate_memory(numBlocks * sizeof(CollisionBoundsBlock), MEMORY_TAG_COLLISION);
+    sCollisionBoundsMesh = gCollisionMesh;
+    sCollisionBoundsMeshCount = gCollisionMeshCount;
+    sCollisionBoundsGrid = gCollisionGrid;
+}
+
+static bool is_collision_bounds_valid(void) {
+    return (sCollisionBoundsBlocks != NULL) && (sCollisionBoundsMesh == gCollisionMesh) &&
+           (sCollisionBoundsMeshCount == gCollisionMeshCount) && (sCollisionBoundsGrid == gCollisionGrid);
+}
+
+/**
+ * @return A four bit mask of the lanes whose widened box contains the point.
+ */
+static s32 test_bounds_block(const CollisionBoundsBlock* block, f32 x, f32 y, f32 z, f32 grow) {
+#ifdef COLLISION_BATCH_SIMD
+    __m128 px = _mm_set1_ps(x);
+    __m128 py = _mm_set1_ps(y);
+    __m128 pz = _mm_set1_ps(z);
+    __m128 g = _mm_set1_ps(grow);
+    __m128 gx = _mm_mul_ps(_mm_loadu_ps(block->growX), g);
+    __m128 gy = _mm_mul_ps(_mm_loadu_ps(block->growY), g);
+    __m128 gz = _mm_mul_ps(_mm_loadu_ps(block->growZ), g);
+    __m128 inX = _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(_mm_loadu_ps(block->minX), gx), px),
+                            _mm_cmpge_ps(_mm_add_ps(_mm_loadu_ps(block->maxX), gx), px));
+    __m128 inY = _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(_mm_loadu_ps(block->minY), gy), py),
+                            _mm_cmpge_ps(_mm_add_ps(_mm_loadu_ps(block->maxY), gy), py));
+    __m128 inZ = _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(_mm_loadu_ps(block->minZ), gz), pz),
+                            _mm_cmpge_ps(_mm_add_ps(_mm_loadu_ps(block->maxZ), gz), pz));
+    return _mm_movemask_ps(_mm_and_ps(inX, _mm_and_ps(inY, inZ)));
+#else
+    s32 mask = 0;
+    s32 lane;
+    for (lane = 0; lane < 4; lane++) {
+        f32 gx = block->growX[lane] * grow;
+        f32 gy = block->growY[lane] * grow;
+        f32 gz = block->growZ[lane] * grow;
+        if ((block->minX[lane] - gx <= x) && (block->maxX[lane] + gx >= x) && (block->minY[lane] - gy <= y) &&
+            (block->maxY[lane] + gy >= y) && (block->minZ[lane] - gz <= z) && (block->maxZ[lane] + gz >= z)) {
+            mask |= 1 << lane;
+        }
+    }
+    return mask;
+#endif
+}
+
+static s32 tyre_terrain_collision_blocks(Player* player, KartTyre* tyre, Collision* collision, Vec3f prevPos) {
+    const CollisionBoundsCell* cell;
+    const CollisionBoundsBlock* block;
+    f32 tyreX = tyre->pos[0];
+    f32 tyreY = tyre->pos[1];
+    f32 tyreZ = tyre->pos[2];
+    f32 grow = player->boundingBoxSize * 3.0f;
+    s32 gridIndex;
+    s32 mask;
+    s32 lane;
+    u32 i;
+
+    gridIndex = get_collision_grid_index(tyreX, tyreZ);
+    if (gridIndex < 0) {
+        return 0;
+    }
+    if (gCollisionGrid[gridIndex].numTriangles == 0) {
+        return 0;
+    }
+
+    cell = &sCollisionBoundsCells[gridIndex];
+    block = &sCollisionBoundsBlocks[cell->firstBlock];
+    for (i = 0; i < cell->numBlocks; i++, block++) {
+        mask = test_bounds_block(block, tyreX, tyreY, tyreZ, grow);
+        if (mask == 0) {
+            continue;
+        }
+        for (lane = 0; lane < 4; lane++) {
+            if (!(mask & (1 << lane))) {
+                continue;
+            }
+            if (tyre_triangle_collision(player, tyre, collision, block->meshIndex[lane], tyreX, tyreY, tyreZ,
+                                        prevPos[0], prevPos[1], prevPos[2]) == 1) {
+                return 1;
+            }
+        }
+    }
+    tyre->baseHeight = tyreY;
+    tyre->surfaceType = 0;
+    return 0;
+}
+
+static s32 player_terrain_collision_scalar(Player* player, Vec3f prevPos[NUM_TYRES]) {
+    s32 result = 0;
+    s32 i;
+
+    for (i = 0; i < NUM_TYRES; i++) {
+        if (player_terrain_collision(player, &player->tyres[i], prevPos[i][0], prevPos[i][1], prevPos[i][2]) == 1) {
+            result |= 1 << i;
+        }
+    }
+    return result;
+}
+
+static s32 player_terrain_collision_blocks(Player* player, Vec3f prevPos[NUM_TYRES]) {
+    Collision collision;
+    KartTyre* tyre;
+    s32 result = 0;
+    s32 i;
+
+    for (i = 0; i < NUM_TYRES; i++) {
+        tyre = &player->tyres[i];
+        tyre_collision_init(&collision);
+        if ((tyre_previous_surface_collision(player, tyre, &collision, prevPos[i][0], prevPos[i][1], prevPos[i][2]) ==
+             1) ||
+            (tyre_terrain_collision_blocks(player, tyre, &collision, prevPos[i]) == 1)) {
+            result |= 1 << i;
+        }
+    }
+    return result;
+}
+
+/**
+ * Resolves the terrain under all four tyres of a player.
+ * Equivalent to calling player_terrain_collision on each tyre in order, which tests/collision_checks.c checks.
+ *
+ * @param player The player whose tyres have already been moved to this tick's positions.
+ * @param prevPos The position of each tyre before it was moved.
+ * @return A mask with bit n set if tyre n is touching the ground.
+ */
+s32 player_terrain_collision_batch(Player* player, Vec3f prevPos[NUM_TYRES]) {
+    if (!is_collision_bounds_valid()) {
+        return player_terrain_collision_scalar(player, prevPos);
+    }
+    return player_terrain_collision_blocks(player, prevPos);
+}
@@ -0,0 +1,35 @@
+#ifndef COLLISION_BATCH_H
+#define COLLISION_BATCH_H
+
+#include <common_structs.h>
+
+#define NUM_TYRES 4
+
+/**
+ * Four collision grid candidates packed side by side so a tyre can be tested
+ * against all of them with one set of SIMD compares.
+ * Bounds are already widened/narrowed for the axis the triangle faces.
+ */
+typedef struct {
+    f32 minX[4];
+    f32 maxX[4];
+    f32 minY[4];
+    f32 maxY[4];
+    f32 minZ[4];
+    f32 maxZ[4];
+    // 1.0f on the axis that grows by the player's bounding box, 0.0f otherwise
+    f32 growX[4];
+    f32 growY[4];
+    f32 growZ[4];
+    u32 meshIndex[4];
+} CollisionBoundsBlock;
+
+typedef struct {
+    u32 firstBlock;
+    u32 numBlocks;
+} CollisionBoundsCell;
+
+void generate_collision_bounds(void);
+s32 player_terrain_collision_batch(Player*, Vec3f[NUM_TYRES]);
+
+#endif // COLLISION_BATCH_H
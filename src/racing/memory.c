@@ -24,15 +24,13 @@
 #include "engine/courses/Course.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "port/Game.h"
 
 s32 sGfxSeekPosition;
 s32 sPackedSeekPosition;
 
-static u8 sMemoryPool[0xFFFFFFF]; // Stock memory pool size: 0xAB630
-uintptr_t sPoolEnd = sMemoryPool + sizeof(sMemoryPool);
-
 uintptr_t sPoolFreeSpace;
 struct MainPoolBlock* sPoolListHeadL;
 struct MainPoolBlock* sPoolListHeadR;
@@ -43,30 +41,6 @@ struct UnkStruct_802B8CD4 D_802B8CD4[] = { 0 };
 s32 D_802B8CE4 = 0; // pad
 s32 memoryPadding[2];
 
-#define PRINT_MEMPOOL                                                                                               \
-    printf("\nPool Start: 0x%llX, Pool End: 0x%llX, size: 0x%llX\ngNextFreeMemoryAddress: 0x%llX\n\n", sMemoryPool, \
-           sMemoryPool + sizeof(sMemoryPool), (sMemoryPool + sizeof(sMemoryPool)) - sMemoryPool,                    \
-           gNextFreeMemoryAddress)
-
-/**
- * @brief Returns the address of the next available memory location and updates the memory pointer
- * to reference the next location of available memory based provided size to allocate.
- * @param size of memory to allocate.
- * @return Address of free memory
- */
-void* get_next_available_memory_addr(uintptr_t size) {
-    uintptr_t freeSpace = (uintptr_t) gNextFreeMemoryAddress;
-    size = ALIGN16(size);
-    gNextFreeMemoryAddress += size;
-
-    if (gNextFreeMemoryAddress > sPoolEnd) {
-        printf("[memory.c] get_next_available_memory_addr(): Memory Pool Out of Bounds! Out of memory!\n");
-        PRINT_MEMPOOL;
-    }
-
-    return (void*) freeSpace;
-}
-
 /**
  * @brief Stores the physical memory addr for segmented memory in `gSegmentTable` using the segment number as an index.
  *
@@ -229,54 +203,6 @@ void move_segment_table_to_dmem(void) {
     }
 }
 
-/**
- * @brief Sets the starting location for allocating memory and calculates pool size.
- *
- * Default memory size, 701.984 Kilobytes.
- */
-void initialize_memory_pool() {
-
-    uintptr_t poolStart = sMemoryPool;
-    // uintptr_t sPoolEnd = sMemoryPool + sizeof(sMemoryPool);
-
-    bzero(sMemoryPool, sizeof(sMemoryPool));
-
-    poolStart = ALIGN16(poolStart);
-    // Truncate to a 16-byte boundary.
-    sPoolEnd &= ~0xF;
-
-    gFreeMemorySize = (sPoolEnd - poolStart) - 0x10;
-    gNextFreeMemoryAddress = poolStart;
-
-    PRINT_MEMPOOL;
-}
-
-/**
- * @brief Allocates memory and adjusts gFreeMemorySize.
- */
-void* allocate_memory(size_t size) {
-    uintptr_t freeSpace;
-
-    size = ALIGN16(size);
-    gFreeMemorySize -= size;
-
-    if (gFreeMemorySize < 0) {
-        printf("[memory.c] allocate_memory(): gFreeMemorySize below zero!\n");
-        printf("gFreeMemorySize: 0x%X", gFreeMemorySize);
-        PRINT_MEMPOOL;
-    }
-
-    freeSpace = (uintptr_t) gNextFreeMemoryAddress;
-    gNextFreeMemoryAddress += size;
-
-    if (gNextFreeMemoryAddress > sPoolEnd) {
-        printf("[memory.c] allocate_memory(): Memory Pool Out of Bounds! Out of memory!\n");
-        PRINT_MEMPOOL;
-    }
-
-    return (void*) freeSpace;
-}
-
 UNUSED void func_802A7D54(s32 arg0, s32 arg1) {
     gD_80150158[arg0].unk0 = arg0;
     gD_80150158[arg0].unk8 = arg1;
@@ -289,7 +215,7 @@ void* load_data(uintptr_t startAddr, uintptr_t endAddr) {
     void* allocated;
     uintptr_t size = endAddr - startAddr;
 
-    allocated = allocate_memory(size);
+    allocated = allocate_memory(size, MEMORY_TAG_OTHER);
     if (allocated != 0) {
         dma_copy((u8*) allocated, (u8*) startAddr, size);
     }
@@ -502,9 +428,8 @@ u8* dma_compressed_vtx(u8* start, u8* end) {
     uintptr_t size;
 
     size = ALIGN16(end - start);
-    freeSpace = (u8*) gNextFreeMemoryAddress;
+    freeSpace = (u8*) get_next_available_memory_addr(size, MEMORY_TAG_GEOMETRY);
     dma_copy(freeSpace, start, size);
-    gNextFreeMemoryAddress += size;
     return freeSpace;
 }
 
@@ -557,7 +482,7 @@ u8* dma_textures(const char* texture, size_t arg1, size_t arg2) {
     temp_v0 = (u8*) gNextFreeMemoryAddress;
 #else
 
-    temp_v0 = (u8*) allocate_memory(arg2);
+    temp_v0 = (u8*) allocate_memory(arg2, MEMORY_TAG_TEXTURES);
 #endif
     temp_a0 = temp_v0 + arg2;
     arg1 = ALIGN16(arg1);
@@ -1556,8 +1481,7 @@ u8* load_lakitu_tlut_x64(const char** textureList, size_t length) {
         size += ResourceGetTexSizeByName(textureList[i]);
     }
 
-    u8* textures = (u8*) gNextFreeMemoryAddress;
-    gNextFreeMemoryAddress += size;
+    u8* textures = (u8*) get_next_available_memory_addr(size, MEMORY_TAG_TEXTURES);
     size_t offset = 0;
     for (size_t i = 0; i < length; i++) {
         u8* tex = (u8*) LOAD_ASSET_RAW(textureList[i]);
@@ -1571,11 +1495,13 @@ u8* load_lakitu_tlut_x64(const char** textureList, size_t length) {
 
 /**
  * @brief Loads & DMAs course data. Vtx, textures, displaylists, etc.
+ *
+ * Callers unload the previous course with memory_pool_begin_course first and close the course scope with
+ * memory_pool_end_course after.
  * @param courseId
  */
 void load_course(s32 courseId) {
     printf("Loading Course %d\n", courseId);
-    gNextFreeMemoryAddress = gFreeMemoryResetAnchor;
     CM_CleanWorld();
     LoadCourse();
     CM_Editor_SetLevelDimensions(gCourseMinX, gCourseMaxX, gCourseMinZ, gCourseMaxZ, gCourseMinY, gCourseMaxY);
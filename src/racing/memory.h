@@ -39,10 +39,35 @@ struct AllocOnlyPool {
 #define MEMORY_POOL_LEFT 0
 #define MEMORY_POOL_RIGHT 1
 
+/**
+ * The pool is split into nested scopes, each starting where the one before it ends.
+ * Freeing a scope also frees every scope after it and gives their pages back to the OS.
+ */
+enum MemoryScope {
+    MEMORY_SCOPE_STARTUP, // Loaded once at boot, below gFreeMemoryResetAnchor
+    MEMORY_SCOPE_COURSE,  // The loaded course, below gFreeMemoryCourseAnchor
+    MEMORY_SCOPE_RACE,    // Everything allocated during a race or on the menus
+    MEMORY_SCOPE_COUNT
+};
+
+/**
+ * What an allocation is for, so the peak of each can be told apart in memory_pool_print_usage.
+ */
+enum MemoryTag {
+    MEMORY_TAG_OTHER,
+    MEMORY_TAG_GEOMETRY,  // Course vertices and display lists
+    MEMORY_TAG_TEXTURES,  // Course, actor and Lakitu textures
+    MEMORY_TAG_COLLISION, // Collision mesh, grid and bounds
+    MEMORY_TAG_PATHS,     // Track paths and their spatial index
+    MEMORY_TAG_ACTORS,    // Actor lists
+    MEMORY_TAG_MENUS,     // Menu buffers
+    MEMORY_TAG_COUNT
+};
+
 #define ALIGN4(val) (((val) + 0x3) & ~0x3)
 
 u8* load_lakitu_tlut_x64(const char** textureList, size_t length);
-void* get_next_available_memory_addr(uintptr_t);
+void* get_next_available_memory_addr(uintptr_t size, s32 tag);
 uintptr_t set_segment_base_addr(s32, void*);
 void* get_segment_base_addr(s32);
 void* segmented_to_virtual(const void*);
@@ -54,8 +79,16 @@ Gfx* segmented_gfx_to_virtual(const void*);
 void replace_segmented_textures_with_o2r_textures(Gfx* gfx, const course_texture* textures);
 void move_segment_table_to_dmem(void);
 void initialize_memory_pool(void);
+void memory_pool_begin_course(void);
+void memory_pool_end_course(void);
+void memory_pool_begin_race(void);
+size_t memory_pool_get_peak(s32 scope);
+size_t memory_pool_get_resident_size(void);
+size_t memory_pool_get_tag_size(s32 tag);
+size_t memory_pool_get_tag_peak(s32 tag);
+void memory_pool_print_usage(void);
 void* decompress_segments(u8*, u8*);
-void* allocate_memory(size_t);
+void* allocate_memory(size_t size, s32 tag);
 void* load_data(uintptr_t, uintptr_t);
 void func_802A7D54(s32, s32);
 
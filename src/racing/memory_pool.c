@@ -0,0 +1,272 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <defines.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory.h"
+#include "code_800029B0.h"
+#include "port/VirtualMemory.h"
+
+/**
+ * The memory pool everything the game loads is bump allocated from, and the scopes it is freed by.
+ */
+
+// Stock memory pool size: 0xAB630. The pool is reserved address space, so only the part in use takes up memory.
+#define MEMORY_POOL_SIZE 0x10000000
+// Inaccessible space after the pool, so that code writing past gNextFreeMemoryAddress faults instead of
+// corrupting whatever comes next.
+#define MEMORY_POOL_GUARD_SIZE 0x1000000
+
+static u8* sMemoryPool;
+uintptr_t sPoolEnd;
+// Highest address handed out since the pages above it were last released
+static uintptr_t sPoolHighWater;
+// Start of the memory allocated during the current race or menu
+static uintptr_t sRaceScopeStart;
+static size_t sScopePeaks[MEMORY_SCOPE_COUNT];
+static const char* sScopeNames[MEMORY_SCOPE_COUNT] = { "Startup", "Course", "Race" };
+// The scope allocations are made in. Freeing a scope takes its bytes off every tag.
+static s32 sCurrentScope = MEMORY_SCOPE_STARTUP;
+static size_t sTagSizes[MEMORY_SCOPE_COUNT][MEMORY_TAG_COUNT];
+static size_t sTagPeaks[MEMORY_TAG_COUNT];
+static const char* sTagNames[MEMORY_TAG_COUNT] = {
+    "Other", "Geometry", "Textures", "Collision", "Paths", "Actors", "Menus",
+};
+
+#define PRINT_MEMPOOL                                                                                               \
+    printf("\nPool Start: 0x%llX, Pool End: 0x%llX, size: 0x%llX\ngNextFreeMemoryAddress: 0x%llX\n\n", sMemoryPool, \
+           sPoolEnd, sPoolEnd - (uintptr_t) sMemoryPool, gNextFreeMemoryAddress)
+
+/**
+ * @brief Stops the game when the pool has run out. Carrying on would only corrupt memory.
+ */
+static void memory_pool_overflow(const char* function, uintptr_t size) {
+    printf("[memory_pool.c] %s(): Memory Pool Out of Bounds! Out of memory allocating 0x%llX bytes!\n", function,
+           (unsigned long long) size);
+    PRINT_MEMPOOL;
+    memory_pool_print_usage();
+    abort();
+}
+
+/**
+ * @brief Returns the pages above anchor to the OS and moves the next allocation there.
+ *
+ * Everything allocated above the anchor is gone afterwards and reads back as zero.
+ */
+static void memory_pool_reset_to(uintptr_t anchor) {
+    uintptr_t pageSize = VirtualMemory_GetPageSize();
+    uintptr_t releaseStart;
+    uintptr_t releaseEnd;
+
+    // Also catches code that moved gNextFreeMemoryAddress itself without going through allocate_memory
+    if (gNextFreeMemoryAddress > sPoolEnd) {
+        memory_pool_overflow("memory_pool_reset_to", gNextFreeMemoryAddress - sPoolEnd);
+    }
+    if (gNextFreeMemoryAddress > sPoolHighWater) {
+        sPoolHighWater = gNextFreeMemoryAddress;
+    }
+
+    releaseStart = (anchor + pageSize - 1) & ~(pageSize - 1);
+    releaseEnd = (sPoolHighWater + pageSize - 1) & ~(pageSize - 1);
+    if (releaseEnd > sPoolEnd) {
+        releaseEnd = sPoolEnd;
+    }
+    if (releaseEnd > releaseStart) {
+        VirtualMemory_Release((void*) releaseStart, releaseEnd - releaseStart);
+    }
+
+    sPoolHighWater = anchor;
+    gNextFreeMemoryAddress = anchor;
+}
+
+static void memory_pool_update_peak(s32 scope, uintptr_t start, uintptr_t end) {
+    if ((end > start) && ((end - start) > sScopePeaks[scope])) {
+        sScopePeaks[scope] = end - start;
+    }
+}
+
+static void memory_pool_update_race_peak(void) {
+    uintptr_t start = sRaceScopeStart;
+
+    if (start < gFreeMemoryResetAnchor) {
+        start = gFreeMemoryResetAnchor;
+    }
+    memory_pool_update_peak(MEMORY_SCOPE_RACE, start, gNextFreeMemoryAddress);
+}
+
+// Forgets the tagged bytes of scope and every scope after it, once they are freed
+static void memory_pool_clear_tags(s32 scope) {
+    for (s32 i = scope; i < MEMORY_SCOPE_COUNT; i++) {
+        for (s32 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+            sTagSizes[i][tag] = 0;
+        }
+    }
+}
+
+static void memory_pool_add_tag(s32 tag, uintptr_t size) {
+    size_t inUse;
+
+    sTagSizes[sCurrentScope][tag] += size;
+    inUse = memory_pool_get_tag_size(tag);
+    if (inUse > sTagPeaks[tag]) {
+        sTagPeaks[tag] = inUse;
+    }
+}
+
+/**
+ * @brief Unloads the current course and everything allocated after it.
+ *
+ * Allocations that follow belong to the course scope until memory_pool_end_course.
+ */
+void memory_pool_begin_course(void) {
+    memory_pool_update_peak(MEMORY_SCOPE_STARTUP, (uintptr_t) sMemoryPool, gFreeMemoryResetAnchor);
+    memory_pool_update_race_peak();
+    memory_pool_reset_to(gFreeMemoryResetAnchor);
+    sRaceScopeStart = gFreeMemoryResetAnchor;
+    memory_pool_clear_tags(MEMORY_SCOPE_COURSE);
+    sCurrentScope = MEMORY_SCOPE_COURSE;
+}
+
+/**
+ * @brief Marks the end of the course's data. Later allocations belong to the race and are freed by
+ * memory_pool_begin_race.
+ */
+void memory_pool_end_course(void) {
+    memory_pool_update_peak(MEMORY_SCOPE_COURSE, gFreeMemoryResetAnchor, gNextFreeMemoryAddress);
+    gFreeMemoryCourseAnchor = gNextFreeMemoryAddress;
+    sRaceScopeStart = gFreeMemoryCourseAnchor;
+    sCurrentScope = MEMORY_SCOPE_RACE;
+}
+
+/**
+ * @brief Frees everything allocated since the course finished loading, keeping the course itself.
+ */
+void memory_pool_begin_race(void) {
+    memory_pool_update_race_peak();
+    memory_pool_reset_to(gFreeMemoryCourseAnchor);
+    sRaceScopeStart = gFreeMemoryCourseAnchor;
+    memory_pool_clear_tags(MEMORY_SCOPE_RACE);
+    sCurrentScope = MEMORY_SCOPE_RACE;
+}
+
+size_t memory_pool_get_peak(s32 scope) {
+    if (scope == MEMORY_SCOPE_RACE) {
+        memory_pool_update_race_peak();
+    }
+    return sScopePeaks[scope];
+}
+
+/**
+ * @brief Bytes of the pool that may be backed by memory, that is everything below the high water mark.
+ */
+size_t memory_pool_get_resident_size(void) {
+    uintptr_t highWater = MAX(sPoolHighWater, gNextFreeMemoryAddress);
+    return highWater - (uintptr_t) sMemoryPool;
+}
+
+/**
+ * @brief Bytes of the pool allocated with tag and not freed yet.
+ */
+size_t memory_pool_get_tag_size(s32 tag) {
+    size_t size = 0;
+
+    for (s32 i = 0; i < MEMORY_SCOPE_COUNT; i++) {
+        size += sTagSizes[i][tag];
+    }
+    return size;
+}
+
+size_t memory_pool_get_tag_peak(s32 tag) {
+    return sTagPeaks[tag];
+}
+
+void memory_pool_print_usage(void) {
+    size_t inUse = gNextFreeMemoryAddress - (uintptr_t) sMemoryPool;
+    size_t tagged = 0;
+
+    printf("[memory_pool.c] Memory pool in use: 0x%zX bytes, resident: 0x%zX bytes\n", inUse,
+           memory_pool_get_resident_size());
+    for (s32 i = 0; i < MEMORY_SCOPE_COUNT; i++) {
+        printf("  %-9s peak: 0x%zX bytes\n", sScopeNames[i], memory_pool_get_peak(i));
+    }
+    for (s32 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        printf("  %-9s in use: 0x%zX bytes, peak: 0x%zX bytes\n", sTagNames[tag], memory_pool_get_tag_size(tag),
+               memory_pool_get_tag_peak(tag));
+        tagged += memory_pool_get_tag_size(tag);
+    }
+    // Decomp code that moves gNextFreeMemoryAddress itself
+    printf("  %-9s in use: 0x%zX bytes\n", "Untagged", (inUse > tagged) ? (inUse - tagged) : 0);
+}
+
+/**
+ * @brief Returns the address of the next available memory location and updates the memory pointer
+ * to reference the next location of available memory based provided size to allocate.
+ * @param size of memory to allocate.
+ * @param tag MemoryTag the allocation is counted under.
+ * @return Address of free memory
+ */
+void* get_next_available_memory_addr(uintptr_t size, s32 tag) {
+    uintptr_t freeSpace = (uintptr_t) gNextFreeMemoryAddress;
+    size = ALIGN16(size);
+
+    if ((freeSpace > sPoolEnd) || (size > sPoolEnd - freeSpace)) {
+        memory_pool_overflow("get_next_available_memory_addr", size);
+    }
+    gNextFreeMemoryAddress += size;
+    memory_pool_add_tag(tag, size);
+
+    return (void*) freeSpace;
+}
+
+/**
+ * @brief Sets the starting location for allocating memory and calculates pool size.
+ *
+ * Default memory size, 701.984 Kilobytes.
+ */
+void initialize_memory_pool() {
+    uintptr_t poolStart;
+
+    // Fresh pages are already zero, so there is no need to clear the pool
+    sMemoryPool = (u8*) VirtualMemory_Reserve(MEMORY_POOL_SIZE, MEMORY_POOL_GUARD_SIZE);
+    poolStart = (uintptr_t) sMemoryPool;
+    sPoolEnd = poolStart + MEMORY_POOL_SIZE;
+
+    poolStart = ALIGN16(poolStart);
+    // Truncate to a 16-byte boundary.
+    sPoolEnd &= ~0xF;
+
+    gFreeMemorySize = (sPoolEnd - poolStart) - 0x10;
+    gNextFreeMemoryAddress = poolStart;
+    sPoolHighWater = poolStart;
+    sRaceScopeStart = poolStart;
+    memory_pool_clear_tags(MEMORY_SCOPE_STARTUP);
+    memset(sTagPeaks, 0, sizeof(sTagPeaks));
+    memset(sScopePeaks, 0, sizeof(sScopePeaks));
+    sCurrentScope = MEMORY_SCOPE_STARTUP;
+
+    PRINT_MEMPOOL;
+}
+
+/**
+ * @brief Allocates memory and adjusts gFreeMemorySize.
+ * @param tag MemoryTag the allocation is counted under.
+ */
+void* allocate_memory(size_t size, s32 tag) {
+    uintptr_t freeSpace;
+
+    size = ALIGN16(size);
+    freeSpace = (uintptr_t) gNextFreeMemoryAddress;
+
+    // gFreeMemorySize is unsigned and is never reset, so check against the end of the pool instead
+    if ((freeSpace > sPoolEnd) || (size > sPoolEnd - freeSpace)) {
+        memory_pool_overflow("allocate_memory", size);
+    }
+
+    gFreeMemorySize -= size;
+    gNextFreeMemoryAddress += size;
+    memory_pool_add_tag(tag, size);
+
+    return (void*) freeSpace;
+}
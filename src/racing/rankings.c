@@ -0,0 +1,112 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <defines.h>
+#include <string.h>
+#include "rankings.h"
+
+// Racers sorted by insertion before merging. Last tick's ranking is nearly right, so this is close to one pass.
+#define RANKINGS_RUN 8
+
+// Sorts [begin, end) by insertion, moving a racer up only past racers with a lower score
+static void insert_run(s32* ids, f32* scores, s32 begin, s32 end) {
+    for (s32 i = begin + 1; i < end; i++) {
+        s32 id = ids[i];
+        f32 score = scores[i];
+        s32 j = i;
+
+        while ((j > begin) && (scores[j - 1] < score)) {
+            ids[j] = ids[j - 1];
+            scores[j] = scores[j - 1];
+            j--;
+        }
+        ids[j] = id;
+        scores[j] = score;
+    }
+}
+
+// Merges the sorted runs [begin, middle) and [middle, end) of the source arrays into the destination arrays.
+// Taking from the left run on ties keeps racers with equal scores in order.
+static void merge_runs(const s32* srcIds, const f32* srcScores, s32* dstIds, f32* dstScores, s32 begin, s32 middle,
+                       s32 end) {
+    s32 left = begin;
+    s32 right = middle;
+
+    // Already in order, as most of the ranking is from one tick to the next
+    if ((middle >= end) || (srcScores[middle - 1] >= srcScores[middle])) {
+        memcpy(&dstIds[begin], &srcIds[begin], (end - begin) * sizeof(s32));
+        memcpy(&dstScores[begin], &srcScores[begin], (end - begin) * sizeof(f32));
+        return;
+    }
+    for (s32 i = begin; i < end; i++) {
+        if ((left < middle) && ((right >= end) || (srcScores[left] >= srcScores[right]))) {
+            dstIds[i] = srcIds[left];
+            dstScores[i] = srcScores[left];
+            left++;
+        } else {
+            dstIds[i] = srcIds[right];
+            dstScores[i] = srcScores[right];
+            right++;
+        }
+    }
+}
+
+void rank_racers(s32* ids, f32* scores, s32 count) {
+    s32 bufferIds[RANKINGS_MAX_RACERS];
+    f32 bufferScores[RANKINGS_MAX_RACERS];
+    s32* srcIds = ids;
+    f32* srcScores = scores;
+    s32* dstIds = bufferIds;
+    f32* dstScores = bufferScores;
+
+    if (count > RANKINGS_MAX_RACERS) {
+        printf("[rankings.c] Can't rank %d racers, the most is %d\n", count, RANKINGS_MAX_RACERS);
+        count = RANKINGS_MAX_RACERS;
+    }
+
+    for (s32 begin = 0; begin < count; begin += RANKINGS_RUN) {
+        insert_run(ids, scores, begin, MIN(begin + RANKINGS_RUN, count));
+    }
+    // Bottom up, swapping between the arrays and the buffer after each pass
+    for (s32 width = RANKINGS_RUN; width < count; width *= 2) {
+        for (s32 begin = 0; begin < count; begin += width * 2) {
+            s32 middle = MIN(begin + width, count);
+            s32 end = MIN(begin + width * 2, count);
+            merge_runs(srcIds, srcScores, dstIds, dstScores, begin, middle, end);
+        }
+        s32* swapIds = srcIds;
+        f32* swapScores = srcScores;
+        srcIds = dstIds;
+        srcScores = dstScores;
+        dstIds = swapIds;
+        dstScores = swapScores;
+    }
+    if (srcIds != ids) {
+        memcpy(ids, srcIds, count * sizeof(s32));
+        memcpy(scores, srcScores, count * sizeof(f32));
+    }
+}
+
+void rank_racers_around_fixed(s32* ids, f32* scores, const bool* fixed, s32 count) {
+    s32 movingIds[RANKINGS_MAX_RACERS];
+    f32 movingScores[RANKINGS_MAX_RACERS];
+    s32 moving = 0;
+    s32 i;
+
+    count = MIN(count, RANKINGS_MAX_RACERS);
+    for (i = 0; i < count; i++) {
+        if (!fixed[i]) {
+            movingIds[moving] = ids[i];
+            movingScores[moving] = scores[i];
+            moving++;
+        }
+    }
+    rank_racers(movingIds, movingScores, moving);
+    moving = 0;
+    for (i = 0; i < count; i++) {
+        if (!fixed[i]) {
+            ids[i] = movingIds[moving];
+            scores[i] = movingScores[moving];
+            moving++;
+        }
+    }
+}
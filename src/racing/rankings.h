@@ -0,0 +1,36 @@
+#ifndef RANKINGS_H
+#define RANKINGS_H
+
+#include <libultraship.h>
+#include <defines.h>
+
+/**
+ * Orders racers by a score, highest first, for set_places and the end of race standings.
+ *
+ * These used to be exchange sorts over [8] arrays, which compare every pair of racers every tick. The merge
+ * sort here compares O(n log n) pairs at worst, and about n when the order given, last tick's ranking, is
+ * nearly right already. Racers with equal scores keep the order they were given in, where the exchange sort
+ * could swap them around.
+ */
+
+// Most racers the rankings take. The per-player tables are still sized by NUM_PLAYERS.
+#define RANKINGS_MAX_RACERS 32
+
+#if NUM_PLAYERS > RANKINGS_MAX_RACERS
+#error NUM_PLAYERS is larger than RANKINGS_MAX_RACERS
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sorts ids and their scores together, highest score first
+void rank_racers(s32* ids, f32* scores, s32 count);
+// As rank_racers, but a racer with fixed[i] set keeps place i and the others are ranked around it
+void rank_racers_around_fixed(s32* ids, f32* scores, const bool* fixed, s32 count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RANKINGS_H
@@ -17,11 +17,13 @@
 #include "memory.h"
 #include "code_80281780.h"
 #include "collision.h"
+#include "collision_batch.h"
 #include "skybox_and_splitscreen.h"
 #include "courses/all_course_data.h"
 #include "courses/all_course_packed.h"
 #include "courses/all_course_offsets.h"
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 #include "engine/Matrix.h"
 #include "engine/courses/Course.h"
 
@@ -177,7 +179,7 @@ void render_course_segments(const char* addr[], struct UnkStruct_800DC5EC* arg1)
     index = ((index - 1) * 4) + direction;
     gSPDisplayList(gDisplayListHead++, addr[index]);
 
-    if (CVarGetInteger("gDisableLod", 1) == 1 && (IsBowsersCastle()) &&
+    if (gFrameSettings.DisableLod == 1 && (IsBowsersCastle()) &&
         (index < 20 || index > 99)) { // always render higher version of bowser statue
         gDisplayListHead--;
         gSPDisplayList(gDisplayListHead++, d_course_bowsers_castle_dl_9148); // use credit version of the course
@@ -194,7 +196,7 @@ void render_mario_raceway_pipe(void) {
         // d_course_mario_raceway_packed_dl_8E8
         gSPDisplayList(gDisplayListHead++, ((uintptr_t) segmented_gfx_to_virtual(0x070008E8)));
     } else {
-        if (CVarGetInteger("gDisableLod", 1) == true) {
+        if (gFrameSettings.DisableLod == true) {
             gSPDisplayList(gDisplayListHead++, ((uintptr_t) segmented_gfx_to_virtual(0x070008E8)));
             return;
         }
@@ -1404,7 +1406,7 @@ void render_course(struct UnkStruct_800DC5EC* arg0) {
     set_track_light_direction(D_800DC610, D_802B87D4, 0, 1);
 
     // Freecam priority renders collision.
-    if (CVarGetInteger("gRenderCollisionMesh", 0) == true) {
+    if (gFrameSettings.RenderCollisionMesh == true) {
         render_collision();
         return;
     }
@@ -1495,16 +1497,19 @@ void func_80295BF8(s32 playerIndex) {
 }
 
 void func_80295C6C(void) {
-    gNextFreeMemoryAddress += ALIGN16(gCollisionMeshCount * sizeof(CollisionTriangle));
+    // The mesh and its indices are built in place at gNextFreeMemoryAddress, so these only claim them
+    allocate_memory(gCollisionMeshCount * sizeof(CollisionTriangle), MEMORY_TAG_COLLISION);
     gCourseMaxX += 20;
     gCourseMaxZ += 20;
     gCourseMinX += -20;
     gCourseMinZ += -20;
     gCourseMinY += -20;
 
-    gCollisionIndices = (u16*) gNextFreeMemoryAddress;
+    allocate_collision_grid();
+    gCollisionIndices = (u32*) gNextFreeMemoryAddress;
     generate_collision_grid();
-    gNextFreeMemoryAddress += ALIGN16(gNumCollisionTriangles * sizeof(u16));
+    allocate_memory(gNumCollisionTriangles * sizeof(u32), MEMORY_TAG_COLLISION);
+    generate_collision_bounds();
 }
 
 UNUSED void func_80295D50(s16 arg0, s16 arg1) {
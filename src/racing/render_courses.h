@@ -53,6 +53,6 @@ extern s16 D_802B87D4;
 
 extern Lights1 D_800DC610[];
 
-extern u16 gNumCollisionTriangles;
+extern u32 gNumCollisionTriangles;
 
 #endif
@@ -22,6 +22,7 @@
 #include "engine/Matrix.h"
 #include "engine/courses/Course.h"
 #include "port/Game.h"
+#include "port/Frustum.h"
 #include "math_util.h"
 #include "src/enhancements/freecam/freecam.h"
 #include "port/interpolation/FrameInterpolation.h"
@@ -784,6 +785,10 @@ void setup_camera(Camera* camera, s32 playerId, s32 cameraId, struct UnkStruct_8
     gSPMatrix(gDisplayListHead++, GetLookAtMatrix(cameraId),
               G_MTX_NOPUSH | G_MTX_MUL | G_MTX_PROJECTION);
 
+    // Entities are culled against the same camera
+    Frustum_SetCamera(screen - D_8015F480, camera->pos, camera->lookAt, camera->up, gCameraZoom[cameraId],
+                      gScreenAspect, CM_GetProps()->NearPersp, CM_GetProps()->FarPersp);
+
     FrameInterpolation_RecordCloseChild();
 }
 
@@ -31,9 +31,12 @@
 #include <assets/wario_kart.h>
 #include <assets/donkeykong_kart.h>
 #include "port/Game.h"
+#include "port/FrameSettings.h"
+#include "port/GfxPool.h"
 #include "engine/Matrix.h"
 #include "port/interpolation/FrameInterpolation.h"
 #include "port/Engine.h"
+#include "port/KartTextures.h"
 
 s8 gRenderingFramebufferByPlayer[] = { 0x00, 0x02, 0x00, 0x01, 0x00, 0x01, 0x00, 0x02 };
 
@@ -113,7 +116,7 @@ u16 check_player_camera_collision(Player* player, Camera* camera, f32 arg2, f32
     s16 var_v0;
     u16 ret;
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gFrameSettings.NoCulling == 1) {
         return true;
     }
 
@@ -506,6 +509,7 @@ void load_kart_texture_and_render_kart_particle_on_screen_four(void) {
 }
 
 void try_rendering_player(Player* player, s8 playerId, s8 arg2) {
+    GfxPool_Ensure();
 
     if (((player->type & PLAYER_EXISTS) == PLAYER_EXISTS) && ((player->type & PLAYER_UNKNOWN_0x40) == 0)) {
         if ((player->unk_002 & 2 << (arg2 * 4)) == 2 << (arg2 * 4)) {
@@ -1649,6 +1653,7 @@ void render_kart(Player* player, s8 playerId, s8 screenId, s8 flipOffset) {
     } else {
         sKartTexture = gEncodedKartTexture[D_801651D0[screenId][playerId]][screenId - 1][playerId - 4].unk_00;
     }
+    gPlayerPalette = KartTextures_BindFrame(sKartTexture, gPlayerPalette);
     mtxf_translate_rotate(mtx, sp154, sp14C);
     mtxf_scale(mtx, gCharacterSize[player->characterId] * player->size);
     convert_to_fixed_point_matrix(GetKartMatrix(playerId + (screenId * 8)), mtx);
@@ -1759,6 +1764,7 @@ void render_ghost(Player* player, s8 playerId, s8 screenId, s8 flipOffset) {
     } else {
         sKartTexture = gEncodedKartTexture[D_801651D0[screenId][playerId]][screenId - 1][playerId - 4].unk_00;
     }
+    gPlayerPalette = KartTextures_BindFrame(sKartTexture, gPlayerPalette);
 
     mtxf_translate_rotate(mtx, spDC, spD4);
     mtxf_scale(mtx, gCharacterSize[player->characterId] * player->size);
@@ -1914,10 +1920,7 @@ void render_player(Player* player, s8 playerId, s8 screenId) {
         func_80025DE8(player, playerId, screenId, var_v1);
     }
     // Allows wheels to spin
-    if (GameEngine_ResourceGetTexTypeByName(sKartTexture) !=
-        1) { // only invalidate texture cache if it's a palette texture
-        gSPInvalidateTexCache(gDisplayListHead++, sKartTexture);
-    }
+    KartTextures_ReleaseFrame(sKartTexture);
 }
 
 void func_80026A48(Player* player, s8 arg1) {
@@ -40,6 +40,7 @@
 #include "courses/all_course_data.h"
 #include <assets/boo_frames.h>
 #include "port/Game.h"
+#include "port/FrameSettings.h"
 
 float OTRGetAspectRatio(void);
 
@@ -3343,7 +3344,7 @@ u8 gen_random_item(s16 rank, s16 option) {
 }
 
 u8 gen_random_item_human(UNUSED s16 arg0, s16 rank) {
-    if (CVarGetInteger("gHarderCPU", 0) == true) {
+    if (gFrameSettings.HarderCPU == true) {
         return gen_random_item(rank, HARD_CPU_TABLE);
     } else {
         return gen_random_item(rank, HUMAN_TABLE);
@@ -0,0 +1,64 @@
+#ifndef CHECKS_H
+#define CHECKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Each check prints what it compared and returns how many of the comparisons failed.
+ * main.cpp lists them by the name ctest runs them under.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// collision_checks.c
+size_t Check_CollisionBatch(void);
+size_t Check_CollisionGrid(void);
+
+// path_checks.c
+size_t Check_PathIndex(void);
+
+// memory_pool_checks.c
+size_t Check_MemoryPool(void);
+
+// ranking_checks.cpp
+size_t Check_RacerRanking(void);
+
+// entity_handle_checks.cpp
+size_t Check_EntityHandles(void);
+
+// frame_timer_checks.cpp
+size_t Check_FrameTimer(void);
+
+// section_culling_checks.cpp
+size_t Check_SectionCulling(void);
+
+// lod_checks.cpp
+size_t Check_LodSelection(void);
+
+// viewport_checks.cpp
+size_t Check_ViewportSections(void);
+
+// text_batch_checks.cpp
+size_t Check_TextBatch(void);
+
+// picking_checks.cpp
+size_t Check_PickingTree(void);
+
+// pak_checks.cpp
+size_t Check_PakTornWrite(void);
+
+// scene_checks.cpp
+size_t Check_SceneRoundTrip(void);
+size_t Check_SceneAutosave(void);
+
+// stubs.c, what IsPodiumCeremony returns
+extern bool gStubPodiumCeremony;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHECKS_H
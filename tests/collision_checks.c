@@ -0,0 +1,568 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <mk64.h>
+#include <common_structs.h>
+#include <defines.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "collision.h"
+#include "collision_batch.h"
+#include "math_util.h"
+#include "code_800029B0.h"
+#include "checks.h"
+
+// Holds the collision mesh, grid and bounds, like the memory pool does in the game
+#define ARENA_SIZE (512 * 1024 * 1024)
+
+#define BATCH_QUERIES 20000
+
+static u8* sArena = NULL;
+// memory_pool.c, the end the allocators check against. The checks point it at the end of their arena.
+extern uintptr_t sPoolEnd;
+static Vtx* sVertices = NULL;
+static u32 sNumVertices = 0;
+static u32 sMaxVertices = 0;
+static u32 sSeed = 0;
+static s32 sTrackOrigin = 0;
+static s32 sTrackSpacing = 1;
+
+// What end_mesh took from the arena for the last mesh, in bytes
+static struct {
+    uintptr_t mesh;
+    uintptr_t grid;
+    uintptr_t indices;
+    uintptr_t bounds;
+} sPoolUse;
+
+static u32 next_random(void) {
+    sSeed = sSeed * 1664525 + 1013904223;
+    return sSeed >> 8;
+}
+
+// Uniform in [lo, hi]
+static s32 random_range(s32 lo, s32 hi) {
+    return lo + (s32) (next_random() % (u32) (hi - lo + 1));
+}
+
+static Vtx* add_vertex(s32 x, s32 y, s32 z, u16 flag) {
+    Vtx* vtx = &sVertices[sNumVertices++];
+
+    memset(vtx, 0, sizeof(Vtx));
+    vtx->v.ob[0] = x;
+    vtx->v.ob[1] = y;
+    vtx->v.ob[2] = z;
+    vtx->v.flag = flag;
+    return vtx;
+}
+
+// Corners in order around the quad
+static void add_quad(s32 x[4], s32 y[4], s32 z[4], u16 flag, s8 surfaceType, u16 sectionId) {
+    Vtx* vtx[4];
+    s32 i;
+
+    for (i = 0; i < 4; i++) {
+        vtx[i] = add_vertex(x[i], y[i], z[i], flag);
+    }
+    add_collision_triangle(vtx[0], vtx[1], vtx[2], surfaceType, sectionId);
+    add_collision_triangle(vtx[0], vtx[2], vtx[3], surfaceType, sectionId);
+}
+
+// Starts a collision mesh the way Course::Init does
+static void begin_mesh(u32 maxQuads) {
+    if (sArena == NULL) {
+        sArena = malloc(ARENA_SIZE);
+    }
+    free(sVertices);
+    sMaxVertices = maxQuads * 4;
+    sVertices = malloc(sMaxVertices * sizeof(Vtx));
+    sNumVertices = 0;
+
+    gCourseMinX = 0;
+    gCourseMinY = 0;
+    gCourseMinZ = 0;
+    gCourseMaxX = 0;
+    gCourseMaxY = 0;
+    gCourseMaxZ = 0;
+    D_8015F59C = 0;
+    D_8015F5A0 = 0;
+    D_8015F5A4 = 0;
+    gCollisionMeshCount = 0;
+    gNextFreeMemoryAddress = ALIGN16((uintptr_t) sArena);
+    sPoolEnd = (uintptr_t) sArena + ARENA_SIZE;
+    gCollisionMesh = (CollisionTriangle*) gNextFreeMemoryAddress;
+}
+
+// Same steps as func_80295C6C, which builds the grid and the bounds once a course's mesh is loaded
+static void end_mesh(void) {
+    uintptr_t start = gNextFreeMemoryAddress;
+
+    gNextFreeMemoryAddress += ALIGN16(gCollisionMeshCount * sizeof(CollisionTriangle));
+    sPoolUse.mesh = gNextFreeMemoryAddress - start;
+    gCourseMaxX += 20;
+    gCourseMaxZ += 20;
+    gCourseMinX += -20;
+    gCourseMinZ += -20;
+    gCourseMinY += -20;
+
+    start = gNextFreeMemoryAddress;
+    allocate_collision_grid();
+    sPoolUse.grid = gNextFreeMemoryAddress - start;
+    gCollisionIndices = (u32*) gNextFreeMemoryAddress;
+    generate_collision_grid();
+    gNextFreeMemoryAddress += ALIGN16(gNumCollisionTriangles * sizeof(u32));
+    sPoolUse.indices = ALIGN16(gNumCollisionTriangles * sizeof(u32));
+    start = gNextFreeMemoryAddress;
+    generate_collision_bounds();
+    sPoolUse.bounds = gNextFreeMemoryAddress - start;
+}
+
+static bool is_arena_overflowed(void) {
+    if (gNextFreeMemoryAddress > (uintptr_t) sArena + ARENA_SIZE) {
+        printf("[Collision] The test mesh needs more than %d bytes\n", ARENA_SIZE);
+        return true;
+    }
+    return false;
+}
+
+static s32 terrain_height(s32 i, s32 j) {
+    return (s32) (((u32) i * 73856093u ^ (u32) j * 19349663u) % 31) - 15;
+}
+
+/**
+ * A bumpy floor of size x size quads, each spacing units across, crossed by sloped walls facing each axis.
+ * A bridge runs over part of the floor and some walls stand straight up, which the tyres never collide with.
+ * Floor quads wind so that their normals face up, as they do in the courses; tyres only land on them from above.
+ */
+static void build_test_track(s32 size, s32 spacing) {
+    s32 origin = -(size * spacing) / 2;
+    s32 x[4];
+    s32 y[4];
+    s32 z[4];
+    s32 i, j, k;
+    u16 flag;
+
+    sTrackOrigin = origin;
+    sTrackSpacing = spacing;
+    for (j = 0; j < size; j++) {
+        for (i = 0; i < size; i++) {
+            k = random_range(0, 15);
+            flag = (k < 13) ? 0 : k - 12;
+            x[0] = x[1] = origin + i * spacing;
+            x[2] = x[3] = x[0] + spacing;
+            z[0] = z[3] = origin + j * spacing;
+            z[1] = z[2] = z[0] + spacing;
+            y[0] = terrain_height(i, j);
+            y[1] = terrain_height(i, j + 1);
+            y[2] = terrain_height(i + 1, j + 1);
+            y[3] = terrain_height(i + 1, j);
+            add_quad(x, y, z, flag, random_range(0, 10), (i / 16) + (j / 16) * 10);
+        }
+    }
+
+    // Half a quad off the floor's grid, so its triangles land in other grid cells
+    for (j = 0; j < size; j++) {
+        for (i = size / 3; i < size / 2; i++) {
+            x[0] = x[1] = origin + i * spacing + spacing / 2;
+            x[2] = x[3] = x[0] + spacing;
+            z[0] = z[3] = origin + j * spacing + spacing / 2;
+            z[1] = z[2] = z[0] + spacing;
+            y[0] = y[1] = y[2] = y[3] = 60 + (i - size / 3);
+            add_quad(x, y, z, 0, 1, 0xFE);
+        }
+    }
+
+    for (k = 0; k < size; k += 10) {
+        s32 lean = ((k / 10) % 4 == 3) ? 0 : 6;
+        s32 from = random_range(0, size / 2) * spacing;
+        s32 to = from + random_range(4, size / 2) * spacing;
+
+        // Facing X
+        x[0] = x[1] = origin + k * spacing + spacing / 3;
+        x[2] = x[3] = x[0] + lean;
+        z[0] = z[3] = origin + from;
+        z[1] = z[2] = origin + to;
+        y[0] = y[1] = -20;
+        y[2] = y[3] = 40;
+        add_quad(x, y, z, 0, 2, 0xFD);
+
+        // Facing Z
+        z[0] = z[1] = origin + k * spacing + spacing / 3;
+        z[2] = z[3] = z[0] + lean;
+        x[0] = x[3] = origin + from;
+        x[1] = x[2] = origin + to;
+        add_quad(x, y, z, 0, 3, 0xFD);
+    }
+}
+
+static bool is_same_tyre(KartTyre* a, KartTyre* b) {
+    return (a->pos[0] == b->pos[0]) && (a->pos[1] == b->pos[1]) && (a->pos[2] == b->pos[2]) &&
+           (a->surfaceType == b->surfaceType) && (a->surfaceFlags == b->surfaceFlags) &&
+           (a->collisionMeshIndex == b->collisionMeshIndex) && (a->baseHeight == b->baseHeight) &&
+           (a->unk_14 == b->unk_14);
+}
+
+/**
+ * Drives a player around a test track and resolves its tyres with player_terrain_collision_batch and with
+ * player_terrain_collision on each tyre, which must leave the tyres exactly the same.
+ */
+size_t Check_CollisionBatch(void) {
+    static const f32 sTyreOffsets[NUM_TYRES][2] = {
+        { 3.5f, 4.0f }, { -3.5f, 4.0f }, { 3.5f, -4.0f }, { -3.5f, -4.0f }
+    };
+    static Player scalar;
+    static Player batched;
+    size_t failures = 0;
+    u32 grounded = 0;
+    u32 walls = 0;
+    s32 step;
+    s32 i;
+
+    sSeed = 0x2545F491;
+    begin_mesh(160 * 160 + 160 * 40);
+    build_test_track(160, 24);
+    end_mesh();
+    if (is_arena_overflowed()) {
+        return 1;
+    }
+
+    memset(&scalar, 0, sizeof(Player));
+    scalar.boundingBoxSize = 5.5f;
+    for (i = 0; i < NUM_TYRES; i++) {
+        scalar.tyres[i].collisionMeshIndex = 5000;
+    }
+
+    for (step = 0; step < BATCH_QUERIES; step++) {
+        Vec3f prevPos[NUM_TYRES];
+        s32 scalarResult = 0;
+        s32 batchResult;
+
+        // Drive on from the last position, now and then jumping anywhere on or just off the track
+        if ((next_random() % 64) == 0) {
+            scalar.pos[0] = random_range(gCourseMinX - 200, gCourseMaxX + 200);
+            scalar.pos[2] = random_range(gCourseMinZ - 200, gCourseMaxZ + 200);
+        } else {
+            scalar.pos[0] += random_range(-24, 24);
+            scalar.pos[2] += random_range(-24, 24);
+        }
+        if ((next_random() % 4) != 0) {
+            scalar.pos[1] = terrain_height((scalar.pos[0] - sTrackOrigin) / sTrackSpacing,
+                                           (scalar.pos[2] - sTrackOrigin) / sTrackSpacing) +
+                            random_range(-2, 10);
+        } else {
+            scalar.pos[1] = random_range(gCourseMinY - 10, gCourseMaxY + 10);
+        }
+        for (i = 0; i < NUM_TYRES; i++) {
+            prevPos[i][0] = scalar.tyres[i].pos[0];
+            prevPos[i][1] = scalar.tyres[i].pos[1];
+            prevPos[i][2] = scalar.tyres[i].pos[2];
+            scalar.tyres[i].pos[0] = scalar.pos[0] + sTyreOffsets[i][0];
+            scalar.tyres[i].pos[1] = scalar.pos[1] + (f32) random_range(-8, 8) / 4.0f;
+            scalar.tyres[i].pos[2] = scalar.pos[2] + sTyreOffsets[i][1];
+        }
+
+        memcpy(&batched, &scalar, sizeof(Player));
+        for (i = 0; i < NUM_TYRES; i++) {
+            if (player_terrain_collision(&scalar, &scalar.tyres[i], prevPos[i][0], prevPos[i][1], prevPos[i][2]) ==
+                1) {
+                scalarResult |= 1 << i;
+            }
+        }
+        batchResult = player_terrain_collision_batch(&batched, prevPos);
+
+        for (i = 0; i < NUM_TYRES; i++) {
+            if (!is_same_tyre(&scalar.tyres[i], &batched.tyres[i])) {
+                if (failures < 8) {
+                    printf("[Collision] Step %d tyre %d: scalar mesh %u flags 0x%X, batched mesh %u flags 0x%X\n",
+                           step, i, scalar.tyres[i].collisionMeshIndex, scalar.tyres[i].surfaceFlags,
+                           batched.tyres[i].collisionMeshIndex, batched.tyres[i].surfaceFlags);
+                }
+                failures++;
+            }
+            if (scalarResult & (1 << i)) {
+                grounded++;
+                walls += scalar.tyres[i].surfaceFlags != 0x40;
+            }
+        }
+        if (scalarResult != batchResult) {
+            failures++;
+        }
+    }
+
+    printf("[Collision] %d tyre queries on %u triangles in a %dx%d grid. %u touched a surface, %u of them a wall\n",
+           BATCH_QUERIES * NUM_TYRES, gCollisionMeshCount, gCollisionGridSize, gCollisionGridSize, grounded, walls);
+    if ((grounded == 0) || (walls == 0)) {
+        printf("[Collision] The queries never reached the floors and the walls\n");
+        failures++;
+    }
+    return failures;
+}
+
+/**
+ * Builds the grid the way generate_collision_grid did before it only visited the cells each triangle reaches:
+ * every cell tested against every triangle, one cell after the other.
+ * @return false if the cells list more than capacity triangles
+ */
+static bool generate_reference_grid(CollisionGrid* cells, u32* indices, u32 capacity) {
+    CollisionTriangle* triangle;
+    s32 gridSize = gCollisionGridSize;
+    s32 sectionX = get_collision_grid_cell_length((s32) gCourseMaxX - gCourseMinX);
+    s32 sectionZ = get_collision_grid_cell_length((s32) gCourseMaxZ - gCourseMinZ);
+    u32 total = 0;
+    s32 index;
+    s32 j, k;
+    u32 i;
+    s16 minX;
+    s16 minZ;
+    s16 maxX;
+    s16 maxZ;
+
+    for (j = 0; j < gridSize; j++) {
+        for (k = 0; k < gridSize; k++) {
+            index = k + j * gridSize;
+            cells[index].triangle = total;
+            cells[index].numTriangles = 0;
+
+            minX = (gCourseMinX + (sectionX * k)) - 20;
+            minZ = (gCourseMinZ + (sectionZ * j)) - 20;
+            maxX = minX + sectionX + 40;
+            maxZ = minZ + sectionZ + 40;
+
+            for (i = 0; i < gCollisionMeshCount; i++) {
+                triangle = gCollisionMesh + i;
+                if ((triangle->maxZ < minZ) || (triangle->minZ > maxZ) || (triangle->maxX < minX) ||
+                    (triangle->minX > maxX)) {
+                    continue;
+                }
+                if (is_triangle_intersecting_bounding_box(minX, maxX, minZ, maxZ, i) == 1) {
+                    if (total == capacity) {
+                        return false;
+                    }
+                    cells[index].numTriangles++;
+                    indices[total++] = i;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Compares gCollisionGrid cell by cell against the reference grid of the same resolution
+static size_t compare_with_reference_grid(const char* name) {
+    s32 numCells = gCollisionGridSize * gCollisionGridSize;
+    u32 capacity = gNumCollisionTriangles + gCollisionMeshCount;
+    CollisionGrid* cells = malloc(numCells * sizeof(CollisionGrid));
+    u32* indices = malloc(capacity * sizeof(u32));
+    size_t failures = 0;
+    s32 cell;
+
+    if (!generate_reference_grid(cells, indices, capacity)) {
+        printf("[Collision] %s: the reference grid lists more triangles than the grid\n", name);
+        failures++;
+    } else {
+        for (cell = 0; cell < numCells; cell++) {
+            CollisionGrid* expected = &cells[cell];
+            CollisionGrid* actual = &gCollisionGrid[cell];
+
+            if ((actual->numTriangles != expected->numTriangles) ||
+                (memcmp(&gCollisionIndices[actual->triangle], &indices[expected->triangle],
+                        expected->numTriangles * sizeof(u32)) != 0)) {
+                if (failures < 8) {
+                    printf("[Collision] %s: cell %d lists %u triangles from %u, the reference %u from %u\n", name,
+                           cell, actual->numTriangles, actual->triangle, expected->numTriangles, expected->triangle);
+                }
+                failures++;
+            }
+        }
+    }
+    printf("[Collision] %s: %u triangles in a %dx%d grid, listed %u times\n", name, gCollisionMeshCount,
+           gCollisionGridSize, gCollisionGridSize, gNumCollisionTriangles);
+    free(cells);
+    free(indices);
+    return failures;
+}
+
+/**
+ * Compares every step-th cell of gCollisionGrid against a scan of the whole mesh for that cell alone. For meshes
+ * too large to build the whole reference grid for.
+ */
+static size_t compare_sampled_cells(const char* name, s32 step) {
+    s32 gridSize = gCollisionGridSize;
+    s32 sectionX = get_collision_grid_cell_length((s32) gCourseMaxX - gCourseMinX);
+    s32 sectionZ = get_collision_grid_cell_length((s32) gCourseMaxZ - gCourseMinZ);
+    size_t failures = 0;
+    s32 sampled = 0;
+    s32 cell;
+
+    for (cell = step / 2; cell < gridSize * gridSize; cell += step) {
+        CollisionGrid* actual = &gCollisionGrid[cell];
+        s16 minX = (gCourseMinX + (sectionX * (cell % gridSize))) - 20;
+        s16 minZ = (gCourseMinZ + (sectionZ * (cell / gridSize))) - 20;
+        s16 maxX = minX + sectionX + 40;
+        s16 maxZ = minZ + sectionZ + 40;
+        u32 listed = 0;
+        bool same = true;
+        u32 i;
+
+        for (i = 0; i < gCollisionMeshCount; i++) {
+            CollisionTriangle* triangle = gCollisionMesh + i;
+            if ((triangle->maxZ < minZ) || (triangle->minZ > maxZ) || (triangle->maxX < minX) ||
+                (triangle->minX > maxX)) {
+                continue;
+            }
+            if (is_triangle_intersecting_bounding_box(minX, maxX, minZ, maxZ, i) == 1) {
+                same = same && (listed < actual->numTriangles) &&
+                       (gCollisionIndices[actual->triangle + listed] == i);
+                listed++;
+            }
+        }
+        if (!same || (listed != actual->numTriangles)) {
+            if (failures < 8) {
+                printf("[Collision] %s: cell %d lists %u triangles, the scan found %u\n", name, cell,
+                       actual->numTriangles, listed);
+            }
+            failures++;
+        }
+        sampled++;
+    }
+    printf("[Collision] %s: compared %d of %d cells with a scan of the whole mesh\n", name, sampled,
+           gridSize * gridSize);
+    return failures;
+}
+
+// Builds a grid of another resolution for the loaded mesh, after everything end_mesh allocated
+static void regenerate_collision_grid(s32 gridSize) {
+    gCollisionGridSize = gridSize;
+    gCollisionGrid = (CollisionGrid*) gNextFreeMemoryAddress;
+    gNextFreeMemoryAddress += ALIGN16(gridSize * gridSize * sizeof(CollisionGrid));
+    gCollisionIndices = (u32*) gNextFreeMemoryAddress;
+    generate_collision_grid();
+    gNextFreeMemoryAddress += ALIGN16(gNumCollisionTriangles * sizeof(u32));
+}
+
+/**
+ * Drops a tyre onto floor triangles whose index does not fit in 16 bits. The tyre must end up on that very
+ * triangle, through both the scalar and the batched search.
+ */
+static size_t check_high_triangle_indices(void) {
+    static Player scalar;
+    static Player batched;
+    size_t failures = 0;
+    u32 checked = 0;
+    u32 index;
+    s32 i;
+
+    for (index = 0x10000; index < gCollisionMeshCount; index += 97) {
+        CollisionTriangle* triangle = &gCollisionMesh[index];
+        Vec3f prevPos[NUM_TYRES];
+        f32 x;
+        f32 z;
+        f32 height;
+
+        if (!(triangle->flags & FACING_Y_AXIS)) {
+            continue;
+        }
+        x = (triangle->vtx1->v.ob[0] + triangle->vtx2->v.ob[0] + triangle->vtx3->v.ob[0]) / 3.0f;
+        z = (triangle->vtx1->v.ob[2] + triangle->vtx2->v.ob[2] + triangle->vtx3->v.ob[2]) / 3.0f;
+        height = calculate_surface_height(x, 0.0f, z, index);
+
+        memset(&scalar, 0, sizeof(Player));
+        scalar.boundingBoxSize = 5.5f;
+        vec3f_set(scalar.pos, x, height + 2.0f, z);
+        for (i = 0; i < NUM_TYRES; i++) {
+            vec3f_set(scalar.tyres[i].pos, x, height + 1.0f, z);
+            vec3f_set(prevPos[i], x, height + 1.0f, z);
+            scalar.tyres[i].collisionMeshIndex = 5000;
+        }
+        memcpy(&batched, &scalar, sizeof(Player));
+
+        player_terrain_collision(&scalar, &scalar.tyres[0], x, height + 1.0f, z);
+        player_terrain_collision_batch(&batched, prevPos);
+        if ((scalar.tyres[0].collisionMeshIndex != index) || (batched.tyres[0].collisionMeshIndex != index)) {
+            if (failures < 8) {
+                printf("[Collision] A tyre on triangle %u landed on %u, and on %u when batched\n", index,
+                       scalar.tyres[0].collisionMeshIndex, batched.tyres[0].collisionMeshIndex);
+            }
+            failures++;
+        }
+        checked++;
+    }
+    printf("[Collision] Dropped a tyre onto %u triangles past index 65535\n", checked);
+    if (checked == 0) {
+        failures++;
+    }
+    return failures;
+}
+
+/**
+ * Checks that generate_collision_grid lists the same triangles in the same order in every cell as the old
+ * cell by cell scan, at the stock resolution and finer ones, and that a mesh with more triangles than 16 bit
+ * indices can reach gets a finer grid that finds every one of them. Then does the same on a mesh of over two
+ * million triangles, and checks that the pool memory the grid takes per triangle stays flat as the mesh grows.
+ */
+size_t Check_CollisionGrid(void) {
+    size_t failures = 0;
+    u32 largeCount;
+    f64 largeOverhead;
+    f64 hugeOverhead;
+
+    sSeed = 0x6A09E667;
+    begin_mesh(160 * 160 * 2);
+    build_test_track(160, 24);
+    end_mesh();
+    failures += compare_with_reference_grid("Stock resolution");
+    regenerate_collision_grid(GRID_SIZE * 2);
+    failures += compare_with_reference_grid("Double resolution");
+    if (is_arena_overflowed()) {
+        return failures + 1;
+    }
+
+    sSeed = 0xBB67AE85;
+    begin_mesh(200 * 200 * 2);
+    build_test_track(200, 36);
+    end_mesh();
+    if (is_arena_overflowed()) {
+        return failures + 1;
+    }
+    if ((gCollisionMeshCount <= 0xFFFF) || (gCollisionGridSize == GRID_SIZE)) {
+        printf("[Collision] The large track has %u triangles in a %dx%d grid\n", gCollisionMeshCount,
+               gCollisionGridSize, gCollisionGridSize);
+        failures++;
+    }
+    failures += compare_with_reference_grid("Large track");
+    failures += check_high_triangle_indices();
+    largeCount = gCollisionMeshCount;
+    largeOverhead = (f64) (sPoolUse.grid + sPoolUse.indices + sPoolUse.bounds) / gCollisionMeshCount;
+
+    // Millions of triangles, as a whole custom track's worth of collision would be. The reference grid would take
+    // hours to build for it, so a sample of its cells is scanned instead.
+    sSeed = 0x3C6EF372;
+    begin_mesh(1000 * 1000 * 5 / 4);
+    build_test_track(1000, 32);
+    end_mesh();
+    if (is_arena_overflowed()) {
+        return failures + 1;
+    }
+    hugeOverhead = (f64) (sPoolUse.grid + sPoolUse.indices + sPoolUse.bounds) / gCollisionMeshCount;
+    printf("[Collision] Pool use: %u triangles took %.1f MB for the mesh, %.1f KB for the %dx%d grid, %.1f MB for "
+           "its lists and %.1f MB for the batched bounds, %.1f bytes a triangle beyond the mesh. %u triangles took "
+           "%.1f bytes a triangle\n",
+           gCollisionMeshCount, sPoolUse.mesh / (1024.0 * 1024.0), sPoolUse.grid / 1024.0, gCollisionGridSize,
+           gCollisionGridSize, sPoolUse.indices / (1024.0 * 1024.0), sPoolUse.bounds / (1024.0 * 1024.0),
+           hugeOverhead, largeCount, largeOverhead);
+    if ((gCollisionMeshCount < 2000000) || (gCollisionGridSize != GRID_SIZE_MAX)) {
+        printf("[Collision] The huge track has %u triangles in a %dx%d grid\n", gCollisionMeshCount,
+               gCollisionGridSize, gCollisionGridSize);
+        failures++;
+    }
+    // The grid, its lists and the bounds grow with the mesh, not faster than it
+    if (hugeOverhead > largeOverhead * 1.25) {
+        printf("[Collision] The grid took %.1f bytes a triangle on the huge track, %.1f on the large one\n",
+               hugeOverhead, largeOverhead);
+        failures++;
+    }
+    failures += compare_sampled_cells("Huge track", 257);
+    failures += check_high_triangle_indices();
+    return failures;
+}
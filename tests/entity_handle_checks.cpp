@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "engine/EntityHandle.h"
+#include "checks.h"
+
+#define HANDLE_COUNT 50000
+#define HANDLE_FRAMES 16
+
+/**
+ * Allocates and releases 50000 handles over several frames, the way the World spawns and destroys entities,
+ * and checks that released handles go stale, that live ones keep resolving, and that released slots are
+ * reused before the slot list grows.
+ */
+size_t Check_EntityHandles(void) {
+    EntityHandleAllocator allocator;
+    std::vector<EntityHandle> live;
+    std::vector<EntityHandle> dead;
+    std::vector<bool> indexUsed;
+    size_t peakLive = 0;
+    size_t passed = 0;
+    size_t failed = 0;
+    uint32_t seed = 0x2545F491;
+
+    auto nextRandom = [&seed]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Handles] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+
+    check(!allocator.IsValid(EntityHandle()), "null handle resolves");
+    check(!allocator.IsValid({ 0, 1 }), "handle resolves before anything was allocated");
+
+    for (size_t frame = 0; frame <= HANDLE_FRAMES; frame++) {
+        bool last = (frame == HANDLE_FRAMES);
+        std::string at = " on frame " + std::to_string(frame);
+
+        if (!last) {
+            for (size_t i = 0; i < HANDLE_COUNT / HANDLE_FRAMES; i++) {
+                bool hadFreeSlot = allocator.HasFreeSlot();
+                size_t slots = allocator.GetSlotCount();
+                EntityHandle handle = allocator.Allocate();
+
+                check(hadFreeSlot == (allocator.GetSlotCount() == slots), "released slot not reused" + at);
+                live.push_back(handle);
+            }
+        }
+        peakLive = std::max(peakLive, live.size());
+
+        // Releases about half of the live handles, or all of them on the last frame
+        for (size_t i = 0; i < live.size();) {
+            if (!last && (nextRandom() & 1)) {
+                i++;
+                continue;
+            }
+            allocator.Release(live[i]);
+            dead.push_back(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        }
+
+        // Releasing a stale handle again must not free its slot a second time
+        if (!dead.empty()) {
+            size_t liveCount = allocator.GetLiveCount();
+            allocator.Release(dead[nextRandom() % dead.size()]);
+            check(allocator.GetLiveCount() == liveCount, "stale handle released a live slot" + at);
+        }
+
+        indexUsed.assign(allocator.GetSlotCount(), false);
+        for (EntityHandle handle : live) {
+            check(allocator.IsValid(handle), "live handle went stale" + at);
+            check((handle.Index < indexUsed.size()) && !indexUsed[handle.Index], "two live handles share a slot" + at);
+            if (handle.Index < indexUsed.size()) {
+                indexUsed[handle.Index] = true;
+            }
+        }
+        size_t staleResolved = 0;
+        for (EntityHandle handle : dead) {
+            staleResolved += allocator.IsValid(handle);
+        }
+        check(staleResolved == 0, std::to_string(staleResolved) + " released handles still resolve" + at);
+        check(allocator.GetLiveCount() == live.size(), "live count is off" + at);
+    }
+
+    // Released slots were reused, so the list only grew to the peak number of live handles
+    check(allocator.GetSlotCount() == peakLive,
+          "slot list grew to " + std::to_string(allocator.GetSlotCount()) + " for " + std::to_string(peakLive) +
+              " live handles");
+
+    // Appending never reuses a slot, even with free ones around
+    EntityHandle reused = allocator.Allocate();
+    EntityHandle appended = allocator.AllocateAppend();
+    check(appended.Index == allocator.GetSlotCount() - 1, "appended handle did not get a new slot");
+    check(allocator.IsValid(reused) && allocator.IsValid(appended), "freshly allocated handle does not resolve");
+
+    // Handles from before a clear stay stale, even once their slot index is handed out again
+    allocator.Clear();
+    check(!allocator.IsValid(reused) && !allocator.IsValid(appended), "handle resolves after a clear");
+    EntityHandle afterClear = allocator.Allocate();
+    check((afterClear.Index == 0) && allocator.IsValid(afterClear), "first handle after a clear");
+    size_t staleAfterClear = 0;
+    for (EntityHandle handle : dead) {
+        staleAfterClear += allocator.IsValid(handle);
+    }
+    check(staleAfterClear == 0, std::to_string(staleAfterClear) + " handles from before a clear resolve again");
+
+    printf("[Handles] %zu handles released, at most %zu slots: %zu checks passed, %zu failed\n", dead.size(), peakLive,
+           passed, failed);
+    return failed;
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "port/FrameTimer.h"
+#include "checks.h"
+
+namespace {
+
+constexpr uint64_t NsPerSecond = 1000000000ULL;
+constexpr f64 TickMs = 1000.0 / FRAME_TIMER_TICK_RATE;
+// Work a frame does before its first tick and the cost of each tick, as in a busy race at 30 fps
+constexpr uint64_t PreTickWork = 3000000;
+constexpr uint64_t TickCost = 1500000;
+
+struct MockedRun {
+    FrameTimingStats Stats;
+    uint64_t Ticks = 0;
+    uint64_t Dropped = 0;
+    s32 MostTicks = 0; // Not counting the first frame, which runs the nominal ticks
+    s32 TicksAfterHitch = 0;
+    // How far the game clock ended up behind the mocked one, not counting the time dropped on purpose
+    f64 DriftMs = 0.0;
+};
+
+// Frame times at the given rate, each off by up to jitter either way, with a hitch every hitchEvery frames
+std::vector<uint64_t> MakeFrames(size_t count, uint64_t frameTime, uint64_t jitter, size_t hitchEvery,
+                                 uint64_t hitchTime) {
+    std::vector<uint64_t> frames;
+    uint32_t seed = 12345;
+
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint64_t interval = frameTime - jitter + (uint64_t) (((seed >> 8) / (f64) (1 << 24)) * 2 * jitter);
+        if ((hitchEvery != 0) && ((i % hitchEvery) == hitchEvery - 1)) {
+            interval = hitchTime;
+        }
+        frames.push_back(interval);
+    }
+    return frames;
+}
+
+/**
+ * Plays the frames on a mocked clock, with the accumulator or the old fixed two ticks per frame. The
+ * controllers are read at the start of each frame, and again before every later tick when sampleEachTick is
+ * set.
+ */
+MockedRun RunMockedFrames(const std::vector<uint64_t>& frames, bool useAccumulator, bool sampleEachTick) {
+    FrameTickAccumulator accumulator;
+    MockedRun run;
+    uint64_t clock = NsPerSecond;
+    uint64_t start = clock;
+    uint64_t frameStart = clock;
+    bool afterHitch = false;
+
+    for (uint64_t interval : frames) {
+        frameStart = clock;
+        s32 ticks = useAccumulator ? accumulator.Advance(clock) : FRAME_TIMER_NOMINAL_TICKS;
+        uint64_t dropped = useAccumulator ? accumulator.TakeDropped() : 0;
+
+        run.Stats.AddFrame(clock, ticks, dropped);
+        run.Ticks += ticks;
+        run.Dropped += dropped;
+        if (run.Stats.Frames > 1) {
+            run.MostTicks = std::max(run.MostTicks, ticks);
+        }
+        if (afterHitch) {
+            run.TicksAfterHitch = std::max(run.TicksAfterHitch, ticks);
+        }
+
+        uint64_t sampled = clock;
+        clock += PreTickWork;
+        for (s32 i = 0; i < ticks; i++) {
+            if (sampleEachTick && (i > 0)) {
+                sampled = clock;
+            }
+            run.Stats.AddTick(clock, sampled);
+            clock += TickCost;
+        }
+        clock = std::max(clock, frameStart + interval);
+        afterHitch = (interval > NsPerSecond / 20);
+    }
+    // The first frame's ticks cover the time before the clock starts
+    f64 gameMs = (f64) (run.Ticks - FRAME_TIMER_NOMINAL_TICKS) * TickMs;
+    run.DriftMs = ((f64) (frameStart - start - run.Dropped) / 1000000.0) - gameMs;
+    return run;
+}
+
+} // namespace
+
+/**
+ * Runs the fixed timestep against a mocked clock: steady, jittered and high refresh rate frames, hitches it
+ * catches up on and longer ones it drops, next to the old fixed two ticks per frame. Checks that the game
+ * clock never falls a tick behind, that the ticks stay evenly spaced, and that reading the controllers before
+ * each tick makes the input they run with newer.
+ */
+size_t Check_FrameTimer(void) {
+    size_t passed = 0;
+    size_t failed = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            printf("[FrameTimer] Failed: %s\n", what.c_str());
+        }
+    };
+    auto checkDrift = [&](const MockedRun& run, const char* name) {
+        check((run.DriftMs > -0.001) && (run.DriftMs < TickMs),
+              std::string(name) + ": game clock " + std::to_string(run.DriftMs) + " ms behind");
+    };
+
+    // The first frame has no previous one to measure from. The frame times are rounded up to whole nanoseconds.
+    FrameTickAccumulator first;
+    uint64_t now = 5 * NsPerSecond;
+    check(first.Advance(now) == FRAME_TIMER_NOMINAL_TICKS, "first frame did not run the nominal ticks");
+    check(first.Advance(now += 33333334) == 2, "frame at 30 fps did not run two ticks");
+    check(first.Advance(now += 16666667) == 1, "frame at 60 fps did not run one tick");
+    check(first.Advance(now += 10000000) == 0, "frame at 100 fps ran a tick");
+    check(first.Advance(now += 10000000) == 1, "time left over from the last frame was lost");
+
+    // Steady 30 fps, where 1/30 s is not a whole number of nanoseconds: the remainder carries over
+    MockedRun steady = RunMockedFrames(MakeFrames(36000, NsPerSecond / 30, 0, 0, 0), true, false);
+    checkDrift(steady, "steady 30 fps");
+    check(steady.MostTicks <= FRAME_TIMER_NOMINAL_TICKS, "steady 30 fps ran more than two ticks in a frame");
+    check(steady.Dropped == 0, "steady 30 fps dropped time");
+
+    // 144 Hz: most frames run no tick, and over ten minutes not one tick is lost
+    MockedRun fast = RunMockedFrames(MakeFrames(86400, NsPerSecond / 144, 0, 0, 0), true, false);
+    checkDrift(fast, "144 Hz");
+    check(fast.MostTicks == 1, "144 Hz ran " + std::to_string(fast.MostTicks) + " ticks in a frame");
+    check(fast.Ticks - FRAME_TIMER_NOMINAL_TICKS == 36000 - 1,
+          "144 Hz ran " + std::to_string(fast.Ticks) + " ticks in ten minutes");
+
+    // 30 fps +-6 ms with a 90 ms hitch every 10 s. The accumulator catches each hitch up in one frame.
+    std::vector<uint64_t> jittered = MakeFrames(1800, NsPerSecond / 30, 6000000, 300, 90000000);
+    MockedRun fixed = RunMockedFrames(jittered, false, false);
+    MockedRun perFrame = RunMockedFrames(jittered, true, false);
+    MockedRun perTick = RunMockedFrames(jittered, true, true);
+    checkDrift(perFrame, "jittered 30 fps");
+    check(perFrame.Dropped == 0, "a 90 ms hitch dropped time");
+    check(perFrame.TicksAfterHitch >= 5,
+          "frame after a 90 ms hitch ran only " + std::to_string(perFrame.TicksAfterHitch) + " ticks");
+    check(fixed.DriftMs > 5 * TickMs, "two ticks per frame kept up with hitches, " + std::to_string(fixed.DriftMs) +
+                                          " ms behind");
+    check(perFrame.Stats.JitterMs() < fixed.Stats.JitterMs(),
+          "tick jitter " + std::to_string(perFrame.Stats.JitterMs()) + " ms with the accumulator, " +
+              std::to_string(fixed.Stats.JitterMs()) + " ms with two ticks per frame");
+
+    // Reading the controllers again before each tick
+    check(perTick.Stats.AverageAgeMs() < perFrame.Stats.AverageAgeMs(), "reading input per tick made it older");
+    check(perTick.Stats.AgeMax <= PreTickWork + TickCost,
+          "input read per tick was " + std::to_string(perTick.Stats.AgeMax) + " ns old");
+
+    // A 250 ms hitch runs six ticks and drops the other nine instead of catching them up over the next frames.
+    // The last frame's hitch comes after it, so five of them are measured.
+    MockedRun hitched = RunMockedFrames(MakeFrames(1800, NsPerSecond / 30, 0, 300, 250000000), true, false);
+    checkDrift(hitched, "250 ms hitches");
+    check(hitched.MostTicks == FRAME_TIMER_MAX_TICKS,
+          "250 ms hitch ran " + std::to_string(hitched.MostTicks) + " ticks in a frame");
+    check(hitched.TicksAfterHitch == FRAME_TIMER_MAX_TICKS, "a 250 ms hitch was not capped");
+    check(hitched.Dropped == 5 * 150000000ULL,
+          "dropped " + std::to_string(hitched.Dropped) + " ns over five 250 ms hitches");
+    check(hitched.Stats.LongFrames == 5, std::to_string(hitched.Stats.LongFrames) + " frames ran extra ticks");
+
+    printf("[FrameTimer] Game clock behind by %.3f ms steady, %.3f ms at 144 Hz, %.3f ms jittered (%.1f ms with "
+           "two ticks per frame), tick jitter %.2f ms (%.2f ms), input age %.2f ms per tick (%.2f ms per frame): "
+           "%zu checks passed, %zu failed\n",
+           steady.DriftMs, fast.DriftMs, perFrame.DriftMs, fixed.DriftMs, perFrame.Stats.JitterMs(),
+           fixed.Stats.JitterMs(), perTick.Stats.AverageAgeMs(), perFrame.Stats.AverageAgeMs(), passed, failed);
+    return failed;
+}
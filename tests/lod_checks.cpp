@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "engine/Lod.h"
+#include "port/FrameSettings.h"
+#include "checks.h"
+
+#define LOD_WALK_STEPS 20000
+#define LOD_ROW_MESHES 200
+
+namespace {
+
+// Full detail and each declared level of the meshes in the triangle count case
+const u32 kTriangles[] = { 1200, 400, 120, 30 };
+
+struct Random {
+    uint32_t Seed = 0x6C078965;
+
+    // Uniform in [lo, hi)
+    f32 Range(f32 lo, f32 hi) {
+        Seed = Seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * ((Seed >> 8) / (f32) (1 << 24));
+    }
+};
+
+std::vector<LodLevel> MakeLevels() {
+    return { { "mesh_lod1", 100.0f }, { "mesh_lod2", 200.0f }, { "mesh_lod3", 400.0f } };
+}
+
+} // namespace
+
+/**
+ * Checks that detail levels only change once the camera is LOD_HYSTERESIS past a switch distance, that a
+ * camera hovering around one never makes a model flicker, that each viewport keeps its own level, and that
+ * the levels cut the triangles drawn along a row of meshes. Also round trips the levels through a scene
+ * file's "ModelLods".
+ */
+size_t Check_LodSelection(void) {
+    const std::vector<LodLevel> levels = MakeLevels();
+    size_t passed = 0;
+    size_t failed = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Lod] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+    // The level a camera at distance may be at, given where it came from: the hysteresis band around each switch
+    auto allowed = [&levels](size_t level, f32 distance) {
+        bool nearEnough = (level == levels.size()) || (distance <= levels[level].Distance * (1.0f + LOD_HYSTERESIS));
+        bool farEnough = (level == 0) || (distance >= levels[level - 1].Distance * (1.0f - LOD_HYSTERESIS));
+        return nearEnough && farEnough;
+    };
+
+    // Moving away one unit at a time switches just past each distance, and moving back just inside it
+    u8 current = 0;
+    std::vector<f32> switchesOut;
+    for (f32 distance = 0.0f; distance <= 600.0f; distance += 1.0f) {
+        u8 before = current;
+        Lod::SelectLevel(levels, current, distance);
+        if (current != before) {
+            switchesOut.push_back(distance);
+        }
+    }
+    check((switchesOut.size() == 3) && (switchesOut[0] == 111.0f) && (switchesOut[1] == 221.0f) &&
+              (switchesOut[2] == 441.0f),
+          "moving away did not switch at 111, 221 and 441");
+    std::vector<f32> switchesIn;
+    for (f32 distance = 600.0f; distance >= 0.0f; distance -= 1.0f) {
+        u8 before = current;
+        Lod::SelectLevel(levels, current, distance);
+        if (current != before) {
+            switchesIn.push_back(distance);
+        }
+    }
+    check((switchesIn.size() == 3) && (switchesIn[0] == 359.0f) && (switchesIn[1] == 179.0f) &&
+              (switchesIn[2] == 89.0f),
+          "moving back did not switch at 359, 179 and 89");
+
+    // A jump skips levels both ways
+    current = 0;
+    check(Lod::SelectLevel(levels, current, 5000.0f) == 3, "jumping far away did not drop to the lowest level");
+    check(Lod::SelectLevel(levels, current, 0.0f) == 0, "jumping close did not go back to full detail");
+
+    // A level left over from a model that declared more levels is brought back into range
+    current = 9;
+    check(Lod::SelectLevel(levels, current, 5000.0f) == 3, "a stale level was not clamped to the declared ones");
+
+    // Hovering within the band around a switch distance never changes the level
+    for (const LodLevel& level : levels) {
+        for (u8 start = 0; start <= levels.size(); start++) {
+            current = start;
+            if (!allowed(start, level.Distance)) {
+                continue;
+            }
+            size_t changes = 0;
+            Random random;
+            for (s32 i = 0; i < 200; i++) {
+                f32 distance = level.Distance * (1.0f + random.Range(-0.9f, 0.9f) * LOD_HYSTERESIS);
+                u8 before = current;
+                Lod::SelectLevel(levels, current, distance);
+                changes += (current != before);
+            }
+            check(changes == 0, std::to_string(changes) + " level changes hovering around " +
+                                    std::to_string(level.Distance) + " from level " + std::to_string(start));
+        }
+    }
+
+    // A camera wandering around never lands on a level outside the band, and switches far less than it
+    // crosses a switch distance
+    Random random;
+    current = 0;
+    f32 distance = 0.0f;
+    size_t crossings = 0;
+    size_t changes = 0;
+    size_t outside = 0;
+    for (s32 i = 0; i < LOD_WALK_STEPS; i++) {
+        f32 next = std::clamp(distance + random.Range(-12.0f, 12.0f), 0.0f, 600.0f);
+        for (const LodLevel& level : levels) {
+            crossings += ((distance < level.Distance) != (next < level.Distance));
+        }
+        distance = next;
+        u8 before = current;
+        Lod::SelectLevel(levels, current, distance);
+        changes += (current != before);
+        outside += !allowed(current, distance);
+    }
+    check(outside == 0, std::to_string(outside) + " random steps ended on a level outside its band");
+    check(changes * 2 < crossings, std::to_string(changes) + " level changes for " + std::to_string(crossings) +
+                                       " switch distance crossings");
+
+    // Declared levels are sorted, and declaring none forgets the model
+    std::vector<LodLevel> unsorted = { { "b", 300.0f }, { "a", 50.0f }, { "c", 900.0f } };
+    Lod::Declare("models/sorted", unsorted);
+    const std::vector<LodLevel>* sorted = Lod::GetLevels("models/sorted");
+    check((sorted != nullptr) && (sorted->size() == 3) && ((*sorted)[0].Model == "a") && ((*sorted)[2].Model == "c"),
+          "declared levels were not sorted by distance");
+    Lod::Declare("models/sorted", {});
+    check(Lod::GetLevels("models/sorted") == nullptr, "declaring no levels kept the old ones");
+
+    // Each viewport keeps its own level. Without a camera, or with gDisableLod, the full model is drawn.
+    const std::string model = "tracks/test/mesh";
+    Lod::Declare(model, levels);
+    LodState state;
+    FVector pos = FVector(0.0f, 0.0f, 0.0f);
+    Vec3f up = { 0.0f, 1.0f, 0.0f };
+    Vec3f lookAt = { 0.0f, 0.0f, 0.0f };
+    Vec3f nearCamera = { 0.0f, 0.0f, 50.0f };
+    Vec3f farCamera = { 0.0f, 0.0f, 300.0f };
+    Frustum_SetCamera(0, nearCamera, lookAt, up, 40.0f, 4.0f / 3.0f, 9.0f, 4500.0f);
+    check(Lod::Select(model, state, pos) == model, "close camera did not draw full detail");
+    Frustum_SetCamera(1, farCamera, lookAt, up, 40.0f, 4.0f / 3.0f, 9.0f, 4500.0f);
+    check(Lod::Select(model, state, pos) == "mesh_lod2", "far camera did not draw the second level");
+    check((state.Level[0] == 0) && (state.Level[1] == 2), "viewports did not keep their own levels");
+    gFrameSettings.DisableLod = 1;
+    check(Lod::Select(model, state, pos) == model, "gDisableLod did not draw full detail");
+    gFrameSettings.DisableLod = 0;
+    Frustum_ClearCamera();
+    check(Lod::Select(model, state, pos) == model, "no camera did not draw full detail");
+
+    // A row of meshes seen from a camera driving along it
+    u64 fullTotal = 0;
+    u64 lodTotal = 0;
+    std::vector<LodState> states(LOD_ROW_MESHES);
+    for (f32 cameraZ = 0.0f; cameraZ < LOD_ROW_MESHES * 20.0f; cameraZ += 5.0f) {
+        for (size_t i = 0; i < LOD_ROW_MESHES; i++) {
+            f32 meshDistance = std::hypot(30.0f, i * 20.0f - cameraZ);
+            size_t level = Lod::SelectLevel(levels, states[i].Level[0], meshDistance);
+            fullTotal += kTriangles[0];
+            lodTotal += kTriangles[level];
+        }
+    }
+    check(lodTotal * 4 < fullTotal, "detail levels drew " + std::to_string(lodTotal) + " triangles against " +
+                                        std::to_string(fullTotal) + " at full detail");
+
+    // Saving writes only the track's own models, and loading reads them back
+    Lod::Declare("tracks/other/mesh", levels);
+    nlohmann::json saved = Lod::to_json("tracks/test/");
+    check(saved.contains(model) && !saved.contains("tracks/other/mesh"), "saved models outside the track");
+    Lod::Declare(model, {});
+    Lod::from_json(saved);
+    const std::vector<LodLevel>* loaded = Lod::GetLevels(model);
+    bool same = (loaded != nullptr) && (loaded->size() == levels.size());
+    for (size_t i = 0; same && (i < levels.size()); i++) {
+        same = ((*loaded)[i].Model == levels[i].Model) && ((*loaded)[i].Distance == levels[i].Distance);
+    }
+    check(same, "levels did not round trip through the scene file");
+    Lod::Declare(model, {});
+    Lod::Declare("tracks/other/mesh", {});
+
+    printf("[Lod] %zu level changes for %zu switch distance crossings on a random walk. A row of %d meshes drew %.1f%% "
+           "of its triangles with detail levels: %zu checks passed, %zu failed\n",
+           changes, crossings, LOD_ROW_MESHES, 100.0 * lodTotal / fullTotal, passed, failed);
+    return failed;
+}
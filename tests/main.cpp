@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "checks.h"
+
+namespace {
+
+struct Check {
+    const char* Name;
+    size_t (*Run)(void);
+};
+
+const std::vector<Check> kChecks = {
+    { "collision_batch", Check_CollisionBatch },
+    { "collision_grid", Check_CollisionGrid },
+    { "path_index", Check_PathIndex },
+    { "memory_pool", Check_MemoryPool },
+    { "racer_ranking", Check_RacerRanking },
+    { "entity_handles", Check_EntityHandles },
+    { "frame_timer", Check_FrameTimer },
+    { "section_culling", Check_SectionCulling },
+    { "lod_selection", Check_LodSelection },
+    { "viewport_sections", Check_ViewportSections },
+    { "text_batch", Check_TextBatch },
+    { "picking_tree", Check_PickingTree },
+    { "pak_torn_write", Check_PakTornWrite },
+    { "scene_round_trip", Check_SceneRoundTrip },
+    { "scene_autosave", Check_SceneAutosave },
+};
+
+size_t RunCheck(const Check& check) {
+    size_t failures = check.Run();
+    printf("[Checks] %s: %zu failures\n", check.Name, failures);
+    return failures;
+}
+
+} // namespace
+
+// Runs the checks named on the command line, or all of them. Exits with 1 if any comparison failed.
+int main(int argc, char** argv) {
+    size_t failures = 0;
+
+    if (argc < 2) {
+        for (const Check& check : kChecks) {
+            failures += RunCheck(check);
+        }
+        return (failures == 0) ? 0 : 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const Check* found = nullptr;
+        for (const Check& check : kChecks) {
+            if (strcmp(check.Name, argv[i]) == 0) {
+                found = &check;
+            }
+        }
+        if (found == nullptr) {
+            printf("[Checks] There is no check named %s\n", argv[i]);
+            return 2;
+        }
+        failures += RunCheck(*found);
+    }
+    return (failures == 0) ? 0 : 1;
+}
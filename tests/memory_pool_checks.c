@@ -0,0 +1,221 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <defines.h>
+#include <stdio.h>
+#include <string.h>
+#include "code_800029B0.h"
+#include "racing/memory.h"
+#include "port/VirtualMemory.h"
+#include "checks.h"
+
+#define POOL_PASSES 2
+#define POOL_RACES 3
+// Allocations each tag of a course is split into, alternating between the two allocators
+#define POOL_CHUNKS 4
+// What setup loads before the first course, below gFreeMemoryResetAnchor
+#define POOL_STARTUP_SIZE 0x100000
+// Tolerance for the rest of the process, as in RunCourseMemoryTest
+#define POOL_PROCESS_SLACK (4 * 1024 * 1024)
+
+// How much of each tag a course loads, in bytes
+typedef struct {
+    const char* name;
+    size_t sizes[MEMORY_TAG_COUNT];
+} TestCourse;
+
+// Stock sized courses around a custom one over a hundred times their size, so unloading it has to show
+static const TestCourse sCourses[] = {
+    { "Small", { 0, 0x30000, 0x40000, 0x52340, 0x8000, 0, 0 } },
+    { "Stock", { 0x1000, 0xA3F10, 0x61200, 0x9C000, 0xC400, 0, 0 } },
+    { "Custom", { 0x4000, 48 * 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024, 1024 * 1024, 0, 0 } },
+    { "Small again", { 0, 0x30000, 0x40000, 0x52340, 0x8000, 0, 0 } },
+};
+#define POOL_COURSES ARRAY_COUNT(sCourses)
+
+// What a race allocates on top of the course
+static const size_t sRaceSizes[MEMORY_TAG_COUNT] = { 0x20000, 0, 0, 0, 0, 0xE100, 0x1000 };
+
+// Where a course or a race put its chunks
+typedef struct {
+    u8* chunks[MEMORY_TAG_COUNT][POOL_CHUNKS];
+    size_t sizes[MEMORY_TAG_COUNT][POOL_CHUNKS];
+} TestLoad;
+
+// The course loaded last, to check it survives its races and is gone once it is unloaded
+static TestLoad sCourseLoad;
+
+// Allocates sizes[tag] of each tag into load and fills it with fill
+static void allocate_tags(TestLoad* load, const size_t* sizes, u8 fill) {
+    for (s32 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        for (s32 i = 0; i < POOL_CHUNKS; i++) {
+            size_t size = sizes[tag] / POOL_CHUNKS + ((i == 0) ? sizes[tag] % POOL_CHUNKS : 0);
+            u8* chunk = (i % 2) ? get_next_available_memory_addr(size, tag) : allocate_memory(size, tag);
+
+            memset(chunk, fill, size);
+            load->chunks[tag][i] = chunk;
+            load->sizes[tag][i] = size;
+        }
+    }
+}
+
+// Counts the chunks whose first or last byte no longer holds fill
+static size_t count_changed_chunks(const TestLoad* load, u8 fill) {
+    size_t changed = 0;
+
+    for (s32 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        for (s32 i = 0; i < POOL_CHUNKS; i++) {
+            size_t size = load->sizes[tag][i];
+            if ((size > 0) && ((load->chunks[tag][i][0] != fill) || (load->chunks[tag][i][size - 1] != fill))) {
+                changed++;
+            }
+        }
+    }
+    return changed;
+}
+
+// Bytes the allocators take for sizes[tag], split into chunks
+static size_t get_aligned_size(const size_t* sizes, s32 tag) {
+    size_t total = 0;
+
+    for (s32 i = 0; i < POOL_CHUNKS; i++) {
+        total += ALIGN16(sizes[tag] / POOL_CHUNKS + ((i == 0) ? sizes[tag] % POOL_CHUNKS : 0));
+    }
+    return total;
+}
+
+/**
+ * Loads synthetic courses back to back twice through the real pool, with a few races on each, the way the game
+ * scopes its loads. Checks that a course survives its races, that unloading it gives its pages back, that the
+ * second pass takes no more memory than the first, and that the peaks are counted under the right tags.
+ */
+size_t Check_MemoryPool(void) {
+    size_t failures = 0;
+    size_t poolResident[POOL_PASSES][POOL_COURSES];
+    size_t processResident[POOL_PASSES][POOL_COURSES];
+    size_t expectedTagPeaks[MEMORY_TAG_COUNT] = { 0 };
+    size_t expectedCoursePeak = 0;
+    size_t expectedRacePeak = 0;
+    size_t custom = 0;
+    size_t customSize = 0;
+    size_t changed;
+    size_t i;
+    s32 tag;
+
+    initialize_memory_pool();
+    allocate_memory(POOL_STARTUP_SIZE, MEMORY_TAG_OTHER);
+    gFreeMemoryResetAnchor = gNextFreeMemoryAddress;
+
+    for (tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        expectedRacePeak += get_aligned_size(sRaceSizes, tag);
+    }
+    for (i = 0; i < POOL_COURSES; i++) {
+        if (sCourses[i].sizes[MEMORY_TAG_GEOMETRY] > sCourses[custom].sizes[MEMORY_TAG_GEOMETRY]) {
+            custom = i;
+        }
+    }
+    for (tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        customSize += get_aligned_size(sCourses[custom].sizes, tag);
+    }
+
+    for (s32 pass = 0; pass < POOL_PASSES; pass++) {
+        for (i = 0; i < POOL_COURSES; i++) {
+            const TestCourse* course = &sCourses[i];
+            u8 fill = (u8) (0x10 + i);
+            size_t courseSize = 0;
+
+            memory_pool_begin_course();
+            // The anchor is on a page boundary, so all of the course before it reads back as zero
+            changed = count_changed_chunks(&sCourseLoad, 0);
+            if (changed != 0) {
+                printf("[Pool] %zu chunks kept their data when %s was loaded\n", changed, course->name);
+                failures++;
+            }
+            allocate_tags(&sCourseLoad, course->sizes, fill);
+            memory_pool_end_course();
+
+            for (tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+                size_t size = get_aligned_size(course->sizes, tag);
+                // Setup's allocation is still in use under its tag
+                size_t inUse = size + ((tag == MEMORY_TAG_OTHER) ? POOL_STARTUP_SIZE : 0);
+                if (memory_pool_get_tag_size(tag) != inUse) {
+                    printf("[Pool] %s counted 0x%zX bytes under tag %d, not 0x%zX\n", course->name,
+                           memory_pool_get_tag_size(tag), tag, inUse);
+                    failures++;
+                }
+                expectedTagPeaks[tag] = MAX(expectedTagPeaks[tag], size);
+                courseSize += size;
+            }
+            expectedCoursePeak = MAX(expectedCoursePeak, courseSize);
+
+            // Each race frees the one before it, and leaves the course alone
+            for (s32 race = 0; race < POOL_RACES; race++) {
+                TestLoad raceLoad;
+
+                memory_pool_begin_race();
+                if ((gNextFreeMemoryAddress != gFreeMemoryCourseAnchor) ||
+                    (memory_pool_get_tag_size(MEMORY_TAG_ACTORS) != 0)) {
+                    printf("[Pool] Race %d on %s did not start where the course ends\n", race, course->name);
+                    failures++;
+                }
+                allocate_tags(&raceLoad, sRaceSizes, 0xEE);
+            }
+            memory_pool_begin_race();
+            changed = count_changed_chunks(&sCourseLoad, fill);
+            if (changed != 0) {
+                printf("[Pool] %zu chunks of %s changed during its races\n", changed, course->name);
+                failures++;
+            }
+
+            poolResident[pass][i] = memory_pool_get_resident_size();
+            processResident[pass][i] = VirtualMemory_GetResidentSize();
+        }
+    }
+
+    for (i = 0; i < POOL_COURSES; i++) {
+        if (poolResident[1][i] > poolResident[0][i]) {
+            printf("[Pool] %s grew from 0x%zX to 0x%zX bytes of the pool on the second load\n", sCourses[i].name,
+                   poolResident[0][i], poolResident[1][i]);
+            failures++;
+        }
+        // Zero where the platform can't tell
+        if (processResident[1][i] > processResident[0][i] + POOL_PROCESS_SLACK) {
+            printf("[Pool] The process grew from 0x%zX to 0x%zX bytes on the second load of %s\n",
+                   processResident[0][i], processResident[1][i], sCourses[i].name);
+            failures++;
+        }
+    }
+    // Unloading the custom course gives most of it back to the OS
+    if ((processResident[1][custom] != 0) &&
+        (processResident[1][custom + 1] + customSize > processResident[1][custom] + POOL_PROCESS_SLACK)) {
+        printf("[Pool] The process only went from 0x%zX to 0x%zX bytes after unloading %s\n",
+               processResident[1][custom], processResident[1][custom + 1], sCourses[custom].name);
+        failures++;
+    }
+
+    for (tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        size_t expected = MAX(expectedTagPeaks[tag], get_aligned_size(sRaceSizes, tag));
+        if (tag == MEMORY_TAG_OTHER) {
+            // Setup, the course and a race all allocate under it at once
+            expected = POOL_STARTUP_SIZE + expectedTagPeaks[tag] + get_aligned_size(sRaceSizes, tag);
+        }
+        if (memory_pool_get_tag_peak(tag) != expected) {
+            printf("[Pool] Tag %d peaked at 0x%zX bytes, not 0x%zX\n", tag, memory_pool_get_tag_peak(tag), expected);
+            failures++;
+        }
+    }
+    if ((memory_pool_get_peak(MEMORY_SCOPE_COURSE) != expectedCoursePeak) ||
+        (memory_pool_get_peak(MEMORY_SCOPE_RACE) != expectedRacePeak) ||
+        (memory_pool_get_peak(MEMORY_SCOPE_STARTUP) != POOL_STARTUP_SIZE)) {
+        printf("[Pool] Scope peaks are 0x%zX, 0x%zX and 0x%zX bytes, not 0x%X, 0x%zX and 0x%zX\n",
+               memory_pool_get_peak(MEMORY_SCOPE_STARTUP), memory_pool_get_peak(MEMORY_SCOPE_COURSE),
+               memory_pool_get_peak(MEMORY_SCOPE_RACE), POOL_STARTUP_SIZE, expectedCoursePeak, expectedRacePeak);
+        failures++;
+    }
+
+    memory_pool_print_usage();
+    printf("[Pool] %zu courses loaded %d times with %d races each. Process resident after %s: 0x%zX bytes, after "
+           "unloading it: 0x%zX bytes. %zu failures\n",
+           POOL_COURSES, POOL_PASSES, POOL_RACES, sCourses[custom].name, processResident[1][custom],
+           processResident[1][custom + 1], failures);
+    return failures;
+}
@@ -0,0 +1,132 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "port/PakStore.h"
+#include "checks.h"
+
+/**
+ * Saves to a pak in a temporary directory, cuts its journal and image short in every way a crash could, and
+ * checks that each reload comes back to the last complete change.
+ */
+size_t Check_PakTornWrite(void) {
+    std::error_code error;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(error) / "spaghetti_pak_check";
+    std::filesystem::remove_all(dir, error);
+    std::filesystem::create_directories(dir, error);
+    std::string imagePath = (dir / "controllerPak.sav").string();
+    std::string journalPath = (dir / "controllerPak.journal").string();
+    size_t passed = 0;
+    size_t failed = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            printf("[Pak] Failed: %s\n", what.c_str());
+        }
+    };
+
+    // A ghost save: an entry, then writes to its data. The last write is the one the crashes cut short.
+    PakEntry entry;
+    entry.FileSize = 0x3C00;
+    entry.GameCode = 0x4E4B5445;
+    entry.CompanyCode = 0x3031;
+    memcpy(entry.GameName, "MARIOKART64", 11);
+    std::vector<u8> first(0x100, 0xA5);
+    std::vector<u8> last(0x200);
+    for (size_t i = 0; i < last.size(); i++) {
+        last[i] = (u8) (i * 7);
+    }
+
+    PakImage beforeLast;
+    PakImage afterLast;
+    std::vector<u8> savedImage;
+    std::vector<u8> journal;
+    size_t lastRecordSize;
+    {
+        PakStore pak(imagePath, journalPath);
+        pak.Load(false);
+        pak.SetEntry(3, entry, 0x3C00);
+        pak.Write(3, 0x40, first.data(), first.size());
+        // Fold these into the image, so the journal replays on top of one
+        pak.Import(pak.GetImage());
+        pak.Write(3, 0x1000, first.data(), first.size());
+        pak.Flush();
+        beforeLast = pak.GetImage();
+        pak.Write(3, 0x2000, last.data(), last.size());
+        pak.Flush();
+        afterLast = pak.GetImage();
+        pak.Close();
+
+        savedImage = ReadWholeFile(imagePath);
+        journal = ReadWholeFile(journalPath);
+        lastRecordSize = EncodeRecord(RECORD_WRITE, 3, 0x2000, last.data(), last.size()).size();
+    }
+    check(journal.size() >= lastRecordSize, "journal holds the last write");
+    if (journal.size() < lastRecordSize) {
+        std::filesystem::remove_all(dir, error);
+        return failed;
+    }
+
+    auto reload = [&](const std::vector<u8>& image, const std::vector<u8>& cutJournal, PakImage& loaded) {
+        WriteWholeFile(imagePath, image);
+        WriteWholeFile(journalPath, cutJournal);
+        PakStore pak(imagePath, journalPath);
+        bool valid = pak.Load(false);
+        loaded = pak.GetImage();
+        pak.Close();
+        return valid;
+    };
+
+    // A crash anywhere in the append leaves the change out, and nothing before it
+    for (size_t cut = journal.size() - lastRecordSize; cut < journal.size(); cut++) {
+        PakImage loaded;
+        reload(savedImage, std::vector<u8>(journal.begin(), journal.begin() + cut), loaded);
+        check(loaded == beforeLast, "journal cut at " + std::to_string(cut) + " of " +
+                                        std::to_string(journal.size()) + " bytes");
+    }
+    {
+        PakImage loaded;
+        reload(savedImage, journal, loaded);
+        check(loaded == afterLast, "complete journal");
+    }
+    // A record whose bytes made it to disk out of order fails its checksum
+    for (size_t at = journal.size() - lastRecordSize; at < journal.size(); at += 37) {
+        std::vector<u8> corrupt = journal;
+        corrupt[at] ^= 0x10;
+        PakImage loaded;
+        reload(savedImage, corrupt, loaded);
+        check(loaded == beforeLast, "journal byte " + std::to_string(at) + " flipped");
+    }
+    // A crash while writing a snapshot leaves its temporary file behind and the old image in place
+    {
+        std::vector<u8> partial = EncodeImage(afterLast);
+        partial.resize(partial.size() / 2);
+        WriteWholeFile(imagePath + ".tmp", partial);
+        PakImage loaded;
+        check(reload(savedImage, journal, loaded) && (loaded == afterLast), "torn snapshot file ignored");
+        std::filesystem::remove(imagePath + ".tmp", error);
+    }
+    // An image that is not the one written is refused rather than read
+    {
+        std::vector<u8> corrupt = savedImage;
+        corrupt[corrupt.size() / 2] ^= 0x01;
+        PakImage loaded;
+        check(!reload(corrupt, {}, loaded), "corrupt image detected");
+    }
+    // Replaying records the image already holds changes nothing
+    {
+        PakStore pak(imagePath, journalPath);
+        WriteWholeFile(imagePath, EncodeImage(afterLast));
+        WriteWholeFile(journalPath, journal);
+        pak.Load(false);
+        check(pak.GetImage() == afterLast, "replay over an image that holds it");
+        pak.Close();
+    }
+
+    std::filesystem::remove_all(dir, error);
+    printf("[Pak] Torn write: %zu checks passed, %zu failed\n", passed, failed);
+    return failed;
+}
@@ -0,0 +1,196 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <common_structs.h>
+#include <defines.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "code_800029B0.h"
+#include "code_80005FD0.h"
+#include "path_spatial_index.h"
+#include "checks.h"
+
+// Holds the indexes, like the memory pool does in the game
+#define ARENA_SIZE (1024 * 1024)
+
+#define PATH_QUERIES 20000
+#define PODIUM_QUERIES 2000
+
+static u8* sArena = NULL;
+// memory_pool.c, the end the allocators check against. The checks point it at the end of their arena.
+extern uintptr_t sPoolEnd;
+static u32 sSeed = 0;
+static TrackPathPoint sPaths[4][1200];
+
+static u32 next_random(void) {
+    sSeed = sSeed * 1664525 + 1013904223;
+    return sSeed >> 8;
+}
+
+// Uniform in [lo, hi]
+static s32 random_range(s32 lo, s32 hi) {
+    return lo + (s32) (next_random() % (u32) (hi - lo + 1));
+}
+
+/**
+ * Lays numPoints points around an oval in sections of 40, like a racing line.
+ * Every 50th point repeats the one before it, so some lookups tie on distance.
+ */
+static void build_test_path(s32 pathIndex, s32 numPoints, s32 radiusX, s32 radiusZ, s32 offset) {
+    TrackPathPoint* path = sPaths[pathIndex];
+    s32 i;
+
+    for (i = 0; i < numPoints; i++) {
+        f32 angle = (6.2831855f * i) / numPoints;
+
+        if ((i % 50) == 49) {
+            path[i] = path[i - 1];
+            continue;
+        }
+        path[i].posX = (s16) (radiusX * cosf(angle)) + offset;
+        path[i].posY = (s16) (120.0f * sinf(angle * 3.0f));
+        path[i].posZ = (s16) (radiusZ * sinf(angle)) + offset;
+        path[i].trackSectionId = i / 40;
+    }
+    gTrackPaths[pathIndex] = path;
+    gPathCountByPathIndex[pathIndex] = numPoints;
+    D_80163368[pathIndex] = 2;
+}
+
+/**
+ * Four paths the way a course loads them: path 1 names some sections no other path has and lacks the ones
+ * around them, path 2 shares points with path 0, and path 3 is loaded but unused.
+ */
+static void build_test_paths(void) {
+    s32 i;
+
+    build_test_path(0, 1200, 3000, 2000, 0);
+    build_test_path(1, 900, 2600, 1700, 150);
+    for (i = 400; i < 600; i++) {
+        sPaths[1][i].trackSectionId += 200;
+    }
+    build_test_path(2, 1200, 3000, 2000, 0);
+    for (i = 0; i < 1200; i += 3) {
+        sPaths[2][i].posX += 40;
+    }
+    build_test_path(3, 300, 1000, 1000, 500);
+    D_80163368[3] = 1;
+}
+
+/**
+ * Compares the indexed search against the linear one for positions near and around the paths, sections that
+ * exist on the query's path, on other paths or nowhere, and every path a racer may be on.
+ * @return Number of queries where the two disagree
+ */
+static size_t compare_with_linear_search(s32 numQueries) {
+    s32 minX = 0x7FFF, maxX = -0x8000, minY = 0x7FFF, maxY = -0x8000, minZ = 0x7FFF, maxZ = -0x8000;
+    size_t mismatches = 0;
+    s32 i;
+
+    for (i = 0; i < gPathCountByPathIndex[0]; i++) {
+        TrackPathPoint* point = &gTrackPaths[0][i];
+        minX = MIN(minX, point->posX);
+        maxX = MAX(maxX, point->posX);
+        minY = MIN(minY, point->posY);
+        maxY = MAX(maxY, point->posY);
+        minZ = MIN(minZ, point->posZ);
+        maxZ = MAX(maxZ, point->posZ);
+    }
+
+    for (i = 0; i < numQueries; i++) {
+        TrackPathPoint* point;
+        f32 pos[3];
+        s32 pathA;
+        s32 pathB;
+        s16 resultA;
+        s16 resultB;
+        u16 sectionId;
+
+        do {
+            pathA = random_range(0, 3);
+        } while (D_80163368[pathA] < 2);
+        pathB = pathA;
+
+        // Half of the queries sit near a path like a racer would, the rest cover the paths plus a margin so the
+        // far fallbacks get exercised too. Some land exactly on a point.
+        point = &gTrackPaths[pathA][random_range(0, gPathCountByPathIndex[pathA] - 1)];
+        switch (random_range(0, 7)) {
+            case 0:
+                pos[0] = point->posX;
+                pos[1] = point->posY;
+                pos[2] = point->posZ;
+                break;
+            case 1:
+            case 2:
+            case 3:
+                pos[0] = point->posX + random_range(-100, 100) + random_range(0, 15) / 16.0f;
+                pos[1] = point->posY + random_range(-100, 100) + random_range(0, 15) / 16.0f;
+                pos[2] = point->posZ + random_range(-100, 100) + random_range(0, 15) / 16.0f;
+                break;
+            default:
+                pos[0] = random_range(minX - 1500, maxX + 1500) + random_range(0, 15) / 16.0f;
+                pos[1] = random_range(minY - 1500, maxY + 1500) + random_range(0, 15) / 16.0f;
+                pos[2] = random_range(minZ - 1500, maxZ + 1500) + random_range(0, 15) / 16.0f;
+                break;
+        }
+
+        if (random_range(0, 15) == 0) {
+            sectionId = random_range(0, 0xFFFF); // Usually a section that doesn't exist
+        } else {
+            s32 sectionPath = random_range(0, 3);
+            sectionId = gTrackPaths[sectionPath][random_range(0, gPathCountByPathIndex[sectionPath] - 1)]
+                            .trackSectionId;
+        }
+
+        resultA = find_closest_path_point_track_section_indexed(pos[0], pos[1], pos[2], sectionId, &pathA);
+        resultB = find_closest_path_point_track_section_linear(pos[0], pos[1], pos[2], sectionId, &pathB);
+        if ((resultA != resultB) || (pathA != pathB)) {
+            if (mismatches < 8) {
+                printf("[Path] Mismatch at (%.2f, %.2f, %.2f) section %d: %d on path %d, linear %d on path %d\n",
+                       pos[0], pos[1], pos[2], sectionId, resultA, pathA, resultB, pathB);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * Checks that find_closest_path_point_track_section_indexed finds the same point on the same path as the linear
+ * search it replaces, during a race and during the podium ceremony, and that it steps aside once the paths
+ * change under it.
+ */
+size_t Check_PathIndex(void) {
+    size_t failures = 0;
+    size_t mismatches;
+    s32 pathIndex = 1;
+
+    if (sArena == NULL) {
+        sArena = malloc(ARENA_SIZE);
+    }
+    sSeed = 0x2545F491;
+    gNextFreeMemoryAddress = ALIGN16((uintptr_t) sArena);
+    sPoolEnd = (uintptr_t) sArena + ARENA_SIZE;
+    build_test_paths();
+    generate_path_spatial_index();
+
+    mismatches = compare_with_linear_search(PATH_QUERIES);
+    printf("[Path] %d queries during a race, %zu mismatches\n", PATH_QUERIES, mismatches);
+    failures += mismatches;
+
+    gStubPodiumCeremony = true;
+    mismatches = compare_with_linear_search(PODIUM_QUERIES);
+    gStubPodiumCeremony = false;
+    printf("[Path] %d queries during the podium ceremony, %zu mismatches\n", PODIUM_QUERIES, mismatches);
+    failures += mismatches;
+
+    // Paths swapped in without a new index must be left to the linear search
+    gTrackPaths[1] = sPaths[2];
+    if (find_closest_path_point_track_section_indexed(0.0f, 0.0f, 0.0f, 0, &pathIndex) != -1) {
+        printf("[Path] The index answered for a path it was not built for\n");
+        failures++;
+    }
+    gTrackPaths[1] = sPaths[1];
+    return failures;
+}
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "engine/editor/PickingBvh.h"
+#include "checks.h"
+
+#define PICKING_SCENES 8
+#define PICKING_STEPS 40
+#define PICKING_RAYS_PER_STEP 50
+#define PICKING_TIMED_RAYS 100
+
+using namespace Editor;
+
+namespace {
+
+// Objects over a few shared random models, which own everything the objects point to
+struct PickingScene {
+    std::vector<std::shared_ptr<const std::vector<Triangle>>> Models;
+    std::deque<FVector> Positions;
+    std::vector<std::unique_ptr<GameObject>> Owned;
+    std::vector<GameObject*> Objects;
+};
+
+float Random(std::mt19937& rng, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+}
+
+FVector RandomPoint(std::mt19937& rng, float extent) {
+    return FVector(Random(rng, -extent, extent), Random(rng, -extent, extent), Random(rng, -extent, extent));
+}
+
+void AddModel(PickingScene& scene, std::mt19937& rng, size_t triangles) {
+    std::vector<Triangle> model;
+
+    for (size_t i = 0; i < triangles; i++) {
+        FVector base = RandomPoint(rng, 150.0f);
+        if ((i % 5) == 0) {
+            // Flat on an axis, like floors and walls, so some bounds have no depth
+            float size = Random(rng, 5.0f, 40.0f);
+            model.push_back({ base, base + FVector(size, 0, 0), base + FVector(0, 0, size) });
+        } else {
+            model.push_back({ base, base + RandomPoint(rng, 30.0f), base + RandomPoint(rng, 30.0f) });
+        }
+    }
+    scene.Models.push_back(std::make_shared<const std::vector<Triangle>>(std::move(model)));
+}
+
+void AddObject(PickingScene& scene, std::mt19937& rng, float extent) {
+    FVector* pos = &scene.Positions.emplace_back(RandomPoint(rng, extent));
+    size_t kind = rng() % 20;
+    size_t model = rng() % scene.Models.size();
+    GameObject* object;
+
+    if (kind < 14) {
+        object = new GameObject("mesh", pos, nullptr, nullptr, nullptr, scene.Models[model],
+                                GameObject::CollisionType::VTX_INTERSECT, 0.0f, nullptr, 0);
+    } else if (kind < 18) {
+        float size = (kind == 14) ? 0.0f : Random(rng, 1.0f, 30.0f);
+        object = new GameObject("box", pos, nullptr, nullptr, nullptr, {}, GameObject::CollisionType::BOUNDING_BOX,
+                                size, nullptr, 0);
+    } else if (kind == 18) {
+        object = new GameObject("sphere", pos, nullptr, nullptr, nullptr, {},
+                                GameObject::CollisionType::BOUNDING_SPHERE, 10.0f, nullptr, 0);
+    } else {
+        object = new GameObject("empty", pos, nullptr, nullptr, nullptr, {},
+                                GameObject::CollisionType::VTX_INTERSECT, 0.0f, nullptr, 0);
+    }
+    scene.Owned.emplace_back(object);
+    scene.Objects.push_back(object);
+}
+
+Ray RandomRay(PickingScene& scene, std::mt19937& rng, FVector origin) {
+    Ray ray;
+    ray.Origin = origin;
+
+    switch (rng() % 8) {
+        case 0: {
+            // Straight along an axis
+            FVector dir = FVector(0, 0, 0);
+            (&dir.x)[rng() % 3] = (rng() % 2) ? 1.0f : -1.0f;
+            ray.Direction = dir;
+            break;
+        }
+        case 1:
+            ray.Direction = RandomPoint(rng, 1.0f).Normalize();
+            break;
+        default: {
+            // At an object, which most of the time hits something
+            const GameObject* target = scene.Objects[rng() % scene.Objects.size()];
+            if (target->Pos == nullptr) {
+                ray.Direction = RandomPoint(rng, 1.0f).Normalize();
+                break;
+            }
+            ray.Direction = ((*target->Pos + RandomPoint(rng, 100.0f)) - origin).Normalize();
+            break;
+        }
+    }
+    return ray;
+}
+
+PickingScene MakeScene(std::mt19937& rng, size_t models, size_t triangles, size_t objects, float extent) {
+    PickingScene scene;
+
+    for (size_t i = 0; i < models; i++) {
+        AddModel(scene, rng, 1 + rng() % triangles);
+    }
+    for (size_t i = 0; i < objects; i++) {
+        AddObject(scene, rng, extent);
+    }
+    return scene;
+}
+
+template <typename Fn> double TimeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * Picks through the trees and by brute force on random scenes, changed between picks the way the editor changes
+ * them by dragging, spawning, despawning and stacking objects, and checks that both pick the same object. Then
+ * compares them on a large custom track's worth of props and prints how long each took.
+ */
+size_t Check_PickingTree(void) {
+    std::mt19937 rng(64);
+    size_t passed = 0;
+    size_t failed = 0;
+    size_t picks = 0;
+    size_t hits = 0;
+    size_t rebuilds = 0;
+    size_t refits = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Picking] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+
+    for (size_t i = 0; i < PICKING_SCENES; i++) {
+        PickingScene scene = MakeScene(rng, 6, 300, 200, 2000.0f);
+        PickingTree tree;
+
+        for (size_t step = 0; step < PICKING_STEPS; step++) {
+            for (size_t j = 0; j < PICKING_RAYS_PER_STEP; j++) {
+                Ray ray = RandomRay(scene, rng, RandomPoint(rng, 3000.0f));
+                GameObject* expected = FindObjectBruteForce(ray, scene.Objects);
+                GameObject* picked = tree.FindObject(ray, scene.Objects);
+
+                picks++;
+                hits += (expected != nullptr);
+                check(picked == expected, std::string("scene ") + std::to_string(i) + " step " +
+                                              std::to_string(step) + ": trees picked " +
+                                              (picked ? picked->Name : "nothing") + ", brute force picked " +
+                                              (expected ? expected->Name : "nothing"));
+            }
+
+            // Drag a few objects around, and sometimes one far away
+            for (size_t j = 0; j < 1 + rng() % 8; j++) {
+                FVector* pos = scene.Objects[rng() % scene.Objects.size()]->Pos;
+                *pos = *pos + RandomPoint(rng, ((step % 10) == 9) ? 3000.0f : 50.0f);
+            }
+            // Objects despawn and spawn
+            if ((step % 5) == 4) {
+                scene.Objects.erase(scene.Objects.begin() + (rng() % scene.Objects.size()));
+                AddObject(scene, rng, 2000.0f);
+            }
+            // Stacked objects tie on distance, and the first one has to win
+            if ((step % 7) == 6) {
+                GameObject* copy = scene.Objects[rng() % scene.Objects.size()];
+                scene.Owned.emplace_back(new GameObject(*copy));
+                scene.Objects.insert(scene.Objects.begin() + (rng() % scene.Objects.size()), scene.Owned.back().get());
+            }
+        }
+        rebuilds += tree.GetRebuildCount();
+        refits += tree.GetRefitCount();
+    }
+    check(hits * 4 > picks, "only " + std::to_string(hits) + " of " + std::to_string(picks) + " picks hit anything");
+    // Dragging refits the tree, and spawning or a far drag rebuilds it
+    check(refits > rebuilds, std::to_string(refits) + " refits for " + std::to_string(rebuilds) + " rebuilds");
+
+    // A large custom track's worth of props
+    PickingScene large = MakeScene(rng, 30, 2000, 1000, 8000.0f);
+    std::vector<Ray> rays;
+    for (size_t i = 0; i < PICKING_TIMED_RAYS; i++) {
+        rays.push_back(RandomRay(large, rng, RandomPoint(rng, 8000.0f)));
+    }
+    PickingTree tree;
+    std::vector<GameObject*> bruteForce(rays.size());
+    std::vector<GameObject*> picked(rays.size());
+    double buildMs = TimeMs([&]() { tree.FindObject(rays[0], large.Objects); });
+    double bruteMs = TimeMs([&]() {
+        for (size_t i = 0; i < rays.size(); i++) {
+            bruteForce[i] = FindObjectBruteForce(rays[i], large.Objects);
+        }
+    });
+    double treeMs = TimeMs([&]() {
+        for (size_t i = 0; i < rays.size(); i++) {
+            picked[i] = tree.FindObject(rays[i], large.Objects);
+        }
+    });
+    size_t largeHits = 0;
+    for (size_t i = 0; i < rays.size(); i++) {
+        check(picked[i] == bruteForce[i], "large scene pick " + std::to_string(i) + " differs from brute force");
+        largeHits += (bruteForce[i] != nullptr);
+    }
+
+    printf("[Picking] %zu picks (%zu hit) on changing scenes, %zu rebuilds and %zu refits. Large scene of %zu "
+           "objects: brute force %.4f ms per pick, trees %.4f ms per pick after %.2f ms to build, %zu of %zu hit. "
+           "%zu checks passed, %zu failed\n",
+           picks, hits, rebuilds, refits, large.Objects.size(), bruteMs / rays.size(), treeMs / rays.size(), buildMs,
+           largeHits, rays.size(), passed, failed);
+    return failed;
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "racing/rankings.h"
+#include "checks.h"
+
+#define RANKING_RACES 20
+#define RANKING_TICKS 3000
+// Progress a racer needs to finish, in the units set_places ranks by
+#define RANKING_FINISH 200.0f
+
+namespace {
+
+const s32 kRacerCounts[] = { 8, 16, 32 };
+
+struct Random {
+    uint32_t Seed = 0x3C6EF372;
+
+    // Uniform in [lo, hi)
+    f32 Range(f32 lo, f32 hi) {
+        Seed = Seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * ((Seed >> 8) / (f32) (1 << 24));
+    }
+};
+
+// Ranks the way set_places did before, exchanging any two unfinished racers that are out of order
+void ExchangeRank(s32* ids, f32* scores, const bool* fixed, s32 count) {
+    for (s32 i = 0; i < count - 1; i++) {
+        if (fixed[i]) {
+            continue;
+        }
+        for (s32 j = i + 1; j < count; j++) {
+            if ((scores[i] < scores[j]) && !fixed[j]) {
+                std::swap(ids[i], ids[j]);
+                std::swap(scores[i], scores[j]);
+            }
+        }
+    }
+}
+
+struct Race {
+    std::vector<f32> Progress;
+    std::vector<f32> Speed;
+    std::vector<bool> Finished;
+    std::vector<s32> IdByRank;
+};
+
+Race StartRace(Random& random, s32 count) {
+    Race race;
+
+    for (s32 i = 0; i < count; i++) {
+        // Staggered on the grid, so no two racers start level
+        race.Progress.push_back(-0.37f * i);
+        race.Speed.push_back(random.Range(0.1f, 0.2f));
+        race.Finished.push_back(false);
+        race.IdByRank.push_back(i);
+    }
+    return race;
+}
+
+// Moves every racer on and fills in what set_places reads: the ids by last rank, their scores and who finished
+void TickRace(Race& race, Random& random, std::vector<s32>& ids, std::vector<f32>& scores,
+              std::vector<bool>& finished) {
+    s32 count = (s32) race.IdByRank.size();
+
+    for (s32 i = 0; i < count; i++) {
+        if (!race.Finished[i]) {
+            race.Progress[i] += race.Speed[i] * random.Range(0.5f, 1.5f);
+            race.Finished[i] = (race.Progress[i] >= RANKING_FINISH);
+        }
+    }
+    for (s32 rank = 0; rank < count; rank++) {
+        s32 id = race.IdByRank[rank];
+        ids[rank] = id;
+        scores[rank] = race.Progress[id];
+        finished[rank] = race.Finished[id];
+    }
+}
+
+bool HasTies(const std::vector<f32>& scores, const std::vector<bool>& finished) {
+    for (size_t i = 0; i < scores.size(); i++) {
+        for (size_t j = i + 1; j < scores.size(); j++) {
+            if (!finished[i] && !finished[j] && (scores[i] == scores[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Fn> double TimeNs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * Runs races of 8, 16 and 32 racers and ranks them every tick the way set_places does, around the racers who
+ * finished, with the merge sort and with the exchange sort it replaced. Checks that both give the same order
+ * whenever no two racers are level, that the order is always highest score first, and that finished racers
+ * and racers with equal scores keep their places. Then prints what ranking costs per tick at each count.
+ */
+size_t Check_RacerRanking(void) {
+    Random random;
+    size_t passed = 0;
+    size_t failed = 0;
+    size_t compared = 0;
+    double exchangeNs[3] = {};
+    double mergeNs[3] = {};
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Ranking] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+
+    for (s32 c = 0; c < 3; c++) {
+        s32 count = kRacerCounts[c];
+        std::vector<s32> ids(count);
+        std::vector<f32> scores(count);
+        std::vector<bool> finished(count);
+
+        for (s32 r = 0; r < RANKING_RACES; r++) {
+            Race race = StartRace(random, count);
+            std::string at = " with " + std::to_string(count) + " racers in race " + std::to_string(r);
+
+            for (s32 tick = 0; tick < RANKING_TICKS; tick++) {
+                TickRace(race, random, ids, scores, finished);
+                std::vector<s32> exchangeIds = ids;
+                std::vector<f32> exchangeScores = scores;
+                std::vector<s32> mergeIds = ids;
+                std::vector<f32> mergeScores = scores;
+                bool fixed[RANKINGS_MAX_RACERS];
+                std::copy(finished.begin(), finished.end(), fixed);
+
+                ExchangeRank(exchangeIds.data(), exchangeScores.data(), fixed, count);
+                rank_racers_around_fixed(mergeIds.data(), mergeScores.data(), fixed, count);
+
+                if (!HasTies(scores, finished)) {
+                    check(mergeIds == exchangeIds, "ranked differently from the exchange sort at tick " +
+                                                       std::to_string(tick) + at);
+                    compared++;
+                }
+                bool ordered = true;
+                s32 last = -1;
+                for (s32 i = 0; i < count; i++) {
+                    ordered &= (mergeScores[i] == race.Progress[mergeIds[i]]);
+                    if (fixed[i]) {
+                        ordered &= (mergeIds[i] == ids[i]);
+                        continue;
+                    }
+                    // Level racers keep the order they came in
+                    if (last >= 0) {
+                        ordered &= (mergeScores[last] > mergeScores[i]) ||
+                                   ((mergeScores[last] == mergeScores[i]) &&
+                                    (std::find(ids.begin(), ids.end(), mergeIds[last]) <
+                                     std::find(ids.begin(), ids.end(), mergeIds[i])));
+                    }
+                    last = i;
+                }
+                check(ordered, "ranking out of order at tick " + std::to_string(tick) + at);
+                race.IdByRank = mergeIds;
+            }
+            check(std::count(race.Finished.begin(), race.Finished.end(), true) == count, "not everyone finished" + at);
+        }
+
+        // A tick's worth of set_places for a race in progress, timed both ways
+        Race race = StartRace(random, count);
+        for (s32 tick = 0; tick < RANKING_TICKS / 2; tick++) {
+            TickRace(race, random, ids, scores, finished);
+            race.IdByRank = ids;
+            std::sort(race.IdByRank.begin(), race.IdByRank.end(),
+                      [&race](s32 a, s32 b) { return race.Progress[a] > race.Progress[b]; });
+        }
+        TickRace(race, random, ids, scores, finished);
+        bool fixed[RANKINGS_MAX_RACERS];
+        bool none[RANKINGS_MAX_RACERS] = {};
+        std::copy(finished.begin(), finished.end(), fixed);
+        std::vector<s32> workIds(count);
+        std::vector<f32> workScores(count);
+        const s32 repeats = 20000;
+        exchangeNs[c] = TimeNs([&]() {
+            for (s32 i = 0; i < repeats; i++) {
+                workIds = ids;
+                workScores = scores;
+                ExchangeRank(workIds.data(), workScores.data(), fixed, count);
+                ExchangeRank(workIds.data(), workScores.data(), none, count);
+            }
+        }) / repeats;
+        mergeNs[c] = TimeNs([&]() {
+            for (s32 i = 0; i < repeats; i++) {
+                workIds = ids;
+                workScores = scores;
+                rank_racers_around_fixed(workIds.data(), workScores.data(), fixed, count);
+                rank_racers(workIds.data(), workScores.data(), count);
+            }
+        }) / repeats;
+    }
+
+    // Level racers stay where they were, across the runs the sort merges too, and a lone racer or no racers at
+    // all are left alone
+    std::vector<s32> levelIds(RANKINGS_MAX_RACERS);
+    std::vector<f32> levelScores(RANKINGS_MAX_RACERS);
+    for (s32 i = 0; i < RANKINGS_MAX_RACERS; i++) {
+        levelIds[i] = (i * 7) % RANKINGS_MAX_RACERS;
+        levelScores[i] = (f32) ((i * 5) % 3);
+    }
+    std::vector<s32> expectedIds = levelIds;
+    std::stable_sort(expectedIds.begin(), expectedIds.end(), [&](s32 a, s32 b) {
+        return levelScores[std::find(levelIds.begin(), levelIds.end(), a) - levelIds.begin()] >
+               levelScores[std::find(levelIds.begin(), levelIds.end(), b) - levelIds.begin()];
+    });
+    rank_racers(levelIds.data(), levelScores.data(), RANKINGS_MAX_RACERS);
+    check(levelIds == expectedIds, "racers with equal scores changed order");
+    s32 oneId = 4;
+    f32 oneScore = 1.0f;
+    rank_racers(&oneId, &oneScore, 1);
+    rank_racers(&oneId, &oneScore, 0);
+    check((oneId == 4) && (oneScore == 1.0f), "ranking one racer changed it");
+
+    printf("[Ranking] %zu ticks matched the exchange sort. Ranking per tick, exchange sort against merge sort: "
+           "8 racers %.0f/%.0f ns, 16 racers %.0f/%.0f ns, 32 racers %.0f/%.0f ns. %zu checks passed, %zu failed\n",
+           compared, exchangeNs[0], mergeNs[0], exchangeNs[1], mergeNs[1], exchangeNs[2], mergeNs[2], passed,
+           failed);
+    return failed;
+}
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "engine/editor/SceneFormat.h"
+#include "checks.h"
+
+using namespace Editor;
+
+namespace {
+
+std::vector<uint8_t> ReadWholeFile(const std::string& path) {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (file == nullptr) {
+        return data;
+    }
+    uint8_t buffer[0x1000];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return data;
+}
+
+nlohmann::json MakeTestActor(size_t i) {
+    float f = (float) i;
+    return { { "Name", "Tree " + std::to_string(i) },
+             { "Position", { f * 13.5f, -f * 0.25f, f * 1000.125f } },
+             { "Rotation", { (int) (i * 91) % 65536, 0, -(int) i } },
+             { "Scale", { 1.0f, 1.0f + f / 8.0f, 1.0f } },
+             { "Model", "__OTR__tracks/test/tree" } };
+}
+
+// Values a scene might hold that are easy to get wrong
+nlohmann::json MakeEdgeCaseScene() {
+    nlohmann::json actors = nlohmann::json::array();
+    for (size_t i = 0; i < 2 * SCENE_CHUNK_ELEMENTS + 3; i++) {
+        actors.push_back(MakeTestActor(i));
+    }
+    return { { "Props",
+               { { "Name", "Ch\xC3\xA2teau \xE2\x9C\x93" },
+                 { "Empty", "" },
+                 { "MaxUnsigned", UINT64_MAX },
+                 { "MinSigned", INT64_MIN },
+                 { "Tenth", 0.1 },
+                 { "Denormal", 5e-324 },
+                 { "NegativeZero", -0.0 },
+                 { "Float", 1.0f / 3.0f },
+                 { "Nested", { { "a", { nlohmann::json::array(), nlohmann::json::object() } } } },
+                 { "Null", nullptr },
+                 { "Bool", true } } },
+             { "StaticMeshActors", actors },
+             { "EmptyArray", nlohmann::json::array() },
+             { "ModelLods", nlohmann::json::object() } };
+}
+
+bool CheckRoundTrip(const std::string& name, const nlohmann::json& scene) {
+    std::vector<uint8_t> binary = EncodeScene(scene);
+    nlohmann::json decoded;
+
+    // Equal values, the same JSON text, and the same bytes when encoded again
+    bool ok = DecodeScene(binary.data(), binary.size(), decoded) && (decoded == scene) &&
+              (decoded.dump() == scene.dump()) && (EncodeScene(decoded) == binary);
+    if (!ok) {
+        printf("[SceneFormat] %s did not survive the binary format\n", name.c_str());
+    }
+    return ok;
+}
+
+// Autosaves a scene through a series of edits, then cuts the file short at every byte and flips bytes in it,
+// checking each read against the autosave that was last complete
+size_t RunAutosaveTest(const std::filesystem::path& dir) {
+    std::string path = (dir / "scene.autosave").string();
+    SceneAutosave autosave(path);
+    // Kept small, since every cut of the file is read back
+    nlohmann::json scene = { { "Props", { { "Name", "Autosave" } } }, { "StaticMeshActors", nlohmann::json::array() } };
+    for (size_t i = 0; i < 2 * SCENE_CHUNK_ELEMENTS + 10; i++) {
+        scene["StaticMeshActors"].push_back({ { "Position", { (float) i, 0.0f, -(float) i } } });
+    }
+    std::vector<nlohmann::json> versions;
+    std::vector<size_t> ends;
+    size_t failures = 0;
+    size_t saves = 0;
+    size_t appended = 0;
+    size_t rewritten = 0;
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".prev");
+    for (size_t edit = 0; edit < 40; edit++) {
+        switch (edit % 4) {
+            case 0: // Drag an actor
+                scene["StaticMeshActors"][(edit * 37) % scene["StaticMeshActors"].size()]["Position"][0] =
+                    (float) edit * 3.5f;
+                break;
+            case 1:
+                scene["Props"]["Name"] = "Edit " + std::to_string(edit);
+                break;
+            case 2:
+                scene["StaticMeshActors"].push_back({ { "Position", { (float) edit, 1.0f, 2.0f } } });
+                break;
+            case 3: // Deleting one shifts the actors after it, changing the parts they are in
+                scene["StaticMeshActors"].erase(scene["StaticMeshActors"].end() - 1 - (edit % 80));
+                break;
+        }
+        size_t before = std::filesystem::exists(path) ? std::filesystem::file_size(path) : 0;
+        size_t written = autosave.Save(scene);
+        size_t after = std::filesystem::file_size(path);
+        if (written == 0) {
+            printf("[SceneFormat] Autosave %zu wrote nothing\n", edit);
+            failures++;
+            continue;
+        }
+        // A rewrite starts the file over, so earlier autosaves can no longer be cut back to
+        if (after != before + written) {
+            rewritten++;
+            versions.clear();
+            ends.clear();
+        } else {
+            saves++;
+            appended += written;
+        }
+        versions.push_back(scene);
+        ends.push_back(after);
+    }
+    if (autosave.Save(scene) != 0) {
+        printf("[SceneFormat] An autosave without changes wrote to the file\n");
+        failures++;
+    }
+
+    std::vector<uint8_t> data = ReadWholeFile(path);
+    nlohmann::json read;
+    for (size_t cut = 0; cut <= data.size(); cut++) {
+        // The last autosave that was written whole before the cut
+        size_t expected = std::upper_bound(ends.begin(), ends.end(), cut) - ends.begin();
+        bool ok = DecodeScene(data.data(), cut, read);
+        bool match = (expected == 0) ? !ok : (ok && (read == versions[expected - 1]));
+        if (!match) {
+            printf("[SceneFormat] Autosave cut at %zu of %zu bytes did not read back as autosave %zu\n", cut,
+                   data.size(), expected);
+            failures++;
+        }
+    }
+    for (size_t i = 0; i < 64; i++) {
+        size_t at = (data.size() - ends[0]) * i / 64 + ends[0];
+        if (at >= data.size()) {
+            break;
+        }
+        size_t expected = std::upper_bound(ends.begin(), ends.end(), at) - ends.begin();
+        data[at] ^= 0x5A;
+        bool ok = DecodeScene(data.data(), data.size(), read) && (read == versions[expected - 1]);
+        data[at] ^= 0x5A;
+        if (!ok) {
+            printf("[SceneFormat] Autosave with byte %zu flipped did not read back as autosave %zu\n", at, expected);
+            failures++;
+        }
+    }
+
+    // A new session keeps the last one's autosave
+    SceneAutosave next(path);
+    next.Save(MakeEdgeCaseScene());
+    std::vector<uint8_t> previous = ReadWholeFile(path + ".prev");
+    if (!DecodeScene(previous.data(), previous.size(), read) || (read != versions.back())) {
+        printf("[SceneFormat] The previous session's autosave was not kept\n");
+        failures++;
+    }
+
+    printf("[SceneFormat] %zu autosaves appended %zu bytes each on average, against %zu bytes for the whole scene, "
+           "with %zu rewrites. Read back %zu cuts and 64 corruptions of the last file\n",
+           saves, (saves != 0) ? appended / saves : 0, EncodeScene(scene).size(), rewritten, data.size() + 1);
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".prev");
+    return failures;
+}
+
+// A scene file only matches the JSON text it was saved with, and is visited one chunk at a time
+size_t RunSourceTest() {
+    nlohmann::json scene = MakeEdgeCaseScene();
+    std::string text = scene.dump(4);
+    std::vector<uint8_t> source(text.begin(), text.end());
+    std::vector<uint8_t> binary = EncodeScene(scene, source.data(), source.size());
+    size_t failures = 0;
+
+    if (!IsSceneFrom(binary.data(), binary.size(), source.data(), source.size())) {
+        printf("[SceneFormat] A scene file did not match the JSON it was saved with\n");
+        failures++;
+    }
+    source[source.size() / 2] ^= 0x01;
+    if (IsSceneFrom(binary.data(), binary.size(), source.data(), source.size())) {
+        printf("[SceneFormat] A scene file matched JSON that was edited after it was saved\n");
+        failures++;
+    }
+    source.push_back(' ');
+    if (IsSceneFrom(binary.data(), binary.size(), source.data(), source.size())) {
+        printf("[SceneFormat] A scene file matched JSON that grew after it was saved\n");
+        failures++;
+    }
+
+    size_t largestPart = 0;
+    size_t elements = 0;
+    VisitScene(binary.data(), binary.size(), [&](SceneValueKind kind, const std::string& name, nlohmann::json& value) {
+        if ((kind == SceneValueKind::ArrayPart) && (name == "StaticMeshActors")) {
+            largestPart = std::max(largestPart, value.size());
+            elements += value.size();
+        }
+    });
+    if ((largestPart > SCENE_CHUNK_ELEMENTS) || (elements != scene["StaticMeshActors"].size())) {
+        printf("[SceneFormat] Visiting a scene gave %zu actors in parts of up to %zu, expected %zu in parts of up "
+               "to %d\n",
+               elements, largestPart, scene["StaticMeshActors"].size(), SCENE_CHUNK_ELEMENTS);
+        failures++;
+    }
+    return failures;
+}
+
+} // namespace
+
+// Scenes with values that are easy to get wrong, and one the size of a busy custom track, come back from the binary
+// format unchanged. A scene file only matches the JSON it was saved with.
+size_t Check_SceneRoundTrip(void) {
+    size_t scenes = 0;
+    size_t failures = 0;
+
+    auto check = [&](const std::string& name, const nlohmann::json& scene) {
+        scenes++;
+        failures += !CheckRoundTrip(name, scene);
+    };
+
+    check("Edge cases", MakeEdgeCaseScene());
+    check("Array root", nlohmann::json::array({ 1, "two", 3.0 }));
+    check("Empty scene", nlohmann::json::object());
+
+    nlohmann::json large = MakeEdgeCaseScene();
+    for (size_t i = large["StaticMeshActors"].size(); i < 5000; i++) {
+        large["StaticMeshActors"].push_back(MakeTestActor(i));
+    }
+    check("5000 static meshes", large);
+    failures += RunSourceTest();
+
+    printf("[SceneFormat] %zu scenes round tripped through the binary format\n", scenes);
+    return failures;
+}
+
+// An autosave file cut short at any byte, or with a byte flipped, reads back as its last complete autosave
+size_t Check_SceneAutosave(void) {
+    std::error_code error;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(error) / "spaghetti_scene_check";
+    std::filesystem::create_directories(dir, error);
+    if (error) {
+        printf("[SceneFormat] Could not create %s for the autosave check\n", dir.string().c_str());
+        return 1;
+    }
+    size_t failures = RunAutosaveTest(dir);
+    std::filesystem::remove_all(dir, error);
+    return failures;
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "port/Frustum.h"
+#include "port/FrameSettings.h"
+#include "checks.h"
+
+#define SECTION_COUNT 96
+#define SECTION_QUADS 12
+#define RING_RADIUS 3000.0f
+#define ROAD_WIDTH 240.0f
+#define RANDOM_CAMERAS 4000
+
+namespace {
+
+// Near and far planes of a custom track, as in Course's default Props
+constexpr f32 NearPlane = 9.0f;
+constexpr f32 FarPlane = 4500.0f;
+constexpr f32 FovY = 40.0f;
+constexpr f32 Aspect = 4.0f / 3.0f;
+
+struct Section {
+    std::vector<std::vector<f32>> Vertices;
+    f32 Min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    f32 Max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    // Grows the box the way ParseCourseSections does for each vertex the section loads
+    void Add(f32 x, f32 y, f32 z) {
+        // Vertices are whole numbers in the display lists
+        std::vector<f32> v = { roundf(x), roundf(y), roundf(z) };
+        for (s32 i = 0; i < 3; i++) {
+            Min[i] = std::min(Min[i], v[i]);
+            Max[i] = std::max(Max[i], v[i]);
+        }
+        Vertices.push_back(v);
+    }
+};
+
+struct Random {
+    uint32_t Seed = 0x1F123BB5;
+
+    // Uniform in [lo, hi)
+    f32 Range(f32 lo, f32 hi) {
+        Seed = Seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * ((Seed >> 8) / (f32) (1 << 24));
+    }
+};
+
+/**
+ * A ring road cut into sections, each a strip of bumpy quads with a wall on the outside, and a tree or a
+ * single thin pole next to some of them, so the boxes range from flat and long to tall and narrow.
+ */
+std::vector<Section> BuildSections(Random& random) {
+    std::vector<Section> sections(SECTION_COUNT);
+
+    for (size_t s = 0; s < SECTION_COUNT; s++) {
+        Section& section = sections[s];
+        for (s32 q = 0; q <= SECTION_QUADS; q++) {
+            f32 angle = (2.0f * (f32) M_PI) * ((f32) (s * SECTION_QUADS + q) / (SECTION_COUNT * SECTION_QUADS));
+            f32 height = 150.0f * sinf(angle * 3.0f);
+            f32 inner = RING_RADIUS - ROAD_WIDTH / 2;
+            f32 outer = RING_RADIUS + ROAD_WIDTH / 2;
+            section.Add(cosf(angle) * inner, height + random.Range(-20.0f, 20.0f), sinf(angle) * inner);
+            section.Add(cosf(angle) * outer, height + random.Range(-20.0f, 20.0f), sinf(angle) * outer);
+            section.Add(cosf(angle) * outer, height + 60.0f, sinf(angle) * outer);
+        }
+        if ((s % 3) == 0) {
+            f32 angle = (2.0f * (f32) M_PI) * ((f32) s / SECTION_COUNT);
+            f32 x = cosf(angle) * (RING_RADIUS - ROAD_WIDTH);
+            f32 z = sinf(angle) * (RING_RADIUS - ROAD_WIDTH);
+            section.Add(x, 0.0f, z);
+            section.Add(x + random.Range(-4.0f, 4.0f), (s % 2) ? 400.0f : 120.0f, z + random.Range(-4.0f, 4.0f));
+        }
+    }
+    return sections;
+}
+
+} // namespace
+
+/**
+ * Moves a camera along a synthetic track, and to random places looking every way, and checks that no section
+ * with a vertex inside the frustum is culled by its box. Also checks that the boxes do cull something, and
+ * that nothing is culled with gNoCulling set or without a camera.
+ */
+size_t Check_SectionCulling(void) {
+    Random random;
+    std::vector<Section> sections = BuildSections(random);
+    size_t passed = 0;
+    size_t failed = 0;
+    size_t views = 0;
+    size_t drawn = 0;
+    size_t missed = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Sections] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+    auto testView = [&](Vec3f pos, Vec3f lookAt, Vec3f up, const std::string& at) {
+        size_t viewMissed = 0;
+        Frustum_SetCamera(0, pos, lookAt, up, FovY, Aspect, NearPlane, FarPlane);
+        for (size_t i = 0; i < sections.size(); i++) {
+            Section& section = sections[i];
+            bool boxVisible = Frustum_TestBox(section.Min, section.Max);
+            bool anyVertexVisible = false;
+            for (std::vector<f32>& v : section.Vertices) {
+                if (Frustum_TestSphere(v.data(), 0.0f)) {
+                    anyVertexVisible = true;
+                    break;
+                }
+            }
+            drawn += boxVisible;
+            viewMissed += (anyVertexVisible && !boxVisible);
+        }
+        check(viewMissed == 0, std::to_string(viewMissed) + " sections with a vertex in view were culled " + at);
+        missed += viewMissed;
+        views++;
+    };
+
+    // Driving along the road a little above it, looking a few quads ahead
+    const size_t pathPoints = SECTION_COUNT * SECTION_QUADS;
+    for (size_t p = 0; p < pathPoints; p++) {
+        f32 angle = (2.0f * (f32) M_PI) * ((f32) p / pathPoints);
+        f32 aheadAngle = (2.0f * (f32) M_PI) * ((f32) (p + 8) / pathPoints);
+        Vec3f pos = { cosf(angle) * RING_RADIUS, 150.0f * sinf(angle * 3.0f) + 40.0f, sinf(angle) * RING_RADIUS };
+        Vec3f lookAt = { cosf(aheadAngle) * RING_RADIUS, 150.0f * sinf(aheadAngle * 3.0f) + 20.0f,
+                         sinf(aheadAngle) * RING_RADIUS };
+        Vec3f up = { 0.0f, 1.0f, 0.0f };
+        testView(pos, lookAt, up, "on the road at point " + std::to_string(p));
+    }
+    size_t roadViews = views;
+    size_t roadDrawn = drawn;
+
+    // Anywhere over the track, looking every way, tilted
+    for (size_t c = 0; c < RANDOM_CAMERAS; c++) {
+        Vec3f pos = { random.Range(-4000.0f, 4000.0f), random.Range(-200.0f, 800.0f), random.Range(-4000.0f, 4000.0f) };
+        Vec3f lookAt = { pos[0] + random.Range(-1.0f, 1.0f), pos[1] + random.Range(-1.0f, 1.0f),
+                         pos[2] + random.Range(-1.0f, 1.0f) };
+        Vec3f up = { random.Range(-0.3f, 0.3f), 1.0f, random.Range(-0.3f, 0.3f) };
+        testView(pos, lookAt, up, "from random camera " + std::to_string(c));
+    }
+
+    // On the road a camera sees a few sections ahead, so most of the ring must be culled
+    f32 roadAverage = (f32) roadDrawn / roadViews;
+    check(roadAverage < SECTION_COUNT / 3, "the boxes culled too little, " + std::to_string(roadAverage) +
+                                               " of " + std::to_string(SECTION_COUNT) + " sections drawn per view");
+
+    // A section behind the camera is culled unless culling is off or there is no camera
+    Vec3f pos = { 0.0f, 40.0f, 0.0f };
+    Vec3f lookAt = { 0.0f, 40.0f, 100.0f };
+    Vec3f up = { 0.0f, 1.0f, 0.0f };
+    Vec3f behindMin = { -10.0f, 0.0f, -200.0f };
+    Vec3f behindMax = { 10.0f, 10.0f, -100.0f };
+    Frustum_SetCamera(0, pos, lookAt, up, FovY, Aspect, NearPlane, FarPlane);
+    check(!Frustum_TestBox(behindMin, behindMax), "box behind the camera was drawn");
+    gFrameSettings.NoCulling = 1;
+    check(Frustum_TestBox(behindMin, behindMax), "box was culled with gNoCulling set");
+    gFrameSettings.NoCulling = 0;
+    Frustum_ClearCamera();
+    check(Frustum_TestBox(behindMin, behindMax), "box was culled without a camera");
+
+    printf("[Sections] %d sections, %zu camera positions: %.1f sections drawn per view on the road, %zu sections "
+           "with a vertex in view were culled. %zu checks passed, %zu failed\n",
+           SECTION_COUNT, views, roadAverage, missed, passed, failed);
+    return failed;
+}
@@ -0,0 +1,72 @@
+#include <libultraship.h>
+#include <defines.h>
+#include "main.h"
+#include "code_800029B0.h"
+#include "code_80005FD0.h"
+#include "racing/memory.h"
+#include "math_util.h"
+#include "port/Game.h"
+#include "port/FrameSettings.h"
+
+/**
+ * The game state read by the sources the checks build, defined here instead of in the files that would bring in
+ * the rest of the game. Like in the game, it starts out zeroed.
+ */
+
+// code_800029B0.c
+CollisionTriangle* gCollisionMesh;
+u32* gCollisionIndices;
+u32 gCollisionMeshCount;
+u32 gNumCollisionTriangles;
+u32 D_8015F58C;
+s32 D_8015F59C;
+s32 D_8015F5A0;
+s32 D_8015F5A4;
+Vtx* vtxBuffer[32];
+s16 gCourseMaxX;
+s16 gCourseMinX;
+s16 gCourseMaxY;
+s16 gCourseMinY;
+s16 gCourseMaxZ;
+s16 gCourseMinZ;
+s16 D_8015F6FA;
+s16 D_8015F6FC;
+uintptr_t gNextFreeMemoryAddress;
+size_t gFreeMemorySize;
+uintptr_t gFreeMemoryCourseAnchor;
+uintptr_t gFreeMemoryResetAnchor;
+
+// code_80005FD0.c
+s32 D_80163368[4];
+TrackPathPoint* gTrackPaths[4];
+u16 gPathCountByPathIndex[4];
+
+// main.c
+CollisionGrid gDefaultCollisionGrid[GRID_SIZE * GRID_SIZE];
+CollisionGrid* gCollisionGrid = gDefaultCollisionGrid;
+s32 gCollisionGridSize = GRID_SIZE;
+
+// FrameSettings.cpp, with every setting off
+FrameSettings gFrameSettings;
+
+// Game.cpp
+bool gStubPodiumCeremony = false;
+
+bool IsPodiumCeremony() {
+    return gStubPodiumCeremony;
+}
+
+void vec3f_set(Vec3f arg0, f32 arg1, f32 arg2, f32 arg3) {
+    arg0[0] = arg1;
+    arg0[1] = arg2;
+    arg0[2] = arg3;
+}
+
+// Only reached when a collision mesh is built from a display list
+void* ResourceGetDataByName(const char* name) {
+    return NULL;
+}
+
+f32 CM_GetWaterLevel(Vec3f pos, Collision* collision) {
+    return -1000.0f;
+}
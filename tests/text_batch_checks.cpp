@@ -0,0 +1,250 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <libultraship.h>
+#include <libultra/gbi.h>
+
+#include "engine/TextBatch.h"
+#include "port/FrameSettings.h"
+#include "checks.h"
+
+#define TEXT_RANDOM_LINES 400
+#define TEXT_LINE_CAPACITY 1024
+
+namespace {
+
+// Stand-ins for the display lists print_letter and func_800959F8 call. Only their addresses are compared.
+Gfx sLineStart[1];
+Gfx sLineEnd[1];
+Gfx sModes[2][1];
+Gfx sRectangle[1];
+
+// The glyph sizes func_80095BD0 picks its vertices by, as in the game's fonts
+const u32 kGlyphSizes[][2] = { { 16, 16 }, { 16, 16 }, { 26, 28 }, { 30, 32 }, { 16, 8 } };
+constexpr size_t GlyphCount = sizeof(kGlyphSizes) / sizeof(kGlyphSizes[0]);
+u8 sGlyphTextures[GlyphCount][512];
+Vtx sGlyphVertices[3][16];
+
+struct Glyph {
+    size_t Texture;
+    s32 Mode;
+};
+
+// What one glyph rectangle was drawn with, and the state it was drawn in
+struct DrawnRect {
+    uintptr_t Mode;
+    uintptr_t Matrix;
+    uintptr_t Texture[2];
+    uintptr_t TileSize[2];
+    uintptr_t Vertices[2];
+    bool bDepthTest;
+
+    bool operator==(const DrawnRect& other) const {
+        return (Mode == other.Mode) && (Matrix == other.Matrix) && (Texture[0] == other.Texture[0]) &&
+               (Texture[1] == other.Texture[1]) && (TileSize[0] == other.TileSize[0]) &&
+               (TileSize[1] == other.TileSize[1]) && (Vertices[0] == other.Vertices[0]) &&
+               (Vertices[1] == other.Vertices[1]) && (bDepthTest == other.bDepthTest);
+    }
+};
+
+struct DrawnLine {
+    std::vector<DrawnRect> Rects;
+    size_t Commands = 0;
+    bool bDepthTestAfter = false;
+};
+
+struct Random {
+    uint32_t Seed = 0x7E3779B9;
+
+    // Uniform in [0, count)
+    size_t Below(size_t count) {
+        Seed = Seed * 1664525u + 1013904223u;
+        return (Seed >> 8) % count;
+    }
+};
+
+/**
+ * Emits a line the way the print_text functions do: begin_text_line, then print_letter, func_80095BD0 and
+ * func_800959F8 for each glyph, then end_text_line. Each glyph gets its own matrix, as AddTextMatrix gives it.
+ */
+Gfx* EmitLine(Gfx* gfx, const std::vector<Glyph>& glyphs, const std::vector<Mtx>& matrices) {
+    gSPDisplayList(gfx++, sLineStart);
+    TextBatch_Begin();
+    for (size_t i = 0; i < glyphs.size(); i++) {
+        const Glyph& glyph = glyphs[i];
+        u8* texture = sGlyphTextures[glyph.Texture];
+        u32 width = kGlyphSizes[glyph.Texture][0];
+        u32 height = kGlyphSizes[glyph.Texture][1];
+        Vtx* vertices = sGlyphVertices[(width == 26) ? 0 : ((width == 30) ? 1 : 2)];
+
+        gfx = TextBatch_SetMode(gfx, sModes[glyph.Mode]);
+        gSPMatrix(gfx++, &matrices[i], G_MTX_NOPUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
+        if (TextBatch_LoadsTexture(texture, width, height)) {
+            gDPLoadTextureTile_4b(gfx++, texture, G_IM_FMT_I, width, 0, 0, 0, width, height + 2, 0,
+                                  G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOMASK,
+                                  G_TX_NOLOD, G_TX_NOLOD);
+        }
+        bool inTextLine = TextBatch_IsOpen();
+        if (!inTextLine) {
+            gSPClearGeometryMode(gfx++, G_ZBUFFER);
+        }
+        gSPVertex(gfx++, vertices, 2, 0);
+        gSPVertex(gfx++, &vertices[(i % 7 + 1) * 2], 2, 2);
+        gSPDisplayList(gfx++, sRectangle);
+        if (!inTextLine) {
+            gSPSetGeometryMode(gfx++, G_ZBUFFER);
+        }
+    }
+    gfx = TextBatch_End(gfx);
+    gSPDisplayList(gfx++, sLineEnd);
+    return gfx;
+}
+
+// Walks the commands of a line, keeping the state the RDP would be in, and lists the rectangles it drew
+DrawnLine ListRects(const Gfx* gfx, const Gfx* end) {
+    DrawnLine line;
+    DrawnRect current = {};
+    size_t vertices = 0;
+
+    current.bDepthTest = true;
+    line.Commands = end - gfx;
+    for (; gfx < end; gfx++) {
+        uintptr_t lo = gfx->words.w0;
+        uintptr_t hi = gfx->words.w1;
+        // Signed to match the immediate opcodes, as in Course.cpp's ScanSection
+        int8_t opcode = GFX_GET_OPCODE(lo) >> 24;
+
+        switch (opcode) {
+            case G_MTX:
+                current.Matrix = hi;
+                break;
+            case (int8_t) G_SETTIMG:
+            case (int8_t) G_SETTIMG_OTR_FILEPATH:
+                current.Texture[0] = lo;
+                current.Texture[1] = hi;
+                break;
+            case (int8_t) G_SETTILESIZE:
+                current.TileSize[0] = lo;
+                current.TileSize[1] = hi;
+                break;
+            case (int8_t) G_CLEARGEOMETRYMODE:
+                if (hi & G_ZBUFFER) {
+                    current.bDepthTest = false;
+                }
+                break;
+            case (int8_t) G_SETGEOMETRYMODE:
+                if (hi & G_ZBUFFER) {
+                    current.bDepthTest = true;
+                }
+                break;
+            case G_VTX:
+                current.Vertices[vertices % 2] = hi;
+                vertices++;
+                break;
+            case (int8_t) G_DL:
+                if ((hi == (uintptr_t) sModes[0]) || (hi == (uintptr_t) sModes[1])) {
+                    // The mode sets up the tiles, so the texture loaded before it is gone
+                    current.Mode = hi;
+                    current.Texture[0] = current.Texture[1] = 0;
+                    current.TileSize[0] = current.TileSize[1] = 0;
+                } else if (hi == (uintptr_t) sRectangle) {
+                    line.Rects.push_back(current);
+                    vertices = 0;
+                }
+                break;
+        }
+    }
+    line.bDepthTestAfter = current.bDepthTest;
+    return line;
+}
+
+} // namespace
+
+/**
+ * Emits lines of glyphs one by one and batched, the way the print_text functions draw them, and checks that
+ * both draw the same rectangles with the same mode, matrices, textures and vertices, with the depth test off,
+ * and that the depth test is back on after each line. Also checks that batching drops the commands a glyph
+ * repeats from the one before it.
+ */
+size_t Check_TextBatch(void) {
+    auto savedBatchText = gFrameSettings.BatchText;
+    std::vector<std::vector<Glyph>> lines;
+    Random random;
+    size_t passed = 0;
+    size_t failed = 0;
+    size_t rects = 0;
+    size_t commands[2] = { 0, 0 };
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[TextBatch] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+
+    // An empty line, a single glyph, runs of one glyph as in "MOO MOO", and a mode change halfway
+    lines.push_back({});
+    lines.push_back({ { 2, 0 } });
+    lines.push_back({ { 0, 0 }, { 1, 0 }, { 1, 0 }, { 4, 0 }, { 0, 0 }, { 1, 0 }, { 1, 0 } });
+    lines.push_back({ { 3, 1 }, { 3, 1 }, { 3, 1 }, { 3, 0 }, { 3, 0 }, { 2, 0 }, { 2, 1 } });
+    // Random lines, mostly in one mode, with glyphs repeating now and then
+    for (size_t i = 0; i < TEXT_RANDOM_LINES; i++) {
+        std::vector<Glyph> line(random.Below(24) + 1);
+        s32 mode = (s32) random.Below(2);
+        for (size_t g = 0; g < line.size(); g++) {
+            bool repeat = (g > 0) && (random.Below(3) == 0);
+            line[g].Texture = repeat ? line[g - 1].Texture : random.Below(GlyphCount);
+            line[g].Mode = (random.Below(16) == 0) ? (1 - mode) : mode;
+        }
+        lines.push_back(line);
+    }
+
+    std::vector<Gfx> scratch(TEXT_LINE_CAPACITY);
+    for (size_t l = 0; l < lines.size(); l++) {
+        const std::vector<Glyph>& glyphs = lines[l];
+        std::vector<Mtx> matrices(glyphs.size());
+        DrawnLine drawn[2];
+        bool repeats = false;
+        for (size_t g = 1; g < glyphs.size(); g++) {
+            repeats |= (glyphs[g].Texture == glyphs[g - 1].Texture) && (glyphs[g].Mode == glyphs[g - 1].Mode);
+        }
+        std::string at = " on line " + std::to_string(l);
+
+        for (s32 batched = 0; batched < 2; batched++) {
+            gFrameSettings.BatchText = batched;
+            Gfx* end = EmitLine(scratch.data(), glyphs, matrices);
+            check(!TextBatch_IsOpen(), "line stayed open after TextBatch_End" + at);
+            drawn[batched] = ListRects(scratch.data(), end);
+            commands[batched] += drawn[batched].Commands;
+        }
+
+        check(drawn[0].Rects.size() == glyphs.size(), "one by one drew " + std::to_string(drawn[0].Rects.size()) +
+                                                          " rectangles for " + std::to_string(glyphs.size()) +
+                                                          " glyphs" + at);
+        check(drawn[0].Rects == drawn[1].Rects, "batched rectangles differ from the ones drawn one by one" + at);
+        size_t depthTested = 0;
+        for (const DrawnRect& rect : drawn[1].Rects) {
+            depthTested += rect.bDepthTest;
+        }
+        check(depthTested == 0, std::to_string(depthTested) + " batched glyphs drawn with the depth test on" + at);
+        check(drawn[0].bDepthTestAfter && drawn[1].bDepthTestAfter, "depth test left off after the line" + at);
+        check(drawn[1].Commands <= drawn[0].Commands, "batching added commands" + at);
+        if (repeats) {
+            check(drawn[1].Commands < drawn[0].Commands, "batching saved nothing on repeated glyphs" + at);
+        }
+        rects += drawn[0].Rects.size();
+    }
+
+    gFrameSettings.BatchText = savedBatchText;
+
+    printf("[TextBatch] %zu lines, %zu rectangles: %zu commands one by one, %zu batched. %zu checks passed, "
+           "%zu failed\n",
+           lines.size(), rects, commands[0], commands[1], passed, failed);
+    return failed;
+}
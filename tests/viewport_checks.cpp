@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <libultraship.h>
+#include <libultra/gbi.h>
+
+#include "engine/JobSystem.h"
+#include "engine/SectionPlan.h"
+#include "port/Frustum.h"
+#include "checks.h"
+
+#define VIEWPORT_SECTIONS 4096
+#define VIEWPORT_COUNT 4
+#define VIEWPORT_FRAMES 240
+#define RING_RADIUS 16000.0f
+
+namespace {
+
+// Near and far planes of a custom track, as in Course's default Props
+constexpr f32 NearPlane = 9.0f;
+constexpr f32 FarPlane = 4500.0f;
+constexpr f32 FovY = 40.0f;
+constexpr f32 Aspect = 4.0f / 3.0f;
+
+struct Random {
+    uint32_t Seed = 0x2545F491;
+
+    // Uniform in [0, count)
+    size_t Below(size_t count) {
+        Seed = Seed * 1664525u + 1013904223u;
+        return (Seed >> 8) % count;
+    }
+};
+
+struct Camera {
+    Vec3f Pos;
+    Vec3f LookAt;
+    Vec3f Up;
+};
+
+/**
+ * A ring road cut into sections with a few lower detail versions declared for some of them. Every so often
+ * a section can't be culled or sorted, the way a section that sets up state for the next one can't.
+ */
+std::vector<TrackSection> BuildSections(std::vector<Gfx>& models, Random& random) {
+    std::vector<TrackSection> sections(VIEWPORT_SECTIONS);
+    std::vector<LodLevel> levels = { { "lod1", 800.0f }, { "lod2", 2000.0f } };
+
+    // A model for each section and each of its levels, only told apart by address
+    models.resize(VIEWPORT_SECTIONS * 3);
+    for (size_t i = 0; i < VIEWPORT_SECTIONS; i++) {
+        TrackSection& section = sections[i];
+        f32 angle = (2.0f * (f32) M_PI) * ((f32) i / VIEWPORT_SECTIONS);
+        f32 next = (2.0f * (f32) M_PI) * ((f32) (i + 1) / VIEWPORT_SECTIONS);
+        f32 height = 300.0f * sinf(angle * 5.0f);
+
+        section.Model = &models[i * 3];
+        section.Min = FVector(std::min(cosf(angle), cosf(next)) * RING_RADIUS - 150.0f, height - 20.0f,
+                              std::min(sinf(angle), sinf(next)) * RING_RADIUS - 150.0f);
+        section.Max = FVector(std::max(cosf(angle), cosf(next)) * RING_RADIUS + 150.0f,
+                              height + 40.0f + (f32) random.Below(400),
+                              std::max(sinf(angle), sinf(next)) * RING_RADIUS + 150.0f);
+        section.bHasBounds = (random.Below(50) != 0);
+        section.bCullable = (random.Below(20) != 0);
+        section.bSortable = (random.Below(8) != 0);
+        section.Path = "tracks/viewports/section_" + std::to_string(i);
+        if ((i % 3) == 0) {
+            Lod::Declare(section.Path, levels);
+            section.LodModels = { &models[i * 3 + 1], &models[i * 3 + 2] };
+        }
+    }
+    return sections;
+}
+
+// Each viewport's car drives around the ring at its own speed, now and then looking back
+Camera GetCamera(size_t viewport, size_t frame) {
+    f32 angle = (f32) viewport * 1.3f + (f32) frame * (0.004f + 0.001f * viewport);
+    f32 ahead = angle + (((frame / 40 + viewport) % 5 == 0) ? -0.02f : 0.02f);
+    Camera camera = { { cosf(angle) * RING_RADIUS, 300.0f * sinf(angle * 5.0f) + 40.0f, sinf(angle) * RING_RADIUS },
+                      { cosf(ahead) * RING_RADIUS, 300.0f * sinf(ahead * 5.0f) + 20.0f, sinf(ahead) * RING_RADIUS },
+                      { 0.0f, 1.0f, 0.0f } };
+    return camera;
+}
+
+/**
+ * Draws a viewport the way Course::Render did before the sections were planned: culling against the current
+ * frustum, sorting each run of sortable sections, then picking and drawing each section's level in one pass.
+ */
+Gfx* DrawViewport(Gfx* gfx, std::vector<TrackSection>& sections, const Camera& camera) {
+    std::vector<size_t> order;
+    Vec3f cameraPos;
+    s32 viewport;
+
+    for (size_t i = 0; i < sections.size(); i++) {
+        TrackSection& section = sections[i];
+        if (section.bCullable && section.bHasBounds) {
+            Vec3f min = { section.Min.x, section.Min.y, section.Min.z };
+            Vec3f max = { section.Max.x, section.Max.y, section.Max.z };
+            if (!Frustum_IsBoxVisible(min, max)) {
+                continue;
+            }
+        }
+        order.push_back(i);
+    }
+    auto closer = [&](size_t a, size_t b) {
+        return SectionPlanner::DistanceToSection(sections[a], camera.Pos) <
+               SectionPlanner::DistanceToSection(sections[b], camera.Pos);
+    };
+    for (auto run = order.begin(); run != order.end();) {
+        auto end = std::find_if(run, order.end(), [&](size_t i) { return !sections[i].bSortable; });
+        std::stable_sort(run, end, closer);
+        run = (end == order.end()) ? end : end + 1;
+    }
+    Frustum_GetCamera(cameraPos, &viewport);
+    for (size_t i : order) {
+        TrackSection& section = sections[i];
+        Gfx* model = section.Model;
+        const std::vector<LodLevel>* levels = Lod::GetLevels(section.Path);
+        if ((levels != nullptr) && (levels->size() == section.LodModels.size())) {
+            size_t level = Lod::SelectLevel(*levels, section.Lod.Level[viewport],
+                                            sqrtf(SectionPlanner::DistanceToSection(section, cameraPos)));
+            if (level > 0) {
+                model = section.LodModels[level - 1];
+            }
+        }
+        gSPDisplayList(gfx++, model);
+    }
+    return gfx;
+}
+
+// Draws a viewport from its plan, the way Course::Render does
+Gfx* DrawPlan(Gfx* gfx, std::vector<TrackSection>& sections, const SectionPlan& plan) {
+    SectionPlanner::Apply(sections, plan);
+    Frustum_AddCounts(plan.Drawn, plan.Culled);
+    memcpy(gfx, plan.Commands.data(), plan.Commands.size() * sizeof(Gfx));
+    return gfx + plan.Commands.size();
+}
+
+bool SameLevels(const std::vector<TrackSection>& a, const std::vector<TrackSection>& b) {
+    for (size_t i = 0; i < a.size(); i++) {
+        if (memcmp(a[i].Lod.Level, b[i].Lod.Level, sizeof(a[i].Lod.Level)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * Captures four player frames of a synthetic custom track three ways: each viewport culled, sorted and drawn
+ * in turn as Course::Render used to, planned one viewport after another, and planned all at once on the job
+ * system. Checks that every frame draws the same calls in the same order, with the same culling counts, and
+ * leaves every section at the same detail level in every viewport. Also checks that a plan is only used for
+ * the camera it was made from, and prints how long each way took.
+ */
+size_t Check_ViewportSections(void) {
+    Random random;
+    std::vector<Gfx> models;
+    std::vector<TrackSection> drawn = BuildSections(models, random);
+    std::vector<TrackSection> serial = drawn;
+    std::vector<TrackSection> parallel = drawn;
+    SectionPlan serialPlans[VIEWPORT_COUNT];
+    SectionPlan parallelPlans[VIEWPORT_COUNT];
+    std::vector<Gfx> lists[3];
+    JobSystem& jobs = GetJobSystem();
+    double drawnMs = 0.0;
+    double serialMs = 0.0;
+    double parallelMs = 0.0;
+    size_t calls = 0;
+    size_t levelChanges = 0;
+    size_t passed = 0;
+    size_t failed = 0;
+
+    auto check = [&](bool ok, const std::string& what) {
+        if (ok) {
+            passed++;
+        } else {
+            failed++;
+            if (failed <= 8) {
+                printf("[Viewports] Failed: %s\n", what.c_str());
+            }
+        }
+    };
+
+    for (std::vector<Gfx>& list : lists) {
+        list.resize(VIEWPORT_SECTIONS * VIEWPORT_COUNT);
+    }
+    for (size_t frame = 0; frame < VIEWPORT_FRAMES; frame++) {
+        Camera cameras[VIEWPORT_COUNT];
+        FrustumView views[VIEWPORT_COUNT];
+        u32 counts[3][VIEWPORT_COUNT][2];
+        Gfx* ends[3];
+        std::string at = " in frame " + std::to_string(frame);
+
+        for (size_t v = 0; v < VIEWPORT_COUNT; v++) {
+            cameras[v] = GetCamera(v, frame);
+            Frustum_BuildView(&views[v], v, cameras[v].Pos, cameras[v].LookAt, cameras[v].Up, FovY, Aspect,
+                              NearPlane, FarPlane);
+        }
+        std::vector<TrackSection> before = drawn;
+
+        // As the viewports used to be drawn
+        auto start = std::chrono::steady_clock::now();
+        Gfx* gfx = lists[0].data();
+        for (size_t v = 0; v < VIEWPORT_COUNT; v++) {
+            Frustum_SetCamera(v, cameras[v].Pos, cameras[v].LookAt, cameras[v].Up, FovY, Aspect, NearPlane, FarPlane);
+            gfx = DrawViewport(gfx, drawn, cameras[v]);
+        }
+        ends[0] = gfx;
+        drawnMs += MsSince(start);
+        Frustum_EndFrame();
+        for (size_t v = 0; v < VIEWPORT_COUNT; v++) {
+            Frustum_GetCounts(v, &counts[0][v][0], &counts[0][v][1]);
+        }
+
+        // Planned ahead, on this thread and across the workers, then drawn
+        for (s32 way = 1; way <= 2; way++) {
+            std::vector<TrackSection>& sections = (way == 1) ? serial : parallel;
+            SectionPlan* plans = (way == 1) ? serialPlans : parallelPlans;
+            start = std::chrono::steady_clock::now();
+            SectionPlanner::PlanViewports(sections, views, VIEWPORT_COUNT, plans, (way == 1) ? nullptr : &jobs);
+            gfx = lists[way].data();
+            for (size_t v = 0; v < VIEWPORT_COUNT; v++) {
+                FrustumView view;
+                Frustum_SetCamera(v, cameras[v].Pos, cameras[v].LookAt, cameras[v].Up, FovY, Aspect, NearPlane,
+                                  FarPlane);
+                Frustum_GetView(&view);
+                check(plans[v].bReady && SectionPlanner::Matches(plans[v], &view, cameras[v].Pos),
+                      "viewport " + std::to_string(v) + " was not planned from its own camera" + at);
+                gfx = DrawPlan(gfx, sections, plans[v]);
+            }
+            ends[way] = gfx;
+            ((way == 1) ? serialMs : parallelMs) += MsSince(start);
+            Frustum_EndFrame();
+            for (size_t v = 0; v < VIEWPORT_COUNT; v++) {
+                Frustum_GetCounts(v, &counts[way][v][0], &counts[way][v][1]);
+            }
+        }
+
+        size_t count = ends[0] - lists[0].data();
+        for (s32 way = 1; way <= 2; way++) {
+            std::string how = (way == 1) ? "planned one by one" : "planned on the job system";
+            check(((size_t) (ends[way] - lists[way].data()) == count) &&
+                      (memcmp(lists[way].data(), lists[0].data(), count * sizeof(Gfx)) == 0),
+                  "the viewports " + how + " drew other calls than when drawn in turn" + at);
+            check(memcmp(counts[way], counts[0], sizeof(counts[0])) == 0,
+                  "the viewports " + how + " counted other sections as culled" + at);
+        }
+        check(SameLevels(serial, drawn) && SameLevels(parallel, drawn),
+              "planned viewports left sections at other detail levels" + at);
+        levelChanges += !SameLevels(before, drawn);
+        calls += count;
+    }
+    check(levelChanges > 0, "no section ever changed its detail level");
+
+    // A plan made from one camera is not used for another one
+    FrustumView view = parallelPlans[0].View;
+    view.CameraPos[0] += 1.0f;
+    check(!SectionPlanner::Matches(parallelPlans[0], &view, parallelPlans[0].SortPos), "a moved camera matched");
+    check(!SectionPlanner::Matches(parallelPlans[0], nullptr, parallelPlans[0].SortPos), "no camera matched");
+    check(!SectionPlanner::Matches(parallelPlans[1], &parallelPlans[0].View, parallelPlans[0].SortPos),
+          "another viewport's camera matched");
+
+    for (const TrackSection& section : drawn) {
+        Lod::Declare(section.Path, {});
+    }
+    Frustum_ClearCamera();
+
+    printf("[Viewports] %d sections seen by %d cameras for %d frames, %.1f calls per frame. Drawn in turn: %.3f ms "
+           "per frame, planned one by one: %.3f ms, planned on %zu worker threads: %.3f ms. %zu checks passed, "
+           "%zu failed\n",
+           VIEWPORT_SECTIONS, VIEWPORT_COUNT, VIEWPORT_FRAMES, (double) calls / VIEWPORT_FRAMES,
+           drawnMs / VIEWPORT_FRAMES, serialMs / VIEWPORT_FRAMES, jobs.GetWorkerCount(),
+           parallelMs / VIEWPORT_FRAMES, passed, failed);
+    return failed;
+}